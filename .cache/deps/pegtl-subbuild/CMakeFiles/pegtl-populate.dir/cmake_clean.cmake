@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pegtl-populate"
+  "CMakeFiles/pegtl-populate-complete"
+  "pegtl-populate-prefix/src/pegtl-populate-stamp/pegtl-populate-build"
+  "pegtl-populate-prefix/src/pegtl-populate-stamp/pegtl-populate-configure"
+  "pegtl-populate-prefix/src/pegtl-populate-stamp/pegtl-populate-download"
+  "pegtl-populate-prefix/src/pegtl-populate-stamp/pegtl-populate-install"
+  "pegtl-populate-prefix/src/pegtl-populate-stamp/pegtl-populate-mkdir"
+  "pegtl-populate-prefix/src/pegtl-populate-stamp/pegtl-populate-patch"
+  "pegtl-populate-prefix/src/pegtl-populate-stamp/pegtl-populate-test"
+  "pegtl-populate-prefix/src/pegtl-populate-stamp/pegtl-populate-update"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/pegtl-populate.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
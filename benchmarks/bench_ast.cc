@@ -0,0 +1,82 @@
+#include "signal_tl/signal_tl.hpp" // for Predicate, Always, Eventually, ExprEqual
+
+#include <benchmark/benchmark.h>
+
+#include <string>  // for string, to_string
+#include <utility> // for move
+#include <vector>  // for vector
+
+namespace stl = signal_tl;
+using signal_tl::ast::Expr;
+
+namespace {
+
+/// Predicates over `k` signals with long names, as generated requirements often have.
+std::vector<Expr> get_predicates(size_t k) {
+  auto out = std::vector<Expr>{};
+  for (size_t i = 0; i < k; i++) {
+    const auto name = "vehicle.powertrain.sensor_" + std::to_string(i % 100);
+    out.emplace_back(stl::Predicate(name) > static_cast<double>(i));
+  }
+  return out;
+}
+
+/// A formula like those built programmatically, with `k` temporal subformulas.
+Expr get_formula(size_t k) {
+  auto args = std::vector<Expr>{};
+  for (const auto& p : get_predicates(k)) {
+    args.push_back(stl::Always(stl::Eventually(p, {0.0, 1.0}) | ~p, {0.0, 10.0}));
+  }
+  return stl::And(std::move(args));
+}
+
+/// Build a conjunction of `k` predicates with `&`, one operand at a time.
+void BM_ChainedAnd(benchmark::State& state) {
+  const auto preds = get_predicates(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto phi = preds.front();
+    for (size_t i = 1; i < preds.size(); i++) { phi = std::move(phi) & preds[i]; }
+    benchmark::DoNotOptimize(phi);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BuildFormula(benchmark::State& state) {
+  for (auto _ : state) {
+    auto phi = get_formula(static_cast<size_t>(state.range(0)));
+    benchmark::DoNotOptimize(phi);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Copy the operands of a large conjunction (as the Python bindings do).
+void BM_CopyOperands(benchmark::State& state) {
+  const auto phi   = get_formula(static_cast<size_t>(state.range(0)));
+  const auto preds = get_predicates(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto args = std::get<stl::ast::AndPtr>(phi)->args;
+    auto copy = preds;
+    benchmark::DoNotOptimize(args);
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Compare two formulas that are equal, but don't share any nodes.
+void BM_CompareFormulas(benchmark::State& state) {
+  const auto lhs = get_formula(static_cast<size_t>(state.range(0)));
+  const auto rhs = get_formula(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stl::ast::ExprEqual{}(lhs, rhs));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_ChainedAnd)->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK(BM_BuildFormula)->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK(BM_CopyOperands)->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK(BM_CompareFormulas)->RangeMultiplier(8)->Range(8, 1 << 12);
+
+BENCHMARK_MAIN();
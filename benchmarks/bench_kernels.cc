@@ -0,0 +1,180 @@
+#include "signal_tl/signal_tl.hpp" // for Signal, Predicate, compute_robustness
+
+#include "kernels.hpp"   // for affine, elementwise_min, scalar
+#include "minmax.hpp"    // for compute_elementwise_min
+#include "operators.hpp" // for compute_predicates
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>   // for sin, cos
+#include <cstdint> // for uint8_t
+#include <memory>  // for make_shared
+#include <utility> // for pair
+#include <vector>  // for vector
+
+namespace stl     = signal_tl;
+namespace kernels = signal_tl::kernels;
+using namespace signal_tl::signal;
+
+namespace {
+
+constexpr int64_t MIN_SIZE = 1 << 10;
+constexpr int64_t MAX_SIZE = 1 << 22;
+
+std::vector<double> get_times(size_t n) {
+  auto out = std::vector<double>(n);
+  for (size_t i = 0; i < n; i++) { out[i] = 0.01 * static_cast<double>(i); }
+  return out;
+}
+
+std::vector<double> get_values(size_t n, double freq) {
+  auto out = std::vector<double>(n);
+  for (size_t i = 0; i < n; i++) { out[i] = std::sin(freq * static_cast<double>(i)); }
+  return out;
+}
+
+SignalPtr get_signal(size_t n, double freq) {
+  return std::make_shared<Signal>(get_values(n, freq), get_times(n));
+}
+
+void BM_AffineScalar(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = get_values(n, 0.1);
+  auto out     = std::vector<double>(n);
+  for (auto _ : state) {
+    kernels::scalar::affine(x.data(), out.data(), n, -1.0, 0.5);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 2 * sizeof(double));
+}
+
+void BM_AffineSimd(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = get_values(n, 0.1);
+  auto out     = std::vector<double>(n);
+  state.SetLabel(kernels::simd_level_name(kernels::simd_level()));
+  for (auto _ : state) {
+    kernels::affine(x.data(), out.data(), n, -1.0, 0.5);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 2 * sizeof(double));
+}
+
+void BM_MinScalar(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = get_values(n, 0.1);
+  const auto y = get_values(n, 0.3);
+  auto out     = std::vector<double>(n);
+  auto chose_y = std::vector<std::uint8_t>(n);
+  for (auto _ : state) {
+    kernels::scalar::elementwise_min(x.data(), y.data(), out.data(), chose_y.data(), n);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::DoNotOptimize(chose_y.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 3 * sizeof(double));
+}
+
+void BM_MinSimd(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = get_values(n, 0.1);
+  const auto y = get_values(n, 0.3);
+  auto out     = std::vector<double>(n);
+  auto chose_y = std::vector<std::uint8_t>(n);
+  state.SetLabel(kernels::simd_level_name(kernels::simd_level()));
+  for (auto _ : state) {
+    kernels::elementwise_min(x.data(), y.data(), out.data(), chose_y.data(), n);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::DoNotOptimize(chose_y.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 3 * sizeof(double));
+}
+
+/// The predicate robustness as it was computed before, one `push_back` at a time.
+void BM_PredicatePushBack(benchmark::State& state) {
+  const auto x = get_signal(static_cast<size_t>(state.range(0)), 0.1);
+  for (auto _ : state) {
+    auto y = std::make_shared<Signal>();
+    for (const auto s : *x) { y->push_back(s.time, s.value - 0.5); }
+    benchmark::DoNotOptimize(y);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Predicate(benchmark::State& state) {
+  const auto trace = Trace{{"x", get_signal(static_cast<size_t>(state.range(0)), 0.1)}};
+  const auto phi   = stl::Predicate("x") > 0.5;
+  for (auto _ : state) {
+    auto y = stl::compute_robustness(phi, trace);
+    benchmark::DoNotOptimize(y);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Not(benchmark::State& state) {
+  const auto trace = Trace{{"x", get_signal(static_cast<size_t>(state.range(0)), 0.1)}};
+  const auto phi   = ~(stl::Predicate("x") > 0.5);
+  for (auto _ : state) {
+    auto y = stl::compute_robustness(phi, trace);
+    benchmark::DoNotOptimize(y);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+constexpr size_t NUM_THRESHOLDS = 64;
+
+/// Many thresholds on the same signal, each computed on its own.
+void BM_ThresholdsOneAtATime(benchmark::State& state) {
+  const auto x = get_signal(static_cast<size_t>(state.range(0)), 0.1);
+  for (auto _ : state) {
+    auto ys = std::vector<SignalPtr>{};
+    for (size_t i = 0; i < NUM_THRESHOLDS; i++) {
+      ys.push_back(x->affine(1.0, -0.01 * static_cast<double>(i)));
+    }
+    benchmark::DoNotOptimize(ys);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * NUM_THRESHOLDS);
+}
+
+/// Same as above, but all of them computed together.
+void BM_ThresholdsTogether(benchmark::State& state) {
+  const auto x    = get_signal(static_cast<size_t>(state.range(0)), 0.1);
+  auto predicates = std::vector<std::pair<stl::ast::ComparisonOp, double>>{};
+  for (size_t i = 0; i < NUM_THRESHOLDS; i++) {
+    predicates.emplace_back(stl::ast::ComparisonOp::GT, 0.01 * static_cast<double>(i));
+  }
+  for (auto _ : state) {
+    auto ys = stl::semantics::compute_predicates(x, predicates);
+    benchmark::DoNotOptimize(ys);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * NUM_THRESHOLDS);
+}
+
+void BM_SynchronizedMin(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = get_signal(n, 0.1);
+  const auto y = get_signal(n, 0.3);
+  for (auto _ : state) {
+    auto z = stl::minmax::compute_elementwise_min(x, y, true);
+    benchmark::DoNotOptimize(z);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_AffineScalar)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_AffineSimd)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_MinScalar)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_MinSimd)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_PredicatePushBack)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_Predicate)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_Not)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_ThresholdsOneAtATime)->Range(MIN_SIZE, 1 << 18);
+BENCHMARK(BM_ThresholdsTogether)->Range(MIN_SIZE, 1 << 18);
+BENCHMARK(BM_SynchronizedMin)->Range(MIN_SIZE, MAX_SIZE);
+
+BENCHMARK_MAIN();
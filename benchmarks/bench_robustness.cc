@@ -0,0 +1,420 @@
+#include "signal_tl/internal/filesystem.hpp" // for temp_directory_path, remove_all
+#include "signal_tl/signal_tl.hpp"           // for Signal, Predicate, ResultCache
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>  // for copysign, sin
+#include <memory> // for make_shared, make_unique
+#include <vector> // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+
+namespace {
+
+constexpr size_t TRACE_SIZE = 1 << 16;
+
+Trace get_trace(size_t n) {
+  auto x = std::make_shared<Signal>();
+  auto y = std::make_shared<Signal>();
+  x->reserve(n);
+  y->reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    const double t = 0.01 * static_cast<double>(i);
+    x->push_back(t, std::sin(t));
+    y->push_back(t, std::sin(3 * t));
+  }
+  return Trace{{"x", x}, {"y", y}};
+}
+
+Expr get_subformula() {
+  return stl::Eventually((stl::Predicate("x") > 0) | (stl::Predicate("y") < 0.5));
+}
+
+/// A formula that references the same subformula `k` times, like a `define-formula`
+/// that is used in multiple places in a specification.
+void BM_SharedSubformula(benchmark::State& state) {
+  const auto trace = get_trace(TRACE_SIZE);
+  const auto sub   = get_subformula();
+  auto args        = std::vector<Expr>{};
+  for (int64_t i = 0; i < state.range(0); i++) {
+    args.push_back((i % 2 == 0) ? sub : Expr{stl::Always(sub)});
+  }
+  const auto phi = (args.size() < 2) ? args.at(0) : stl::And(args);
+  for (auto _ : state) {
+    auto rob = stl::compute_robustness(phi, trace);
+    benchmark::DoNotOptimize(rob);
+  }
+}
+
+/// Same as above, but each reference is a structurally equal copy of the subformula.
+void BM_CopiedSubformula(benchmark::State& state) {
+  const auto trace = get_trace(TRACE_SIZE);
+  auto args        = std::vector<Expr>{};
+  for (int64_t i = 0; i < state.range(0); i++) {
+    args.push_back((i % 2 == 0) ? get_subformula() : stl::Always(get_subformula()));
+  }
+  const auto phi = (args.size() < 2) ? args.at(0) : stl::And(args);
+  for (auto _ : state) {
+    auto rob = stl::compute_robustness(phi, trace);
+    benchmark::DoNotOptimize(rob);
+  }
+}
+
+/// A wide conjunction of independent subformulas, evaluated with different numbers
+/// of threads.
+void BM_ParallelAnd(benchmark::State& state) {
+  const auto trace = get_trace(TRACE_SIZE);
+  auto args        = std::vector<Expr>{};
+  for (int i = 0; i < 32; i++) {
+    const double c = 0.05 * i;
+    const auto sub = (stl::Predicate("x") > c) | (stl::Predicate("y") < c);
+    args.push_back(stl::Eventually(sub));
+  }
+  const auto phi = stl::And(args);
+
+  auto options        = stl::EvaluationOptions{};
+  options.num_threads = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    auto rob = stl::compute_robustness(phi, trace, options);
+    benchmark::DoNotOptimize(rob);
+  }
+}
+
+std::vector<Expr> get_formulas() {
+  const auto x = stl::Predicate("x");
+  const auto y = stl::Predicate("y");
+  return {
+      stl::Always(x > -0.5),
+      stl::Eventually((x > 0.9) & (y < 0)),
+      stl::Always((x > 0) | stl::Eventually(y > 0.5)),
+      stl::Until(x > -0.9, y > 0.99)};
+}
+
+/// Evaluate each (formula, trace) pair with a separate call.
+void BM_LoopOverPairs(benchmark::State& state) {
+  const auto formulas = get_formulas();
+  const auto n        = static_cast<size_t>(state.range(0));
+  const auto traces   = std::vector<Trace>(n, get_trace(1024));
+  for (auto _ : state) {
+    auto out = std::vector<double>{};
+    for (const auto& phi : formulas) {
+      for (const auto& trace : traces) {
+        out.push_back(stl::compute_robustness(phi, trace)->front().value);
+      }
+    }
+    benchmark::DoNotOptimize(out);
+  }
+}
+
+void BM_Batch(benchmark::State& state) {
+  const auto formulas = get_formulas();
+  const auto n        = static_cast<size_t>(state.range(0));
+  const auto traces   = std::vector<Trace>(n, get_trace(1024));
+  auto options        = stl::EvaluationOptions{};
+  options.num_threads = 0;
+  for (auto _ : state) {
+    auto out = stl::compute_robustness_batch(formulas, traces, options);
+    benchmark::DoNotOptimize(out);
+  }
+}
+
+/// Evaluate the formulas again on an unchanged trace, as in a regression run, without
+/// a cache, with the results in memory, and with the results in a directory (and a
+/// new cache for each run).
+void BM_RepeatedEvaluation(benchmark::State& state) {
+  const auto formulas = get_formulas();
+  const auto trace    = get_trace(static_cast<size_t>(state.range(0)));
+  const auto dir      = stdfs::temp_directory_path() / "signal_tl_bench_result_cache";
+  stdfs::remove_all(dir);
+  auto cache    = std::make_unique<stl::ResultCache>(dir);
+  auto options  = stl::EvaluationOptions{};
+  const auto on = state.range(1);
+  if (on > 0) {
+    options.cache = cache.get();
+    benchmark::DoNotOptimize(stl::compute_robustness_batch(formulas, {trace}, options));
+  }
+  for (auto _ : state) {
+    if (on > 1) {
+      cache         = std::make_unique<stl::ResultCache>(dir);
+      options.cache = cache.get();
+    }
+    auto out = stl::compute_robustness_batch(formulas, {trace}, options);
+    benchmark::DoNotOptimize(out);
+  }
+  stdfs::remove_all(dir);
+}
+
+/// Evaluate all the formulas on many short traces, where the overhead of walking the
+/// formulas (instead of computing the signals) matters the most.
+void BM_TreeOverTraces(benchmark::State& state) {
+  const auto phi    = stl::And(get_formulas());
+  const auto n      = static_cast<size_t>(state.range(0));
+  const auto traces = std::vector<Trace>(256, get_trace(n));
+  for (auto _ : state) {
+    for (const auto& trace : traces) {
+      auto rob = stl::compute_robustness(phi, trace);
+      benchmark::DoNotOptimize(rob);
+    }
+  }
+}
+
+/// Same as above, but with the formula compiled once.
+void BM_PlanOverTraces(benchmark::State& state) {
+  const auto plan   = stl::EvaluationPlan{stl::And(get_formulas())};
+  const auto n      = static_cast<size_t>(state.range(0));
+  const auto traces = std::vector<Trace>(256, get_trace(n));
+  for (auto _ : state) {
+    for (const auto& trace : traces) {
+      auto rob = plan.evaluate(trace);
+      benchmark::DoNotOptimize(rob);
+    }
+  }
+}
+
+/// A bounded response specification, checked at the start of a long trace.
+Expr get_response_formula() {
+  const auto x        = stl::Predicate("x");
+  const auto y        = stl::Predicate("y");
+  const auto response = stl::Implies(x > 0.9, stl::Eventually(y > 0.5, {0.0, 2.0}));
+  return stl::Always(response, {0.0, 10.0}) & stl::Eventually(x < -0.9, {0.0, 5.0});
+}
+
+void BM_RobustnessAtStart(benchmark::State& state) {
+  const auto trace = get_trace(static_cast<size_t>(state.range(0)));
+  const auto phi   = get_response_formula();
+  for (auto _ : state) {
+    auto rob = stl::compute_robustness(phi, trace)->front().value > 0;
+    benchmark::DoNotOptimize(rob);
+  }
+}
+
+void BM_RobustnessAtQuery(benchmark::State& state) {
+  const auto trace = get_trace(static_cast<size_t>(state.range(0)));
+  const auto phi   = get_response_formula();
+  const double t   = trace.at("x")->begin_time();
+  for (auto _ : state) {
+    auto rob = stl::compute_robustness_at(phi, trace, t) > 0;
+    benchmark::DoNotOptimize(rob);
+  }
+}
+
+void BM_SatisfactionAtStart(benchmark::State& state) {
+  const auto trace = get_trace(static_cast<size_t>(state.range(0)));
+  const auto phi   = get_response_formula();
+  for (auto _ : state) {
+    auto verdict = stl::check_satisfaction(phi, trace);
+    benchmark::DoNotOptimize(verdict);
+  }
+}
+
+/// The gradient of the robustness at the start of the trace, with a single backward
+/// pass, and with central differences over the first `range(0)` samples of each
+/// signal (i.e., what it takes to optimize over a short prefix of the trace).
+void BM_RobustnessGradient(benchmark::State& state) {
+  const auto trace = get_trace(1 << 12);
+  const auto phi   = get_response_formula();
+  for (auto _ : state) {
+    auto grad = stl::compute_robustness_gradient(phi, trace);
+    benchmark::DoNotOptimize(grad);
+  }
+}
+
+void BM_FiniteDifferences(benchmark::State& state) {
+  const auto phi    = get_response_formula();
+  const auto signal = get_trace(1 << 12);
+  const auto n      = static_cast<size_t>(state.range(0));
+  const double h    = 1e-6;
+  for (auto _ : state) {
+    auto trace = signal;
+    auto grad  = std::vector<double>{};
+    for (const auto& [name, x] : signal) {
+      const auto ts = std::vector<double>(x->times().begin(), x->times().end());
+      auto values   = std::vector<double>(x->values().begin(), x->values().end());
+      for (size_t i = 0; i < n; i++) {
+        double out = 0.0;
+        for (const double dx : {h, -h}) {
+          values[i] += dx;
+          trace[name] = std::make_shared<Signal>(values, ts);
+          out += std::copysign(stl::compute_robustness_at(phi, trace, 0.0), dx);
+          values[i] -= dx;
+        }
+        grad.push_back(out / (2 * h));
+      }
+      trace[name] = x;
+    }
+    benchmark::DoNotOptimize(grad);
+  }
+}
+
+/// A bounded formula, evaluated with each of the semantics.
+Expr get_bounded_formula() {
+  const auto x = stl::Predicate("x");
+  const auto y = stl::Predicate("y");
+  return stl::Always((x > 0) | stl::Eventually(y > 0.5, {0.0, 1.0}), {0.0, 5.0});
+}
+
+void BM_ClassicSemantics(benchmark::State& state) {
+  const auto trace = get_trace(static_cast<size_t>(state.range(0)));
+  const auto phi   = get_bounded_formula();
+  for (auto _ : state) {
+    auto rob = stl::compute_robustness(phi, trace);
+    benchmark::DoNotOptimize(rob);
+  }
+}
+
+void BM_FilteringSemantics(benchmark::State& state) {
+  const auto trace  = get_trace(static_cast<size_t>(state.range(0)));
+  const auto phi    = get_bounded_formula();
+  auto options      = stl::EvaluationOptions{};
+  options.semantics = stl::Semantics::Filtering;
+  for (auto _ : state) {
+    auto rob = stl::compute_robustness(phi, trace, options);
+    benchmark::DoNotOptimize(rob);
+  }
+}
+
+void BM_CumulativeSemantics(benchmark::State& state) {
+  const auto trace = get_trace(static_cast<size_t>(state.range(0)));
+  const auto phi   = get_bounded_formula();
+  for (auto _ : state) {
+    auto rob = stl::compute_cumulative_robustness(phi, trace);
+    benchmark::DoNotOptimize(rob);
+  }
+}
+
+/// The discrete-time robustness, over the (uniformly sampled) signals of the trace.
+void BM_DiscreteSemantics(benchmark::State& state) {
+  const auto trace = get_trace(static_cast<size_t>(state.range(0)));
+  const auto phi   = get_bounded_formula();
+  for (auto _ : state) {
+    auto rob = stl::discrete::compute_robustness(phi, trace);
+    benchmark::DoNotOptimize(rob);
+  }
+}
+
+/// Same as above, but directly over the values, with a compiled plan.
+void BM_DiscreteValues(benchmark::State& state) {
+  const auto trace = get_trace(static_cast<size_t>(state.range(0)));
+  const auto plan  = stl::EvaluationPlan{get_bounded_formula()};
+  auto values      = stl::discrete::DiscreteTrace{};
+  for (const auto& [name, x] : trace) {
+    values[name].assign(x->values().begin(), x->values().end());
+  }
+  for (auto _ : state) {
+    auto rob = stl::discrete::compute_robustness(plan, values, 0.01);
+    benchmark::DoNotOptimize(rob);
+  }
+}
+
+/// A deep formula, where every node creates signals as long as the trace.
+void BM_DeepFormula(benchmark::State& state) {
+  const auto trace = get_trace(TRACE_SIZE);
+  auto phi         = Expr{stl::Predicate("x") > 0};
+  for (int64_t i = 0; i < state.range(0); i++) {
+    const auto y = stl::Predicate("y") < 0.1 * static_cast<double>(i);
+    phi = (i % 2 == 0) ? stl::Eventually(phi & y) : stl::Always(phi | ~y);
+  }
+  for (auto _ : state) {
+    auto out = stl::compute_robustness(phi, trace);
+    benchmark::DoNotOptimize(out);
+  }
+}
+
+/// Same as above, but with the statistics of each subformula recorded.
+void BM_ProfiledDeepFormula(benchmark::State& state) {
+  const auto trace = get_trace(TRACE_SIZE);
+  auto phi         = Expr{stl::Predicate("x") > 0};
+  for (int64_t i = 0; i < state.range(0); i++) {
+    const auto y = stl::Predicate("y") < 0.1 * static_cast<double>(i);
+    phi = (i % 2 == 0) ? stl::Eventually(phi & y) : stl::Always(phi | ~y);
+  }
+  auto profile    = stl::EvaluationProfile{};
+  auto options    = stl::EvaluationOptions{};
+  options.profile = &profile;
+  for (auto _ : state) {
+    auto out = stl::compute_robustness(phi, trace, options);
+    benchmark::DoNotOptimize(out);
+  }
+}
+
+/// A formula with the redundancies of generated requirements: nested temporal
+/// operators, predicates over the same signal, negated subformulas, and constants,
+/// evaluated with (`1`) and without (`0`) simplifying it first.
+void BM_RedundantFormula(benchmark::State& state) {
+  const auto trace = get_trace(TRACE_SIZE);
+  const auto x     = stl::Predicate("x");
+  const auto y     = stl::Predicate("y");
+  auto args        = std::vector<Expr>{};
+  for (int i = 0; i < 8; i++) {
+    const double c = 0.1 * i;
+    const auto g = stl::Always((x > -c) & (x > -0.5), {0.0, 1.0});
+    args.push_back(stl::Always(g, {0.0, 2.0}));
+    args.push_back(~stl::Eventually((y >= c) | stl::Const(false), {0.5, 1.0}));
+  }
+  const auto phi = stl::And(args);
+
+  auto options     = stl::EvaluationOptions{};
+  options.simplify = state.range(0) != 0;
+  for (auto _ : state) {
+    auto rob = stl::compute_robustness(phi, trace, options);
+    benchmark::DoNotOptimize(rob);
+  }
+}
+
+/// Re-evaluating a trace after appending a chunk of 100 samples to it.
+void BM_RecomputeAppended(benchmark::State& state) {
+  const auto trace = get_trace(static_cast<size_t>(state.range(0)));
+  const auto plan  = stl::EvaluationPlan{get_bounded_formula()};
+  for (auto _ : state) {
+    auto rob = plan.evaluate(trace);
+    benchmark::DoNotOptimize(rob);
+  }
+}
+
+void BM_IncrementalAppend(benchmark::State& state) {
+  const auto trace = get_trace(static_cast<size_t>(state.range(0)));
+  auto eval        = stl::IncrementalEvaluation{
+      stl::EvaluationPlan{get_bounded_formula()}, trace};
+  double t = trace.at("x")->end_time();
+  for (auto _ : state) {
+    auto x = std::make_shared<Signal>();
+    auto y = std::make_shared<Signal>();
+    for (size_t i = 0; i < 100; i++) {
+      t += 0.01;
+      x->push_back(t, std::sin(t));
+      y->push_back(t, std::sin(3 * t));
+    }
+    eval.append(Trace{{"x", x}, {"y", y}});
+    benchmark::DoNotOptimize(eval.results());
+  }
+}
+
+} // namespace
+
+BENCHMARK(BM_RobustnessAtStart)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_RobustnessAtQuery)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_SatisfactionAtStart)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_RobustnessGradient);
+BENCHMARK(BM_FiniteDifferences)->RangeMultiplier(8)->Range(8, 512);
+BENCHMARK(BM_ClassicSemantics)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_FilteringSemantics)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_CumulativeSemantics)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_DiscreteSemantics)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_DiscreteValues)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_DeepFormula)->RangeMultiplier(4)->Range(4, 64);
+BENCHMARK(BM_ProfiledDeepFormula)->RangeMultiplier(4)->Range(4, 64);
+BENCHMARK(BM_RedundantFormula)->Arg(0)->Arg(1);
+BENCHMARK(BM_RecomputeAppended)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_IncrementalAppend)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_LoopOverPairs)->RangeMultiplier(8)->Range(8, 512)->UseRealTime();
+BENCHMARK(BM_Batch)->RangeMultiplier(8)->Range(8, 512)->UseRealTime();
+BENCHMARK(BM_RepeatedEvaluation)->ArgsProduct({{1 << 12, 1 << 18}, {0, 1, 2}});
+BENCHMARK(BM_TreeOverTraces)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_PlanOverTraces)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_ParallelAnd)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK(BM_SharedSubformula)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(BM_CopiedSubformula)->RangeMultiplier(4)->Range(1, 64);
+
+BENCHMARK_MAIN();
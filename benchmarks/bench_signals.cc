@@ -0,0 +1,294 @@
+#include "signal_tl/signal_tl.hpp" // for Signal, Predicate, compute_robustness
+
+#include "minmax.hpp" // for compute_min_seq
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm> // for min
+#include <cmath>     // for sin
+#include <cstdint>   // for int64_t
+#include <map>       // for map
+#include <memory>    // for make_shared
+#include <string>    // for string, to_string
+#include <utility>   // for move
+#include <vector>    // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+
+namespace {
+
+constexpr int64_t MIN_SIZE = 1 << 10;
+constexpr int64_t MAX_SIZE = 1 << 20;
+constexpr double DT        = 0.01;
+
+/// A sampled sine wave, starting at `offset` with a sampling period of `dt`.
+SignalPtr get_signal(size_t n, double dt, double offset, double freq) {
+  auto times  = std::vector<double>(n);
+  auto values = std::vector<double>(n);
+  for (size_t i = 0; i < n; i++) {
+    times[i]  = offset + dt * static_cast<double>(i);
+    values[i] = std::sin(freq * times[i]);
+  }
+  return std::make_shared<Signal>(std::move(values), std::move(times));
+}
+
+void BM_SignalFromColumns(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = get_signal(n, DT, 0.0, 1.0);
+  for (auto _ : state) {
+    auto times  = std::vector<double>{x->times().begin(), x->times().end()};
+    auto values = std::vector<double>{x->values().begin(), x->values().end()};
+    auto y      = std::make_shared<Signal>(std::move(values), std::move(times));
+    benchmark::DoNotOptimize(y);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SignalPushBack(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    auto y = std::make_shared<Signal>();
+    y->reserve(n);
+    for (size_t i = 0; i < n; i++) {
+      const double t = DT * static_cast<double>(i);
+      y->push_back(t, std::sin(t));
+    }
+    benchmark::DoNotOptimize(y);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Append a signal to another in chunks of `state.range(1)` samples, as when a trace
+/// is read (or received) a block at a time.
+void BM_SignalAppendChunks(benchmark::State& state) {
+  const auto n     = static_cast<size_t>(state.range(0));
+  const auto chunk = static_cast<size_t>(state.range(1));
+  const auto x     = get_signal(n, DT, 0.0, 1.0);
+  const auto ts    = x->times();
+  const auto xs    = x->values();
+  const auto ds    = x->derivatives();
+  for (auto _ : state) {
+    auto y = std::make_shared<Signal>();
+    y->reserve(n);
+    for (size_t i = 0; i < n; i += chunk) {
+      const size_t m = std::min(chunk, n - i);
+      y->append_sorted({ts.data() + i, m}, {xs.data() + i, m}, {ds.data() + i, m});
+    }
+    benchmark::DoNotOptimize(y);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Look up the end of a window at every sample of a signal.
+void BM_SignalEndAt(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = get_signal(n, DT, 0.0, 1.0);
+  for (auto _ : state) {
+    size_t total = 0;
+    for (const double t : x->times()) {
+      total += static_cast<size_t>(x->end_at(t + 0.5 * DT * static_cast<double>(n)) -
+                                   x->begin());
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Synchronize two signals that are sampled with different periods, so that almost
+/// none of their time points coincide.
+void BM_SynchronizeMisaligned(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = get_signal(n, DT, 0.0, 1.0);
+  const auto y = get_signal(n, 1.3 * DT, 0.0, 3.0);
+  for (auto _ : state) {
+    auto [x_, y_] = synchronize(x, y);
+    benchmark::DoNotOptimize(x_);
+    benchmark::DoNotOptimize(y_);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SynchronizeAligned(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = get_signal(n, DT, 0.0, 1.0);
+  const auto y = get_signal(n, DT, 0.0, 3.0);
+  for (auto _ : state) {
+    auto [x_, y_] = synchronize(x, y);
+    benchmark::DoNotOptimize(x_);
+    benchmark::DoNotOptimize(y_);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Run with the number of samples and the width of the window as a fraction
+/// (1/arg) of the length of the trace.
+void BM_WindowedMin(benchmark::State& state) {
+  const auto n        = static_cast<size_t>(state.range(0));
+  const auto x        = get_signal(n, DT, 0.0, 1.0);
+  const double length = x->end_time() - x->begin_time();
+  const double b      = length / static_cast<double>(state.range(1));
+  state.SetLabel("window = trace / " + std::to_string(state.range(1)));
+  for (auto _ : state) {
+    auto z = stl::minmax::compute_min_seq(x, 0.0, b);
+    benchmark::DoNotOptimize(z);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_UnboundedMin(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = get_signal(n, DT, 0.0, 1.0);
+  for (auto _ : state) {
+    auto z = stl::minmax::compute_min_seq(x);
+    benchmark::DoNotOptimize(z);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// A trace with `k` signals, each sampled at a slightly different rate.
+Trace get_trace(size_t n, size_t k) {
+  auto trace = Trace{};
+  for (size_t i = 0; i < k; i++) {
+    const double scale             = 1.0 + 0.1 * static_cast<double>(i);
+    trace["x" + std::to_string(i)] = get_signal(n, scale * DT, 0.0, scale);
+  }
+  return trace;
+}
+
+template <bool IsAnd>
+Expr get_nary_formula(size_t k) {
+  auto args = std::vector<Expr>{};
+  for (size_t i = 0; i < k; i++) {
+    args.push_back(stl::Predicate("x" + std::to_string(i)) > 0);
+  }
+  if constexpr (IsAnd) {
+    return stl::And(args);
+  } else {
+    return stl::Or(args);
+  }
+}
+
+/// Run with the number of samples of each signal and the number of arguments.
+template <bool IsAnd>
+void BM_Nary(benchmark::State& state) {
+  const auto n     = static_cast<size_t>(state.range(0));
+  const auto k     = static_cast<size_t>(state.range(1));
+  const auto trace = get_trace(n, k);
+  const auto phi   = get_nary_formula<IsAnd>(k);
+  for (auto _ : state) {
+    auto rob = stl::compute_robustness(phi, trace);
+    benchmark::DoNotOptimize(rob);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+void BM_NaryAnd(benchmark::State& state) {
+  BM_Nary<true>(state);
+}
+
+/// Same as `BM_NaryAnd`, but with all the signals logged at the same time points.
+void BM_NaryAndSharedTimes(benchmark::State& state) {
+  const auto n  = static_cast<size_t>(state.range(0));
+  const auto k  = static_cast<size_t>(state.range(1));
+  auto times    = std::vector<double>(n);
+  auto channels = std::map<std::string, std::vector<double>>{};
+  for (size_t i = 0; i < n; i++) { times[i] = DT * static_cast<double>(i); }
+  for (size_t j = 0; j < k; j++) {
+    auto& values       = channels["x" + std::to_string(j)];
+    const double scale = 1.0 + 0.1 * static_cast<double>(j);
+    for (const double t : times) { values.push_back(std::sin(scale * t)); }
+  }
+  const auto trace = make_trace(std::move(times), std::move(channels));
+  const auto phi   = get_nary_formula<true>(k);
+  for (auto _ : state) {
+    auto rob = stl::compute_robustness(phi, trace);
+    benchmark::DoNotOptimize(rob);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+void BM_NaryOr(benchmark::State& state) {
+  BM_Nary<false>(state);
+}
+
+/// Piecewise constant channels (a mode flag and a setpoint), logged every `DT`.
+std::map<std::string, std::vector<double>> get_piecewise_constant(size_t n) {
+  auto channels = std::map<std::string, std::vector<double>>{};
+  for (size_t i = 0; i < n; i++) {
+    channels["mode"].push_back(static_cast<double>((i / 150) % 3));
+    channels["setpoint"].push_back(0.5 * static_cast<double>((i / 400) % 2));
+  }
+  return channels;
+}
+
+std::vector<double> get_times(size_t n) {
+  auto times = std::vector<double>(n);
+  for (size_t i = 0; i < n; i++) { times[i] = DT * static_cast<double>(i); }
+  return times;
+}
+
+Expr get_mode_formula() {
+  const auto mode     = stl::Predicate("mode");
+  const auto setpoint = stl::Predicate("setpoint");
+  const auto response = stl::Eventually(setpoint > 0.25 & mode < 2, {0.0, 1.5});
+  return stl::Always((mode >= 1) | response, {0.0, 4.0});
+}
+
+void BM_CompressSignal(benchmark::State& state) {
+  const auto n        = static_cast<size_t>(state.range(0));
+  const auto times    = get_times(n);
+  const auto channels = get_piecewise_constant(n);
+  for (auto _ : state) {
+    auto y = Signal::compressed(std::vector{channels.at("mode")}, std::vector{times});
+    benchmark::DoNotOptimize(y);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// The robustness over piecewise constant channels, with every logged sample.
+void BM_PiecewiseConstantRaw(benchmark::State& state) {
+  const auto n     = static_cast<size_t>(state.range(0));
+  const auto trace = make_trace(get_times(n), get_piecewise_constant(n));
+  const auto phi   = get_mode_formula();
+  for (auto _ : state) {
+    auto rob = stl::compute_robustness(phi, trace);
+    benchmark::DoNotOptimize(rob);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Same as above, with only the breakpoints of the channels.
+void BM_PiecewiseConstantCompressed(benchmark::State& state) {
+  const auto n     = static_cast<size_t>(state.range(0));
+  const auto trace = make_compressed_trace(get_times(n), get_piecewise_constant(n));
+  const auto phi   = get_mode_formula();
+  for (auto _ : state) {
+    auto rob = stl::compute_robustness(phi, trace);
+    benchmark::DoNotOptimize(rob);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_SignalFromColumns)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_SignalPushBack)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_SignalAppendChunks)->ArgsProduct({{1 << 12, 1 << 16}, {1, 64, 1024}});
+BENCHMARK(BM_SignalEndAt)->Range(MIN_SIZE, 1 << 14);
+BENCHMARK(BM_SynchronizeAligned)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_SynchronizeMisaligned)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_UnboundedMin)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_WindowedMin)->ArgsProduct({
+    benchmark::CreateRange(MIN_SIZE, MAX_SIZE, 8),
+    {1000, 100, 10, 2},
+});
+BENCHMARK(BM_NaryAnd)->ArgsProduct({{1 << 12, 1 << 16}, {2, 8, 32}});
+BENCHMARK(BM_NaryAndSharedTimes)->ArgsProduct({{1 << 12, 1 << 16}, {2, 8, 32}});
+BENCHMARK(BM_NaryOr)->ArgsProduct({{1 << 12, 1 << 16}, {2, 8, 32}});
+BENCHMARK(BM_CompressSignal)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_PiecewiseConstantRaw)->Range(MIN_SIZE, MAX_SIZE);
+BENCHMARK(BM_PiecewiseConstantCompressed)->Range(MIN_SIZE, MAX_SIZE);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,148 @@
+#include "signal_tl/internal/filesystem.hpp" // for path, directory_iterator, remove
+#include "signal_tl/parser.hpp"              // for from_file, from_string
+#include "signal_tl/signal_tl.hpp"           // for Signal, compute_robustness
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>   // for sin
+#include <cstdint> // for int64_t
+#include <memory>  // for make_shared
+#include <sstream> // for ostringstream
+#include <string>  // for string, to_string
+#include <utility> // for move
+#include <vector>  // for vector
+
+#ifndef SIGNALTL_TESTS_DIR
+#error "SIGNALTL_TESTS_DIR has not been defined in the preprocessor stage"
+#endif
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+
+namespace {
+
+/// Signals used by the specifications in `tests/formulas`.
+const auto SIGNAL_NAMES = std::vector<std::string>{"p", "q", "r", "s", "x"};
+
+Trace get_trace(size_t n) {
+  auto trace  = Trace{};
+  double freq = 1.0;
+  for (const auto& name : SIGNAL_NAMES) {
+    auto times  = std::vector<double>(n);
+    auto values = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) {
+      times[i]  = 0.01 * static_cast<double>(i);
+      values[i] = 10 * std::sin(freq * times[i]);
+    }
+    trace[name] = std::make_shared<Signal>(std::move(values), std::move(times));
+    freq += 0.5;
+  }
+  return trace;
+}
+
+/// A specification with `k` formulas, each referring to the previous ones.
+std::string get_spec(size_t k) {
+  auto out = std::ostringstream{};
+  out << "; Generated specification\n";
+  out << "(define-formula phi0 (< p 0))\n";
+  for (size_t i = 1; i < k; i++) {
+    const auto& name = SIGNAL_NAMES[i % SIGNAL_NAMES.size()];
+    out << "(define-formula phi" << i << " (and phi" << i - 1 << " (always (> " << name
+        << " " << i << ".5)) (eventually (not (< " << name << " -" << i << ")))))\n";
+  }
+  out << "(assert monitor phi" << k - 1 << ")\n";
+  return out.str();
+}
+
+void BM_ParseString(benchmark::State& state) {
+  const auto spec = get_spec(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto parsed = stl::parser::from_string(spec);
+    benchmark::DoNotOptimize(parsed);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(spec.size()));
+}
+
+/// Parse the specification on all the hardware threads.
+void BM_ParseStringConcurrent(benchmark::State& state) {
+  const auto spec     = get_spec(static_cast<size_t>(state.range(0)));
+  auto options        = stl::parser::ParseOptions{};
+  options.num_threads = 0;
+  for (auto _ : state) {
+    auto parsed = stl::parser::from_string(spec, options);
+    benchmark::DoNotOptimize(parsed);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(spec.size()));
+}
+
+/// Load the specification from its cache.
+void BM_ParseStringCached(benchmark::State& state) {
+  const auto spec = get_spec(static_cast<size_t>(state.range(0)));
+  auto options    = stl::parser::ParseOptions{};
+  options.cache   = stdfs::temp_directory_path() / "signal_tl_bench.stlspec";
+  stl::parser::from_string(spec, options);
+  for (auto _ : state) {
+    auto parsed = stl::parser::from_string(spec, options);
+    benchmark::DoNotOptimize(parsed);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(spec.size()));
+  stdfs::remove(*options.cache);
+}
+
+void BM_ParseFile(benchmark::State& state, const stdfs::path& path) {
+  for (auto _ : state) {
+    auto parsed = stl::parser::from_file(path);
+    benchmark::DoNotOptimize(parsed);
+  }
+}
+
+/// Evaluate the robustness of all the formulas in the specification, for traces with
+/// `state.range(0)` samples.
+void BM_EvaluateFile(benchmark::State& state, const stdfs::path& path) {
+  const auto spec  = stl::parser::from_file(path);
+  const auto trace = get_trace(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (const auto& [name, phi] : spec->formulas) {
+      auto rob = stl::compute_robustness(phi, trace);
+      benchmark::DoNotOptimize(rob);
+    }
+  }
+  state.SetItemsProcessed(
+      state.iterations() * state.range(0) *
+      static_cast<int64_t>(spec->formulas.size()));
+}
+
+/// Register the benchmarks for all the valid specifications in `tests/formulas`.
+void register_spec_files() {
+  const auto dir = stdfs::path(SIGNALTL_TESTS_DIR) / "formulas";
+  for (const auto& entry : stdfs::directory_iterator(dir)) {
+    const auto& path = entry.path();
+    if (!stdfs::is_regular_file(path) ||
+        path.filename().string().find("fail") != std::string::npos) {
+      continue;
+    }
+    const auto name = path.stem().string();
+    benchmark::RegisterBenchmark(("BM_ParseFile/" + name).c_str(), BM_ParseFile, path);
+    benchmark::RegisterBenchmark(
+        ("BM_EvaluateFile/" + name).c_str(), BM_EvaluateFile, path)
+        ->RangeMultiplier(8)
+        ->Range(1 << 10, 1 << 19);
+  }
+}
+
+} // namespace
+
+BENCHMARK(BM_ParseString)->RangeMultiplier(4)->Range(4, 1 << 10);
+BENCHMARK(BM_ParseStringConcurrent)->RangeMultiplier(4)->Range(4, 1 << 10);
+BENCHMARK(BM_ParseStringCached)->RangeMultiplier(4)->Range(4, 1 << 10);
+
+int main(int argc, char** argv) {
+  register_spec_files();
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,127 @@
+#include "signal_tl/signal_tl.hpp" // for Signal, SignalPtr
+
+#include "until.hpp" // for compute_until
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm> // for max, min
+#include <cmath>     // for sin, cos
+#include <limits>    // for numeric_limits
+#include <memory>    // for make_shared
+#include <vector>    // for vector
+
+namespace semantics = signal_tl::semantics;
+using namespace signal_tl::signal;
+
+namespace {
+
+constexpr double DT = 0.01;
+
+SignalPtr get_signal(size_t n, double (*f)(double)) {
+  auto times  = std::vector<double>(n);
+  auto values = std::vector<double>(n);
+  for (size_t i = 0; i < n; i++) {
+    times[i]  = DT * static_cast<double>(i);
+    values[i] = f(times[i]);
+  }
+  return std::make_shared<Signal>(std::move(values), std::move(times));
+}
+
+double slow(double t) {
+  return std::sin(t) + 0.5;
+}
+
+double fast(double t) {
+  return std::cos(7 * t);
+}
+
+/// The naive O(N W) bounded Until over the samples of signals with the same time
+/// points, scanning the whole window for every sample.
+std::vector<double> naive_until(const Signal& x, const Signal& y, double a, double b) {
+  const auto ts  = x.times();
+  const auto xs  = x.values();
+  const auto ys  = y.values();
+  const size_t n = x.size();
+
+  auto out = std::vector<double>(n);
+  for (size_t i = 0; i < n; i++) {
+    double inf_x = std::numeric_limits<double>::infinity();
+    double opt   = -inf_x;
+    for (size_t j = i; j < n && ts[j] <= ts[i] + b; j++) {
+      inf_x = std::min(inf_x, xs[j]);
+      if (ts[j] >= ts[i] + a) {
+        opt = std::max(opt, std::min(ys[j], inf_x));
+      }
+    }
+    out[i] = opt;
+  }
+  return out;
+}
+
+/// Run with the number of samples and the width of the window (in samples).
+void BM_UntilNaive(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = get_signal(n, slow);
+  const auto y = get_signal(n, fast);
+  const auto b = DT * static_cast<double>(state.range(1));
+  for (auto _ : state) {
+    auto out = naive_until(*x, *y, b / 2, b);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// The bounded Until, which scans windows of up to 24 samples, and uses the wedges for
+/// the wider ones.
+void BM_UntilBounded(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = get_signal(n, slow);
+  const auto y = get_signal(n, fast);
+  const auto b = DT * static_cast<double>(state.range(1));
+  for (auto _ : state) {
+    auto out = semantics::compute_until(x, y, b / 2, b);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// As `BM_UntilBounded`, on signals that share their time points.
+void BM_UntilSharedTimes(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  auto times   = std::vector<double>(n);
+  auto xs      = std::vector<double>(n);
+  auto ys      = std::vector<double>(n);
+  for (size_t i = 0; i < n; i++) {
+    times[i] = DT * static_cast<double>(i);
+    xs[i]    = slow(times[i]);
+    ys[i]    = fast(times[i]);
+  }
+  const auto trace =
+      make_trace(std::move(times), {{"x", std::move(xs)}, {"y", std::move(ys)}});
+  const auto b = DT * static_cast<double>(state.range(1));
+  for (auto _ : state) {
+    auto out = semantics::compute_until(trace.at("x"), trace.at("y"), b / 2, b);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_UntilUnbounded(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  const auto x = get_signal(n, slow);
+  const auto y = get_signal(n, fast);
+  for (auto _ : state) {
+    auto out = semantics::compute_until(x, y);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_UntilNaive)->ArgsProduct({{1 << 14}, {4, 16, 32, 64, 128, 1024, 4096}});
+BENCHMARK(BM_UntilBounded)->ArgsProduct({{1 << 14}, {4, 16, 32, 64, 128, 1024, 4096}});
+BENCHMARK(BM_UntilSharedTimes)->ArgsProduct({{1 << 14}, {4, 16, 128, 4096}});
+BENCHMARK(BM_UntilUnbounded)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -26,6 +26,9 @@ endif()
 unset(CMAKE_CXX_CLANG_TIDY)
 unset(CMAKE_CXX_INCLUDE_WHAT_YOU_USE)
 
+set(THREADS_PREFER_PTHREAD_FLAG ON)
+find_package(Threads REQUIRED)
+
 message(CHECK_START "Looking for fmtlib/fmt")
 find_package(fmt QUIET)
 if(NOT fmt_FOUND)
@@ -102,6 +105,36 @@ if(BUILD_PYTHON_BINDINGS)
   endif()
 endif()
 
+# ##############################################################################
+# Benchmarking Dependencies
+# ##############################################################################
+
+if(BUILD_BENCHMARKS)
+  message(CHECK_START "Looking for google/benchmark")
+  find_package(benchmark QUIET)
+  if(NOT benchmark_FOUND)
+    message(CHECK_FAIL "system library not found (using fetched version).")
+    FetchContent_Declare(
+      benchmark
+      GIT_REPOSITORY https://github.com/google/benchmark.git
+      GIT_TAG v1.5.2
+      GIT_PROGRESS ON
+    )
+
+    FetchContent_GetProperties(benchmark)
+    if(NOT benchmark_POPULATED)
+      FetchContent_Populate(benchmark)
+      set(BENCHMARK_ENABLE_TESTING
+          OFF
+          CACHE BOOL "Build the tests for google/benchmark" FORCE
+      )
+      add_subdirectory(${benchmark_SOURCE_DIR} ${benchmark_BINARY_DIR})
+    endif()
+  else()
+    message(CHECK_PASS "system library found.")
+  endif()
+endif()
+
 # ##############################################################################
 # Testing Dependencies
 # ##############################################################################
@@ -0,0 +1,160 @@
+// Evaluate the assertions of a specification on a batch of trace files.
+//
+//     batch_robustness SPEC MANIFEST OUTPUT [--shard I/N] [--threads N] [--resume]
+//                      [--formulas] [--cache PATH] [--result-cache DIR]
+//
+// The manifest lists the trace files (see `TraceFile`), one per line, and the
+// robustness of each assertion on each trace is written to OUTPUT as a CSV file (see
+// `run_batch`). To split a batch over processes, or over the nodes of a cluster, run
+// a process for each shard, e.g., for a job array,
+//
+//     batch_robustness spec.stl traces.txt results-$ID.csv --shard $ID/$COUNT
+//
+// and concatenate the outputs (without their headers). Each shard only reads its own
+// traces, so the shards scale independently. If a process is interrupted, running it
+// again with `--resume` only evaluates the traces that aren't in its output. With
+// `--result-cache`, the robustness of the formulas on each trace is kept in DIR (see
+// `ResultCache`), so that later runs on unchanged traces don't evaluate them again.
+
+#include "signal_tl/batch.hpp"
+#include "signal_tl/internal/filesystem.hpp"
+#include "signal_tl/parser.hpp"
+#include "signal_tl/result_cache.hpp"
+#include "signal_tl/signal_tl.hpp"
+
+#include <fmt/format.h>
+
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace stl = signal_tl;
+
+namespace {
+
+constexpr std::string_view USAGE =
+    "Usage: batch_robustness SPEC MANIFEST OUTPUT [--shard I/N] [--threads N]\n"
+    "                        [--resume] [--formulas] [--cache PATH]\n"
+    "                        [--result-cache DIR]\n";
+
+struct Arguments {
+  stdfs::path spec;
+  stdfs::path manifest;
+  stdfs::path output;
+  stl::Shard shard                        = {};
+  size_t num_threads                      = 0;
+  bool resume                             = false;
+  bool formulas                           = false;
+  std::optional<stdfs::path> cache        = std::nullopt;
+  std::optional<stdfs::path> result_cache = std::nullopt;
+};
+
+size_t parse_size(std::string_view arg) {
+  size_t pos     = 0;
+  const auto str = std::string{arg};
+  const auto out = std::stoull(str, &pos);
+  if (pos != str.size() || str.front() == '-') {
+    throw std::invalid_argument(fmt::format("Expected a number, got: {}", arg));
+  }
+  return out;
+}
+
+Arguments parse_arguments(int argc, char* argv[]) {
+  auto args       = Arguments{};
+  auto positional = std::vector<std::string_view>{};
+  for (int i = 1; i < argc; i++) {
+    const auto arg   = std::string_view{argv[i]};
+    const auto value = [&]() {
+      if (i + 1 >= argc) {
+        throw std::invalid_argument(fmt::format("Missing the value of {}", arg));
+      }
+      return std::string_view{argv[++i]};
+    };
+    if (arg == "--shard") {
+      const auto shard = value();
+      const auto sep   = shard.find('/');
+      if (sep == std::string_view::npos) {
+        throw std::invalid_argument(
+            fmt::format("Expected --shard I/N, got: {}", shard));
+      }
+      args.shard.index = parse_size(shard.substr(0, sep));
+      args.shard.count = parse_size(shard.substr(sep + 1));
+    } else if (arg == "--threads") {
+      args.num_threads = parse_size(value());
+    } else if (arg == "--resume") {
+      args.resume = true;
+    } else if (arg == "--formulas") {
+      args.formulas = true;
+    } else if (arg == "--cache") {
+      args.cache = stdfs::path{std::string{value()}};
+    } else if (arg == "--result-cache") {
+      args.result_cache = stdfs::path{std::string{value()}};
+    } else if (arg.size() > 1 && arg.front() == '-') {
+      throw std::invalid_argument(fmt::format("Unknown option: {}", arg));
+    } else {
+      positional.push_back(arg);
+    }
+  }
+  if (positional.size() != 3) {
+    throw std::invalid_argument("Expected a specification, a manifest, and an output");
+  }
+  args.spec     = stdfs::path{std::string{positional[0]}};
+  args.manifest = stdfs::path{std::string{positional[1]}};
+  args.output   = stdfs::path{std::string{positional[2]}};
+  return args;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  auto args = Arguments{};
+  try {
+    args = parse_arguments(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n' << USAGE;
+    return 2;
+  }
+
+  try {
+    auto parse_options   = stl::parser::ParseOptions{};
+    parse_options.cache  = args.cache;
+    const auto spec      = stl::parser::from_file(args.spec, parse_options);
+    const auto& formulas = (args.formulas) ? spec->formulas : spec->assertions;
+    if (formulas.empty()) {
+      std::cerr << "The specification has nothing to evaluate\n";
+      return 2;
+    }
+
+    const auto traces =
+        stl::select_shard(stl::read_manifest(args.manifest), args.shard);
+    auto options                   = stl::BatchOptions{};
+    options.evaluation.num_threads = args.num_threads;
+    options.resume                 = args.resume;
+    auto result_cache              = std::unique_ptr<stl::ResultCache>{};
+    if (args.result_cache.has_value()) {
+      result_cache             = std::make_unique<stl::ResultCache>(*args.result_cache);
+      options.evaluation.cache = result_cache.get();
+    }
+
+    const auto summary = stl::run_batch(formulas, traces, args.output, options);
+
+    std::cerr << fmt::format(
+        "Shard {}/{}: evaluated {} traces, skipped {}, and failed {}\n",
+        args.shard.index,
+        args.shard.count,
+        summary.evaluated,
+        summary.skipped,
+        summary.failed);
+    return (summary.failed == 0) ? 0 : 1;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    return 2;
+  }
+}
@@ -1,6 +1,7 @@
-#include "bindings.hpp"      // for init_ast_module
-#include "signal_tl/ast.hpp" // for Expr, Until, Const, Always, Even...
-#include "signal_tl/fmt.hpp" // IWYU pragma: keep
+#include "bindings.hpp"           // for init_ast_module
+#include "signal_tl/ast.hpp"      // for Expr, Until, Const, Always, Even...
+#include "signal_tl/fmt.hpp"      // IWYU pragma: keep
+#include "signal_tl/simplify.hpp" // for simplify, SimplifyOptions
 
 #include <fmt/format.h> // for format
 
@@ -48,6 +49,16 @@ void init_ast_module(py::module& parent) {
   parent.def("Always", &Always, "arg"_a, "interval"_a = std::nullopt);
   parent.def("Eventually", &Eventually, "arg"_a, "interval"_a = std::nullopt);
   parent.def("Until", &Until, "arg0"_a, "arg1"_a, "interval"_a = std::nullopt);
+  parent.def(
+      "simplify",
+      [](const Expr& phi, bool classic) {
+        auto options    = ast::SimplifyOptions{};
+        options.classic = classic;
+        return ast::simplify(phi, options);
+      },
+      "phi"_a,
+      py::kw_only(),
+      "classic"_a = true);
 
   auto m = parent.def_submodule("ast", "Define the AST nodes for STL");
   py::class_<ast::Const>(m, "Const")
@@ -60,7 +71,8 @@ void init_ast_module(py::module& parent) {
 
   py::class_<ast::Predicate>(m, "Predicate")
       .def(py::init<const std::string&>(), "name"_a)
-      .def_readonly("name", &ast::Predicate::name)
+      .def_property_readonly(
+          "name", [](const ast::Predicate& e) { return e.name.str(); })
       .def("__and__", &and_op<ast::Predicate>)
       .def("__or__", &or_op<ast::Predicate>)
       .def("__invert__", &not_op<ast::Predicate>)
@@ -1,18 +1,32 @@
-#include "bindings.hpp"             // for init_robustness_module
-#include "signal_tl/ast.hpp"        // for Expr, signal_tl
-#include "signal_tl/robustness.hpp" // for compute_robustness, semantics
-#include "signal_tl/signal.hpp"     // for Trace, signal
+#include "bindings.hpp"               // for init_robustness_module
+#include "signal_tl/ast.hpp"          // for Expr, signal_tl
+#include "signal_tl/cumulative.hpp"   // for compute_cumulative_robustness
+#include "signal_tl/discrete.hpp"     // for DiscreteTrace, compute_robustness
+#include "signal_tl/gradient.hpp"     // for compute_robustness_gradient
+#include "signal_tl/plan.hpp"         // for EvaluationPlan, IncrementalEvaluation
+#include "signal_tl/profile.hpp"      // for EvaluationProfile, NodeProfile
+#include "signal_tl/result_cache.hpp" // for ResultCache
+#include "signal_tl/robustness.hpp"   // for compute_robustness, semantics
+#include "signal_tl/satisfaction.hpp" // for check_satisfaction, Verdict
+#include "signal_tl/signal.hpp"       // for Trace, signal
 
 #include "signal_tl/fmt.hpp" // IWYU pragma: keep
 
 #include <pybind11/cast.h>          // for operator""_a, arg
 #include <pybind11/detail/common.h> // for constexpr_first, ignore_unused
 #include <pybind11/detail/descr.h>  // for operator+
+#include <pybind11/numpy.h>         // for array_t
 #include <pybind11/pybind11.h>      // for module, module_
 #include <pybind11/pytypes.h>       // for dict
 
-#include <memory> // for shared_ptr
-#include <vector> // for vector
+#include <algorithm> // for copy, fill
+#include <cstddef>   // for size_t
+#include <map>       // for map
+#include <memory>    // for shared_ptr, make_unique
+#include <optional>  // for optional
+#include <string>    // for string
+#include <utility>   // for make_pair, move
+#include <vector>    // for vector
 
 using namespace signal_tl;
 using namespace semantics;
@@ -29,4 +43,325 @@ void init_robustness_module(py::module& parent) {
       "phi"_a,
       "trace"_a,
       "synchronized"_a = false);
+
+  py::enum_<Semantics>(m, "Semantics")
+      .value("Classic", Semantics::Classic)
+      .value("Filtering", Semantics::Filtering);
+
+  // A cache of the robustness of formulas on traces, for the evaluations given it as
+  // their `cache`.
+  py::class_<ResultCache>(m, "ResultCache")
+      .def(
+          py::init([](const std::optional<std::string>& directory, size_t max_samples) {
+            if (directory.has_value()) {
+              return std::make_unique<ResultCache>(*directory, max_samples);
+            }
+            return std::make_unique<ResultCache>(max_samples);
+          }),
+          "directory"_a = py::none(),
+          py::kw_only(),
+          "max_samples"_a = size_t{1} << 26)
+      .def_property_readonly(
+          "hits", [](const ResultCache& cache) { return cache.stats().hits; })
+      .def_property_readonly(
+          "disk_hits", [](const ResultCache& cache) { return cache.stats().disk_hits; })
+      .def_property_readonly(
+          "misses", [](const ResultCache& cache) { return cache.stats().misses; })
+      .def_property_readonly(
+          "evicted", [](const ResultCache& cache) { return cache.stats().evicted; })
+      .def("clear", &ResultCache::clear)
+      .def("__len__", &ResultCache::size);
+
+  m.def(
+      "compute_robustness",
+      [](const ast::Expr& phi,
+         const Trace& trace,
+         size_t num_threads,
+         Semantics semantics,
+         ResultCache* cache) {
+        auto options        = EvaluationOptions{};
+        options.num_threads = num_threads;
+        options.semantics   = semantics;
+        options.cache       = cache;
+        // The evaluation doesn't touch any Python objects.
+        auto release = py::gil_scoped_release{};
+        return compute_robustness(phi, trace, options);
+      },
+      "phi"_a,
+      "trace"_a,
+      py::kw_only(),
+      "num_threads"_a = 1,
+      "semantics"_a   = Semantics::Classic,
+      "cache"_a       = py::none());
+
+  py::class_<NodeProfile>(m, "NodeProfile")
+      .def_readonly("formula", &NodeProfile::formula)
+      .def_readonly("operands", &NodeProfile::operands)
+      .def_readonly("seconds", &NodeProfile::seconds)
+      .def_readonly("input_samples", &NodeProfile::input_samples)
+      .def_readonly("output_samples", &NodeProfile::output_samples)
+      .def_readonly("added_samples", &NodeProfile::added_samples)
+      .def_readonly("bytes_allocated", &NodeProfile::bytes_allocated)
+      .def_readonly("cached", &NodeProfile::cached)
+      .def("__repr__", [](const NodeProfile& node) {
+        return fmt::format(
+            "NodeProfile(formula={}, seconds={})", node.formula, node.seconds);
+      });
+
+  py::class_<EvaluationProfile>(m, "EvaluationProfile")
+      .def_readonly("nodes", &EvaluationProfile::nodes)
+      .def_readonly("seconds", &EvaluationProfile::seconds)
+      .def("report", &EvaluationProfile::report)
+      .def("__str__", &EvaluationProfile::report);
+
+  // Returns the robustness signal and the profile of its evaluation.
+  m.def(
+      "profile_robustness",
+      [](const ast::Expr& phi,
+         const Trace& trace,
+         size_t num_threads,
+         Semantics semantics) {
+        auto profile        = EvaluationProfile{};
+        auto options        = EvaluationOptions{};
+        options.num_threads = num_threads;
+        options.semantics   = semantics;
+        options.profile     = &profile;
+        auto release        = py::gil_scoped_release{};
+        auto rob            = compute_robustness(phi, trace, options);
+        return std::make_pair(std::move(rob), std::move(profile));
+      },
+      "phi"_a,
+      "trace"_a,
+      py::kw_only(),
+      "num_threads"_a = 1,
+      "semantics"_a   = Semantics::Classic);
+
+  // Returns the `(positive, negative)` cumulative robustness.
+  m.def(
+      "compute_cumulative_robustness",
+      [](const ast::Expr& phi, const Trace& trace) {
+        auto rob = compute_cumulative_robustness(phi, trace);
+        return std::make_pair(std::move(rob.positive), std::move(rob.negative));
+      },
+      "phi"_a,
+      "trace"_a);
+
+  m.def(
+      "compute_robustness_at",
+      [](const ast::Expr& phi, const Trace& trace, double t) {
+        return compute_robustness_at(phi, trace, t);
+      },
+      "phi"_a,
+      "trace"_a,
+      "t"_a);
+
+  // Returns the robustness at `time`, and a dict with the partial derivatives with
+  // respect to each sample of the signals used by the formula.
+  m.def(
+      "compute_robustness_gradient",
+      [](const ast::Expr& phi, const Trace& trace, std::optional<double> time) {
+        auto grad = RobustnessGradient{};
+        {
+          auto release = py::gil_scoped_release{};
+          grad         = compute_robustness_gradient(phi, trace, time);
+        }
+        auto out = py::dict{};
+        for (const auto& entry : grad.gradient) {
+          const auto name = py::str(entry.signal);
+          if (!out.contains(name)) {
+            auto dense = py::array_t<double>(
+                static_cast<py::ssize_t>(trace.at(entry.signal)->size()));
+            std::fill(dense.mutable_data(), dense.mutable_data() + dense.size(), 0.0);
+            out[name] = dense;
+          }
+          auto dense = out[name].cast<py::array_t<double>>();
+          dense.mutable_at(entry.index) = entry.derivative;
+        }
+        return std::make_pair(grad.value, out);
+      },
+      "phi"_a,
+      "trace"_a,
+      "time"_a = py::none());
+
+  py::class_<Verdict>(m, "Verdict")
+      .def_readonly("satisfied", &Verdict::satisfied)
+      .def_readonly("time", &Verdict::time)
+      .def_readonly("violation", &Verdict::violation)
+      .def("__bool__", [](const Verdict& v) { return v.satisfied; })
+      .def("__repr__", [](const Verdict& v) {
+        return fmt::format("Verdict(satisfied={}, time={})", v.satisfied, v.time);
+      });
+
+  m.def(
+      "check_satisfaction",
+      [](const ast::Expr& phi,
+         const Trace& trace,
+         std::optional<double> time,
+         bool find_violation) {
+        auto options           = SatisfactionOptions{};
+        options.time           = time;
+        options.find_violation = find_violation;
+        return check_satisfaction(phi, trace, options);
+      },
+      "phi"_a,
+      "trace"_a,
+      py::kw_only(),
+      "time"_a           = py::none(),
+      "find_violation"_a = false);
+
+  m.def("compute_satisfaction", &compute_satisfaction, "phi"_a, "trace"_a);
+
+  // A plan can be compiled once and evaluated on many traces.
+  py::class_<EvaluationPlan>(m, "EvaluationPlan")
+      .def(py::init<const ast::Expr&>(), "phi"_a)
+      .def(py::init<const std::vector<ast::Expr>&>(), "formulas"_a)
+      .def(py::init<const std::map<std::string, ast::Expr>&>(), "formulas"_a)
+      .def_property_readonly("signals", &EvaluationPlan::signals)
+      .def_property_readonly("num_ops", [](const EvaluationPlan& plan) {
+        return plan.ops().size();
+      })
+      .def(
+          "evaluate",
+          [](const EvaluationPlan& plan,
+             const Trace& trace,
+             size_t num_threads,
+             ResultCache* cache) {
+            auto options        = EvaluationOptions{};
+            options.num_threads = num_threads;
+            options.cache       = cache;
+            auto release        = py::gil_scoped_release{};
+            return plan.evaluate(trace, options);
+          },
+          "trace"_a,
+          py::kw_only(),
+          "num_threads"_a = 1,
+          "cache"_a       = py::none());
+
+  // Keeps the results of a plan on a trace, to update them as chunks are appended.
+  py::class_<IncrementalEvaluation>(m, "IncrementalEvaluation")
+      .def(
+          py::init(
+              [](const EvaluationPlan& plan, const Trace& trace, size_t num_threads) {
+                auto options        = EvaluationOptions{};
+                options.num_threads = num_threads;
+                auto release        = py::gil_scoped_release{};
+                return IncrementalEvaluation{plan, trace, options};
+              }),
+          "plan"_a,
+          "trace"_a,
+          py::kw_only(),
+          "num_threads"_a = 1)
+      .def(
+          "append",
+          [](IncrementalEvaluation& self, const Trace& chunk) {
+            auto release = py::gil_scoped_release{};
+            self.append(chunk);
+          },
+          "chunk"_a)
+      .def_property_readonly("outputs", &IncrementalEvaluation::outputs);
+
+  // The discrete-time robustness, over signals sampled at the same, uniformly spaced
+  // time points, or over the values of each signal (with the given sampling period).
+  m.def(
+      "compute_discrete_robustness",
+      [](const ast::Expr& phi, const Trace& trace) {
+        auto release = py::gil_scoped_release{};
+        return discrete::compute_robustness(phi, trace);
+      },
+      "phi"_a,
+      "trace"_a);
+  m.def(
+      "compute_discrete_robustness",
+      [](const ast::Expr& phi, const discrete::DiscreteTrace& values, double period) {
+        auto rob = std::vector<double>{};
+        {
+          auto release = py::gil_scoped_release{};
+          rob          = discrete::compute_robustness(phi, values, period);
+        }
+        auto out = py::array_t<double>(static_cast<py::ssize_t>(rob.size()));
+        std::copy(rob.begin(), rob.end(), out.mutable_data());
+        return out;
+      },
+      "phi"_a,
+      "values"_a,
+      "period"_a = 1.0);
+
+  // Returns an array of shape `(len(formulas), len(traces))`. The traces are
+  // evaluated concurrently on `num_threads` threads (by default, one per core).
+  const auto to_array = [](RobustnessMatrix&& rob) {
+    auto out = py::array_t<double>(
+        {static_cast<py::ssize_t>(rob.num_formulas),
+         static_cast<py::ssize_t>(rob.num_traces)});
+    std::copy(rob.values.begin(), rob.values.end(), out.mutable_data());
+    return out;
+  };
+
+  m.def(
+      "compute_robustness_batch",
+      [to_array](
+          const std::vector<ast::Expr>& formulas,
+          const std::vector<Trace>& traces,
+          size_t num_threads,
+          ResultCache* cache) {
+        auto options        = EvaluationOptions{};
+        options.num_threads = num_threads;
+        options.cache       = cache;
+        auto rob            = RobustnessMatrix{};
+        {
+          auto release = py::gil_scoped_release{};
+          rob          = compute_robustness_batch(formulas, traces, options);
+        }
+        return to_array(std::move(rob));
+      },
+      "formulas"_a,
+      "traces"_a,
+      py::kw_only(),
+      "num_threads"_a = 0,
+      "cache"_a       = py::none());
+
+  m.def(
+      "compute_robustness_batch",
+      [to_array](
+          const EvaluationPlan& plan,
+          const std::vector<Trace>& traces,
+          size_t num_threads,
+          ResultCache* cache) {
+        auto options        = EvaluationOptions{};
+        options.num_threads = num_threads;
+        options.cache       = cache;
+        auto rob            = RobustnessMatrix{};
+        {
+          auto release = py::gil_scoped_release{};
+          rob          = compute_robustness_batch(plan, traces, options);
+        }
+        return to_array(std::move(rob));
+      },
+      "plan"_a,
+      "traces"_a,
+      py::kw_only(),
+      "num_threads"_a = 0,
+      "cache"_a       = py::none());
+
+  m.def(
+      "compute_robustness_batch",
+      [to_array](
+          const std::map<std::string, ast::Expr>& formulas,
+          const std::vector<Trace>& traces,
+          size_t num_threads,
+          ResultCache* cache) {
+        auto options        = EvaluationOptions{};
+        options.num_threads = num_threads;
+        options.cache       = cache;
+        auto rob            = RobustnessMatrix{};
+        {
+          auto release = py::gil_scoped_release{};
+          rob          = compute_robustness_batch(formulas, traces, options);
+        }
+        return to_array(std::move(rob));
+      },
+      "formulas"_a,
+      "traces"_a,
+      py::kw_only(),
+      "num_threads"_a = 0,
+      "cache"_a       = py::none());
 }
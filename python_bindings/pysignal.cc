@@ -1,7 +1,8 @@
-#include "bindings.hpp"         // for init_signal_module
-#include "signal_tl/ast.hpp"    // for signal_tl
-#include "signal_tl/fmt.hpp"    // IWYU pragma: keep
-#include "signal_tl/signal.hpp" // for Sample, Trace, Signal, SignalPtr
+#include "bindings.hpp"             // for init_signal_module
+#include "signal_tl/ast.hpp"        // for signal_tl
+#include "signal_tl/fmt.hpp"        // IWYU pragma: keep
+#include "signal_tl/signal.hpp"     // for Sample, Trace, Signal, SignalPtr
+#include "signal_tl/trace_file.hpp" // for TraceFile, write_trace_file
 
 #include <array>                    // for array
 #include <cstddef>                  // for size_t
@@ -9,21 +10,67 @@
 #include <fmt/format.h>             // for format
 #include <map>                      // for operator==, map, operator!=
 #include <memory>                   // for allocator, operator<<, __shared_...
+#include <optional>                 // for optional, nullopt
+#include <stdexcept>                // for invalid_argument
 #include <pybind11/attr.h>          // for buffer_protocol, keep_alive
 #include <pybind11/cast.h>          // for operator""_a, handle::cast, cast_op
 #include <pybind11/detail/common.h> // for ignore_unused, constexpr_first
 #include <pybind11/detail/descr.h>  // for operator+
+#include <pybind11/numpy.h>         // for array_t, array
 #include <pybind11/operators.h>     // for self, self_t, operator<, operator<=
-#include <pybind11/pybind11.h>      // for class_, init, make_iterator, mod...
+#include <pybind11/pybind11.h>      // for class_, init, make_iterator, gil...
 #include <pybind11/pytypes.h>       // for getattr, iterable, sequence, dict
 #include <pybind11/stl_bind.h>      // for bind_vector, bind_map
 #include <string>                   // for basic_string
+#include <utility>                  // for move
 #include <vector>                   // for vector
 
 using namespace signal_tl;
+using namespace signal;
+
+namespace {
+
+/// 1-D arrays of `float64`. Other inputs (lists, other dtypes, non-contiguous arrays)
+/// are converted to such an array by NumPy first.
+using Array = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// Keep the given Python object alive for as long as the returned pointer is.
+///
+/// As signals can be destroyed on any thread (e.g., while evaluating robustness with
+/// the GIL released), the GIL is acquired before dropping the reference.
+std::shared_ptr<const void> keep_alive(py::object obj) {
+  return std::shared_ptr<const void>(new py::object(std::move(obj)), [](const void* p) {
+    auto gil = py::gil_scoped_acquire{};
+    delete static_cast<const py::object*>(p);
+  });
+}
+
+/// Get a column from a 1-D array, copying it unless `copy` is false.
+///
+/// A viewed array is kept alive by the column, but nothing stops Python from writing
+/// to it, so the views are only made when asked for.
+Column to_column(const Array& arr, bool copy) {
+  if (arr.ndim() != 1) {
+    throw std::invalid_argument("Expected a 1-D array");
+  }
+  const auto n = static_cast<size_t>(arr.shape(0));
+  if (copy) {
+    return Column{std::vector<double>(arr.data(), arr.data() + n)};
+  }
+  return Column::view(arr.data(), n, keep_alive(arr));
+}
+
+/// Get a read-only array that views the column, while keeping `base` alive.
+py::array to_array(const Column& col, const py::object& base) {
+  const auto n = static_cast<py::ssize_t>(col.size());
+  auto arr     = py::array_t<double>(n, col.data(), base);
+  arr.attr("setflags")("write"_a = false);
+  return arr;
+}
+
+} // namespace
 
 void init_signal_module(py::module& parent) {
-  using namespace signal;
 
   auto m = parent.def_submodule("signal", "A general class of signals (PWL, etc.)");
   py::bind_vector<std::vector<double>>(m, "DoubleList", py::buffer_protocol());
@@ -34,7 +81,7 @@ void init_signal_module(py::module& parent) {
       .def(py::init())
       .def_readonly("time", &Sample::time)
       .def_readonly("value", &Sample::value)
-      .def_readonly("derivative", &Sample::value)
+      .def_readonly("derivative", &Sample::derivative)
       .def(py::self < py::self)
       .def(py::self > py::self)
       .def(py::self >= py::self)
@@ -45,13 +92,55 @@ void init_signal_module(py::module& parent) {
       .def(py::init<>())
       .def(py::init<const Signal&>(), "other"_a)
       .def(py::init<const std::vector<Sample>&>())
+      .def(
+          py::init([](const Array& points, const Array& times, bool copy) {
+            return std::make_shared<Signal>(
+                to_column(points, copy), to_column(times, copy));
+          }),
+          "points"_a,
+          "times"_a,
+          py::kw_only(),
+          "copy"_a = true,
+          "Create a signal from arrays of values and time stamps.\n\n"
+          "The arrays are copied, unless copy is False: then contiguous float64 "
+          "arrays are used without copying them, and must not be modified while the "
+          "signal is alive.")
       .def(
           py::init<const std::vector<double>&, const std::vector<double>&>(),
           "points"_a,
           "times"_a)
       .def_property_readonly("begin_time", &Signal::begin_time)
       .def_property_readonly("end_time", &Signal::end_time)
-      .def("simplify", &Signal::simplify)
+      .def_property_readonly(
+          "times",
+          [](const SignalPtr& s) { return to_array(s->time_column(), py::cast(s)); },
+          "Read-only view of the time stamps of the samples.")
+      .def_property_readonly(
+          "values",
+          [](const SignalPtr& s) { return to_array(s->value_column(), py::cast(s)); },
+          "Read-only view of the values of the samples.")
+      .def(
+          "to_numpy",
+          [](const SignalPtr& s) {
+            const auto base = py::cast(s);
+            return py::make_tuple(
+                to_array(s->time_column(), base), to_array(s->value_column(), base));
+          },
+          "Get read-only views of the (times, values) of the signal, without copying.")
+      .def_static(
+          "compressed",
+          [](const Array& points, const Array& times, double tolerance) {
+            return Signal::compressed(
+                std::vector<double>(points.data(), points.data() + points.size()),
+                std::vector<double>(times.data(), times.data() + times.size()),
+                tolerance);
+          },
+          "points"_a,
+          "times"_a,
+          "tolerance"_a = 0.0,
+          "Create a signal that only keeps the breakpoints of the samples, i.e., drops "
+          "the samples within tolerance of the segments between the kept ones.")
+      .def("simplify", &Signal::simplify, "tolerance"_a = 0.0)
       .def("resize", &Signal::resize, "start"_a, "end"_a, "fill"_a)
       .def("shift", &Signal::shift, "dt"_a)
       .def("__repr__", [](const Signal& e) { return fmt::format("{}", e); })
@@ -66,4 +155,72 @@ void init_signal_module(py::module& parent) {
       .def("at", [](const SignalPtr& s, double t) { return s->at(t).value; });
 
   m.def("synchronize", &synchronize, "x"_a, "y"_a);
+  m.def(
+      "trace_from_numpy",
+      [](const Array& times,
+         const py::dict& channels,
+         bool copy,
+         std::optional<double> tolerance) {
+        const auto time_col = to_column(times, copy);
+        auto trace          = Trace{};
+        for (const auto& [name, values] : channels) {
+          auto value_col = to_column(values.cast<Array>(), copy);
+          if (value_col.size() != time_col.size()) {
+            throw std::invalid_argument(fmt::format(
+                "Channel '{}' has {} values, but there are {} time stamps",
+                name.cast<std::string>(),
+                value_col.size(),
+                time_col.size()));
+          }
+          if (tolerance.has_value()) {
+            // Each channel gets its own breakpoints.
+            trace[name.cast<std::string>()] = Signal::compressed(
+                std::vector<double>(value_col.begin(), value_col.end()),
+                std::vector<double>(time_col.begin(), time_col.end()),
+                *tolerance);
+            continue;
+          }
+          // All the channels view the same time stamps.
+          trace[name.cast<std::string>()] =
+              std::make_shared<Signal>(std::move(value_col), Column{time_col});
+        }
+        return trace;
+      },
+      "times"_a,
+      "channels"_a,
+      py::kw_only(),
+      "copy"_a      = true,
+      "tolerance"_a = std::nullopt,
+      "Create a trace from an array of time stamps and a dict of value arrays.\n\n"
+      "The arrays are copied, unless copy is False (see Signal).\n\n"
+      "If tolerance is given, each channel only keeps its breakpoints (see "
+      "Signal.compressed), which is much smaller for piecewise constant channels.");
+
+  py::class_<TraceFile>(m, "TraceFile")
+      .def(
+          py::init([](const std::string& path) { return TraceFile{path}; }),
+          "path"_a,
+          "Map the trace file at the given path.")
+      .def_property_readonly("channels", &TraceFile::channels)
+      .def("__contains__", &TraceFile::contains)
+      .def("__getitem__", &TraceFile::signal, "name"_a)
+      .def("trace", py::overload_cast<>(&TraceFile::trace, py::const_))
+      .def(
+          "trace",
+          py::overload_cast<const std::vector<std::string>&>(
+              &TraceFile::trace, py::const_),
+          "names"_a)
+      .def(
+          "trace",
+          py::overload_cast<const ast::Expr&>(&TraceFile::trace, py::const_),
+          "phi"_a,
+          "Get the trace with the channels referenced by the formula.");
+  m.def(
+      "write_trace_file",
+      [](const std::string& path, const Trace& trace) {
+        write_trace_file(path, trace);
+      },
+      "path"_a,
+      "trace"_a,
+      "Write the trace to a memory-mappable binary trace file.");
 }
@@ -3,9 +3,22 @@ __version__ = "0.1.4-dev55+9d981d4"
 # isort: split
 
 from signal_tl._cext import (Always, And, Const, Eventually, Not, Or,
-                             Predicate, Until)
-from signal_tl._cext.semantics import compute_robustness
-from signal_tl._cext.signal import Sample, Signal, Trace, synchronize
+                             Predicate, Until, simplify)
+from signal_tl._cext.semantics import (EvaluationPlan, EvaluationProfile,
+                                       IncrementalEvaluation, NodeProfile,
+                                       ResultCache, Semantics, Verdict,
+                                       check_satisfaction,
+                                       compute_cumulative_robustness,
+                                       compute_discrete_robustness,
+                                       compute_robustness,
+                                       compute_robustness_at,
+                                       compute_robustness_batch,
+                                       compute_robustness_gradient,
+                                       compute_satisfaction,
+                                       profile_robustness)
+from signal_tl._cext.signal import (Sample, Signal, Trace, TraceFile,
+                                    synchronize, trace_from_numpy,
+                                    write_trace_file)
 
 F = Eventually
 G = Always
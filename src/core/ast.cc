@@ -2,7 +2,14 @@
 #include "signal_tl/internal/utils.hpp"
 
 #include <cstddef>
+#include <functional>
 #include <iterator>
+#include <optional>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace signal_tl {
 
@@ -28,46 +35,61 @@ using utils::overloaded;
 
 namespace {
 
-Expr AndHelper(const AndPtr& lhs, const Expr& rhs) {
-  std::vector<Expr> args{lhs->args};
+/// Append `rhs` to the operands of an n-ary node (`And` for `NodePtr = AndPtr`, and
+/// `Or` for `OrPtr`), flattening it if it is the same kind of node.
+///
+/// If `rhs` is the absorbing constant of the node (`false` for `And`, `true` for
+/// `Or`), the whole node simplifies to it, which is returned instead. The other
+/// constant is the identity of the node, and isn't appended.
+template <typename NodePtr>
+std::optional<Const> append_operand(std::vector<Expr>& args, const Expr& rhs) {
+  constexpr bool absorbing = std::is_same_v<NodePtr, OrPtr>;
+  if (const auto* c = std::get_if<Const>(&rhs)) {
+    return (c->value == absorbing) ? std::optional{*c} : std::nullopt;
+  } else if (const auto* e = std::get_if<NodePtr>(&rhs)) {
+    args.insert(args.end(), (*e)->args.begin(), (*e)->args.end());
+  } else {
+    args.push_back(rhs);
+  }
+  return std::nullopt;
+}
 
-  std::visit(
-      overloaded{
-          [&args](const auto e) { args.push_back(e); },
-          [&args](const Const e) {
-            if (!e.value) {
-              args = {Expr{e}};
-            }
-          },
-          [&args](const AndPtr& e) {
-            args.reserve(
-                args.size() +
-                static_cast<size_t>(std::distance(e->args.begin(), e->args.end())));
-            args.insert(args.end(), e->args.begin(), e->args.end());
-          }},
-      rhs);
-  return std::make_shared<And>(args);
+template <typename NodePtr>
+size_t num_operands(const Expr& e) {
+  const auto* node = std::get_if<NodePtr>(&e);
+  return (node != nullptr) ? (*node)->args.size() : 1;
 }
 
-Expr OrHelper(const OrPtr& lhs, const Expr& rhs) {
-  std::vector<Expr> args{lhs->args};
+/// Combine the n-ary node `lhs` with `rhs`, in a new node.
+template <typename NodePtr>
+Expr combine(const NodePtr& lhs, const Expr& rhs) {
+  using Node = typename NodePtr::element_type;
+  if (std::holds_alternative<Const>(rhs) &&
+      std::get<Const>(rhs).value != std::is_same_v<NodePtr, OrPtr>) {
+    return lhs;
+  }
+  auto args = std::vector<Expr>{};
+  args.reserve(lhs->args.size() + num_operands<NodePtr>(rhs));
+  args.insert(args.end(), lhs->args.begin(), lhs->args.end());
+  if (const auto c = append_operand<NodePtr>(args, rhs)) {
+    return *c;
+  }
+  return make_node<Node>(std::move(args));
+}
 
-  std::visit(
-      overloaded{
-          [&args](const auto e) { args.push_back(e); },
-          [&args](const Const e) {
-            if (e.value) {
-              args = {Expr{e}};
-            }
-          },
-          [&args](const OrPtr& e) {
-            args.reserve(
-                args.size() +
-                static_cast<size_t>(std::distance(e->args.begin(), e->args.end())));
-            args.insert(args.end(), e->args.begin(), e->args.end());
-          }},
-      rhs);
-  return std::make_shared<Or>(args);
+/// Combine the n-ary node held by `lhs` with `rhs`, in place if possible.
+template <typename NodePtr>
+Expr combine(Expr&& lhs, const Expr& rhs) {
+  auto* node = std::get_if<NodePtr>(&lhs);
+  // The node can only be modified if nothing else can see it. If `rhs` is the same
+  // node, it is shared by `lhs` and `rhs`.
+  if (node->use_count() != 1 || node_address(rhs) == node->get()) {
+    return combine(*node, rhs);
+  }
+  if (const auto c = append_operand<NodePtr>((*node)->args, rhs)) {
+    return *c;
+  }
+  return std::move(lhs);
 }
 
 } // namespace
@@ -76,25 +98,233 @@ Expr operator&(const Expr& lhs, const Expr& rhs) {
   if (const auto c_ptr = std::get_if<Const>(&lhs)) {
     return (c_ptr->value) ? rhs : *c_ptr;
   } else if (const AndPtr* e_ptr = std::get_if<AndPtr>(&lhs)) {
-    return AndHelper(*e_ptr, rhs);
+    return combine(*e_ptr, rhs);
   }
-  return std::make_shared<And>(std::vector{lhs, rhs});
+  return make_node<And>(std::vector{lhs, rhs});
 }
 
 Expr operator|(const Expr& lhs, const Expr& rhs) {
   if (const auto c_ptr = std::get_if<Const>(&lhs)) {
     return (!c_ptr->value) ? rhs : *c_ptr;
   } else if (const OrPtr* e_ptr = std::get_if<OrPtr>(&lhs)) {
-    return OrHelper(*e_ptr, rhs);
+    return combine(*e_ptr, rhs);
+  }
+  return make_node<Or>(std::vector{lhs, rhs});
+}
+
+Expr operator&(Expr&& lhs, const Expr& rhs) {
+  if (std::holds_alternative<AndPtr>(lhs)) {
+    return combine<AndPtr>(std::move(lhs), rhs);
   }
-  return std::make_shared<Or>(std::vector{lhs, rhs});
+  return static_cast<const Expr&>(lhs) & rhs;
+}
+
+Expr operator|(Expr&& lhs, const Expr& rhs) {
+  if (std::holds_alternative<OrPtr>(lhs)) {
+    return combine<OrPtr>(std::move(lhs), rhs);
+  }
+  return static_cast<const Expr&>(lhs) | rhs;
 }
 
 Expr operator~(const Expr& expr) {
   if (const auto e = std::get_if<Const>(&expr)) {
     return Const{!(*e).value};
   }
-  return std::make_shared<Not>(expr);
+  return make_node<Not>(expr);
+}
+
+const void* node_address(const Expr& e) {
+  return std::visit(
+      overloaded{
+          [](const Const&) -> const void* { return nullptr; },
+          [](const Predicate&) -> const void* { return nullptr; },
+          [](const auto& e_ptr) -> const void* { return e_ptr.get(); }},
+      e);
+}
+
+namespace {
+
+size_t hash_double(double value) {
+  // Make sure that 0.0 and -0.0 have the same hash, as they compare equal.
+  return std::hash<double>{}((value == 0.0) ? 0.0 : value);
+}
+
+void hash_interval(size_t& seed, const Interval& interval) {
+  const auto [a, b] = interval.as_double();
+  utils::hash_combine(seed, hash_double(a));
+  utils::hash_combine(seed, hash_double(b));
+}
+
+struct HashOp {
+  std::unordered_map<const void*, size_t>* cache;
+
+  size_t operator()(const Expr& e) const {
+    const void* addr = node_address(e);
+    if (cache != nullptr && addr != nullptr) {
+      if (const auto it = cache->find(addr); it != cache->end()) {
+        return it->second;
+      }
+    }
+
+    size_t seed = e.index();
+    std::visit([&](const auto& node) { this->hash_node(seed, node); }, e);
+
+    if (cache != nullptr && addr != nullptr) {
+      cache->emplace(addr, seed);
+    }
+    return seed;
+  }
+
+  void hash_node(size_t& seed, const Const& e) const {
+    utils::hash_combine(seed, e.value);
+  }
+
+  void hash_node(size_t& seed, const Predicate& e) const {
+    utils::hash_combine(seed, e.name);
+    utils::hash_combine(seed, static_cast<int>(e.op));
+    utils::hash_combine(seed, hash_double(e.rhs));
+  }
+
+  void hash_node(size_t& seed, const NotPtr& e) const {
+    utils::hash_combine(seed, (*this)(e->arg));
+  }
+
+  void hash_node(size_t& seed, const AndPtr& e) const {
+    for (const auto& arg : e->args) { utils::hash_combine(seed, (*this)(arg)); }
+  }
+
+  void hash_node(size_t& seed, const OrPtr& e) const {
+    for (const auto& arg : e->args) { utils::hash_combine(seed, (*this)(arg)); }
+  }
+
+  void hash_node(size_t& seed, const AlwaysPtr& e) const {
+    hash_interval(seed, e->interval);
+    utils::hash_combine(seed, (*this)(e->arg));
+  }
+
+  void hash_node(size_t& seed, const EventuallyPtr& e) const {
+    hash_interval(seed, e->interval);
+    utils::hash_combine(seed, (*this)(e->arg));
+  }
+
+  void hash_node(size_t& seed, const UntilPtr& e) const {
+    hash_interval(seed, e->interval);
+    utils::hash_combine(seed, (*this)(e->args.first));
+    utils::hash_combine(seed, (*this)(e->args.second));
+  }
+};
+
+bool equal_args(const std::vector<Expr>& lhs, const std::vector<Expr>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); i++) {
+    if (!ExprEqual{}(lhs[i], rhs[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool equal_node(const Const& lhs, const Const& rhs) {
+  return lhs == rhs;
+}
+
+bool equal_node(const Predicate& lhs, const Predicate& rhs) {
+  return lhs == rhs;
+}
+
+bool equal_node(const NotPtr& lhs, const NotPtr& rhs) {
+  return ExprEqual{}(lhs->arg, rhs->arg);
+}
+
+bool equal_node(const AndPtr& lhs, const AndPtr& rhs) {
+  return equal_args(lhs->args, rhs->args);
+}
+
+bool equal_node(const OrPtr& lhs, const OrPtr& rhs) {
+  return equal_args(lhs->args, rhs->args);
+}
+
+bool equal_node(const AlwaysPtr& lhs, const AlwaysPtr& rhs) {
+  return lhs->interval.as_double() == rhs->interval.as_double() &&
+         ExprEqual{}(lhs->arg, rhs->arg);
+}
+
+bool equal_node(const EventuallyPtr& lhs, const EventuallyPtr& rhs) {
+  return lhs->interval.as_double() == rhs->interval.as_double() &&
+         ExprEqual{}(lhs->arg, rhs->arg);
+}
+
+bool equal_node(const UntilPtr& lhs, const UntilPtr& rhs) {
+  return lhs->interval.as_double() == rhs->interval.as_double() &&
+         ExprEqual{}(lhs->args.first, rhs->args.first) &&
+         ExprEqual{}(lhs->args.second, rhs->args.second);
+}
+
+} // namespace
+
+size_t ExprHash::operator()(const Expr& e) const {
+  return HashOp{cache}(e);
+}
+
+bool ExprEqual::operator()(const Expr& lhs, const Expr& rhs) const {
+  if (lhs.index() != rhs.index()) {
+    return false;
+  }
+  const void* addr = node_address(lhs);
+  if (addr != nullptr && addr == node_address(rhs)) {
+    return true;
+  }
+  return std::visit(
+      [&rhs](const auto& node) {
+        using T = std::decay_t<decltype(node)>;
+        return equal_node(node, std::get<T>(rhs));
+      },
+      lhs);
+}
+
+namespace {
+
+void collect_signal_names(
+    const Expr& e,
+    std::set<std::string>& names,
+    std::unordered_set<const void*>& visited) {
+  // Shared subexpressions only need to be visited once.
+  const void* addr = node_address(e);
+  if (addr != nullptr && !visited.insert(addr).second) {
+    return;
+  }
+  const auto recurse = [&](const Expr& arg) {
+    collect_signal_names(arg, names, visited);
+  };
+  std::visit(
+      overloaded{
+          [](const Const&) {},
+          [&](const Predicate& p) { names.insert(p.name); },
+          [&](const NotPtr& p) { recurse(p->arg); },
+          [&](const AndPtr& p) {
+            for (const auto& arg : p->args) { recurse(arg); }
+          },
+          [&](const OrPtr& p) {
+            for (const auto& arg : p->args) { recurse(arg); }
+          },
+          [&](const AlwaysPtr& p) { recurse(p->arg); },
+          [&](const EventuallyPtr& p) { recurse(p->arg); },
+          [&](const UntilPtr& p) {
+            recurse(p->args.first);
+            recurse(p->args.second);
+          }},
+      e);
+}
+
+} // namespace
+
+std::set<std::string> signal_names(const Expr& e) {
+  auto names   = std::set<std::string>{};
+  auto visited = std::unordered_set<const void*>{};
+  collect_signal_names(e, names, visited);
+  return names;
 }
 
 } // namespace ast
@@ -111,15 +341,15 @@ Expr Not(Expr arg) {
   if (const auto e = std::get_if<ast::Const>(&arg)) {
     return ast::Const{!(*e).value};
   }
-  return std::make_shared<ast::Not>(std::move(arg));
+  return ast::make_node<ast::Not>(std::move(arg));
 }
 
 Expr And(std::vector<Expr> args) {
-  return std::make_shared<ast::And>(std::move(args));
+  return ast::make_node<ast::And>(std::move(args));
 }
 
 Expr Or(std::vector<Expr> args) {
-  return std::make_shared<ast::Or>(std::move(args));
+  return ast::make_node<ast::Or>(std::move(args));
 }
 
 Expr Implies(const Expr& x, const Expr& y) {
@@ -135,27 +365,27 @@ Expr Iff(const Expr& x, const Expr& y) {
 }
 
 Expr Always(Expr arg) {
-  return std::make_shared<ast::Always>(std::move(arg));
+  return ast::make_node<ast::Always>(std::move(arg));
 }
 
 Expr Always(Expr arg, ast::Interval interval) {
-  return std::make_shared<ast::Always>(std::move(arg), interval);
+  return ast::make_node<ast::Always>(std::move(arg), interval);
 }
 
 Expr Eventually(Expr arg) {
-  return std::make_shared<ast::Eventually>(std::move(arg));
+  return ast::make_node<ast::Eventually>(std::move(arg));
 }
 
 Expr Eventually(Expr arg, ast::Interval interval) {
-  return std::make_shared<ast::Eventually>(std::move(arg), interval);
+  return ast::make_node<ast::Eventually>(std::move(arg), interval);
 }
 
 Expr Until(Expr arg1, Expr arg2) {
-  return std::make_shared<ast::Until>(std::move(arg1), std::move(arg2));
+  return ast::make_node<ast::Until>(std::move(arg1), std::move(arg2));
 }
 
 Expr Until(Expr arg1, Expr arg2, ast::Interval interval) {
-  return std::make_shared<ast::Until>(std::move(arg1), std::move(arg2), interval);
+  return ast::make_node<ast::Until>(std::move(arg1), std::move(arg2), interval);
 }
 
 } // namespace signal_tl
@@ -0,0 +1,147 @@
+#include "buffer_pool.hpp"
+
+#include "signal_tl/signal.hpp" // for Signal, SignalPtr
+
+#include <cassert> // for assert
+#include <cstddef> // for size_t
+#include <memory>  // for shared_ptr, weak_ptr, make_shared
+#include <mutex>   // for lock_guard
+#include <utility> // for move
+#include <vector>  // for vector
+
+namespace signal_tl::signal {
+
+namespace {
+
+thread_local BufferPool* current_pool = nullptr;
+thread_local size_t allocated         = 0;
+
+/// Allocate a new (empty) buffer that can hold `capacity` elements.
+std::vector<double> allocate(size_t capacity) {
+  auto buffer = std::vector<double>{};
+  buffer.reserve(capacity);
+  allocated += buffer.capacity() * sizeof(double);
+  return buffer;
+}
+
+} // namespace
+
+BufferPool::Scope::Scope(BufferPool* pool) : previous{current_pool} {
+  current_pool = pool;
+}
+
+BufferPool::Scope::~Scope() {
+  current_pool = previous;
+}
+
+BufferPool* BufferPool::current() {
+  return current_pool;
+}
+
+std::vector<double> BufferPool::acquire(size_t capacity) {
+  {
+    auto lock = std::lock_guard{mutex};
+    counts.acquired++;
+    // Use the smallest buffer that is large enough.
+    if (auto it = free.lower_bound(capacity); it != free.end()) {
+      auto buffer = std::move(it->second);
+      free.erase(it);
+      counts.reused++;
+      return buffer;
+    }
+  }
+  return allocate(capacity);
+}
+
+void BufferPool::release(std::vector<double>&& buffer) {
+  if (buffer.capacity() == 0) {
+    return;
+  }
+  buffer.clear();
+  auto lock = std::lock_guard{mutex};
+  counts.released++;
+  if (free.size() >= max_free) {
+    // Drop the smallest buffer, as the large ones are the expensive ones to allocate.
+    if (free.begin()->first >= buffer.capacity()) {
+      return;
+    }
+    free.erase(free.begin());
+  }
+  const size_t capacity = buffer.capacity();
+  free.emplace(capacity, std::move(buffer));
+}
+
+BufferPool::Stats BufferPool::stats() const {
+  auto lock = std::lock_guard{mutex};
+  return counts;
+}
+
+void BufferPool::adopt(
+    Signal& sig,
+    Column&& values,
+    Column&& times,
+    Column&& derivatives) {
+  assert(values.size() == times.size());
+  sig.time_col       = std::move(times);
+  sig.value_col      = std::move(values);
+  sig.derivative_col = std::move(derivatives);
+  if (sig.derivative_col.size() != sig.time_col.size()) {
+    sig.compute_derivatives();
+  }
+}
+
+SignalPtr
+BufferPool::make_signal(Column&& values, Column&& times, Column&& derivatives) {
+  if (derivatives.size() != times.size()) {
+    // Get a buffer to compute the derivatives into.
+    auto buffer = derivatives.release();
+    if (buffer.capacity() < times.size()) {
+      release(std::move(buffer));
+      buffer = acquire(times.size());
+    }
+    derivatives = std::move(buffer);
+  }
+
+  // Return the columns of the signal to the pool (if it is still alive) once the last
+  // reference to the signal is dropped.
+  auto deleter = [pool = weak_from_this()](Signal* sig) {
+    if (auto self = pool.lock()) {
+      self->release(sig->time_col.release());
+      self->release(sig->value_col.release());
+      self->release(sig->derivative_col.release());
+    }
+    delete sig; // NOLINT(cppcoreguidelines-owning-memory)
+  };
+  auto sig = std::shared_ptr<Signal>(new Signal{}, std::move(deleter));
+  adopt(*sig, std::move(values), std::move(times), std::move(derivatives));
+  return sig;
+}
+
+std::vector<double> acquire_buffer(size_t capacity) {
+  if (auto pool = BufferPool::current()) {
+    return pool->acquire(capacity);
+  }
+  return allocate(capacity);
+}
+
+void release_buffer(std::vector<double>&& buffer) {
+  if (auto pool = BufferPool::current()) {
+    pool->release(std::move(buffer));
+  }
+}
+
+SignalPtr make_signal(Column&& values, Column&& times, Column&& derivatives) {
+  if (auto pool = BufferPool::current()) {
+    return pool->make_signal(
+        std::move(values), std::move(times), std::move(derivatives));
+  }
+  auto sig = std::make_shared<Signal>();
+  BufferPool::adopt(*sig, std::move(values), std::move(times), std::move(derivatives));
+  return sig;
+}
+
+size_t allocated_bytes() {
+  return allocated;
+}
+
+} // namespace signal_tl::signal
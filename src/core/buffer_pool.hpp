@@ -0,0 +1,135 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_BUFFER_POOL_HPP
+#define SIGNAL_TEMPORAL_LOGIC_BUFFER_POOL_HPP
+
+#include "signal_tl/signal.hpp" // for Column, Signal, SignalPtr
+
+#include <cstddef> // for size_t
+#include <map>     // for multimap
+#include <memory>  // for enable_shared_from_this
+#include <mutex>   // for mutex
+#include <vector>  // for vector
+
+namespace signal_tl::signal {
+
+/**
+ * A pool of recycled buffers for the columns of intermediate signals.
+ *
+ * Evaluating a formula creates (and destroys) a few signals for every node in the
+ * formula, all of which are about as long as the trace. Instead of allocating fresh
+ * columns for each of them, the kernels get their buffers from the pool, and signals
+ * created using `make_signal` return their columns to the pool when they are
+ * destroyed. Thus, after the first few nodes, evaluation mostly reuses the memory of
+ * the signals that are no longer needed.
+ *
+ * The pool must be owned by a `std::shared_ptr`. Signals created by the pool can
+ * outlive it, in which case their columns are just freed.
+ *
+ * The kernels don't take a pool as an argument: the pool used by the current thread
+ * is set using a `BufferPool::Scope` (similar to the default memory resource of
+ * `std::pmr`), and `acquire_buffer`/`make_signal` fall back to regular allocations
+ * if there is no such pool.
+ */
+class BufferPool : public std::enable_shared_from_this<BufferPool> {
+ public:
+  struct Stats {
+    /// Number of buffers requested from the pool.
+    size_t acquired = 0;
+    /// Number of requests served by a recycled buffer.
+    size_t reused = 0;
+    /// Number of buffers returned to the pool.
+    size_t released = 0;
+  };
+
+  /**
+   * Sets the pool used by the current thread for the lifetime of the scope.
+   */
+  class Scope {
+   public:
+    explicit Scope(BufferPool* pool);
+    ~Scope();
+
+    Scope(const Scope&)            = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    BufferPool* previous;
+  };
+
+  /**
+   * Create a pool that keeps at most `max_buffers` unused buffers.
+   */
+  explicit BufferPool(size_t max_buffers = 64) : max_free{max_buffers} {}
+
+  /**
+   * Get an empty buffer that can hold at least `capacity` elements.
+   */
+  [[nodiscard]] std::vector<double> acquire(size_t capacity);
+
+  /**
+   * Return a buffer to the pool, to be reused by later calls to `acquire`.
+   */
+  void release(std::vector<double>&& buffer);
+
+  /**
+   * Create a signal from the given columns, which are returned to the pool once the
+   * signal is destroyed.
+   *
+   * The time stamps must be strictly increasing (this is not checked). If
+   * `derivatives` is empty, they are computed from the times and values. Columns that
+   * view external memory (e.g., time stamps shared with other signals) are not
+   * returned to the pool.
+   */
+  [[nodiscard]] SignalPtr
+  make_signal(Column&& values, Column&& times, Column&& derivatives = {});
+
+  [[nodiscard]] Stats stats() const;
+
+  /**
+   * Get the pool used by the current thread, or `nullptr` if there is none.
+   */
+  [[nodiscard]] static BufferPool* current();
+
+ private:
+  friend SignalPtr make_signal(Column&& values, Column&& times, Column&& derivatives);
+
+  /// Move the columns into the (empty) signal.
+  static void adopt(Signal& sig, Column&& values, Column&& times, Column&& derivatives);
+
+  mutable std::mutex mutex;
+  /// Unused buffers, by capacity.
+  std::multimap<size_t, std::vector<double>> free;
+  size_t max_free;
+  Stats counts;
+};
+
+/**
+ * Get an empty buffer that can hold at least `capacity` elements from the current
+ * pool, or allocate one if there is no current pool.
+ */
+[[nodiscard]] std::vector<double> acquire_buffer(size_t capacity);
+
+/**
+ * Return the buffer to the current pool, if any.
+ */
+void release_buffer(std::vector<double>&& buffer);
+
+/**
+ * Create a signal from the given columns, using the current pool if there is one.
+ *
+ * The time stamps must be strictly increasing (this is not checked). If
+ * `derivatives` is empty, they are computed from the times and values.
+ */
+[[nodiscard]] SignalPtr
+make_signal(Column&& values, Column&& times, Column&& derivatives = {});
+
+/**
+ * Get the total number of bytes allocated for new buffers (i.e., not recycled by a
+ * pool) by `acquire_buffer` and `make_signal` on the current thread.
+ */
+[[nodiscard]] size_t allocated_bytes();
+
+} // namespace signal_tl::signal
+
+#endif
@@ -0,0 +1,206 @@
+#include "signal_tl/executor.hpp"
+
+#include <algorithm>          // for max
+#include <atomic>             // for atomic
+#include <condition_variable> // for condition_variable
+#include <cstddef>            // for size_t
+#include <deque>              // for deque
+#include <exception>          // for exception_ptr, current_exception, rethrow_...
+#include <functional>         // for function
+#include <memory>             // for unique_ptr, make_unique, shared_ptr
+#include <mutex>              // for mutex, lock_guard, unique_lock
+#include <thread>             // for thread
+#include <utility>            // for move, exchange
+#include <vector>             // for vector
+
+namespace signal_tl {
+
+namespace {
+
+/// The pool (if any) that owns the current thread, and the index of the thread in it.
+thread_local const ThreadPool::Impl* current_pool = nullptr;
+thread_local size_t current_index                 = 0;
+
+} // namespace
+
+struct ThreadPool::Impl {
+  struct Worker {
+    std::mutex mutex;
+    std::deque<std::function<void()>> queue;
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::vector<std::thread> threads;
+
+  std::mutex sleep_mutex;
+  std::condition_variable wakeup;
+  std::atomic<size_t> queued     = 0;
+  std::atomic<size_t> next_queue = 0;
+  bool stopping                  = false;
+
+  Impl(size_t num_threads) {
+    for (size_t i = 0; i < num_threads; i++) {
+      workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < num_threads; i++) {
+      threads.emplace_back([this, i]() { this->work(i); });
+    }
+  }
+
+  ~Impl() {
+    {
+      auto lock = std::lock_guard{sleep_mutex};
+      stopping  = true;
+    }
+    wakeup.notify_all();
+    for (auto& t : threads) { t.join(); }
+  }
+
+  Impl(const Impl&) = delete;
+  Impl& operator=(const Impl&) = delete;
+
+  void push(std::function<void()> task) {
+    // Tasks created by a worker go to its own queue, others are distributed over all
+    // the queues.
+    const size_t idx =
+        (current_pool == this) ? current_index : (next_queue++ % workers.size());
+    {
+      auto lock = std::lock_guard{workers[idx]->mutex};
+      workers[idx]->queue.push_back(std::move(task));
+    }
+    {
+      auto lock = std::lock_guard{sleep_mutex};
+      queued++;
+    }
+    wakeup.notify_one();
+  }
+
+  /// Pop the newest task from the worker's own queue, or steal the oldest task from
+  /// some other worker.
+  bool pop(size_t idx, std::function<void()>& task) {
+    {
+      auto& own = *workers[idx];
+      auto lock = std::lock_guard{own.mutex};
+      if (!own.queue.empty()) {
+        task = std::move(own.queue.back());
+        own.queue.pop_back();
+        return true;
+      }
+    }
+    for (size_t k = 1; k < workers.size(); k++) {
+      auto& other = *workers[(idx + k) % workers.size()];
+      auto lock   = std::lock_guard{other.mutex};
+      if (!other.queue.empty()) {
+        task = std::move(other.queue.front());
+        other.queue.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void work(size_t idx) {
+    current_pool  = this;
+    current_index = idx;
+    while (true) {
+      auto task = std::function<void()>{};
+      if (pop(idx, task)) {
+        queued--;
+        task();
+        continue;
+      }
+      auto lock = std::unique_lock{sleep_mutex};
+      wakeup.wait(lock, [this]() { return stopping || queued > 0; });
+      if (stopping && queued == 0) {
+        return;
+      }
+    }
+  }
+};
+
+ThreadPool::ThreadPool(size_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  impl = std::make_unique<Impl>(num_threads);
+}
+
+ThreadPool::~ThreadPool() = default;
+
+void ThreadPool::submit(std::function<void()> task) {
+  impl->push(std::move(task));
+}
+
+size_t ThreadPool::concurrency() const {
+  return impl->threads.size();
+}
+
+struct TaskGroup::State {
+  std::mutex mutex;
+  std::condition_variable done;
+  size_t pending = 0;
+  std::exception_ptr error;
+};
+
+struct TaskGroup::Task {
+  std::function<void()> fn;
+  std::atomic<bool> claimed = false;
+
+  /// Run the task, unless some other thread has already claimed it.
+  void try_run(State& state) {
+    if (claimed.exchange(true)) {
+      return;
+    }
+    auto error = std::exception_ptr{};
+    try {
+      fn();
+    } catch (...) { error = std::current_exception(); }
+    // Release anything captured by the task as soon as possible.
+    fn = nullptr;
+
+    auto lock = std::lock_guard{state.mutex};
+    if (error && !state.error) {
+      state.error = error;
+    }
+    if (--state.pending == 0) {
+      state.done.notify_all();
+    }
+  }
+};
+
+TaskGroup::TaskGroup(Executor* exec) :
+    executor{exec}, state{std::make_shared<State>()} {}
+
+TaskGroup::~TaskGroup() {
+  try {
+    this->wait();
+  } catch (...) {}
+}
+
+void TaskGroup::run(std::function<void()> task) {
+  auto t = std::make_shared<Task>();
+  t->fn  = std::move(task);
+  {
+    auto lock = std::lock_guard{state->mutex};
+    state->pending++;
+  }
+  tasks.push_back(t);
+  if (executor != nullptr) {
+    executor->submit([t, s = state]() { t->try_run(*s); });
+  }
+}
+
+void TaskGroup::wait() {
+  // Run whatever hasn't been picked up by the executor...
+  for (auto& t : tasks) { t->try_run(*state); }
+  tasks.clear();
+
+  // ... and wait for the tasks that are running on other threads.
+  auto lock = std::unique_lock{state->mutex};
+  state->done.wait(lock, [this]() { return state->pending == 0; });
+  if (auto error = std::exchange(state->error, nullptr)) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace signal_tl
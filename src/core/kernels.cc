@@ -0,0 +1,259 @@
+#include "kernels.hpp"
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint8_t
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define SIGNALTL_KERNELS_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define SIGNALTL_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace signal_tl::kernels {
+
+namespace {
+
+template <bool IsMin>
+void scalar_minmax(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    const bool pick_y = (IsMin) ? (y[i] < x[i]) : (x[i] < y[i]);
+    out[i]            = (pick_y) ? y[i] : x[i];
+    chose_y[i]        = (pick_y) ? 1 : 0;
+  }
+}
+
+#if defined(SIGNALTL_KERNELS_X86)
+
+__attribute__((target("avx2"))) void
+avx2_affine(const double* x, double* out, size_t n, double scale, double offset) {
+  const __m256d s = _mm256_set1_pd(scale);
+  const __m256d o = _mm256_set1_pd(offset);
+  size_t i        = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d v = _mm256_loadu_pd(x + i);
+    _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_mul_pd(v, s), o));
+  }
+  scalar::affine(x + i, out + i, n - i, scale, offset);
+}
+
+template <bool IsMin>
+__attribute__((target("avx2"))) void avx2_minmax(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d a = _mm256_loadu_pd(x + i);
+    const __m256d b = _mm256_loadu_pd(y + i);
+    const __m256d m =
+        (IsMin) ? _mm256_cmp_pd(b, a, _CMP_LT_OQ) : _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+    _mm256_storeu_pd(out + i, _mm256_blendv_pd(a, b, m));
+
+    const int bits = _mm256_movemask_pd(m);
+    for (int k = 0; k < 4; k++) {
+      chose_y[i + static_cast<size_t>(k)] = static_cast<std::uint8_t>((bits >> k) & 1);
+    }
+  }
+  scalar_minmax<IsMin>(x + i, y + i, out + i, chose_y + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void
+avx512_affine(const double* x, double* out, size_t n, double scale, double offset) {
+  const __m512d s = _mm512_set1_pd(scale);
+  const __m512d o = _mm512_set1_pd(offset);
+  size_t i        = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m512d v = _mm512_loadu_pd(x + i);
+    _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_mul_pd(v, s), o));
+  }
+  scalar::affine(x + i, out + i, n - i, scale, offset);
+}
+
+template <bool IsMin>
+__attribute__((target("avx512f"))) void avx512_minmax(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m512d a = _mm512_loadu_pd(x + i);
+    const __m512d b = _mm512_loadu_pd(y + i);
+    const __mmask8 m =
+        (IsMin) ? _mm512_cmp_pd_mask(b, a, _CMP_LT_OQ)
+                : _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+    _mm512_storeu_pd(out + i, _mm512_mask_blend_pd(m, a, b));
+
+    for (unsigned k = 0; k < 8; k++) {
+      chose_y[i + k] = static_cast<std::uint8_t>((m >> k) & 1U);
+    }
+  }
+  scalar_minmax<IsMin>(x + i, y + i, out + i, chose_y + i, n - i);
+}
+
+#elif defined(SIGNALTL_KERNELS_NEON)
+
+void neon_affine(const double* x, double* out, size_t n, double scale, double offset) {
+  const float64x2_t s = vdupq_n_f64(scale);
+  const float64x2_t o = vdupq_n_f64(offset);
+  size_t i            = 0;
+  for (; i + 2 <= n; i += 2) {
+    const float64x2_t v = vld1q_f64(x + i);
+    vst1q_f64(out + i, vaddq_f64(vmulq_f64(v, s), o));
+  }
+  scalar::affine(x + i, out + i, n - i, scale, offset);
+}
+
+template <bool IsMin>
+void neon_minmax(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n) {
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const float64x2_t a = vld1q_f64(x + i);
+    const float64x2_t b = vld1q_f64(y + i);
+    const uint64x2_t m  = (IsMin) ? vcltq_f64(b, a) : vcltq_f64(a, b);
+    vst1q_f64(out + i, vbslq_f64(m, b, a));
+
+    chose_y[i]     = static_cast<std::uint8_t>(vgetq_lane_u64(m, 0) & 1U);
+    chose_y[i + 1] = static_cast<std::uint8_t>(vgetq_lane_u64(m, 1) & 1U);
+  }
+  scalar_minmax<IsMin>(x + i, y + i, out + i, chose_y + i, n - i);
+}
+
+#endif
+
+SimdLevel detect_simd_level() {
+#if defined(SIGNALTL_KERNELS_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return SimdLevel::AVX512;
+  } else if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+  return SimdLevel::Scalar;
+#elif defined(SIGNALTL_KERNELS_NEON)
+  return SimdLevel::NEON;
+#else
+  return SimdLevel::Scalar;
+#endif
+}
+
+template <bool IsMin>
+void dispatch_minmax(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n) {
+  switch (simd_level()) {
+#if defined(SIGNALTL_KERNELS_X86)
+    case SimdLevel::AVX512:
+      return avx512_minmax<IsMin>(x, y, out, chose_y, n);
+    case SimdLevel::AVX2:
+      return avx2_minmax<IsMin>(x, y, out, chose_y, n);
+#elif defined(SIGNALTL_KERNELS_NEON)
+    case SimdLevel::NEON:
+      return neon_minmax<IsMin>(x, y, out, chose_y, n);
+#endif
+    default:
+      return scalar_minmax<IsMin>(x, y, out, chose_y, n);
+  }
+}
+
+} // namespace
+
+SimdLevel simd_level() {
+  static const SimdLevel level = detect_simd_level();
+  return level;
+}
+
+const char* simd_level_name(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::Scalar:
+      return "scalar";
+    case SimdLevel::NEON:
+      return "neon";
+    case SimdLevel::AVX2:
+      return "avx2";
+    case SimdLevel::AVX512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+void affine(const double* x, double* out, size_t n, double scale, double offset) {
+  switch (simd_level()) {
+#if defined(SIGNALTL_KERNELS_X86)
+    case SimdLevel::AVX512:
+      return avx512_affine(x, out, n, scale, offset);
+    case SimdLevel::AVX2:
+      return avx2_affine(x, out, n, scale, offset);
+#elif defined(SIGNALTL_KERNELS_NEON)
+    case SimdLevel::NEON:
+      return neon_affine(x, out, n, scale, offset);
+#endif
+    default:
+      return scalar::affine(x, out, n, scale, offset);
+  }
+}
+
+void elementwise_min(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n) {
+  dispatch_minmax<true>(x, y, out, chose_y, n);
+}
+
+void elementwise_max(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n) {
+  dispatch_minmax<false>(x, y, out, chose_y, n);
+}
+
+namespace scalar {
+
+void affine(const double* x, double* out, size_t n, double scale, double offset) {
+  for (size_t i = 0; i < n; i++) { out[i] = scale * x[i] + offset; }
+}
+
+void elementwise_min(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n) {
+  scalar_minmax<true>(x, y, out, chose_y, n);
+}
+
+void elementwise_max(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n) {
+  scalar_minmax<false>(x, y, out, chose_y, n);
+}
+
+} // namespace scalar
+
+} // namespace signal_tl::kernels
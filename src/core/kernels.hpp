@@ -0,0 +1,96 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_KERNELS_HPP
+#define SIGNAL_TEMPORAL_LOGIC_KERNELS_HPP
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint8_t
+
+/**
+ * Vectorized kernels over the contiguous columns of a Signal.
+ *
+ * Each kernel has a portable scalar implementation, and (if the compiler supports
+ * it) AVX2 and AVX-512 implementations on x86-64 or a NEON implementation on
+ * AArch64. On x86-64, the implementation is chosen at runtime based on the features
+ * supported by the CPU, so the library doesn't need to be compiled with `-mavx2`,
+ * etc.
+ *
+ * The vectorized implementations compute the same results as the scalar loops: the
+ * affine map uses a separate multiply and add (no fused multiply-add), and the
+ * min/max kernels use the same (ordered) comparisons as the comparison operators of
+ * `Sample`, so ties and NaNs prefer `x`.
+ */
+namespace signal_tl::kernels {
+
+enum struct SimdLevel { Scalar, NEON, AVX2, AVX512 };
+
+/**
+ * Get the instruction set used by the kernels on this machine.
+ */
+SimdLevel simd_level();
+
+/**
+ * Get a human readable name for the SIMD instruction set.
+ */
+const char* simd_level_name(SimdLevel level);
+
+/**
+ * Compute `out[i] = scale * x[i] + offset` for `i` in `[0, n)`.
+ *
+ * `out` may alias `x`.
+ */
+void affine(const double* x, double* out, size_t n, double scale, double offset);
+
+/**
+ * Compute the element-wise minimum of `x` and `y`.
+ *
+ * `out[i]` is set to `y[i]` if `y[i] < x[i]`, and to `x[i]` otherwise.
+ * `chose_y[i]` is set to `1` if `y[i]` was chosen, and to `0` otherwise.
+ */
+void elementwise_min(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n);
+
+/**
+ * Compute the element-wise maximum of `x` and `y`.
+ *
+ * `out[i]` is set to `y[i]` if `x[i] < y[i]`, and to `x[i]` otherwise.
+ * `chose_y[i]` is set to `1` if `y[i]` was chosen, and to `0` otherwise.
+ */
+void elementwise_max(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n);
+
+/**
+ * Portable implementations of the kernels, mainly used for testing and
+ * benchmarking the vectorized versions.
+ */
+namespace scalar {
+
+void affine(const double* x, double* out, size_t n, double scale, double offset);
+
+void elementwise_min(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n);
+
+void elementwise_max(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n);
+
+} // namespace scalar
+
+} // namespace signal_tl::kernels
+
+#endif
@@ -0,0 +1,168 @@
+#include "signal_tl/internal/node_pool.hpp"
+
+#include <array>   // for array
+#include <cstddef> // for max_align_t
+#include <mutex>   // for mutex, lock_guard
+#include <new>     // for operator new, operator delete
+#include <vector>  // for vector
+
+namespace signal_tl::ast::internal {
+
+namespace {
+
+/// Blocks are multiples of the alignment of the nodes, up to `MAX_BLOCK` bytes (larger
+/// nodes are allocated directly).
+constexpr size_t GRANULE     = alignof(std::max_align_t);
+constexpr size_t NUM_CLASSES = 8;
+constexpr size_t MAX_BLOCK   = GRANULE * NUM_CLASSES;
+constexpr size_t CHUNK_SIZE  = size_t{64} << 10;
+
+/// The number of free blocks of a size that a thread keeps to itself. The blocks that
+/// a thread frees beyond that are shared with the other threads, so that memory freed
+/// by one thread can be reused for nodes allocated by another.
+constexpr size_t MAX_CACHED = 4096;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+constexpr size_t size_class(size_t size) {
+  return (size + GRANULE - 1) / GRANULE - 1;
+}
+
+/// The free blocks shared by all threads, and the chunks they come from.
+class SharedPool {
+ public:
+  /// Take all the shared free blocks of the size class, or a new chunk of them.
+  FreeBlock* refill(size_t c) {
+    const auto lock = std::lock_guard{mutex};
+    if (auto* head = free[c]; head != nullptr) {
+      free[c] = nullptr;
+      return head;
+    }
+    // Split a new chunk into a list of blocks.
+    auto* chunk = static_cast<char*>(::operator new(CHUNK_SIZE));
+    chunks.push_back(chunk);
+    const size_t block_size = (c + 1) * GRANULE;
+    const size_t n          = CHUNK_SIZE / block_size;
+    FreeBlock* head = nullptr;
+    for (size_t i = n; i > 0; i--) {
+      auto* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * block_size);
+      block->next = head;
+      head        = block;
+    }
+    return head;
+  }
+
+  /// Share the list of free blocks from `head` to `tail`.
+  void give(size_t c, FreeBlock* head, FreeBlock* tail) {
+    const auto lock = std::lock_guard{mutex};
+    tail->next      = free[c];
+    free[c]         = head;
+  }
+
+ private:
+  std::mutex mutex;
+  std::array<FreeBlock*, NUM_CLASSES> free{};
+  /// The chunks are never released, as there may be nodes in them until the very end.
+  std::vector<char*> chunks;
+};
+
+SharedPool& shared_pool() {
+  // Never destroyed, as nodes held by static objects may be freed after it would be.
+  static auto* pool = new SharedPool{};
+  return *pool;
+}
+
+/// The free blocks of a thread.
+struct ThreadCache;
+
+/// Whether the cache of the thread is yet to be created, alive, or destroyed (in which
+/// case the shared pool is used directly).
+enum class CacheState { Unused, Alive, Destroyed };
+thread_local CacheState cache_state = CacheState::Unused;
+
+struct ThreadCache {
+  std::array<FreeBlock*, NUM_CLASSES> free{};
+  std::array<size_t, NUM_CLASSES> count{};
+
+  ThreadCache() {
+    cache_state = CacheState::Alive;
+  }
+
+  ~ThreadCache() {
+    cache_state = CacheState::Destroyed;
+    for (size_t c = 0; c < NUM_CLASSES; c++) { share(c); }
+  }
+
+  /// Share all the free blocks of the size class with the other threads.
+  void share(size_t c) {
+    if (free[c] == nullptr) {
+      return;
+    }
+    auto* tail = free[c];
+    while (tail->next != nullptr) { tail = tail->next; }
+    shared_pool().give(c, free[c], tail);
+    free[c]  = nullptr;
+    count[c] = 0;
+  }
+};
+
+ThreadCache* thread_cache() {
+  if (cache_state == CacheState::Destroyed) {
+    return nullptr;
+  }
+  thread_local ThreadCache cache;
+  return &cache;
+}
+
+} // namespace
+
+void* allocate_node(size_t size) {
+  if (size > MAX_BLOCK) {
+    return ::operator new(size);
+  }
+  const size_t c = size_class(size);
+  auto* cache    = thread_cache();
+  if (cache == nullptr) {
+    // The thread is exiting: take a list of blocks, and give back the rest.
+    auto* block = shared_pool().refill(c);
+    if (block->next != nullptr) {
+      auto* tail = block->next;
+      while (tail->next != nullptr) { tail = tail->next; }
+      shared_pool().give(c, block->next, tail);
+    }
+    return block;
+  }
+  if (cache->free[c] == nullptr) {
+    cache->free[c]  = shared_pool().refill(c);
+    cache->count[c] = 0;
+  }
+  auto* block    = cache->free[c];
+  cache->free[c] = block->next;
+  if (cache->count[c] > 0) {
+    cache->count[c]--;
+  }
+  return block;
+}
+
+void deallocate_node(void* block, size_t size) noexcept {
+  if (size > MAX_BLOCK) {
+    ::operator delete(block);
+    return;
+  }
+  const size_t c = size_class(size);
+  auto* freed    = static_cast<FreeBlock*>(block);
+  auto* cache    = thread_cache();
+  if (cache == nullptr) {
+    shared_pool().give(c, freed, freed);
+    return;
+  }
+  freed->next    = cache->free[c];
+  cache->free[c] = freed;
+  if (++cache->count[c] > MAX_CACHED) {
+    cache->share(c);
+  }
+}
+
+} // namespace signal_tl::ast::internal
@@ -1,35 +1,199 @@
-#include "signal_tl/signal.hpp" // for Sample, Signal, SignalPtr, synchronize
+#include "signal_tl/signal.hpp" // for Sample, Signal, SignalPtr, Trace, synchronize
 #include "signal_tl/fmt.hpp"    // IWYU pragma: keep
 
-#include <algorithm>    // for lower_bound, max
+#include "buffer_pool.hpp" // for acquire_buffer, make_signal
+#include "kernels.hpp"     // for affine
+
+#include <algorithm>    // for equal, lower_bound, max, min, upper_bound
+#include <cmath>        // for isfinite
 #include <fmt/format.h> // for format
 #include <iterator>     // for prev, next
+#include <limits>       // for numeric_limits
+#include <map>          // for map
 #include <memory>       // for shared_ptr, __shared_ptr_access, mak...
 #include <stdexcept>    // for invalid_argument
+#include <string>       // for string
 #include <tuple>        // for make_tuple, tuple
+#include <utility>      // for move
 #include <vector>       // for vector
 
 namespace signal_tl::signal {
 
+namespace {
+
+void check_strictly_increasing(const double* ts, size_t n) {
+  for (size_t i = 1; i < n; i++) {
+    if (ts[i] <= ts[i - 1]) {
+      throw std::invalid_argument(fmt::format(
+          "Time points are not strictly monotonically increasing: "
+          "time[{}] = {} and time[{}] = {}",
+          i - 1,
+          ts[i - 1],
+          i,
+          ts[i]));
+    }
+  }
+}
+
+/**
+ * Copy the breakpoints of the samples to `out_ts` and `out_xs` (which may be the
+ * inputs, as the breakpoints are compacted towards the front), and return their
+ * number. A sample is dropped if it is within `tolerance` of the segment between
+ * the breakpoints around it.
+ *
+ * From each breakpoint (the anchor), we narrow the cone of the slopes of the lines
+ * that pass within `tolerance` of every sample after it, and extend the segment as
+ * long as the line to the next sample lies in the cone. Thus, this takes O(n) time,
+ * and with a tolerance of 0, only the samples on a straight line (e.g., all but the
+ * ends of a constant run) are dropped.
+ */
+size_t compress_samples(
+    const double* ts,
+    const double* xs,
+    size_t n,
+    double tolerance,
+    double* out_ts,
+    double* out_xs) {
+  constexpr double INF = std::numeric_limits<double>::infinity();
+  if (n == 0) {
+    return 0;
+  }
+
+  size_t m        = 0;
+  const auto keep = [&](size_t i) {
+    out_ts[m] = ts[i];
+    out_xs[m] = xs[i];
+    m++;
+  };
+  keep(0);
+  size_t anchor = 0;
+  double lo     = -INF;
+  double hi     = INF;
+  for (size_t j = 1; j < n; j++) {
+    if (j > anchor + 1) {
+      const double x0    = xs[anchor];
+      const double slope = (xs[j] == x0) ? 0.0 : (xs[j] - x0) / (ts[j] - ts[anchor]);
+      if (!(lo <= slope && slope <= hi)) {
+        // The segment ends at the previous sample.
+        anchor = j - 1;
+        keep(anchor);
+        lo = -INF;
+        hi = INF;
+      }
+    }
+
+    // Narrow the cone by the sample. Infinite values are only merged with equal ones.
+    const double x0 = xs[anchor];
+    if (std::isfinite(xs[j]) && std::isfinite(x0)) {
+      const double dt = ts[j] - ts[anchor];
+      lo              = std::max(lo, (xs[j] - tolerance - x0) / dt);
+      hi              = std::min(hi, (xs[j] + tolerance - x0) / dt);
+    } else if (xs[j] == x0) {
+      lo = std::max(lo, 0.0);
+      hi = std::min(hi, 0.0);
+    } else {
+      lo = INF;
+      hi = -INF;
+    }
+  }
+  if (n > 1) {
+    keep(n - 1);
+  }
+  return m;
+}
+
+} // namespace
+
 Sample Signal::at(double t) const {
-  if (this->begin_time() > t && this->end_time() < t) {
+  if (this->empty() || this->begin_time() > t || this->end_time() < t) {
     throw std::invalid_argument(
         fmt::format("Signal is undefined for given time instance {}", t));
   }
-  constexpr auto comp_time = [](const Sample& a, const Sample& b) -> bool {
-    return a.time < b.time;
-  };
+  // The last sample at or before `t`, which exists as the signal starts before it.
+  const auto ts  = this->times();
+  const size_t k = std::upper_bound(ts.begin(), ts.end(), t) - ts.begin() - 1;
+  const auto s   = this->sample_at(k);
+  if (s.time == t) {
+    return s;
+  }
+  return Sample{t, s.interpolate(t), s.derivative};
+}
 
-  auto it = std::lower_bound(
-      this->begin(), this->end(), Sample{t, 0.0}, comp_time); // it->time >= t
-  if (it->time == t) {
-    return *it;
+void Signal::check_index(size_t i) const {
+  if (i >= this->size()) {
+    throw std::out_of_range(fmt::format(
+        "Sample index {} is out of range for a Signal of size {}", i, this->size()));
+  }
+}
+
+Signal::Signal(std::vector<double>&& points, std::vector<double>&& times) :
+    Signal{Column{std::move(points)}, Column{std::move(times)}} {}
+
+Signal::Signal(Column&& points, Column&& times) :
+    time_col{std::move(times)}, value_col{std::move(points)} {
+  if (value_col.size() != time_col.size()) {
+    throw std::invalid_argument(
+        "Number of sample points and time points need to be equal.");
+  }
+  check_strictly_increasing(time_col.data(), time_col.size());
+  this->compute_derivatives();
+}
+
+SignalPtr Signal::compressed(
+    std::vector<double>&& points,
+    std::vector<double>&& times,
+    double tolerance) {
+  if (points.size() != times.size()) {
+    throw std::invalid_argument(
+        "Number of sample points and time points need to be equal.");
+  }
+  check_strictly_increasing(times.data(), times.size());
+  double* ts     = times.data();
+  double* xs     = points.data();
+  const size_t m = compress_samples(ts, xs, times.size(), tolerance, ts, xs);
+  times.resize(m);
+  points.resize(m);
+  times.shrink_to_fit();
+  points.shrink_to_fit();
+  return std::make_shared<Signal>(std::move(points), std::move(times));
+}
+
+SignalPtr Signal::from_sorted(Column&& points, Column&& times, Column&& derivatives) {
+  if (points.size() != times.size() ||
+      (!derivatives.empty() && derivatives.size() != times.size())) {
+    throw std::invalid_argument(
+        "Number of sample points, time points, and derivatives need to be equal.");
+  }
+  auto sig            = std::make_shared<Signal>();
+  sig->time_col       = std::move(times);
+  sig->value_col      = std::move(points);
+  sig->derivative_col = std::move(derivatives);
+#ifndef NDEBUG
+  check_strictly_increasing(sig->time_col.data(), sig->time_col.size());
+#endif
+  if (sig->derivative_col.empty()) {
+    sig->compute_derivatives();
+  }
+  return sig;
+}
+
+void Signal::compute_derivatives() {
+  const size_t n = time_col.size();
+  auto& out      = derivative_col.mut();
+  out.resize(n);
+  const double* ts = time_col.data();
+  const double* xs = value_col.data();
+  for (size_t i = 0; i + 1 < n; i++) {
+    // Constant segments have a slope of 0, even if they are infinite.
+    out[i] = (xs[i + 1] == xs[i]) ? 0.0 : (xs[i + 1] - xs[i]) / (ts[i + 1] - ts[i]);
+  }
+  if (n > 0) {
+    out.back() = 0.0;
   }
-  return Sample{t, it->interpolate(t), it->derivative};
 }
 
 void Signal::push_back(Sample sample) {
-  if (!this->samples.empty()) {
+  if (!this->empty()) {
     if (sample.time <= this->end_time()) {
       throw std::invalid_argument(fmt::format(
           "Trying to append a Sample timestamped at or before the Signal end_time,"
@@ -38,32 +202,103 @@ void Signal::push_back(Sample sample) {
           this->end_time(),
           sample));
     }
-    const auto t = this->samples.back().time;
-    const auto v = this->samples.back().value;
-    auto& last   = this->samples.back();
+    const auto t = this->time_col.back();
+    const auto v = this->value_col.back();
 
-    last.derivative = (sample.value - v) / (sample.time - t);
+    this->derivative_col.mut().back() =
+        (sample.value == v) ? 0.0 : (sample.value - v) / (sample.time - t);
   }
-  this->samples.push_back(Sample{sample.time, sample.value, 0.0});
+  this->time_col.mut().push_back(sample.time);
+  this->value_col.mut().push_back(sample.value);
+  this->derivative_col.mut().push_back(0.0);
 }
 
 void Signal::push_back(double time, double value) {
   this->push_back(Sample{time, value, 0.0});
 }
 
-SignalPtr Signal::simplify() const {
-  auto sig = std::make_shared<Signal>();
-  for (const auto& s : this->samples) {
-    const auto [t, v, d] = s;
-    if ((sig->empty()) ||
-        (sig->back().interpolate(t) != v || sig->back().derivative != d)) {
-      sig->push_back(s);
+void Signal::append(utils::span<const double> times, utils::span<const double> values) {
+  if (times.size() != values.size()) {
+    throw std::invalid_argument(
+        "Number of sample points and time points need to be equal.");
+  }
+  check_strictly_increasing(times.data(), times.size());
+  this->append_sorted(times, values);
+}
+
+void Signal::append_sorted(
+    utils::span<const double> times,
+    utils::span<const double> values,
+    utils::span<const double> derivatives) {
+  if (times.size() != values.size() ||
+      (!derivatives.empty() && derivatives.size() != times.size())) {
+    throw std::invalid_argument(
+        "Number of sample points, time points, and derivatives need to be equal.");
+  }
+  if (times.empty()) {
+    return;
+  }
+  if (!this->empty() && times.front() <= this->end_time()) {
+    throw std::invalid_argument(fmt::format(
+        "Trying to append a Sample timestamped at or before the Signal end_time,"
+        "i.e., time is not strictly monotonically increasing."
+        "Current end_time is {}, given Sample is at {}.",
+        this->end_time(),
+        times.front()));
+  }
+#ifndef NDEBUG
+  check_strictly_increasing(times.data(), times.size());
+#endif
+
+  const size_t n0 = this->size();
+  const size_t n  = n0 + times.size();
+  auto& ts        = this->time_col.mut();
+  auto& xs        = this->value_col.mut();
+  auto& ds        = this->derivative_col.mut();
+  ts.insert(ts.end(), times.begin(), times.end());
+  xs.insert(xs.end(), values.begin(), values.end());
+  if (derivatives.empty()) {
+    ds.resize(n);
+    for (size_t i = (n0 > 0) ? n0 - 1 : 0; i + 1 < n; i++) {
+      ds[i] = (xs[i + 1] == xs[i]) ? 0.0 : (xs[i + 1] - xs[i]) / (ts[i + 1] - ts[i]);
+    }
+    ds.back() = 0.0;
+  } else {
+    if (n0 > 0) {
+      ds.back() = (xs[n0] == xs[n0 - 1])
+                      ? 0.0
+                      : (xs[n0] - xs[n0 - 1]) / (ts[n0] - ts[n0 - 1]);
     }
+    ds.insert(ds.end(), derivatives.begin(), derivatives.end());
+  }
+}
+
+void Signal::truncate(double time) {
+  const auto ts  = this->times();
+  const size_t n = std::lower_bound(ts.begin(), ts.end(), time) - ts.begin();
+  if (n == ts.size()) {
+    return;
   }
-  if (this->end_time() != sig->end_time()) {
-    sig->push_back(this->back());
+  this->time_col.mut().resize(n);
+  this->value_col.mut().resize(n);
+  this->derivative_col.mut().resize(n);
+  // The last sample has no segment after it.
+  if (n > 0) {
+    this->derivative_col.mut().back() = 0.0;
   }
-  return sig;
+}
+
+SignalPtr Signal::simplify(double tolerance) const {
+  const size_t n = this->size();
+  auto times     = std::vector<double>(n);
+  auto values    = std::vector<double>(n);
+  const size_t m = compress_samples(
+      time_col.data(), value_col.data(), n, tolerance, times.data(), values.data());
+  times.resize(m);
+  values.resize(m);
+  times.shrink_to_fit();
+  values.shrink_to_fit();
+  return std::make_shared<Signal>(std::move(values), std::move(times));
 }
 
 SignalPtr Signal::resize(double start, double end, double fill) const {
@@ -100,76 +335,166 @@ SignalPtr Signal::resize(double start, double end, double fill) const {
 }
 
 SignalPtr Signal::shift(double dt) const {
-  auto sig = std::make_shared<Signal>(this->samples);
-  for (auto& s : sig->samples) { s.time += dt; }
+  auto sig = std::make_shared<Signal>(*this);
+  for (auto& t : sig->time_col.mut()) { t += dt; }
 
   return sig;
 }
 
 SignalPtr Signal::resize_shift(double start, double end, double fill, double dt) const {
   auto out = this->resize(start, end, fill);
-  for (auto& s : out->samples) { s.time += dt; }
+  for (auto& t : out->time_col.mut()) { t += dt; }
   return out;
 }
 
+SignalPtr Signal::affine(double scale, double offset) const {
+  const auto n     = this->size();
+  auto values      = acquire_buffer(n);
+  auto derivatives = acquire_buffer(n);
+  values.resize(n);
+  derivatives.resize(n);
+  kernels::affine(value_col.data(), values.data(), n, scale, offset);
+  kernels::affine(derivative_col.data(), derivatives.data(), n, scale, 0.0);
+  // The time stamps don't change, so a shared time column is shared with the output.
+  auto times = Column{};
+  if (time_col.is_view()) {
+    times = time_col;
+  } else {
+    times = acquire_buffer(n);
+    times.mut().assign(time_col.begin(), time_col.end());
+  }
+  return make_signal(std::move(values), std::move(times), std::move(derivatives));
+}
+
 std::tuple<std::shared_ptr<Signal>, std::shared_ptr<Signal>>
 synchronize(const std::shared_ptr<Signal>& x, const std::shared_ptr<Signal>& y) {
-  const double begin_time = std::max(x->begin_time(), y->begin_time());
-  // const double end_time   = std::min(x->end_time(), y->end_time());
-
-  // These will store the new series of Samples, containing a sample for every
-  // time instance in x and y, and the time points where they intersect.
-  auto xv = std::vector<Sample>{};
-  auto yv = std::vector<Sample>{};
-
-  // Iterator to the first element where element.time <= begin_time.
-  // If the iterator begins after begin_time, get the prev (if it exists) and
-  // interpolate from it.
-  constexpr auto comp_time = [](const Sample& a, const Sample& b) -> bool {
-    return a.time < b.time;
+  const auto view = SynchronizedView{*x, *y};
+
+  auto times = std::make_shared<std::vector<double>>();
+  auto xs    = std::vector<double>{};
+  auto ys    = std::vector<double>{};
+  times->reserve(view.size_hint());
+  xs.reserve(view.size_hint());
+  ys.reserve(view.size_hint());
+  for (const auto& p : view) {
+    times->push_back(p.time);
+    xs.push_back(p.x);
+    ys.push_back(p.y);
+  }
+
+  const auto n = times->size();
+  return std::make_tuple(
+      std::make_shared<Signal>(std::move(xs), Column::view(times->data(), n, times)),
+      std::make_shared<Signal>(std::move(ys), Column::view(times->data(), n, times)));
+}
+
+Trace make_trace(
+    std::vector<double>&& times,
+    std::map<std::string, std::vector<double>>&& channels) {
+  const auto shared = std::make_shared<const std::vector<double>>(std::move(times));
+  auto trace        = Trace{};
+  for (auto& [name, values] : channels) {
+    auto ts     = Column::view(shared->data(), shared->size(), shared);
+    trace[name] = std::make_shared<Signal>(Column{std::move(values)}, std::move(ts));
+  }
+  return trace;
+}
+
+Trace make_compressed_trace(
+    const std::vector<double>& times,
+    std::map<std::string, std::vector<double>>&& channels,
+    double tolerance) {
+  auto trace = Trace{};
+  for (auto& [name, values] : channels) {
+    trace[name] = Signal::compressed(std::move(values), std::vector{times}, tolerance);
+  }
+  return trace;
+}
+
+Trace share_time_bases(const Trace& trace, bool synchronized) {
+  // The (shared) time column of each distinct time base.
+  auto bases = std::vector<Column>{};
+
+  const auto same_times = [](const Column& a, const Column& b) {
+    return a.size() == b.size() &&
+           (a.data() == b.data() || std::equal(a.begin(), a.end(), b.begin()));
   };
-  auto i = std::lower_bound(x->begin(), x->end(), Sample{begin_time, 0.0}, comp_time);
-  if (i->time > begin_time && i != x->begin()) {
-    xv.push_back(Sample{
-        begin_time, std::prev(i)->interpolate(begin_time), std::prev(i)->derivative});
-  }
-  auto j = std::lower_bound(y->begin(), y->end(), Sample{begin_time, 0.0}, comp_time);
-  if (j->time > begin_time && j != y->begin()) {
-    yv.push_back(Sample{
-        begin_time, std::prev(j)->interpolate(begin_time), std::prev(i)->derivative});
-  }
-
-  // Now, we have to track the timestamps.
-  while (i != x->end() && j != y->end()) {
-    if (i->time == j->time) {
-      // The samples remain in both.
-      xv.push_back(*i);
-      yv.push_back(*j);
-      i++;
-      j++;
-    } else if (i->time < j->time) {
-      // Add the current point
-      xv.push_back(*i);
-      yv.push_back(Sample{i->time, std::prev(j)->interpolate(i->time)});
-      // TODO: Intercept?
-      // We need to "catch up".
-      i++;
-    } else if (j->time < i->time) {
-      yv.push_back(*j);
-      xv.push_back(Sample{j->time, std::prev(i)->interpolate(j->time)});
-      j++;
+  const auto find_base = [&](const Column& ts) -> const Column* {
+    for (const auto& base : bases) {
+      if ((synchronized) ? ts.size() == base.size() : same_times(ts, base)) {
+        return &base;
+      }
     }
+    return nullptr;
+  };
+
+  auto out = Trace{};
+  for (const auto& [name, x] : trace) {
+    if (x->empty()) {
+      out[name] = x;
+      continue;
+    }
+    const auto& ts     = x->time_column();
+    const Column* base = find_base(ts);
+    if (base == nullptr) {
+      if (synchronized && !bases.empty()) {
+        throw std::invalid_argument(fmt::format(
+            "Signals in a synchronized trace must have the same number of samples, "
+            "but '{}' has {} samples instead of {}",
+            name,
+            ts.size(),
+            bases.front().size()));
+      }
+      // A time column that is already shared is used as is.
+      bases.push_back((ts.is_view()) ? ts : Column::view(ts.data(), ts.size(), x));
+      base = &bases.back();
+    }
+
+    const auto xs = x->values();
+    const auto ds = x->derivatives();
+    out[name]     = make_signal(
+        Column::view(xs.data(), xs.size(), x),
+        Column{*base},
+        Column::view(ds.data(), ds.size(), x));
   }
+  return out;
+}
 
-  if (const double t = xv.back().time; yv.back().time < t) {
-    yv.push_back(Sample{xv.back().time, yv.back().interpolate(t)});
+SignalPtr slice(const SignalPtr& x, double start, double end) {
+  if (x->empty() || (start <= x->begin_time() && x->end_time() <= end)) {
+    return x;
+  }
+  const double lo = std::max(start, x->begin_time());
+  const double hi = std::min(end, x->end_time());
+  if (hi < lo) {
+    return std::make_shared<Signal>();
   }
 
-  if (const double t = yv.back().time; xv.back().time < t) {
-    xv.push_back(Sample{yv.back().time, xv.back().interpolate(t)});
+  const auto ts = x->times();
+  const auto xs = x->values();
+  // The samples in [lo, hi] are the ones in [first, last).
+  const size_t first = std::lower_bound(ts.begin(), ts.end(), lo) - ts.begin();
+  const size_t last  = std::upper_bound(ts.begin(), ts.end(), hi) - ts.begin();
+
+  if (first < last && ts[first] == lo && ts[last - 1] == hi) {
+    const size_t n = last - first;
+    return make_signal(
+        Column::view(xs.data() + first, n, x), Column::view(ts.data() + first, n, x));
   }
 
-  return std::make_tuple(std::make_shared<Signal>(xv), std::make_shared<Signal>(yv));
+  auto times  = acquire_buffer(last - first + 2);
+  auto values = acquire_buffer(last - first + 2);
+  if (first == last || ts[first] > lo) {
+    times.push_back(lo);
+    values.push_back((*x)[first - 1].interpolate(lo));
+  }
+  times.insert(times.end(), ts.begin() + first, ts.begin() + last);
+  values.insert(values.end(), xs.begin() + first, xs.begin() + last);
+  if (times.back() < hi) {
+    times.push_back(hi);
+    values.push_back((*x)[last - 1].interpolate(hi));
+  }
+  return make_signal(std::move(values), std::move(times));
 }
 
 } // namespace signal_tl::signal
@@ -0,0 +1,406 @@
+#include "signal_tl/simplify.hpp"
+#include "signal_tl/ast.hpp"
+#include "signal_tl/internal/utils.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace signal_tl::ast {
+
+using utils::overloaded;
+
+namespace {
+
+/// Check if the robustness of the predicate is `x - c` (for `x > c` and `x >= c`),
+/// rather than `c - x`.
+bool is_lower_bound(ComparisonOp op) {
+  return op == ComparisonOp::GT || op == ComparisonOp::GE;
+}
+
+bool is_strict(ComparisonOp op) {
+  return op == ComparisonOp::GT || op == ComparisonOp::LT;
+}
+
+/// The negation of the predicate, whose robustness is the negated robustness.
+Predicate negate_predicate(const Predicate& e) {
+  switch (e.op) {
+    case ComparisonOp::GT:
+      return Predicate{e.name, ComparisonOp::LE, e.rhs};
+    case ComparisonOp::GE:
+      return Predicate{e.name, ComparisonOp::LT, e.rhs};
+    case ComparisonOp::LT:
+      return Predicate{e.name, ComparisonOp::GE, e.rhs};
+    case ComparisonOp::LE:
+      return Predicate{e.name, ComparisonOp::GT, e.rhs};
+  }
+  throw std::logic_error("Unknown comparison operator in predicate.");
+}
+
+/// Collapse two predicates over the same signal, in the same direction.
+///
+/// Their conjunction (`NodePtr = AndPtr`) is the tighter of the two, and their
+/// disjunction (`OrPtr`) is the looser one. If the bounds are equal, the robustness
+/// is the same, but the satisfaction at the bound isn't, so the strict comparison is
+/// kept for the conjunction.
+template <typename NodePtr>
+Predicate collapse(const Predicate& lhs, const Predicate& rhs) {
+  constexpr bool conjunction = std::is_same_v<NodePtr, AndPtr>;
+  if (lhs.rhs == rhs.rhs) {
+    return (is_strict(lhs.op) == conjunction) ? lhs : rhs;
+  }
+  const bool lhs_tighter = (lhs.rhs > rhs.rhs) == is_lower_bound(lhs.op);
+  return (lhs_tighter == conjunction) ? lhs : rhs;
+}
+
+bool is_point(const Interval& interval) {
+  const auto [a, b] = interval.as_double();
+  return b - a == 0;
+}
+
+/// Merge the intervals `[a, b]` and `[c, d]` of nested operators into `[a + c, b + d]`,
+/// keeping the type of the bounds if they are all integers.
+Interval add_intervals(const Interval& lhs, const Interval& rhs) {
+  using ULL     = unsigned long long int;
+  auto out      = Interval{};
+  const auto* a = std::get_if<ULL>(&lhs.low);
+  const auto* b = std::get_if<ULL>(&lhs.high);
+  const auto* c = std::get_if<ULL>(&rhs.low);
+  const auto* d = std::get_if<ULL>(&rhs.high);
+  if (a != nullptr && b != nullptr && c != nullptr && d != nullptr) {
+    out.low  = *a + *c;
+    out.high = *b + *d;
+  } else {
+    const auto [lhs_a, lhs_b] = lhs.as_double();
+    const auto [rhs_a, rhs_b] = rhs.as_double();
+    out.low                   = lhs_a + rhs_a;
+    out.high                  = lhs_b + rhs_b;
+  }
+  return out;
+}
+
+/// Check if two (simplified) expressions are the same, i.e., the same node, or equal
+/// leaves.
+bool same_expr(const Expr& lhs, const Expr& rhs) {
+  if (lhs.index() != rhs.index()) {
+    return false;
+  } else if (const auto* c = std::get_if<Const>(&lhs)) {
+    return *c == std::get<Const>(rhs);
+  } else if (const auto* p = std::get_if<Predicate>(&lhs)) {
+    return *p == std::get<Predicate>(rhs);
+  }
+  return node_address(lhs) == node_address(rhs);
+}
+
+bool same_operands(const std::vector<Expr>& lhs, const std::vector<Expr>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); i++) {
+    if (!same_expr(lhs[i], rhs[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Simplifies the subformulas of a formula, each distinct node once.
+///
+/// The results are memoized by the addresses of the nodes in the original formula, so
+/// a subformula that is shared in the original is simplified into a single node,
+/// shared by the same parents.
+class Simplifier {
+ public:
+  Simplifier(const Expr& phi, const SimplifyOptions& simplify_options) :
+      options{simplify_options} {
+    count_parents(phi);
+  }
+
+  /// The simplified expression.
+  Expr rewrite(const Expr& e) {
+    const void* node = node_address(e);
+    if (node == nullptr) {
+      return e;
+    } else if (auto it = simplified.find(node); it != simplified.end()) {
+      return it->second;
+    }
+
+    auto out = std::visit(
+        overloaded{
+            [&](const NotPtr& n) { return rewrite_negation(n->arg); },
+            [&](const AndPtr& n) { return reduce<AndPtr>(n, rewrite_all(n->args)); },
+            [&](const OrPtr& n) { return reduce<OrPtr>(n, rewrite_all(n->args)); },
+            [&](const AlwaysPtr& n) {
+              return temporal<AlwaysPtr>(n, rewrite(n->arg), n->interval);
+            },
+            [&](const EventuallyPtr& n) {
+              return temporal<EventuallyPtr>(n, rewrite(n->arg), n->interval);
+            },
+            [&](const UntilPtr& n) {
+              return until(
+                  n, rewrite(n->args.first), rewrite(n->args.second), n->interval);
+            },
+            [&](const auto&) { return e; }},
+        e);
+    return memoize(simplified, node, std::move(out));
+  }
+
+  /// The simplified negation of the expression.
+  Expr rewrite_negation(const Expr& e) {
+    if (const auto* c = std::get_if<Const>(&e)) {
+      return Const{!c->value};
+    } else if (const auto* p = std::get_if<Predicate>(&e)) {
+      return negate_predicate(*p);
+    }
+    const void* node = node_address(e);
+    if (auto it = negated.find(node); it != negated.end()) {
+      return it->second;
+    }
+
+    auto out = Expr{};
+    if (const auto* arg = std::get_if<NotPtr>(&e)) {
+      out = rewrite((*arg)->arg);
+    } else if (!absorbs_negation(e)) {
+      out = make_not(rewrite(e));
+    } else {
+      out = std::visit(
+          overloaded{
+              [&](const AndPtr& n) {
+                return reduce<OrPtr>(nullptr, rewrite_all_negations(n->args));
+              },
+              [&](const OrPtr& n) {
+                return reduce<AndPtr>(nullptr, rewrite_all_negations(n->args));
+              },
+              [&](const AlwaysPtr& n) {
+                return temporal<EventuallyPtr>(
+                    nullptr, rewrite_negation(n->arg), n->interval);
+              },
+              [&](const EventuallyPtr& n) {
+                return temporal<AlwaysPtr>(
+                    nullptr, rewrite_negation(n->arg), n->interval);
+              },
+              [&](const auto&) { return make_not(rewrite(e)); }},
+          e);
+    }
+    return memoize(negated, node, std::move(out));
+  }
+
+ private:
+  SimplifyOptions options;
+  /// The number of parents of each node in the original formula.
+  std::unordered_map<const void*, size_t> parents;
+  std::unordered_map<const void*, Expr> simplified;
+  std::unordered_map<const void*, Expr> negated;
+  std::unordered_map<const void*, bool> absorbing;
+  /// The nodes in the simplified formula that (may) have more than one parent.
+  std::unordered_set<const void*> shared;
+
+  void count_parents(const Expr& e) {
+    const void* node = node_address(e);
+    if (node == nullptr || parents[node]++ > 0) {
+      return;
+    }
+    std::visit(
+        overloaded{
+            [&](const NotPtr& n) { count_parents(n->arg); },
+            [&](const AndPtr& n) {
+              for (const auto& arg : n->args) { count_parents(arg); }
+            },
+            [&](const OrPtr& n) {
+              for (const auto& arg : n->args) { count_parents(arg); }
+            },
+            [&](const AlwaysPtr& n) { count_parents(n->arg); },
+            [&](const EventuallyPtr& n) { count_parents(n->arg); },
+            [&](const UntilPtr& n) {
+              count_parents(n->args.first);
+              count_parents(n->args.second);
+            },
+            [](const auto&) {}},
+        e);
+  }
+
+  Expr memoize(
+      std::unordered_map<const void*, Expr>& results,
+      const void* node,
+      Expr out) {
+    if (parents[node] > 1) {
+      shared.insert(node_address(out));
+    }
+    results.emplace(node, out);
+    return out;
+  }
+
+  std::vector<Expr> rewrite_all(const std::vector<Expr>& args) {
+    auto out = std::vector<Expr>{};
+    out.reserve(args.size());
+    for (const auto& arg : args) { out.push_back(rewrite(arg)); }
+    return out;
+  }
+
+  std::vector<Expr> rewrite_all_negations(const std::vector<Expr>& args) {
+    auto out = std::vector<Expr>{};
+    out.reserve(args.size());
+    for (const auto& arg : args) { out.push_back(rewrite_negation(arg)); }
+    return out;
+  }
+
+  /// Check if the negation of the (original) expression can be pushed down to its
+  /// leaves without adding negations anywhere, i.e., if they are all constants,
+  /// predicates, or negations, and the nodes on the way aren't shared (so they would
+  /// be evaluated anyway).
+  bool absorbs_negation(const Expr& e) {
+    if (std::holds_alternative<Const>(e) || std::holds_alternative<Predicate>(e) ||
+        std::holds_alternative<NotPtr>(e)) {
+      return true;
+    }
+    const void* node = node_address(e);
+    if (parents[node] > 1) {
+      return false;
+    } else if (auto it = absorbing.find(node); it != absorbing.end()) {
+      return it->second;
+    }
+
+    const auto all_absorb = [&](const std::vector<Expr>& args) {
+      for (const auto& arg : args) {
+        if (!absorbs_negation(arg)) {
+          return false;
+        }
+      }
+      return true;
+    };
+    const bool out = std::visit(
+        overloaded{
+            [&](const AndPtr& n) { return all_absorb(n->args); },
+            [&](const OrPtr& n) { return all_absorb(n->args); },
+            [&](const AlwaysPtr& n) { return absorbs_negation(n->arg); },
+            [&](const EventuallyPtr& n) { return absorbs_negation(n->arg); },
+            [](const auto&) { return false; }},
+        e);
+    absorbing.emplace(node, out);
+    return out;
+  }
+
+  /// Negate a simplified expression.
+  static Expr make_not(const Expr& arg) {
+    if (const auto* c = std::get_if<Const>(&arg)) {
+      return Const{!c->value};
+    } else if (const auto* p = std::get_if<Predicate>(&arg)) {
+      return negate_predicate(*p);
+    } else if (const auto* n = std::get_if<NotPtr>(&arg)) {
+      return (*n)->arg;
+    }
+    return make_node<Not>(arg);
+  }
+
+  /// Build a conjunction (`NodePtr = AndPtr`) or disjunction (`OrPtr`) of simplified
+  /// operands, or reuse the `original` node if its operands didn't change.
+  template <typename NodePtr>
+  Expr reduce(const NodePtr& original, const std::vector<Expr>& operands) {
+    using Node          = typename NodePtr::element_type;
+    const bool identity = std::is_same_v<NodePtr, AndPtr>;
+
+    auto args     = std::vector<Expr>{};
+    auto absorbed = std::optional<Const>{};
+    auto nodes    = std::unordered_set<const void*>{};
+    // The index of the predicate over each signal, for each direction.
+    auto lower_bounds = std::unordered_map<Symbol, size_t>{};
+    auto upper_bounds = std::unordered_map<Symbol, size_t>{};
+
+    const auto add = [&](const Expr& arg) {
+      if (const auto* c = std::get_if<Const>(&arg)) {
+        if (c->value != identity) {
+          absorbed = *c;
+        }
+      } else if (const auto* p = std::get_if<Predicate>(&arg)) {
+        auto& index = is_lower_bound(p->op) ? lower_bounds : upper_bounds;
+        if (auto it = index.find(p->name); it != index.end()) {
+          args[it->second] =
+              collapse<NodePtr>(std::get<Predicate>(args[it->second]), *p);
+        } else {
+          index.emplace(p->name, args.size());
+          args.push_back(*p);
+        }
+      } else if (nodes.insert(node_address(arg)).second) {
+        args.push_back(arg);
+      }
+    };
+
+    for (const auto& arg : operands) {
+      // The operands of the nested nodes are already simplified, and are flattened
+      // into this node unless the nested node is needed on its own.
+      const auto* nested = std::get_if<NodePtr>(&arg);
+      if (nested != nullptr && shared.count(nested->get()) == 0) {
+        for (const auto& nested_arg : (*nested)->args) { add(nested_arg); }
+      } else {
+        add(arg);
+      }
+      if (absorbed.has_value()) {
+        return *absorbed;
+      }
+    }
+
+    if (args.empty()) {
+      return Const{identity};
+    } else if (args.size() == 1) {
+      return args.front();
+    } else if (original != nullptr && same_operands(original->args, args)) {
+      return original;
+    }
+    return make_node<Node>(std::move(args));
+  }
+
+  /// Build an `Always` or `Eventually` node over a simplified operand.
+  template <typename NodePtr>
+  Expr temporal(const NodePtr& original, const Expr& arg, const Interval& interval) {
+    using Node = typename NodePtr::element_type;
+    if (std::holds_alternative<Const>(arg)) {
+      return arg;
+    } else if (options.classic) {
+      // A point interval is evaluated as the operand itself.
+      if (is_point(interval)) {
+        return arg;
+      } else if (const auto* nested = std::get_if<NodePtr>(&arg)) {
+        return make_node<Node>(
+            (*nested)->arg, add_intervals(interval, (*nested)->interval));
+      }
+    }
+    if (original != nullptr && same_expr(original->arg, arg)) {
+      return original;
+    }
+    return make_node<Node>(arg, interval);
+  }
+
+  /// Build an `Until` node over simplified operands.
+  Expr until(
+      const UntilPtr& original,
+      const Expr& lhs,
+      const Expr& rhs,
+      const Interval& interval) {
+    const auto* lhs_const = std::get_if<Const>(&lhs);
+    const auto* rhs_const = std::get_if<Const>(&rhs);
+    if ((lhs_const != nullptr && !lhs_const->value) ||
+        (rhs_const != nullptr && !rhs_const->value)) {
+      return Const{false};
+    } else if (lhs_const != nullptr && options.classic) {
+      return temporal<EventuallyPtr>(nullptr, rhs, interval);
+    } else if (
+        same_expr(original->args.first, lhs) && same_expr(original->args.second, rhs)) {
+      return original;
+    }
+    return make_node<Until>(lhs, rhs, interval);
+  }
+};
+
+} // namespace
+
+Expr simplify(const Expr& phi, const SimplifyOptions& options) {
+  return Simplifier{phi, options}.rewrite(phi);
+}
+
+} // namespace signal_tl::ast
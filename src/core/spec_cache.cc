@@ -0,0 +1,453 @@
+#include "signal_tl/spec_cache.hpp"
+#include "signal_tl/ast.hpp"
+#include "signal_tl/internal/utils.hpp" // for overloaded
+
+#include <array>         // for array
+#include <cstring>       // for memcpy
+#include <fmt/format.h>  // for format
+#include <fstream>       // for ifstream, ofstream
+#include <iterator>      // for istreambuf_iterator
+#include <map>           // for map
+#include <memory>        // for make_unique
+#include <random>        // for random_device
+#include <stdexcept>     // for invalid_argument, runtime_error
+#include <system_error>  // for error_code
+#include <unordered_map> // for unordered_map
+#include <utility>       // for move, pair
+#include <variant>       // for visit, get_if, variant_size_v
+#include <vector>        // for vector
+
+namespace signal_tl {
+using ast::Expr;
+using ast::Interval;
+
+namespace {
+
+#ifndef SIGNALTL_LIBRARY_VERSION
+#define SIGNALTL_LIBRARY_VERSION "unknown"
+#endif
+
+constexpr std::array<char, 8> MAGIC = {'S', 'T', 'L', 'S', 'P', 'E', 'C', '\0'};
+constexpr uint32_t VERSION          = 2;
+
+/// The version of the AST, which must be changed whenever the formulas parsed from a
+/// source may change (e.g., the nodes or the meaning of their fields).
+constexpr uint32_t AST_VERSION = 1;
+// Adding a node to the AST changes the format of the nodes, too.
+static_assert(std::variant_size_v<Expr> == 8, "Update the node kinds and AST_VERSION");
+
+struct Header {
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t ast_version;
+  uint64_t library_hash;
+  uint64_t source_hash;
+  uint64_t num_nodes;
+  uint64_t num_formulas;
+  uint64_t num_assertions;
+};
+
+static_assert(sizeof(Header) == 56);
+
+/// The hash of the version of the library that writes (and reads) the caches.
+uint64_t library_hash() {
+  static const uint64_t hash = hash_source(SIGNALTL_LIBRARY_VERSION);
+  return hash;
+}
+
+/// The kind of each node, in the order of the alternatives of `Expr`.
+enum class Kind : uint8_t { Const, Predicate, Not, And, Or, Always, Eventually, Until };
+
+/// The kind of each bound of an interval.
+enum class Bound : uint8_t { Integer, Real };
+
+class Writer {
+ public:
+  template <typename T>
+  void put(const T& value) {
+    const auto offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+  }
+
+  void put_string(const std::string& s) {
+    put(static_cast<uint64_t>(s.size()));
+    out.append(s);
+  }
+
+  void put_bound(const Interval::Num& bound) {
+    if (const auto* integer = std::get_if<unsigned long long int>(&bound)) {
+      put(Bound::Integer);
+      put(static_cast<uint64_t>(*integer));
+    } else {
+      put(Bound::Real);
+      put(std::get<double>(bound));
+    }
+  }
+
+  void put_interval(const Interval& interval) {
+    put_bound(interval.low);
+    put_bound(interval.high);
+  }
+
+  std::string out;
+};
+
+class Reader {
+ public:
+  explicit Reader(std::string_view bytes) : data{bytes} {}
+
+  template <typename T>
+  T get() {
+    if (sizeof(T) > data.size() - pos) {
+      throw std::invalid_argument("Truncated specification cache");
+    }
+    auto value = T{};
+    std::memcpy(&value, data.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+  }
+
+  std::string get_string() {
+    const auto size = get<uint64_t>();
+    if (size > data.size() - pos) {
+      throw std::invalid_argument("Truncated specification cache");
+    }
+    auto s = std::string{data.substr(pos, size)};
+    pos += size;
+    return s;
+  }
+
+  Interval::Num get_bound() {
+    switch (get<Bound>()) {
+      case Bound::Integer:
+        return static_cast<unsigned long long int>(get<uint64_t>());
+      case Bound::Real:
+        return get<double>();
+    }
+    throw std::invalid_argument("Invalid interval in specification cache");
+  }
+
+  Interval get_interval() {
+    // Not using the constructors, as the bounds may have different types.
+    auto interval = Interval{};
+    interval.low  = get_bound();
+    interval.high = get_bound();
+    return interval;
+  }
+
+  [[nodiscard]] bool done() const {
+    return pos == data.size();
+  }
+
+ private:
+  std::string_view data;
+  size_t pos = 0;
+};
+
+/// Get the operands of the node.
+std::vector<const Expr*> operands_of(const Expr& e) {
+  return std::visit(
+      utils::overloaded{
+          [](const ast::Const&) { return std::vector<const Expr*>{}; },
+          [](const ast::Predicate&) { return std::vector<const Expr*>{}; },
+          [](const ast::NotPtr& n) { return std::vector<const Expr*>{&n->arg}; },
+          [](const ast::AndPtr& n) {
+            auto out = std::vector<const Expr*>{};
+            for (const auto& arg : n->args) { out.push_back(&arg); }
+            return out;
+          },
+          [](const ast::OrPtr& n) {
+            auto out = std::vector<const Expr*>{};
+            for (const auto& arg : n->args) { out.push_back(&arg); }
+            return out;
+          },
+          [](const ast::AlwaysPtr& n) { return std::vector<const Expr*>{&n->arg}; },
+          [](const ast::EventuallyPtr& n) { return std::vector<const Expr*>{&n->arg}; },
+          [](const ast::UntilPtr& n) {
+            return std::vector<const Expr*>{&n->args.first, &n->args.second};
+          }},
+      e);
+}
+
+/// Writes the distinct nodes of the formulas in post-order.
+class NodeTable {
+ public:
+  /// Add the formula (and its operands) to the table, and return the index of its
+  /// root node.
+  ///
+  /// This walks the formula with an explicit stack, as formulas that are built on
+  /// other formulas can be (much) deeper than the call stack allows.
+  uint64_t add(const Expr& root) {
+    if (ast::node_address(root) == nullptr) {
+      return put_node(root);
+    }
+    auto stack = std::vector<std::pair<const Expr*, bool>>{{&root, false}};
+    while (!stack.empty()) {
+      const auto [e, expanded] = stack.back();
+      if (indices.count(ast::node_address(*e)) > 0) {
+        stack.pop_back();
+      } else if (!expanded) {
+        stack.back().second = true;
+        const auto args     = operands_of(*e);
+        for (auto it = args.rbegin(); it != args.rend(); it++) {
+          const void* addr = ast::node_address(**it);
+          if (addr != nullptr && indices.count(addr) == 0) {
+            stack.emplace_back(*it, false);
+          }
+        }
+      } else {
+        indices.emplace(ast::node_address(*e), put_node(*e));
+        stack.pop_back();
+      }
+    }
+    return indices.at(ast::node_address(root));
+  }
+
+  [[nodiscard]] uint64_t size() const {
+    return count;
+  }
+
+  Writer writer;
+
+ private:
+  /// Get the index of an operand, adding it if it is a leaf (leaves are not shared).
+  uint64_t index_of(const Expr& e) {
+    const void* addr = ast::node_address(e);
+    return (addr == nullptr) ? put_node(e) : indices.at(addr);
+  }
+
+  /// Write the node, whose operands are already in the table.
+  uint64_t put_node(const Expr& e) {
+    // The indices of the leaf operands are taken before writing the node.
+    auto args = std::vector<uint64_t>{};
+    for (const auto* arg : operands_of(e)) { args.push_back(index_of(*arg)); }
+
+    auto& w = writer;
+    w.put(static_cast<Kind>(e.index()));
+    std::visit(
+        utils::overloaded{
+            [&](const ast::Const& n) { w.put(static_cast<uint8_t>(n.value)); },
+            [&](const ast::Predicate& n) {
+              w.put_string(n.name);
+              w.put(static_cast<uint8_t>(n.op));
+              w.put(n.rhs);
+            },
+            [&](const ast::AndPtr&) { w.put(static_cast<uint64_t>(args.size())); },
+            [&](const ast::OrPtr&) { w.put(static_cast<uint64_t>(args.size())); },
+            [&](const ast::AlwaysPtr& n) { w.put_interval(n->interval); },
+            [&](const ast::EventuallyPtr& n) { w.put_interval(n->interval); },
+            [&](const ast::UntilPtr& n) { w.put_interval(n->interval); },
+            [&](const ast::NotPtr&) {}},
+        e);
+    for (const uint64_t arg : args) { w.put(arg); }
+    return count++;
+  }
+
+  std::unordered_map<const void*, uint64_t> indices;
+  uint64_t count = 0;
+};
+
+Header read_header(Reader& in) {
+  const auto header = in.get<Header>();
+  if (header.magic != MAGIC) {
+    throw std::invalid_argument("Not a specification cache");
+  }
+  if (header.version != VERSION) {
+    throw std::invalid_argument(fmt::format(
+        "Unsupported specification cache version {} (expected {})",
+        header.version,
+        VERSION));
+  }
+  if (header.ast_version != AST_VERSION || header.library_hash != library_hash()) {
+    throw std::invalid_argument(
+        "Specification cache was written by another version of the library");
+  }
+  return header;
+}
+
+} // namespace
+
+uint64_t hash_source(std::string_view source) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const char c : source) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+std::string serialize_specification(const Specification& spec, uint64_t source_hash) {
+  auto nodes = NodeTable{};
+  auto roots = std::vector<std::pair<const std::string*, uint64_t>>{};
+  for (const auto* table : {&spec.formulas, &spec.assertions}) {
+    for (const auto& [name, phi] : *table) {
+      roots.emplace_back(&name, nodes.add(phi));
+    }
+  }
+
+  auto header           = Header{};
+  header.magic          = MAGIC;
+  header.version        = VERSION;
+  header.ast_version    = AST_VERSION;
+  header.library_hash   = library_hash();
+  header.source_hash    = source_hash;
+  header.num_nodes      = nodes.size();
+  header.num_formulas   = spec.formulas.size();
+  header.num_assertions = spec.assertions.size();
+
+  auto out = Writer{};
+  out.put(header);
+  out.out.append(nodes.writer.out);
+  for (const auto& [name, root] : roots) {
+    out.put_string(*name);
+    out.put(root);
+  }
+  return std::move(out.out);
+}
+
+uint64_t serialized_source_hash(std::string_view data) {
+  auto in = Reader{data};
+  return read_header(in).source_hash;
+}
+
+std::unique_ptr<Specification> deserialize_specification(std::string_view data) {
+  auto in           = Reader{data};
+  const auto header = read_header(in);
+
+  auto nodes = std::vector<Expr>{};
+  // Each node takes at least one byte.
+  if (header.num_nodes > data.size()) {
+    throw std::invalid_argument("Truncated specification cache");
+  }
+  nodes.reserve(header.num_nodes);
+  const auto arg = [&]() -> const Expr& {
+    const auto i = in.get<uint64_t>();
+    if (i >= nodes.size()) {
+      throw std::invalid_argument("Invalid operand in specification cache");
+    }
+    return nodes[i];
+  };
+  for (uint64_t i = 0; i < header.num_nodes; i++) {
+    const auto kind = in.get<Kind>();
+    switch (kind) {
+      case Kind::Const:
+        nodes.emplace_back(ast::Const{in.get<uint8_t>() != 0});
+        break;
+      case Kind::Predicate: {
+        auto name     = in.get_string();
+        const auto op = in.get<uint8_t>();
+        if (op > static_cast<uint8_t>(ast::ComparisonOp::LE)) {
+          throw std::invalid_argument("Invalid predicate in specification cache");
+        }
+        const auto rhs = in.get<double>();
+        nodes.emplace_back(
+            ast::Predicate{std::move(name), static_cast<ast::ComparisonOp>(op), rhs});
+        break;
+      }
+      case Kind::Not:
+        nodes.emplace_back(ast::make_node<ast::Not>(arg()));
+        break;
+      case Kind::And:
+      case Kind::Or: {
+        const auto n = in.get<uint64_t>();
+        if (n > data.size()) {
+          throw std::invalid_argument("Truncated specification cache");
+        }
+        auto args = std::vector<Expr>{};
+        args.reserve(n);
+        for (uint64_t k = 0; k < n; k++) { args.push_back(arg()); }
+        if (kind == Kind::And) {
+          nodes.emplace_back(ast::make_node<ast::And>(std::move(args)));
+        } else {
+          nodes.emplace_back(ast::make_node<ast::Or>(std::move(args)));
+        }
+        break;
+      }
+      case Kind::Always: {
+        const auto interval = in.get_interval();
+        nodes.emplace_back(ast::make_node<ast::Always>(arg(), interval));
+        break;
+      }
+      case Kind::Eventually: {
+        const auto interval = in.get_interval();
+        nodes.emplace_back(ast::make_node<ast::Eventually>(arg(), interval));
+        break;
+      }
+      case Kind::Until: {
+        const auto interval = in.get_interval();
+        const auto& lhs     = arg();
+        nodes.emplace_back(ast::make_node<ast::Until>(lhs, arg(), interval));
+        break;
+      }
+      default:
+        throw std::invalid_argument("Invalid node in specification cache");
+    }
+  }
+
+  auto spec = std::make_unique<Specification>();
+  for (uint64_t i = 0; i < header.num_formulas + header.num_assertions; i++) {
+    auto name   = in.get_string();
+    auto& table = (i < header.num_formulas) ? spec->formulas : spec->assertions;
+    table.emplace(std::move(name), arg());
+  }
+  if (!in.done()) {
+    throw std::invalid_argument("Trailing data in specification cache");
+  }
+  return spec;
+}
+
+void write_spec_cache(
+    const stdfs::path& path,
+    const Specification& spec,
+    uint64_t source_hash) {
+  const auto data = serialize_specification(spec, source_hash);
+
+  // Write to a temporary file first, and then replace the cache with it, so that
+  // concurrent readers (and writers, e.g., the shards of a batch) never see a partial
+  // file.
+  const auto tmp = stdfs::path{
+      path.string() + fmt::format(".{:08x}.tmp", std::random_device{}())};
+  {
+    auto out = std::ofstream{tmp, std::ios::binary | std::ios::trunc};
+    if (!out) {
+      throw std::runtime_error(
+          fmt::format("Unable to open specification cache: {}", path.string()));
+    }
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    out.close();
+    if (!out) {
+      auto ec = std::error_code{};
+      stdfs::remove(tmp, ec);
+      throw std::runtime_error(
+          fmt::format("Unable to write specification cache: {}", path.string()));
+    }
+  }
+  auto ec = std::error_code{};
+  stdfs::rename(tmp, path, ec);
+  if (ec) {
+    stdfs::remove(tmp, ec);
+    throw std::runtime_error(
+        fmt::format("Unable to write specification cache: {}", path.string()));
+  }
+}
+
+std::unique_ptr<Specification>
+read_spec_cache(const stdfs::path& path, uint64_t source_hash) {
+  auto in = std::ifstream{path, std::ios::binary};
+  if (!in) {
+    return nullptr;
+  }
+  const auto data =
+      std::string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+  try {
+    if (serialized_source_hash(data) != source_hash) {
+      return nullptr;
+    }
+    return deserialize_specification(data);
+  } catch (const std::invalid_argument&) {
+    return nullptr;
+  }
+}
+
+} // namespace signal_tl
@@ -0,0 +1,59 @@
+#include "signal_tl/symbol.hpp"
+
+#include <deque>         // for deque
+#include <mutex>         // for unique_lock
+#include <shared_mutex>  // for shared_mutex, shared_lock
+#include <unordered_map> // for unordered_map
+
+namespace signal_tl {
+
+namespace {
+
+class SymbolTable {
+ public:
+  const std::string* intern(std::string_view name) {
+    {
+      const auto lock = std::shared_lock{mutex};
+      if (const auto it = index.find(name); it != index.end()) {
+        return it->second;
+      }
+    }
+    const auto lock = std::unique_lock{mutex};
+    if (const auto it = index.find(name); it != index.end()) {
+      return it->second;
+    }
+    // The strings in a deque don't move when more are added, so the views into them
+    // (and the symbols) stay valid.
+    const auto& stored = strings.emplace_back(name);
+    index.emplace(std::string_view{stored}, &stored);
+    return &stored;
+  }
+
+  size_t size() const {
+    const auto lock = std::shared_lock{mutex};
+    return strings.size();
+  }
+
+ private:
+  mutable std::shared_mutex mutex;
+  std::deque<std::string> strings;
+  std::unordered_map<std::string_view, const std::string*> index;
+};
+
+SymbolTable& symbol_table() {
+  // Never destroyed, so that symbols held by static objects stay valid.
+  static auto* table = new SymbolTable{};
+  return *table;
+}
+
+} // namespace
+
+Symbol::Symbol() : Symbol{std::string_view{}} {}
+
+Symbol::Symbol(std::string_view name) : interned{symbol_table().intern(name)} {}
+
+size_t Symbol::count() {
+  return symbol_table().size();
+}
+
+} // namespace signal_tl
@@ -0,0 +1,383 @@
+#include "signal_tl/trace_file.hpp"
+#include "signal_tl/fmt.hpp" // IWYU pragma: keep
+
+#include <algorithm>    // for equal
+#include <array>        // for array
+#include <cstring>      // for memcpy
+#include <fmt/format.h> // for format
+#include <fstream>      // for ofstream
+#include <limits>       // for numeric_limits
+#include <memory>       // for shared_ptr, make_shared
+#include <set>          // for set
+#include <stdexcept>    // for invalid_argument, out_of_range, runtime_error
+#include <string>       // for string
+#include <vector>       // for vector
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h> // for CreateFileW, CreateFileMappingW, MapViewOfFile
+#else
+#include <fcntl.h>    // for open, O_RDONLY
+#include <sys/mman.h> // for mmap, munmap
+#include <sys/stat.h> // for fstat
+#include <unistd.h>   // for close
+#endif
+
+namespace signal_tl::signal {
+
+namespace {
+
+constexpr std::array<char, 8> MAGIC = {'S', 'T', 'L', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t VERSION          = 1;
+
+struct Header {
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t num_time_bases;
+  uint32_t num_channels;
+  uint32_t reserved;
+};
+
+struct TimeBaseEntry {
+  uint64_t offset;
+  uint64_t size;
+};
+
+struct ChannelEntry {
+  uint64_t name_offset;
+  uint64_t name_size;
+  uint64_t time_base;
+  uint64_t values;
+  uint64_t derivatives;
+};
+
+static_assert(sizeof(Header) == 24);
+static_assert(sizeof(TimeBaseEntry) == 16);
+static_assert(sizeof(ChannelEntry) == 40);
+
+constexpr uint64_t align(uint64_t offset) {
+  return (offset + 7) & ~uint64_t{7};
+}
+
+} // namespace
+
+/// The read-only mapping of the whole file.
+struct TraceFile::Mapping {
+  const unsigned char* data = nullptr;
+  size_t size               = 0;
+#if defined(_WIN32)
+  HANDLE file    = INVALID_HANDLE_VALUE;
+  HANDLE mapping = nullptr;
+#endif
+
+  explicit Mapping(const stdfs::path& path);
+  ~Mapping();
+
+  Mapping(const Mapping&)            = delete;
+  Mapping& operator=(const Mapping&) = delete;
+
+  /// Check if `count` objects of `width` bytes starting at `offset` are in the file.
+  [[nodiscard]] bool contains(uint64_t offset, uint64_t count, uint64_t width) const {
+    return offset <= size && count <= (size - offset) / width;
+  }
+
+  template <typename T>
+  [[nodiscard]] T read(uint64_t offset) const {
+    if (!contains(offset, 1, sizeof(T))) {
+      throw std::invalid_argument("Truncated trace file");
+    }
+    auto out = T{};
+    std::memcpy(&out, data + offset, sizeof(T));
+    return out;
+  }
+
+  [[nodiscard]] const double* column(uint64_t offset) const {
+    // The offsets are checked when the file is opened.
+    return reinterpret_cast<const double*>(data + offset); // NOLINT
+  }
+};
+
+#if defined(_WIN32)
+
+TraceFile::Mapping::Mapping(const stdfs::path& path) {
+  file = CreateFileW(
+      path.c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error(
+        fmt::format("Unable to open trace file: {}", path.string()));
+  }
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size)) {
+    CloseHandle(file);
+    throw std::runtime_error(
+        fmt::format("Unable to get the size of trace file: {}", path.string()));
+  }
+  size = static_cast<size_t>(file_size.QuadPart);
+  if (size == 0) {
+    return;
+  }
+  mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  const void* view =
+      (mapping != nullptr) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (view == nullptr) {
+    if (mapping != nullptr) {
+      CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    throw std::runtime_error(
+        fmt::format("Unable to map trace file: {}", path.string()));
+  }
+  data = static_cast<const unsigned char*>(view);
+}
+
+TraceFile::Mapping::~Mapping() {
+  if (data != nullptr) {
+    UnmapViewOfFile(data);
+  }
+  if (mapping != nullptr) {
+    CloseHandle(mapping);
+  }
+  CloseHandle(file);
+}
+
+#else
+
+TraceFile::Mapping::Mapping(const stdfs::path& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY); // NOLINT
+  if (fd < 0) {
+    throw std::runtime_error(
+        fmt::format("Unable to open trace file: {}", path.string()));
+  }
+  struct stat info = {};
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error(
+        fmt::format("Unable to get the size of trace file: {}", path.string()));
+  }
+  size = static_cast<size_t>(info.st_size);
+  if (size > 0) {
+    void* view = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) { // NOLINT
+      ::close(fd);
+      throw std::runtime_error(
+          fmt::format("Unable to map trace file: {}", path.string()));
+    }
+    data = static_cast<const unsigned char*>(view);
+  }
+  // The mapping stays valid after the file is closed.
+  ::close(fd);
+}
+
+TraceFile::Mapping::~Mapping() {
+  if (data != nullptr) {
+    ::munmap(const_cast<unsigned char*>(data), size); // NOLINT
+  }
+}
+
+#endif
+
+TraceFile::TraceFile(const stdfs::path& path) {
+  auto map = std::make_shared<Mapping>(path);
+
+  const auto header = map->read<Header>(0);
+  if (header.magic != MAGIC) {
+    throw std::invalid_argument(
+        fmt::format("Not a trace file (bad magic number): {}", path.string()));
+  }
+  if (header.version != VERSION) {
+    throw std::invalid_argument(fmt::format(
+        "Unsupported trace file version {} (expected {}): {}",
+        header.version,
+        VERSION,
+        path.string()));
+  }
+
+  const auto check_column = [&](uint64_t offset, uint64_t size) {
+    if (offset % alignof(double) != 0 || !map->contains(offset, size, sizeof(double))) {
+      throw std::invalid_argument(
+          fmt::format("Invalid column in trace file: {}", path.string()));
+    }
+  };
+
+  uint64_t offset = sizeof(Header);
+  time_bases.reserve(header.num_time_bases);
+  for (uint32_t i = 0; i < header.num_time_bases; i++) {
+    const auto entry = map->read<TimeBaseEntry>(offset);
+    check_column(entry.offset, entry.size);
+    time_bases.push_back({entry.offset, entry.size});
+    offset += sizeof(TimeBaseEntry);
+  }
+
+  for (uint32_t i = 0; i < header.num_channels; i++) {
+    const auto entry = map->read<ChannelEntry>(offset);
+    offset += sizeof(ChannelEntry);
+    if (entry.time_base >= time_bases.size() ||
+        !map->contains(entry.name_offset, entry.name_size, 1)) {
+      throw std::invalid_argument(
+          fmt::format("Invalid channel in trace file: {}", path.string()));
+    }
+    const auto size = time_bases[entry.time_base].size;
+    check_column(entry.values, size);
+    check_column(entry.derivatives, size);
+
+    auto name = std::string{
+        reinterpret_cast<const char*>(map->data + entry.name_offset), // NOLINT
+        entry.name_size};
+    const auto [it, inserted] = channel_table.emplace(
+        std::move(name),
+        Channel{static_cast<size_t>(entry.time_base), entry.values, entry.derivatives});
+    if (!inserted) {
+      throw std::invalid_argument(fmt::format(
+          "Duplicate channel `{}` in trace file: {}", it->first, path.string()));
+    }
+  }
+
+  mapping = std::move(map);
+}
+
+std::vector<std::string> TraceFile::channels() const {
+  auto out = std::vector<std::string>{};
+  out.reserve(channel_table.size());
+  for (const auto& [name, _] : channel_table) { out.push_back(name); }
+  return out;
+}
+
+bool TraceFile::contains(std::string_view name) const {
+  return channel_table.find(name) != channel_table.end();
+}
+
+SignalPtr TraceFile::signal(std::string_view name) const {
+  const auto it = channel_table.find(name);
+  if (it == channel_table.end()) {
+    throw std::out_of_range(fmt::format("No channel named `{}` in the trace", name));
+  }
+  const auto& channel = it->second;
+  const auto& times   = time_bases[channel.time_base];
+  const auto n        = static_cast<size_t>(times.size);
+
+  auto sig            = std::make_shared<Signal>();
+  sig->time_col       = Column::view(mapping->column(times.offset), n, mapping);
+  sig->value_col      = Column::view(mapping->column(channel.values), n, mapping);
+  sig->derivative_col = Column::view(mapping->column(channel.derivatives), n, mapping);
+  return sig;
+}
+
+Trace TraceFile::trace() const {
+  auto out = Trace{};
+  for (const auto& [name, _] : channel_table) { out.emplace(name, signal(name)); }
+  return out;
+}
+
+Trace TraceFile::trace(const std::vector<std::string>& names) const {
+  auto out = Trace{};
+  for (const auto& name : names) { out.emplace(name, signal(name)); }
+  return out;
+}
+
+Trace TraceFile::trace(const ast::Expr& phi) const {
+  auto out = Trace{};
+  for (const auto& name : ast::signal_names(phi)) { out.emplace(name, signal(name)); }
+  return out;
+}
+
+void write_trace_file(const stdfs::path& path, const Trace& trace) {
+  // Find the distinct time bases, so that the channels with the same time points
+  // share them.
+  auto bases        = std::vector<const Signal*>{};
+  auto channel_base = std::vector<uint64_t>{};
+  for (const auto& [name, sig] : trace) {
+    const auto ts = sig->times();
+    uint64_t base = 0;
+    for (; base < bases.size(); base++) {
+      const auto other = bases[base]->times();
+      if (other.size() == ts.size() &&
+          (other.data() == ts.data() ||
+           std::equal(ts.begin(), ts.end(), other.begin()))) {
+        break;
+      }
+    }
+    if (base == bases.size()) {
+      bases.push_back(sig.get());
+    }
+    channel_base.push_back(base);
+  }
+  if (bases.size() > std::numeric_limits<uint32_t>::max() ||
+      trace.size() > std::numeric_limits<uint32_t>::max()) {
+    throw std::invalid_argument("Too many channels to write to a trace file");
+  }
+
+  // Lay out the file.
+  uint64_t offset = sizeof(Header) + bases.size() * sizeof(TimeBaseEntry) +
+                    trace.size() * sizeof(ChannelEntry);
+  auto channels = std::vector<ChannelEntry>{};
+  for (const auto& [name, sig] : trace) {
+    channels.push_back({offset, name.size(), channel_base[channels.size()], 0, 0});
+    offset += name.size();
+  }
+  offset = align(offset);
+
+  auto time_entries = std::vector<TimeBaseEntry>{};
+  for (const auto* sig : bases) {
+    time_entries.push_back({offset, sig->size()});
+    offset += sig->size() * sizeof(double);
+  }
+  {
+    auto entry = channels.begin();
+    for (const auto& [name, sig] : trace) {
+      entry->values = offset;
+      offset += sig->size() * sizeof(double);
+      entry->derivatives = offset;
+      offset += sig->size() * sizeof(double);
+      entry++;
+    }
+  }
+
+  auto out = std::ofstream{path, std::ios::binary | std::ios::trunc};
+  if (!out) {
+    throw std::runtime_error(
+        fmt::format("Unable to open trace file for writing: {}", path.string()));
+  }
+  const auto write = [&out](const void* data, size_t size) {
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+  };
+  const auto write_column = [&](utils::span<const double> col) {
+    write(col.data(), col.size() * sizeof(double));
+  };
+
+  const auto header = Header{
+      MAGIC,
+      VERSION,
+      static_cast<uint32_t>(bases.size()),
+      static_cast<uint32_t>(trace.size()),
+      0};
+  write(&header, sizeof(header));
+  write(time_entries.data(), time_entries.size() * sizeof(TimeBaseEntry));
+  write(channels.data(), channels.size() * sizeof(ChannelEntry));
+  uint64_t names_end = channels.empty() ? sizeof(Header) : channels.front().name_offset;
+  for (const auto& [name, sig] : trace) {
+    write(name.data(), name.size());
+    names_end += name.size();
+  }
+  constexpr auto padding = std::array<char, 8>{};
+  write(padding.data(), align(names_end) - names_end);
+
+  for (const auto* sig : bases) { write_column(sig->times()); }
+  for (const auto& [name, sig] : trace) {
+    write_column(sig->values());
+    write_column(sig->derivatives());
+  }
+  if (!out) {
+    throw std::runtime_error(
+        fmt::format("Unable to write trace file: {}", path.string()));
+  }
+}
+
+} // namespace signal_tl::signal
@@ -3,15 +3,21 @@
 #ifndef SIGNAL_TEMPORAL_LOGIC_AST_HPP
 #define SIGNAL_TEMPORAL_LOGIC_AST_HPP
 
-#include <cmath>       // for isinf
-#include <limits>      // for numeric_limits
-#include <memory>      // for shared_ptr
-#include <stdexcept>   // for invalid_argument
-#include <string>      // for string, operator==, basic_string
-#include <type_traits> // for remove_reference<>::type
-#include <utility>     // for move, make_pair, pair
-#include <variant>     // for get, get_if, visit, variant
-#include <vector>      // for vector
+#include "signal_tl/internal/node_pool.hpp" // for NodeAllocator
+#include "signal_tl/symbol.hpp"             // for Symbol
+
+#include <cmath>         // for isinf
+#include <cstddef>       // for size_t
+#include <limits>        // for numeric_limits
+#include <memory>        // for shared_ptr, allocate_shared
+#include <set>           // for set
+#include <stdexcept>     // for invalid_argument
+#include <string>        // for string, operator==, basic_string
+#include <type_traits>   // for remove_reference<>::type
+#include <unordered_map> // for unordered_map
+#include <utility>       // for move, forward, make_pair, pair
+#include <variant>       // for get, get_if, visit, variant
+#include <vector>        // for vector
 
 namespace signal_tl {
 namespace ast {
@@ -65,15 +71,16 @@ enum class ComparisonOp { GT, GE, LT, LE };
 /// A Predicate AST node.
 ///
 /// It simply holds the expression `x ~ c`, where `x` is some signal identifier, `~` is
-/// a valid comparison operator, and `c` is some constant (double).
+/// a valid comparison operator, and `c` is some constant (double). The identifier is
+/// interned, so predicates are cheap to copy and compare.
 struct Predicate {
-  std::string name;
+  Symbol name;
   ComparisonOp op = ComparisonOp::GE;
   double rhs      = 0.0;
 
   // Predicate() = delete;
   Predicate(
-      std::string ap_name,
+      Symbol ap_name,
       ComparisonOp operation = ComparisonOp::GE,
       double constant_val    = 0.0) :
       name{std::move(ap_name)}, op{operation}, rhs{constant_val} {};
@@ -231,6 +238,16 @@ struct Until {
       args{std::make_pair(std::move(arg0), std::move(arg1))}, interval{time_interval} {}
 };
 
+/// Create a node of a formula, e.g., `make_node<Always>(phi)`.
+///
+/// Formulas built programmatically consist of many small nodes, so they are allocated
+/// from a pool (see `internal::allocate_node`) instead of one at a time.
+template <typename Node, typename... Args>
+std::shared_ptr<Node> make_node(Args&&... args) {
+  return std::allocate_shared<Node>(
+      internal::NodeAllocator<Node>{}, std::forward<Args>(args)...);
+}
+
 Predicate operator>(const Predicate& lhs, const double bound);
 Predicate operator>=(const Predicate& lhs, const double bound);
 Predicate operator<(const Predicate& lhs, const double bound);
@@ -239,8 +256,50 @@ Predicate operator<=(const Predicate& lhs, const double bound);
 Expr operator~(const Expr& e);
 Expr operator&(const Expr& lhs, const Expr& rhs);
 Expr operator|(const Expr& lhs, const Expr& rhs);
+
+/// Same as above, but if `lhs` is a conjunction (disjunction) that isn't shared with
+/// any other expression, the operands are appended to it in place. Thus, building an
+/// n-ary conjunction one operand at a time, e.g., `phi = std::move(phi) & psi`, takes
+/// linear (instead of quadratic) time.
+Expr operator&(Expr&& lhs, const Expr& rhs);
+Expr operator|(Expr&& lhs, const Expr& rhs);
 Expr operator>>(const Expr& lhs, const Expr& rhs);
 
+/// Structural hash for expressions.
+///
+/// Expressions that are equal according to `ExprEqual` have the same hash, even if
+/// they are different objects.
+///
+/// Hashing an expression visits every node in its tree. To hash formulas where
+/// subexpressions are shared (i.e., held by the same pointer in different parents)
+/// efficiently, `cache` can be set to a map from node addresses to their hashes. The
+/// cache is only valid for as long as the hashed expressions are alive, and is
+/// typically used for the duration of a single evaluation.
+struct ExprHash {
+  std::unordered_map<const void*, size_t>* cache = nullptr;
+
+  size_t operator()(const Expr& e) const;
+};
+
+/// Structural equality for expressions.
+///
+/// Two expressions are equal if they are the same kind of node with equal
+/// parameters (constants, intervals, etc.) and equal operands (in the same order).
+/// Subexpressions held by the same pointer are equal without being visited.
+struct ExprEqual {
+  bool operator()(const Expr& lhs, const Expr& rhs) const;
+};
+
+/// Get the address of the node held by the expression, or `nullptr` if it is held by
+/// value (i.e., `Const` and `Predicate`).
+///
+/// Copies of an `Expr` share the same node, so this can be used to identify shared
+/// subexpressions.
+const void* node_address(const Expr& e);
+
+/// Get the names of all the signals used by the predicates in the expression.
+std::set<std::string> signal_names(const Expr& e);
+
 } // namespace ast
 
 using ast::Expr;
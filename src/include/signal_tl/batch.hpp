@@ -0,0 +1,84 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_BATCH_HPP
+#define SIGNAL_TEMPORAL_LOGIC_BATCH_HPP
+
+#include "signal_tl/ast.hpp"                 // for Expr
+#include "signal_tl/internal/filesystem.hpp" // for path
+#include "signal_tl/robustness.hpp"          // for EvaluationOptions
+
+#include <cstddef> // for size_t
+#include <map>     // for map
+#include <string>  // for string
+#include <vector>  // for vector
+
+namespace signal_tl::semantics {
+
+/// A slice of the traces of a manifest, to split a batch over processes (or nodes).
+///
+/// The traces are assigned round-robin by their position in the manifest, i.e., shard
+/// `index` gets the traces at `index`, `index + count`, and so on. As the shards don't
+/// share anything, each of them can run anywhere, as long as it writes its own output.
+struct Shard {
+  size_t index = 0;
+  size_t count = 1;
+};
+
+/// Read the paths of the trace files (see `TraceFile`) listed in a manifest.
+///
+/// The manifest has one path per line. Empty lines, and lines starting with `#`, are
+/// ignored, and relative paths are relative to the directory of the manifest.
+///
+/// Throws `std::runtime_error` if the manifest can't be read.
+std::vector<stdfs::path> read_manifest(const stdfs::path& manifest);
+
+/// Get the traces in the given shard, in order.
+///
+/// Throws `std::invalid_argument` if the shard isn't one of `shard.count` shards.
+std::vector<stdfs::path>
+select_shard(const std::vector<stdfs::path>& traces, const Shard& shard);
+
+/// Options to control how `run_batch` evaluates the traces.
+struct BatchOptions {
+  /// The options for evaluating the formulas. The traces are evaluated concurrently
+  /// (on `evaluation.executor`, or a pool of `evaluation.num_threads` threads).
+  EvaluationOptions evaluation = {};
+
+  /// If `true`, and the output file exists, the traces that already have a row in it
+  /// are skipped, and the rows of the others are appended to it. A partial row (left
+  /// by a run that was interrupted) is dropped first.
+  bool resume = false;
+};
+
+/// The number of traces of a batch that were evaluated, skipped (as they were in the
+/// output of an earlier run), and that couldn't be evaluated.
+struct BatchSummary {
+  size_t evaluated = 0;
+  size_t skipped   = 0;
+  size_t failed    = 0;
+};
+
+/// Evaluate the named formulas (e.g., the `assertions` of a `Specification`) on each
+/// of the trace files, writing the results to `output` as they are computed.
+///
+/// The output is a CSV file with the header `trace,<names...>,error`, and a row for
+/// each trace with the robustness of each formula at the start of the trace (as in
+/// `compute_robustness_batch`). The rows are in the order in which the traces finish,
+/// and each row is flushed once it is written, so an interrupted run can be resumed
+/// (see `BatchOptions::resume`). A trace that can't be evaluated, e.g., as it is
+/// missing a signal, gets a row with no values and the error.
+///
+/// Only the channels used by the formulas are read from the trace files, and the
+/// formulas are compiled once for all the traces.
+///
+/// Throws `std::runtime_error` if the output can't be written, and
+/// `std::invalid_argument` if an output to resume has the results of other formulas.
+BatchSummary run_batch(
+    const std::map<std::string, ast::Expr>& formulas,
+    const std::vector<stdfs::path>& traces,
+    const stdfs::path& output,
+    const BatchOptions& options = {});
+
+} // namespace signal_tl::semantics
+
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_CUMULATIVE_HPP
+#define SIGNAL_TEMPORAL_LOGIC_CUMULATIVE_HPP
+
+#include "signal_tl/ast.hpp"
+#include "signal_tl/robustness.hpp"
+#include "signal_tl/signal.hpp"
+
+namespace signal_tl::semantics {
+
+/// The positive and negative cumulative robustness of a formula.
+///
+/// The formula is satisfied where the positive robustness is greater than 0, and
+/// violated where the negative robustness is less than 0.
+struct CumulativeRobustness {
+  signal::SignalPtr positive;
+  signal::SignalPtr negative;
+};
+
+/// Compute the cumulative robustness of the formula (Haghighi et al., 2019).
+///
+/// The positive (negative) robustness of a predicate is the positive (negative) part
+/// of its classic robustness, and negations swap (and negate) them. `And`, `Or` and
+/// `Always` are the same as with the classic robustness, applied to each of them,
+/// while `Eventually` integrates them over its interval, so that satisfying (or
+/// violating) the operand for longer is better (or worse). Each integral is computed
+/// in a single pass over the operand. The smooth approximations of `min` and `max`
+/// used in the paper are not applied.
+///
+/// Only the `num_threads`, `executor` and `synchronized` options are used.
+///
+/// Throws `std::invalid_argument` if the formula contains `Until` (which has no
+/// cumulative semantics here).
+CumulativeRobustness compute_cumulative_robustness(
+    const ast::Expr& phi,
+    const signal::Trace& trace,
+    const EvaluationOptions& options = {});
+
+} // namespace signal_tl::semantics
+
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_DISCRETE_HPP
+#define SIGNAL_TEMPORAL_LOGIC_DISCRETE_HPP
+
+#include "signal_tl/ast.hpp"
+#include "signal_tl/plan.hpp"
+#include "signal_tl/signal.hpp"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+/// Discrete-time robustness, for signals sampled at a fixed rate.
+///
+/// Instead of piecewise-linear signals, the signals are sequences of values (the
+/// value at step `k` is the sample at time `k * period`), and the robustness of a
+/// formula at step `k` only depends on the values at the steps in the windows of its
+/// temporal operators. Thus, nothing is interpolated, no crossing points are added,
+/// and the windows are indexed by steps.
+namespace signal_tl::discrete {
+
+/// The values of each signal at the steps `0, 1, ..., n - 1`.
+using DiscreteTrace = std::map<std::string, std::vector<double>>;
+
+/// Convert the interval of a temporal operator to steps.
+///
+/// Integral bounds are numbers of steps, and real bounds are times, which are
+/// converted to the steps within them (i.e., `[a, b]` becomes `[ceil(a / period),
+/// floor(b / period)]`, up to rounding errors). An infinite upper bound is
+/// `EvaluationPlan::npos`.
+///
+/// Throws `std::invalid_argument` if the interval doesn't contain any step.
+std::pair<size_t, size_t> to_steps(const ast::Interval& interval, double period);
+
+/// Compute the discrete-time robustness of the formula at each step.
+///
+/// All the signals used by the formula must have the same number of values. As with
+/// the continuous-time robustness, the windows of the temporal operators are clipped
+/// to the last step (i.e., the signals are extended as constants after their end).
+///
+/// Unlike the continuous-time robustness, the windows always start at their lower
+/// bound, even if they have a single step: `Eventually(x, [a, a])` (or `Always`,
+/// with integral bounds) is `x` shifted by `a` steps, whereas the continuous-time
+/// operators return `x` as is for any window of zero width.
+///
+/// Throws `std::out_of_range` if a signal used by the formula isn't in the trace, and
+/// `std::invalid_argument` if the signals have different lengths.
+std::vector<double>
+compute_robustness(const ast::Expr& phi, const DiscreteTrace& trace, double period = 1);
+
+/// Same as above, for a compiled plan with a single output.
+std::vector<double> compute_robustness(
+    const semantics::EvaluationPlan& plan,
+    const DiscreteTrace& trace,
+    double period = 1);
+
+/// Compute the discrete-time robustness of the formula over a trace of signals that
+/// are sampled at the same, uniformly spaced time points. The result is sampled at
+/// the same time points. The values of the signals are read in place (not copied).
+///
+/// Throws `std::invalid_argument` if the signals aren't sampled at the same time
+/// points, or aren't sampled uniformly.
+signal::SignalPtr compute_robustness(const ast::Expr& phi, const signal::Trace& trace);
+
+} // namespace signal_tl::discrete
+
+#endif
@@ -0,0 +1,98 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_EXECUTOR_HPP
+#define SIGNAL_TEMPORAL_LOGIC_EXECUTOR_HPP
+
+#include <cstddef>    // for size_t
+#include <functional> // for function
+#include <memory>     // for unique_ptr, shared_ptr
+#include <vector>     // for vector
+
+namespace signal_tl {
+
+/// Interface for something that can run tasks concurrently.
+///
+/// This can be implemented to run the tasks created by signal_tl on existing thread
+/// pools. Tasks may be run in any order, and may (for example, if the executor is
+/// shut down) never run at all: anything waiting for a task submitted by signal_tl
+/// will run the task itself if no executor thread has started it yet.
+class Executor {
+ public:
+  virtual ~Executor() = default;
+
+  /// Schedule a task to be run on some thread.
+  ///
+  /// The tasks submitted by signal_tl never throw exceptions.
+  virtual void submit(std::function<void()> task) = 0;
+
+  /// Get the number of tasks that can run concurrently on this executor.
+  [[nodiscard]] virtual size_t concurrency() const = 0;
+};
+
+/// A work-stealing thread pool.
+///
+/// Each worker has its own double-ended queue of tasks. Tasks submitted from within a
+/// worker are pushed to (and popped from) the back of its queue, so that the most
+/// recently created (and smallest) tasks are run first, while idle workers steal the
+/// oldest tasks from the front of the other queues.
+class ThreadPool : public Executor {
+ public:
+  struct Impl;
+
+  /// Create a pool with the given number of threads.
+  ///
+  /// If `num_threads` is `0`, the number of hardware threads is used.
+  explicit ThreadPool(size_t num_threads = 0);
+  /// Stop the pool after all already submitted tasks are completed.
+  ~ThreadPool() override;
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// Schedule a task on the pool. The task must not throw.
+  void submit(std::function<void()> task) override;
+  [[nodiscard]] size_t concurrency() const override;
+
+ private:
+  std::unique_ptr<Impl> impl;
+};
+
+/// A group of tasks that can be waited on together (fork-join parallelism).
+///
+/// Tasks are submitted to the given executor, and `wait` blocks until all of them
+/// are completed. While waiting, the calling thread runs the tasks in the group that
+/// haven't been started by the executor. Thus, tasks in a group can themselves
+/// create and wait on task groups without deadlocking the executor, even if all its
+/// threads are blocked waiting.
+///
+/// If there is no executor, the tasks are run when `wait` is called.
+class TaskGroup {
+ public:
+  explicit TaskGroup(Executor* executor);
+  /// Wait for the tasks to complete, ignoring any exceptions they throw.
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  /// Add a task to the group.
+  void run(std::function<void()> task);
+
+  /// Wait for all tasks in the group to complete.
+  ///
+  /// If any task throws an exception, the first such exception is rethrown here
+  /// (after all the tasks are completed).
+  void wait();
+
+ private:
+  struct State;
+  struct Task;
+
+  Executor* executor;
+  std::shared_ptr<State> state;
+  std::vector<std::shared_ptr<Task>> tasks;
+};
+
+} // namespace signal_tl
+
+#endif
@@ -8,6 +8,7 @@
 
 #include "signal_tl/ast.hpp"
 #include "signal_tl/signal.hpp"
+#include "signal_tl/symbol.hpp"
 
 #include "signal_tl/internal/utils.hpp"
 
@@ -24,6 +25,15 @@ struct formatter {
 
 } // namespace signal_tl::ast
 
+/// Symbols are formatted as their strings, with the same format specs.
+template <>
+struct fmt::formatter<signal_tl::Symbol> : fmt::formatter<std::string_view> {
+  template <typename FormatContext>
+  auto format(const signal_tl::Symbol& s, FormatContext& ctx) {
+    return fmt::formatter<std::string_view>::format(s.str(), ctx);
+  }
+};
+
 template <>
 struct fmt::formatter<signal_tl::ast::Const>
     : signal_tl::ast::formatter<signal_tl::ast::Const> {
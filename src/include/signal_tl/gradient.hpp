@@ -0,0 +1,61 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_GRADIENT_HPP
+#define SIGNAL_TEMPORAL_LOGIC_GRADIENT_HPP
+
+#include "signal_tl/ast.hpp"
+#include "signal_tl/robustness.hpp"
+#include "signal_tl/signal.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace signal_tl::semantics {
+
+/// The partial derivative of the robustness with respect to the value of a sample.
+struct GradientEntry {
+  std::string signal;
+  size_t index      = 0;
+  double derivative = 0.0;
+};
+
+/// The robustness of a formula at some time, and its gradient with respect to the
+/// values of the samples of the trace.
+struct RobustnessGradient {
+  double time  = 0.0;
+  double value = 0.0;
+  /// The nonzero partial derivatives, sorted by the name of the signal and the index
+  /// of the sample. The other samples don't affect the robustness (locally).
+  std::vector<GradientEntry> gradient;
+};
+
+/// Compute the gradient of the robustness of the formula at `time` (by default, the
+/// start of the robustness signal) with respect to the values of the samples of the
+/// trace.
+///
+/// The robustness at a time point is the value of a single predicate at some time
+/// (where the minimum and maximum of the operators are attained), which is
+/// interpolated from (at most) two samples. The robustness of the subformulas is
+/// computed only over the windows needed for `time` (see
+/// `EvaluationOptions::window`), and a single backward pass from the robustness of
+/// the formula follows the operands that attain the minimum/maximum of each operator
+/// down to that predicate. Where a temporal operator is optimal at a kink of its
+/// operand (e.g., where the operands of an `Or` cross), the time of the optimum moves
+/// with the samples, and the gradient combines both operands. Where multiple operands
+/// attain the same value otherwise, the first one is used, i.e., the gradient is a
+/// subgradient.
+///
+/// Throws `std::out_of_range` if the robustness isn't defined at `time`, and
+/// `std::invalid_argument` if `options` selects a semantics other than the classic
+/// one.
+RobustnessGradient compute_robustness_gradient(
+    const ast::Expr& phi,
+    const signal::Trace& trace,
+    std::optional<double> time       = std::nullopt,
+    const EvaluationOptions& options = {});
+
+} // namespace signal_tl::semantics
+
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_NODE_POOL_HPP
+#define SIGNAL_TEMPORAL_LOGIC_NODE_POOL_HPP
+
+#include <cstddef> // for size_t
+
+namespace signal_tl::ast::internal {
+
+/// Get a block of at least `size` bytes (aligned for any node) for a node of a formula.
+///
+/// Small blocks come from a free list of the current thread, which is refilled from
+/// chunks shared by all the threads. Blocks can be returned on any thread. The memory
+/// of the chunks is reused for later nodes, but isn't released until the end of the
+/// program.
+void* allocate_node(size_t size);
+
+/// Return a block allocated by `allocate_node` with the same `size`.
+void deallocate_node(void* block, size_t size) noexcept;
+
+/// Allocator for the nodes of formulas (along with their reference counts), used with
+/// `std::allocate_shared`.
+template <typename T>
+struct NodeAllocator {
+  using value_type = T;
+
+  NodeAllocator() = default;
+  template <typename U>
+  NodeAllocator(const NodeAllocator<U>&) noexcept {}
+
+  T* allocate(size_t n) {
+    static_assert(alignof(T) <= alignof(std::max_align_t));
+    return static_cast<T*>(allocate_node(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t n) noexcept {
+    deallocate_node(p, n * sizeof(T));
+  }
+
+  template <typename U>
+  bool operator==(const NodeAllocator<U>&) const noexcept {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const NodeAllocator<U>&) const noexcept {
+    return false;
+  }
+};
+
+} // namespace signal_tl::ast::internal
+
+#endif
@@ -3,8 +3,11 @@
 #ifndef SIGNAL_TEMPORAL_LOGIC_UTILS_HPP
 #define SIGNAL_TEMPORAL_LOGIC_UTILS_HPP
 
+#include <cstddef>
+#include <functional>
 #include <iterator>
 #include <tuple>
+#include <type_traits>
 
 namespace signal_tl::utils {
 
@@ -76,6 +79,69 @@ constexpr auto reversed(T&& iterable) {
   return iterable_wrapper{std::forward<T>(iterable)};
 }
 
+/**
+ * Combine the hash of `value` into `seed`, as in `boost::hash_combine`.
+ */
+template <typename T>
+inline void hash_combine(size_t& seed, const T& value) {
+  seed ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+/**
+ * A non-owning view over a contiguous sequence of objects.
+ *
+ * This is a minimal version of the C++20 `std::span`, and only provides what is
+ * needed to read the columns of a Signal.
+ */
+template <typename T>
+struct span {
+  using element_type = T;
+  using value_type   = std::remove_cv_t<T>;
+  using size_type    = size_t;
+  using pointer      = T*;
+  using reference    = T&;
+  using iterator     = T*;
+
+  constexpr span() noexcept : ptr{nullptr}, len{0} {}
+  constexpr span(T* data, size_t size) noexcept : ptr{data}, len{size} {}
+
+  [[nodiscard]] constexpr T* data() const noexcept {
+    return ptr;
+  }
+
+  [[nodiscard]] constexpr size_t size() const noexcept {
+    return len;
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return len == 0;
+  }
+
+  [[nodiscard]] constexpr T* begin() const noexcept {
+    return ptr;
+  }
+
+  [[nodiscard]] constexpr T* end() const noexcept {
+    return ptr + len;
+  }
+
+  [[nodiscard]] constexpr T& operator[](size_t idx) const {
+    return ptr[idx];
+  }
+
+  [[nodiscard]] constexpr T& front() const {
+    return ptr[0];
+  }
+
+  [[nodiscard]] constexpr T& back() const {
+    return ptr[len - 1];
+  }
+
+ private:
+  T* ptr;
+  size_t len;
+};
+
 } // namespace signal_tl::utils
 
 #endif
@@ -0,0 +1,176 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_MONITOR_HPP
+#define SIGNAL_TEMPORAL_LOGIC_MONITOR_HPP
+
+#include "signal_tl/ast.hpp"
+#include "signal_tl/signal.hpp"
+
+#include <functional> // for function
+#include <future>     // for future
+#include <memory>     // for unique_ptr
+#include <string>     // for string
+#include <vector>     // for vector
+
+namespace signal_tl::semantics {
+
+/// Online (streaming) monitor for the classic robustness semantics.
+///
+/// The monitor is built once from an `ast::Expr` and then fed with `Sample`s, one
+/// signal at a time, via `push_back`. Each operator in the formula keeps only the
+/// state it needs to produce the next robustness value:
+///
+/// - Predicates and `Not` are stateless maps;
+/// - `And`/`Or` keep the last sample of each operand to synchronize them;
+/// - Bounded `Always`/`Eventually` keep a monotonic wedge over the samples in their
+///   window, along with the samples needed to interpolate the window boundaries;
+/// - Bounded `Until` keeps the samples of its operands in its window, and reruns the
+///   offline algorithm over them whenever its output can be settled further.
+///
+/// Thus, each input sample costs amortized O(1) work per node in the formula, except
+/// for bounded `Until`, where it costs time linear in the number of samples in the
+/// window.
+///
+/// Robustness values are "settled" once no future sample can change them, and can be
+/// collected using `poll`. The robustness of the bounded operators, over `[a, b]`, is
+/// settled at `t` once their operands are known up to `t + b`, and has the same
+/// samples (up to collinear ones) as the offline robustness. Operators whose horizon
+/// is unbounded (with intervals `[a, inf)`) can only be settled at the end of the
+/// stream, i.e., once `finish` is called, and buffer their inputs until then.
+class OnlineMonitor {
+ public:
+  struct Impl;
+
+  OnlineMonitor(const ast::Expr& phi);
+  ~OnlineMonitor();
+
+  OnlineMonitor(OnlineMonitor&&) noexcept;
+  OnlineMonitor& operator=(OnlineMonitor&&) noexcept;
+
+  OnlineMonitor(const OnlineMonitor&) = delete;
+  OnlineMonitor& operator=(const OnlineMonitor&) = delete;
+
+  /// Append a sample to the signal named `name`.
+  ///
+  /// Samples must be strictly monotonically increasing in time for each signal, but
+  /// different signals need not be sampled at the same time instances. Samples for
+  /// signals that do not appear in the formula are ignored.
+  void push_back(const std::string& name, signal::Sample sample);
+  void push_back(const std::string& name, double time, double value);
+
+  /// Signal the end of all input streams.
+  ///
+  /// This settles all remaining robustness values, truncating the windows of the
+  /// temporal operators to the end of the trace. No samples can be added after
+  /// this.
+  void finish();
+
+  /// Get the robustness samples that were settled since the last call to `poll`.
+  ///
+  /// NOTE: The `derivative` field of the returned samples is not populated. Use
+  /// `Signal::push_back` to reconstruct the piecewise-linear robustness signal.
+  [[nodiscard]] std::vector<signal::Sample> poll();
+
+  /// Get the time up to which the robustness signal has been settled.
+  [[nodiscard]] double settled_until() const;
+
+  /// Check if `finish` has been called on the monitor.
+  [[nodiscard]] bool finished() const;
+
+ private:
+  std::unique_ptr<Impl> impl;
+};
+
+/// Called with the robustness samples of a formula (by name) that were settled by an
+/// update of a `MonitorGroup`, in order of time.
+using RobustnessCallback =
+    std::function<void(const std::string& name, const std::vector<signal::Sample>&)>;
+
+/// Front end for monitoring many formulas over many streams, e.g., telemetry that
+/// arrives over sockets at a different rate for each channel.
+///
+/// Each sample of a channel is fed to the group as it arrives, independently of the
+/// other channels, and is routed to the `OnlineMonitor`s of the formulas that use the
+/// channel (which handle channels whose time stamps are out of phase). Whenever the
+/// robustness of a formula is settled further, the new samples are delivered to the
+/// callback of the formula, and the futures given by `settled_sample` that they
+/// settle are fulfilled. The sign of the robustness is the verdict, i.e., positive if
+/// the formula is satisfied and negative if it is violated.
+///
+/// The robustness at a time can only be settled once all the channels used by the
+/// formula have samples past it (by the horizon of the formula). Channels that are
+/// only sent when they change can thus hold back the verdicts, so `hold` and
+/// `advance_to` extend channels whose value is known to be unchanged, e.g., on a
+/// periodic timer, to bound the latency.
+///
+/// The group isn't thread-safe: it is meant to be fed from a single thread, e.g., the
+/// event loop that reads the streams. The callbacks are called on that thread, from
+/// `push_back` (and the other updates), and must not update the group.
+class MonitorGroup {
+ public:
+  struct Impl;
+
+  MonitorGroup();
+  ~MonitorGroup();
+
+  MonitorGroup(MonitorGroup&&) noexcept;
+  MonitorGroup& operator=(MonitorGroup&&) noexcept;
+
+  MonitorGroup(const MonitorGroup&)            = delete;
+  MonitorGroup& operator=(const MonitorGroup&) = delete;
+
+  /// Add a formula to monitor, which will only see the samples pushed after it is
+  /// added.
+  ///
+  /// Throws `std::invalid_argument` if there already is a formula with the name, and
+  /// `std::logic_error` if the group has finished.
+  void add(
+      const std::string& name,
+      const ast::Expr& phi,
+      RobustnessCallback on_update = nullptr);
+
+  /// Append a sample to the channel named `channel`.
+  ///
+  /// Samples must be strictly monotonically increasing in time for each channel. Each
+  /// sample is checked before it is fed to any monitor, so a sample that is rejected
+  /// (with `std::invalid_argument`) doesn't change anything. Samples of channels that
+  /// aren't used by any formula are ignored.
+  void push_back(const std::string& channel, double time, double value);
+
+  /// Extend the channel with its last value up to `time`, if it has a sample before
+  /// it. The channel can then only be appended to after `time`.
+  void hold(const std::string& channel, double time);
+
+  /// Extend every channel that has a sample with its last value up to `time` (see
+  /// `hold`).
+  void advance_to(double time);
+
+  /// Get the first robustness sample of the formula at or after time `t`, once it is
+  /// settled. As the robustness is settled at the time points of the samples of the
+  /// channels, this is the sample at the first of those at or after `t`.
+  ///
+  /// The future has a `std::out_of_range` exception if there is no such sample once
+  /// the group has finished. Throws `std::out_of_range` if there is no such formula,
+  /// and `std::invalid_argument` if `t` is before the last settled sample, as the
+  /// settled samples are only kept until they are delivered.
+  [[nodiscard]] std::future<signal::Sample>
+  settled_sample(const std::string& name, double t);
+
+  /// Get the time up to which the robustness of the formula has been settled.
+  ///
+  /// Throws `std::out_of_range` if there is no such formula.
+  [[nodiscard]] double settled_until(const std::string& name) const;
+
+  /// Signal the end of all the streams, settling the rest of the robustness of each
+  /// formula (see `OnlineMonitor::finish`).
+  void finish();
+
+  [[nodiscard]] bool finished() const;
+
+ private:
+  std::unique_ptr<Impl> impl;
+};
+
+} // namespace signal_tl::semantics
+
+#endif
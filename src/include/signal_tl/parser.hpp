@@ -4,12 +4,14 @@
 #ifndef SIGNAL_TEMPORAL_LOGIC_PARSER_HPP
 #define SIGNAL_TEMPORAL_LOGIC_PARSER_HPP
 
-#include "signal_tl/ast.hpp" // for Expr
+#include "signal_tl/ast.hpp"      // for Expr
+#include "signal_tl/executor.hpp" // for Executor
 #include "signal_tl/internal/filesystem.hpp"
 
 #include <cstddef>     // for size_t
 #include <map>         // for map
 #include <memory>      // for unique_ptr
+#include <optional>    // for optional
 #include <string>      // for string
 #include <string_view> // for string_view
 #include <utility>     // for move
@@ -40,6 +42,27 @@ struct Specification {
 
 namespace parser {
 
+/// Options to control how a specification is parsed.
+struct ParseOptions {
+  /// Number of threads used to parse the (top-level) commands of the specification
+  /// concurrently.
+  ///
+  /// If `1`, the specification is parsed serially on the calling thread. If `0`, the
+  /// number of hardware threads is used. Ignored if `executor` is set.
+  size_t num_threads = 1;
+
+  /// Executor used to parse the commands concurrently, for example, to share an
+  /// existing thread pool.
+  Executor* executor = nullptr;
+
+  /// If set, the parsed specification is cached in this file (see `spec_cache.hpp`).
+  ///
+  /// If the file has the specification of the same source, it is loaded from the
+  /// file instead of parsing the source. Otherwise, the source is parsed and the file
+  /// is overwritten (unless it can't be written, which isn't an error).
+  std::optional<stdfs::path> cache = std::nullopt;
+};
+
 /// Given a `string_view` of the actual specification (typically read from the
 /// specification script file), this fuction will return the parsed contents.
 ///
@@ -49,6 +72,12 @@ namespace parser {
 /// lose its meaning once you do.
 std::unique_ptr<Specification> from_string(std::string_view);
 
+/// Parse the specification with the given options.
+///
+/// The result (and any error thrown) is the same as that of `from_string(input)`.
+std::unique_ptr<Specification>
+from_string(std::string_view input, const ParseOptions& options);
+
 /// Given a `std::filesystem::path` to the specification file, this function
 /// reads the file and creates a concrete `Specification` from it.
 ///
@@ -58,6 +87,12 @@ std::unique_ptr<Specification> from_string(std::string_view);
 /// lose its meaning once you do.
 std::unique_ptr<Specification> from_file(const stdfs::path&);
 
+/// Parse the specification file with the given options.
+///
+/// The result (and any error thrown) is the same as that of `from_file(input)`.
+std::unique_ptr<Specification>
+from_file(const stdfs::path& input, const ParseOptions& options);
+
 } // namespace parser
 
 // LCOV_EXCL_START
@@ -0,0 +1,188 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_PLAN_HPP
+#define SIGNAL_TEMPORAL_LOGIC_PLAN_HPP
+
+#include "signal_tl/ast.hpp"
+#include "signal_tl/robustness.hpp"
+#include "signal_tl/signal.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace signal_tl::semantics {
+
+/// A set of formulas compiled into a flat sequence of operations.
+///
+/// Compiling the formulas merges their (structurally) equal subformulas, resolves
+/// the names of the signals used by the predicates to slots, and orders the
+/// operations such that each one comes after its operands. It also counts the uses of
+/// the result of each operation, so that it is freed (and its buffers reused) as soon
+/// as possible.
+///
+/// Thus, a plan can be compiled once and evaluated on many traces without walking
+/// the syntax trees or looking up signals by name for each node.
+class EvaluationPlan {
+ public:
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  enum class OpCode { Const, Predicate, Not, And, Or, Eventually, Always, Until };
+
+  /// A single operation of the plan.
+  struct Op {
+    OpCode code = OpCode::Const;
+    /// Indices of the operations whose results are the operands.
+    std::vector<size_t> args;
+
+    /// The value of a `Const`.
+    bool value = false;
+    /// The slot of the signal used by a `Predicate`, and the comparison with `rhs`.
+    size_t slot                  = 0;
+    ast::ComparisonOp comparison = ast::ComparisonOp::GE;
+    double rhs                   = 0.0;
+    /// The interval of a temporal operator.
+    ast::Interval interval = {};
+
+    /// The length of the longest chain of operands, i.e., operations on the same
+    /// level don't depend on each other.
+    size_t level = 0;
+    /// How far past a time point the result at that point depends on the trace, i.e.,
+    /// the largest sum of the upper bounds of the intervals of the temporal operators
+    /// on a chain of operands (infinite if any of them is unbounded).
+    double horizon = 0.0;
+    /// Number of operations using the result, or `npos` if the result is an output of
+    /// the plan (and is never freed).
+    size_t uses = 0;
+  };
+
+  /// Compile a single formula.
+  explicit EvaluationPlan(const ast::Expr& phi);
+
+  /// Compile the formulas, e.g., to evaluate them on the same traces.
+  explicit EvaluationPlan(const std::vector<ast::Expr>& formulas);
+
+  /// Compile the named formulas (e.g., the `formulas` or `assertions` of a
+  /// `Specification`). The outputs are in the order of the names.
+  explicit EvaluationPlan(const std::map<std::string, ast::Expr>& formulas);
+
+  /// The operations, in post-order.
+  [[nodiscard]] const std::vector<Op>& ops() const {
+    return operations;
+  }
+
+  /// The names of the signals, by slot.
+  [[nodiscard]] const std::vector<std::string>& signals() const {
+    return signal_names;
+  }
+
+  /// The index of the operation computing each of the formulas.
+  [[nodiscard]] const std::vector<size_t>& outputs() const {
+    return output_ops;
+  }
+
+  /// Compute the robustness of each of the formulas on the given trace.
+  ///
+  /// Throws `std::out_of_range` if a signal used by the formulas isn't in the trace.
+  [[nodiscard]] std::vector<signal::SignalPtr>
+  evaluate(const signal::Trace& trace, const EvaluationOptions& options = {}) const;
+
+  /// Compute the robustness of each of the formulas, where `inputs` has the signal
+  /// for each slot (see `signals()`).
+  [[nodiscard]] std::vector<signal::SignalPtr> evaluate(
+      const std::vector<signal::SignalPtr>& inputs,
+      const EvaluationOptions& options = {}) const;
+
+  /// Compute the robustness of every operation (by index) on the given trace, e.g., to
+  /// inspect the robustness of the subformulas. Nothing is freed before the end.
+  [[nodiscard]] std::vector<signal::SignalPtr>
+  evaluate_ops(const signal::Trace& trace, const EvaluationOptions& options = {}) const;
+
+ private:
+  std::vector<Op> operations;
+  /// The subformula computed by each operation, for profiles.
+  std::vector<ast::Expr> op_formulas;
+  std::vector<std::string> signal_names;
+  std::vector<size_t> output_ops;
+  /// The indices of the operations sorted by level, for concurrent evaluation.
+  std::vector<size_t> by_level;
+
+  /// Evaluate the plan, where `inputs` has a signal for each of the signal names
+  /// (which are sorted, and thus in the order of the slots). Returns the results of
+  /// the outputs, or of all the operations if `keep_all` is set.
+  [[nodiscard]] std::vector<signal::SignalPtr> run(
+      const signal::Trace& inputs,
+      std::pair<double, double> time_range,
+      const EvaluationOptions& options,
+      bool keep_all = false) const;
+};
+
+/// The robustness of the formulas of a plan on a trace that is extended over time,
+/// e.g., an offline trace to which new chunks of samples are appended.
+///
+/// The result of each operation at a time point `t` only depends on the trace over
+/// `[t, t + horizon]` (see `EvaluationPlan::Op::horizon`). Thus, appending samples
+/// after the end of the trace at `T` only changes it from `T - horizon` on, and
+/// `append` only recomputes the results from there, using the parts of their operands
+/// that are needed (which were updated first). The cost of an append is then in the
+/// number of new samples and the samples within the horizons, instead of the length
+/// of the trace, except for the operations with an unbounded horizon (such as
+/// unbounded `Always`, and the operations using them), which are recomputed.
+///
+/// The result of every operation is kept. The signals that are returned aren't
+/// changed by later appends, as the shared ones are copied before they are extended
+/// (so the previous results should be dropped to avoid the copies).
+class IncrementalEvaluation {
+ public:
+  /// Evaluate the plan on the trace, keeping the result of each operation.
+  ///
+  /// The `window` and the `profile` of the options are ignored.
+  ///
+  /// Throws `std::out_of_range` if a signal used by the plan isn't in the trace.
+  IncrementalEvaluation(
+      EvaluationPlan plan,
+      const signal::Trace& trace,
+      const EvaluationOptions& options = {});
+
+  /// Append the samples of each signal of `chunk` to the signal in the trace, and
+  /// update the results.
+  ///
+  /// The signals that aren't used by the plan are ignored, and the ones that aren't in
+  /// `chunk` aren't extended. Throws `std::invalid_argument` (without appending
+  /// anything) if a chunk doesn't start after the end of its signal.
+  void append(const signal::Trace& chunk);
+
+  /// The robustness of each of the formulas on the trace so far.
+  [[nodiscard]] std::vector<signal::SignalPtr> outputs() const;
+
+  /// The result of every operation (by index) on the trace so far.
+  [[nodiscard]] const std::vector<signal::SignalPtr>& results() const {
+    return op_results;
+  }
+
+  [[nodiscard]] const EvaluationPlan& plan() const {
+    return compiled;
+  }
+
+ private:
+  EvaluationPlan compiled;
+  EvaluationOptions eval_options;
+  /// The signal of each slot of the plan, so far.
+  std::vector<signal::SignalPtr> inputs;
+  std::vector<signal::SignalPtr> op_results;
+};
+
+/// Compute the robustness of the formula of a plan compiled from a single formula.
+///
+/// Throws `std::invalid_argument` if the plan has more than one output.
+signal::SignalPtr compute_robustness(
+    const EvaluationPlan& plan,
+    const signal::Trace& trace,
+    const EvaluationOptions& options = {});
+
+} // namespace signal_tl::semantics
+
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_PROFILE_HPP
+#define SIGNAL_TEMPORAL_LOGIC_PROFILE_HPP
+
+#include "signal_tl/ast.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace signal_tl::semantics {
+
+/// Statistics of the evaluation of a single (distinct) subformula.
+struct NodeProfile {
+  /// The subformula.
+  ast::Expr formula;
+  /// The indices (in `EvaluationProfile::nodes`) of the operands.
+  std::vector<size_t> operands;
+
+  /// Wall time spent computing this subformula from its operands, in seconds.
+  double seconds = 0.0;
+  /// Number of samples of the operands (or, for a predicate, of its signal).
+  size_t input_samples = 0;
+  /// Number of samples of the result.
+  size_t output_samples = 0;
+  /// Number of samples of the result in excess of the largest operand, e.g., the
+  /// time points that synchronizing the operands of an `And` adds (the samples of
+  /// the other operands and the points where they cross).
+  size_t added_samples = 0;
+  /// Bytes allocated for new buffers, on the thread computing the subformula. Buffers
+  /// that are recycled from the signals of other subformulas aren't counted.
+  size_t bytes_allocated = 0;
+  /// Whether the result was found in the `EvaluationOptions::cache`, in which case
+  /// it wasn't computed (and neither were the operands only needed by it).
+  bool cached = false;
+};
+
+/// The statistics of a robustness evaluation, for each distinct subformula (see
+/// `EvaluationOptions::profile`).
+struct EvaluationProfile {
+  /// The subformulas, in the order they are computed: operands come before the
+  /// subformulas using them.
+  std::vector<NodeProfile> nodes;
+  /// Wall time of the whole evaluation (including preparing the trace), in seconds.
+  double seconds = 0.0;
+
+  /// Format the statistics as a table, with a row for each subformula.
+  [[nodiscard]] std::string report() const;
+};
+
+} // namespace signal_tl::semantics
+
+#endif
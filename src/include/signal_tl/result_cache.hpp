@@ -0,0 +1,135 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_RESULT_CACHE_HPP
+#define SIGNAL_TEMPORAL_LOGIC_RESULT_CACHE_HPP
+
+#include "signal_tl/internal/filesystem.hpp" // for path
+#include "signal_tl/internal/utils.hpp"      // for span
+#include "signal_tl/signal.hpp"              // for Signal, SignalPtr
+
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint64_t
+#include <list>          // for list
+#include <mutex>         // for mutex
+#include <optional>      // for optional
+#include <unordered_map> // for unordered_map
+#include <utility>       // for pair
+
+namespace signal_tl::semantics {
+
+/// Mix a 64-bit value into a fingerprint.
+///
+/// Unlike `std::hash`, this is the same on every platform and in every process, so
+/// that fingerprints can name files that are shared between runs.
+constexpr uint64_t fingerprint_combine(uint64_t seed, uint64_t value) {
+  // The value is mixed as in `utils::hash_combine`, followed by the finalizer of
+  // MurmurHash3 to spread it over all the bits.
+  uint64_t h = seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+/// Get the fingerprint of a column of `double`s, from the bits of its elements.
+uint64_t fingerprint(utils::span<const double> column);
+
+/// Get the fingerprint of the samples of a signal, i.e., of its time stamps and
+/// values (which determine its derivatives).
+uint64_t fingerprint(const signal::Signal& x);
+
+/// A cache of robustness signals, to skip evaluating the same formulas on the same
+/// traces again, e.g., when a specification is checked against unchanged traces on
+/// every run, or when separately evaluated formulas share subformulas.
+///
+/// The results are keyed by a fingerprint of the subformula (its structure, after
+/// compiling it into an `EvaluationPlan`) and of the signals of the trace it uses,
+/// along with the semantics and the window of the evaluation. Thus, a cached result
+/// is found again for any formula with the same subformula, on any trace with the
+/// same samples in those signals, regardless of the names and the other signals of
+/// the formula and the trace. Set `EvaluationOptions::cache` to use a cache.
+///
+/// The robustness of the formulas, and of their temporal subformulas, is cached (the
+/// others are cheap to compute from them). The least recently used results are
+/// evicted from memory once they exceed `max_samples` in total. If the cache has a
+/// directory, the results are also written to it (as trace files, see `TraceFile`),
+/// and are loaded from there when they aren't in memory, so that they are kept
+/// between runs. Failing to read or write a file only makes it a miss.
+///
+/// The keys are 64-bit fingerprints, which are not checked against the formulas and
+/// the signals, so distinct results with the same fingerprint (which is very
+/// unlikely) would be confused. The cached signals are shared with the results of
+/// the evaluations, so these must not be modified.
+///
+/// A cache can be shared by concurrent evaluations.
+class ResultCache {
+ public:
+  /// The version of the keys, which is changed whenever the results for a key may
+  /// change (so that the results written by earlier versions are not found).
+  static constexpr uint64_t VERSION = 1;
+
+  struct Stats {
+    /// Number of results that were found (in memory or on disk).
+    size_t hits = 0;
+    /// Number of results that were found on disk.
+    size_t disk_hits = 0;
+    /// Number of results that were looked up, but not found.
+    size_t misses = 0;
+    /// Number of results evicted from memory.
+    size_t evicted = 0;
+  };
+
+  /// Create a cache that only keeps the results in memory.
+  explicit ResultCache(size_t max_samples = size_t{1} << 26);
+
+  /// Create a cache that also keeps the results in the given directory, which is
+  /// created if needed.
+  explicit ResultCache(stdfs::path directory, size_t max_samples = size_t{1} << 26);
+
+  ResultCache(const ResultCache&)            = delete;
+  ResultCache& operator=(const ResultCache&) = delete;
+
+  /// Get the result with the given key, or `nullptr` if it isn't cached.
+  [[nodiscard]] signal::SignalPtr find(uint64_t key);
+
+  /// Add a result to the cache (replacing the one with the same key, if any).
+  void insert(uint64_t key, const signal::SignalPtr& y);
+
+  /// Remove all the results from memory (but not from the directory).
+  void clear();
+
+  /// The number of results in memory.
+  [[nodiscard]] size_t size() const;
+
+  [[nodiscard]] Stats stats() const;
+
+  [[nodiscard]] const std::optional<stdfs::path>& directory() const {
+    return dir;
+  }
+
+ private:
+  using Entry = std::pair<uint64_t, signal::SignalPtr>;
+
+  /// Get the path of the file of the result with the given key.
+  [[nodiscard]] stdfs::path path_of(uint64_t key) const;
+
+  /// Add a result to memory, evicting the oldest ones if needed. The mutex must be
+  /// held.
+  void remember(uint64_t key, const signal::SignalPtr& y);
+
+  std::optional<stdfs::path> dir;
+  size_t max_samples;
+
+  mutable std::mutex mutex;
+  /// The results in memory, from the most to the least recently used.
+  std::list<Entry> entries;
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> by_key;
+  size_t num_samples = 0;
+  Stats counts;
+};
+
+} // namespace signal_tl::semantics
+
+#endif
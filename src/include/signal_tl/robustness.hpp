@@ -4,18 +4,157 @@
 #define SIGNAL_TEMPORAL_LOGIC_ROBUSTNESS_HPP
 
 #include "signal_tl/ast.hpp"
+#include "signal_tl/executor.hpp"
 #include "signal_tl/signal.hpp"
 
+#include <cstddef>
 #include <map>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace signal_tl::semantics {
 
+class EvaluationPlan;
+struct EvaluationProfile;
+class ResultCache;
+
+/// The quantitative semantics of the temporal operators.
+enum class Semantics {
+  /// The classic (space) robustness, where `Eventually` and `Always` are the maximum
+  /// and minimum of their operand over their intervals.
+  Classic,
+  /// Temporal logic as filtering (Rodionova et al., 2016), with a uniform kernel.
+  ///
+  /// `Eventually` and `Always` are both the average of their operand over their
+  /// intervals (which, as the average is linear, makes them dual to each other).
+  /// `Until` keeps the classic semantics.
+  Filtering,
+};
+
+/// Options to control how the robustness is computed.
+struct EvaluationOptions {
+  /// Number of threads used to evaluate independent subformulas (and the operands of
+  /// n-ary And/Or) concurrently.
+  ///
+  /// If `1`, the formula is evaluated serially on the calling thread. If `0`, the
+  /// number of hardware threads is used. Ignored if `executor` is set.
+  size_t num_threads = 1;
+
+  /// Executor used to run the concurrent tasks, for example, to share an existing
+  /// thread pool. The calling thread also participates in the evaluation.
+  Executor* executor = nullptr;
+
+  /// If `true`, all the signals in the trace are assumed to be sampled at the same
+  /// time points (only their number of samples is checked).
+  ///
+  /// Either way, the signals that share their time points are evaluated on a
+  /// shared time column, so that binary operators over them don't need to
+  /// synchronize them (see `signal::share_time_bases`).
+  bool synchronized = false;
+
+  /// If set, the robustness is only needed over this time range, e.g., `{t, t}` for
+  /// the robustness at time `t`.
+  ///
+  /// Each subformula is then only computed over the part of the trace that the
+  /// robustness over the range depends on, e.g., `Always(phi, [a, b])` over `[s, t]`
+  /// only needs `phi` over `[s, t + b]`. The robustness signal is restricted to
+  /// the range (and is empty if the range doesn't overlap the robustness signal).
+  std::optional<std::pair<double, double>> window = std::nullopt;
+
+  /// The semantics of the temporal operators.
+  Semantics semantics = Semantics::Classic;
+
+  /// If set, the statistics of the evaluation of each distinct subformula are
+  /// recorded into it (replacing its contents).
+  ///
+  /// The formula is then evaluated as an `EvaluationPlan`, one subformula at a time,
+  /// so that each of them is timed on its own. If not set, nothing is recorded (or
+  /// measured). Ignored by `compute_robustness_batch`.
+  EvaluationProfile* profile = nullptr;
+
+  /// If `true`, the formula is simplified before it is evaluated (see
+  /// `ast::simplify`), e.g., folding constants, and merging nested temporal operators
+  /// (for the classic semantics), so that fewer signals are computed. The robustness
+  /// is the same either way, but the formulas in the `profile` are the simplified
+  /// ones. A compiled `EvaluationPlan` is evaluated as it is.
+  bool simplify = true;
+
+  /// If set, the robustness of the formulas (and of their temporal subformulas) is
+  /// looked up in the cache before it is computed, and added to it after (see
+  /// `ResultCache`). The formula is then evaluated as an `EvaluationPlan`, and the
+  /// subformulas that are only needed by cached results aren't computed at all.
+  ResultCache* cache = nullptr;
+};
+
 signal::SignalPtr compute_robustness(
     const ast::Expr& phi,
     const signal::Trace& trace,
     bool synchronized = false);
 
+signal::SignalPtr compute_robustness(
+    const ast::Expr& phi,
+    const signal::Trace& trace,
+    const EvaluationOptions& options);
+
+/// Compute the robustness of the formula at time `t`.
+///
+/// This only computes the subformulas over the part of the trace that is needed for
+/// the robustness at `t` (see `EvaluationOptions::window`, which is overridden).
+///
+/// Throws `std::out_of_range` if the robustness isn't defined at `t`.
+double compute_robustness_at(
+    const ast::Expr& phi,
+    const signal::Trace& trace,
+    double t,
+    const EvaluationOptions& options = {});
+
+/// Dense matrix of robustness values, with a row for each formula and a column for
+/// each trace.
+struct RobustnessMatrix {
+  size_t num_formulas = 0;
+  size_t num_traces   = 0;
+  /// The values in row-major order, i.e., the value for formula `i` and trace `j` is
+  /// at `values[i * num_traces + j]`.
+  std::vector<double> values;
+
+  [[nodiscard]] double at(size_t formula, size_t trace) const {
+    return values.at(formula * num_traces + trace);
+  }
+};
+
+/// Compute the robustness of each formula for each trace.
+///
+/// The value for each pair is the robustness at the start of the robustness signal
+/// (i.e, at the start of the trace), or NaN if the robustness signal is empty. The
+/// traces are evaluated concurrently, according to `options`. The formulas are
+/// compiled into a single `EvaluationPlan`, so they share their common subformulas.
+/// If `options.window` is set, it is the value at the start of the robustness
+/// restricted to the window instead.
+RobustnessMatrix compute_robustness_batch(
+    const std::vector<ast::Expr>& formulas,
+    const std::vector<signal::Trace>& traces,
+    const EvaluationOptions& options = {});
+
+/// Compute the robustness of each named formula (for example, the `formulas` or
+/// `assertions` in a `Specification`) for each trace.
+///
+/// The rows of the matrix are in the order of the names of the formulas.
+RobustnessMatrix compute_robustness_batch(
+    const std::map<std::string, ast::Expr>& formulas,
+    const std::vector<signal::Trace>& traces,
+    const EvaluationOptions& options = {});
+
+/// Compute the robustness of each formula of a compiled plan for each trace.
+///
+/// The rows of the matrix are in the order of the outputs of the plan.
+RobustnessMatrix compute_robustness_batch(
+    const EvaluationPlan& plan,
+    const std::vector<signal::Trace>& traces,
+    const EvaluationOptions& options = {});
+
 } // namespace signal_tl::semantics
 
 #endif
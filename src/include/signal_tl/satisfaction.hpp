@@ -0,0 +1,69 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_SATISFACTION_HPP
+#define SIGNAL_TEMPORAL_LOGIC_SATISFACTION_HPP
+
+#include "signal_tl/ast.hpp"
+#include "signal_tl/signal.hpp"
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace signal_tl::semantics {
+
+/// A closed time interval `[first, second]`.
+using TimeInterval = std::pair<double, double>;
+
+/// A union of disjoint closed intervals, sorted by time, e.g., the set of time points
+/// where a formula holds.
+using IntervalSet = std::vector<TimeInterval>;
+
+/// Options to control how the satisfaction of a formula is checked.
+struct SatisfactionOptions {
+  /// The time at which the formula is checked. By default, it is checked at the start
+  /// of the signals it uses, i.e., where its robustness signal starts.
+  std::optional<double> time = std::nullopt;
+
+  /// Whether to find the interval where the formula is violated, if it is.
+  bool find_violation = false;
+};
+
+/// The result of checking the satisfaction of a formula at some time.
+struct Verdict {
+  bool satisfied = false;
+  /// The time at which the formula was checked.
+  double time = 0.0;
+  /// If the formula is violated (and `find_violation` was set), an interval where
+  /// the requirement that fails doesn't hold. This follows the first failing
+  /// operand of `And`s and the first failing point of `Always`s down to the
+  /// subformula that is violated (e.g., a predicate), and is limited to the part of
+  /// the trace that was needed for the verdict.
+  std::optional<TimeInterval> violation = std::nullopt;
+};
+
+/// Check if the trace satisfies the formula (with the qualitative, Boolean
+/// semantics).
+///
+/// Instead of the robustness signals, this works on the sets of intervals where the
+/// subformulas hold, and each subformula is only evaluated over the part of the trace
+/// that is needed for the verdict at the queried time, e.g., `Always(phi, [a, b])`
+/// only reads `phi` over `[t + a, t + b]`. The operands of `And` and `Or` are
+/// evaluated in order, and the evaluation stops as soon as the result is decided. As
+/// with the robustness, strict and non-strict comparisons are treated the same, i.e.,
+/// the verdict matches the sign of the robustness except (possibly) when it is 0.
+///
+/// Throws `std::out_of_range` if the time is outside the range where all the signals
+/// used by the formula are defined.
+Verdict check_satisfaction(
+    const ast::Expr& phi,
+    const signal::Trace& trace,
+    const SatisfactionOptions& options = {});
+
+/// Compute the set of time points where the formula holds, over the whole range
+/// where all the signals used by the formula are defined.
+IntervalSet compute_satisfaction(const ast::Expr& phi, const signal::Trace& trace);
+
+} // namespace signal_tl::semantics
+
+#endif
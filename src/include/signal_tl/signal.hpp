@@ -3,19 +3,26 @@
 #ifndef SIGNAL_TEMPORAL_LOGIC_SIGNAL_HPP
 #define SIGNAL_TEMPORAL_LOGIC_SIGNAL_HPP
 
-#include <algorithm>   // for lower_bound
-#include <cstddef>     // for size_t
-#include <iterator>    // for next, prev
-#include <map>         // for map
-#include <memory>      // for shared_ptr, allocator_traits<>::value_type
-#include <stdexcept>   // for invalid_argument
-#include <string>      // for string
-#include <tuple>       // for tuple
-#include <type_traits> // for declval
-#include <vector>      // for vector
+#include <algorithm>        // for lower_bound, upper_bound, max, min
+#include <cstddef>          // for size_t, ptrdiff_t
+#include <initializer_list> // for initializer_list
+#include <iterator>         // for next, prev, distance, reverse_iterator
+#include <map>              // for map
+#include <memory>           // for shared_ptr, allocator_traits<>::value_type
+#include <stdexcept>        // for invalid_argument, out_of_range
+#include <string>           // for string
+#include <tuple>            // for tuple
+#include <type_traits>      // for declval
+#include <utility>          // for move
+#include <vector>           // for vector
+
+#include "signal_tl/internal/utils.hpp" // for span
 
 namespace signal_tl::signal {
 
+class BufferPool;
+class TraceFile;
+
 struct Sample {
   double time;
   double value;
@@ -65,44 +72,322 @@ constexpr Sample operator-(const Sample& other) {
   return {other.time, -other.value, -other.derivative};
 }
 
+/**
+ * A contiguous column of `double`s in a Signal.
+ *
+ * A column either owns its data, or views memory owned by someone else (e.g., a
+ * NumPy array or a memory mapped file) without copying it. The viewed memory is kept
+ * alive by a shared pointer to its owner, and is never written to: modifying a column
+ * that views external memory first copies the data into owned storage.
+ */
+class Column {
+ public:
+  Column() = default;
+  Column(std::vector<double>&& data) : owned{std::move(data)} {}
+  Column(std::initializer_list<double> data) : owned{data} {}
+
+  /**
+   * Create a column that views `size` elements at `data`.
+   *
+   * The memory must stay valid (and unchanged) for as long as `owner` is alive.
+   */
+  [[nodiscard]] static Column
+  view(const double* data, size_t size, std::shared_ptr<const void> owner) {
+    auto col   = Column{};
+    col.ptr    = data;
+    col.len    = size;
+    col.keeper = std::move(owner);
+    return col;
+  }
+
+  /**
+   * Check if the column views external memory.
+   */
+  [[nodiscard]] bool is_view() const {
+    return ptr != nullptr;
+  }
+
+  /**
+   * Get the owner of the viewed memory, or `nullptr` if the column owns its data.
+   */
+  [[nodiscard]] const std::shared_ptr<const void>& owner() const {
+    return keeper;
+  }
+
+  [[nodiscard]] const double* data() const {
+    return (is_view()) ? ptr : owned.data();
+  }
+
+  [[nodiscard]] size_t size() const {
+    return (is_view()) ? len : owned.size();
+  }
+
+  [[nodiscard]] bool empty() const {
+    return size() == 0;
+  }
+
+  [[nodiscard]] const double* begin() const {
+    return data();
+  }
+
+  [[nodiscard]] const double* end() const {
+    return data() + size();
+  }
+
+  [[nodiscard]] double operator[](size_t i) const {
+    return data()[i];
+  }
+
+  [[nodiscard]] double at(size_t i) const {
+    if (i >= size()) {
+      throw std::out_of_range("Column index out of range");
+    }
+    return data()[i];
+  }
+
+  [[nodiscard]] double front() const {
+    return data()[0];
+  }
+
+  [[nodiscard]] double back() const {
+    return data()[size() - 1];
+  }
+
+  /**
+   * Get the owned storage of the column for modification, copying the viewed data
+   * into it if needed.
+   */
+  std::vector<double>& mut() {
+    if (is_view()) {
+      owned.assign(ptr, ptr + len);
+      ptr = nullptr;
+      len = 0;
+      keeper.reset();
+    }
+    return owned;
+  }
+
+  /**
+   * Move the owned storage out of the column, leaving it empty.
+   *
+   * If the column views external memory, an empty vector is returned.
+   */
+  std::vector<double> release() {
+    auto out = std::move(owned);
+    owned.clear();
+    ptr = nullptr;
+    len = 0;
+    keeper.reset();
+    return out;
+  }
+
+ private:
+  std::vector<double> owned;
+  const double* ptr = nullptr;
+  size_t len        = 0;
+  std::shared_ptr<const void> keeper;
+};
+
 /**
  * Piecewise-linear, right-continuous signal
+ *
+ * The samples are stored as a structure of arrays, i.e., the time stamps, values,
+ * and derivatives are stored in separate contiguous columns. This allows kernels that
+ * only need (say) the values to run over dense arrays of `double`s. The columns can
+ * be accessed directly using `times()`, `values()`, and `derivatives()`, while
+ * iterating over the signal (or using `at_idx`) yields `Sample`s.
+ *
+ * The time and value columns may view memory owned outside the signal (see
+ * `Column`), so that signals can be created from external arrays without copying.
  */
 struct Signal {
  private:
-  std::vector<Sample> samples;
+  Column time_col;
+  Column value_col;
+  Column derivative_col;
 
  public:
+  /**
+   * Random access iterator over the samples in a signal.
+   *
+   * As the signal doesn't store `Sample` objects, dereferencing the iterator creates
+   * a `Sample` by value.
+   */
+  struct const_iterator {
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = Sample;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = Sample;
+
+    /// Proxy object that allows `it->time`, etc.
+    struct pointer {
+      Sample sample;
+      const Sample* operator->() const {
+        return &sample;
+      }
+    };
+
+    const_iterator() = default;
+    const_iterator(const Signal* signal, size_t index) : sig{signal}, idx{index} {}
+
+    [[nodiscard]] size_t index() const {
+      return idx;
+    }
+
+    reference operator*() const {
+      return sig->sample_at(idx);
+    }
+    pointer operator->() const {
+      return pointer{sig->sample_at(idx)};
+    }
+    reference operator[](difference_type n) const {
+      return sig->sample_at(idx + static_cast<size_t>(n));
+    }
+
+    const_iterator& operator++() {
+      ++idx;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto ret = *this;
+      ++idx;
+      return ret;
+    }
+    const_iterator& operator--() {
+      --idx;
+      return *this;
+    }
+    const_iterator operator--(int) {
+      auto ret = *this;
+      --idx;
+      return ret;
+    }
+    const_iterator& operator+=(difference_type n) {
+      idx = static_cast<size_t>(static_cast<difference_type>(idx) + n);
+      return *this;
+    }
+    const_iterator& operator-=(difference_type n) {
+      return *this += -n;
+    }
+    friend const_iterator operator+(const_iterator it, difference_type n) {
+      return it += n;
+    }
+    friend const_iterator operator+(difference_type n, const_iterator it) {
+      return it += n;
+    }
+    friend const_iterator operator-(const_iterator it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const const_iterator& a, const const_iterator& b) {
+      return static_cast<difference_type>(a.idx) - static_cast<difference_type>(b.idx);
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b) {
+      return a.idx == b.idx;
+    }
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) {
+      return a.idx != b.idx;
+    }
+    friend bool operator<(const const_iterator& a, const const_iterator& b) {
+      return a.idx < b.idx;
+    }
+    friend bool operator>(const const_iterator& a, const const_iterator& b) {
+      return a.idx > b.idx;
+    }
+    friend bool operator<=(const const_iterator& a, const const_iterator& b) {
+      return a.idx <= b.idx;
+    }
+    friend bool operator>=(const const_iterator& a, const const_iterator& b) {
+      return a.idx >= b.idx;
+    }
+
+   private:
+    const Signal* sig = nullptr;
+    size_t idx        = 0;
+  };
+
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
   [[nodiscard]] double begin_time() const {
-    return (samples.empty()) ? 0.0 : samples.front().time;
+    return (time_col.empty()) ? 0.0 : time_col.front();
   }
 
   [[nodiscard]] double end_time() const {
-    return (samples.empty()) ? 0.0 : samples.back().time;
+    return (time_col.empty()) ? 0.0 : time_col.back();
   }
 
   [[nodiscard]] double interpolate(double t, size_t idx) const {
-    return this->samples.at(idx).interpolate(t);
+    return (*this)[idx].interpolate(t);
   }
 
   [[nodiscard]] double time_intersect(const Sample& point, size_t idx) const {
-    return this->samples.at(idx).time_intersect(point);
+    return (*this)[idx].time_intersect(point);
   }
 
   [[nodiscard]] double area(double t, size_t idx) const {
-    return this->samples.at(idx).area(t);
+    return (*this)[idx].area(t);
   }
 
+  /**
+   * Get the first sample of the (non-empty) signal.
+   */
   [[nodiscard]] Sample front() const {
-    return this->samples.front();
+    return (*this)[0];
   }
 
+  /**
+   * Get the last sample of the (non-empty) signal.
+   */
   [[nodiscard]] Sample back() const {
-    return this->samples.back();
+    return (*this)[this->size() - 1];
+  }
+
+  /**
+   * Get the sample at index `i`.
+   *
+   * The index is only checked in debug builds (i.e., if `NDEBUG` isn't defined), so
+   * this is the accessor to use in loops whose bounds are already known. Use `at_idx`
+   * for indices that need to be checked.
+   */
+  [[nodiscard]] Sample operator[](size_t i) const {
+#ifndef NDEBUG
+    this->check_index(i);
+#endif
+    return this->sample_at(i);
   }
 
+  /**
+   * Get the sample at index `i`.
+   *
+   * Throws `std::out_of_range` if the index isn't less than `size()`.
+   */
   [[nodiscard]] Sample at_idx(size_t i) const {
-    return this->samples.at(i);
+    this->check_index(i);
+    return this->sample_at(i);
+  }
+
+  /**
+   * Get the time stamps of the samples as a contiguous array.
+   */
+  [[nodiscard]] utils::span<const double> times() const {
+    return {time_col.data(), time_col.size()};
+  }
+
+  /**
+   * Get the values of the samples as a contiguous array.
+   */
+  [[nodiscard]] utils::span<const double> values() const {
+    return {value_col.data(), value_col.size()};
+  }
+
+  /**
+   * Get the derivatives of the samples as a contiguous array.
+   *
+   * The derivative at index `i` is the slope of the line between the samples `i` and
+   * `i + 1`, and is `0` for the last sample.
+   */
+  [[nodiscard]] utils::span<const double> derivatives() const {
+    return {derivative_col.data(), derivative_col.size()};
   }
 
   /**
@@ -110,71 +395,77 @@ struct Signal {
    *
    * Does a binary search for the given time instance, and interpolates from
    * the closest sample less than `t` if necessary.
+   *
+   * Throws `std::invalid_argument` if the signal isn't defined at `t`.
    */
   [[nodiscard]] Sample at(double t) const;
   /**
    * Get const_iterator to the start of the signal
    */
-  [[nodiscard]] auto begin() const {
-    return this->samples.cbegin();
+  [[nodiscard]] const_iterator begin() const {
+    return const_iterator{this, 0};
   }
 
   /**
    * Get const_iterator to the end of the signal
    */
-  [[nodiscard]] auto end() const {
-    return this->samples.cend();
+  [[nodiscard]] const_iterator end() const {
+    return const_iterator{this, this->size()};
   }
 
   /**
    * Get const_iterator to the first element of the signal that is timed at or after
    * `s`
    */
-  [[nodiscard]] auto begin_at(double s) const {
+  [[nodiscard]] const_iterator begin_at(double s) const {
     if (this->begin_time() >= s)
       return this->begin();
 
-    constexpr auto comp_op = [](const Sample& a, const Sample& b) {
-      return a.time < b.time;
-    };
-    return std::lower_bound(this->begin(), this->end(), Sample{s, 0.0}, comp_op);
+    auto it = std::lower_bound(time_col.begin(), time_col.end(), s);
+    return const_iterator{this, static_cast<size_t>(it - time_col.begin())};
   }
 
   /**
    * Get const_iterator to the element after the last element of the signal
    * that is timed at or before `t`
    */
-  [[nodiscard]] auto end_at(double t) const {
+  [[nodiscard]] const_iterator end_at(double t) const {
     if (this->end_time() <= t)
       return this->end();
 
-    auto it = this->end();
-    while (it->time > t) it = std::prev(it);
-    // Now we have the pointer to the first element from the back whose .time <= t.
-    // So increment by 1 and return
-    return std::next(it);
+    auto it = std::upper_bound(time_col.begin(), time_col.end(), t);
+    return const_iterator{this, static_cast<size_t>(it - time_col.begin())};
   }
 
   /**
    * Get const reverse_iterator to the samples.
    */
-  [[nodiscard]] auto rbegin() const {
-    return this->samples.crbegin();
+  [[nodiscard]] const_reverse_iterator rbegin() const {
+    return const_reverse_iterator{this->end()};
   }
 
   /**
    * Get const reverse_iterator to the samples.
    */
-  [[nodiscard]] auto rend() const {
-    return this->samples.crend();
+  [[nodiscard]] const_reverse_iterator rend() const {
+    return const_reverse_iterator{this->begin()};
   }
 
   [[nodiscard]] size_t size() const {
-    return this->samples.size();
+    return this->time_col.size();
   }
 
   [[nodiscard]] bool empty() const {
-    return this->samples.empty();
+    return this->time_col.empty();
+  }
+
+  /**
+   * Reserve space for `n` samples in each column.
+   */
+  void reserve(size_t n) {
+    time_col.mut().reserve(n);
+    value_col.mut().reserve(n);
+    derivative_col.mut().reserve(n);
   }
 
   /**
@@ -184,9 +475,47 @@ struct Signal {
   void push_back(double time, double value);
 
   /**
-   * Remove sampling points where (y, dy) is continuous
+   * Add the given samples to the back of the Signal, copying the columns in bulk and
+   * computing the derivatives in the same pass.
+   *
+   * Throws `std::invalid_argument` if the columns don't have the same size, or if the
+   * time stamps aren't strictly increasing (and after the end of the signal).
+   */
+  void append(utils::span<const double> times, utils::span<const double> values);
+
+  /**
+   * Add samples that are already known to be sorted to the back of the Signal, e.g.,
+   * the columns of another signal, which were checked when it was created.
+   *
+   * Like `from_sorted`, only the first time stamp is checked (against the end of the
+   * signal), and the rest only in debug builds. If `derivatives` is empty, they are
+   * computed in the same pass, otherwise they are trusted to be the slopes of the
+   * given samples, as only the slope into the first sample is recomputed.
+   *
+   * Throws `std::invalid_argument` if the columns don't have the same size, or if the
+   * first time stamp isn't after the end of the signal.
+   */
+  void append_sorted(
+      utils::span<const double> times,
+      utils::span<const double> values,
+      utils::span<const double> derivatives = {});
+
+  /**
+   * Remove the samples at or after `time`, e.g., to replace the end of the signal by
+   * appending other samples.
    */
-  [[nodiscard]] std::shared_ptr<Signal> simplify() const;
+  void truncate(double time);
+
+  /**
+   * Keep only the breakpoints of the signal, i.e., remove the samples that are within
+   * `tolerance` of the segment between the samples kept around them.
+   *
+   * With the default tolerance of 0, only the samples on straight lines are removed
+   * (e.g., all but the first and last samples of each constant run), so the signal is
+   * unchanged at all time points. Otherwise, the simplified signal is within
+   * `tolerance` of the original one at all its time points.
+   */
+  [[nodiscard]] std::shared_ptr<Signal> simplify(double tolerance = 0.0) const;
   /**
    * Restrict/extend the signal to [s,t] with default value v where not defined.
    */
@@ -204,12 +533,18 @@ struct Signal {
   [[nodiscard]] std::shared_ptr<Signal>
   resize_shift(double start, double end, double fill, double dt) const;
 
-  Signal() : samples{} {}
+  /**
+   * Apply the affine map `scale * x + offset` to the values of the signal.
+   *
+   * As this doesn't change the time stamps, the output shares the same time points as
+   * the input and the derivatives are just scaled. Used to compute `x - c`, `c - x`
+   * and `-x` for predicates and negations.
+   */
+  [[nodiscard]] std::shared_ptr<Signal> affine(double scale, double offset) const;
+
+  Signal() = default;
 
-  Signal(const Signal& other) {
-    this->samples.reserve(other.size());
-    for (const auto& s : other) { this->push_back(s); }
-  }
+  Signal(const Signal& other) = default;
 
   /**
    * Create a Signal from a sequence of amples
@@ -219,7 +554,7 @@ struct Signal {
       typename = decltype(std::begin(std::declval<T>())),
       typename = decltype(std::end(std::declval<T>()))>
   Signal(const T& data) {
-    this->samples.reserve(data.size());
+    this->reserve(data.size());
     for (const auto& s : data) { this->push_back(s); }
   }
 
@@ -232,9 +567,64 @@ struct Signal {
           "Number of sample points and time points need to be equal.");
     }
 
-    size_t n = points.size();
-    this->samples.reserve(n);
-    for (size_t i = 0; i < n; i++) { this->push_back(times.at(i), points.at(i)); }
+    this->append({times.data(), times.size()}, {points.data(), points.size()});
+  }
+
+  /**
+   * Create a Signal by taking ownership of the given data points and time stamps.
+   *
+   * The time stamps are checked to be strictly monotonically increasing, and the
+   * derivatives are computed in a single pass over the columns.
+   */
+  Signal(std::vector<double>&& points, std::vector<double>&& times);
+
+  /**
+   * Create a Signal from the given columns, which may view external memory.
+   *
+   * The time stamps are checked to be strictly monotonically increasing, and the
+   * derivatives are computed (into a new column). The given columns are not copied.
+   */
+  Signal(Column&& points, Column&& times);
+
+  /**
+   * Create a Signal that only keeps the breakpoints of the given samples (see
+   * `simplify`), e.g., for piecewise constant channels (mode flags, setpoints, or
+   * quantized sensors) that are logged at a high rate.
+   *
+   * The breakpoints are compacted in place in the given buffers, which are then
+   * shrunk to fit, and the time stamps are checked as in the constructor.
+   */
+  [[nodiscard]] static std::shared_ptr<Signal> compressed(
+      std::vector<double>&& points,
+      std::vector<double>&& times,
+      double tolerance = 0.0);
+
+  /**
+   * Create a Signal from columns that are already known to be valid, e.g., the output
+   * of a kernel, or columns read back from a trusted source.
+   *
+   * Unlike the constructor, the time stamps are only checked to be strictly
+   * increasing in debug builds, and the given derivatives are trusted. If
+   * `derivatives` is empty, they are computed from the times and values. None of the
+   * columns are copied.
+   *
+   * Throws `std::invalid_argument` if the columns don't have the same size.
+   */
+  [[nodiscard]] static std::shared_ptr<Signal>
+  from_sorted(Column&& points, Column&& times, Column&& derivatives = {});
+
+  /**
+   * Get the columns of the time stamps, values, and derivatives, e.g., to share them
+   * with other signals or to expose them without copying.
+   */
+  [[nodiscard]] const Column& time_column() const {
+    return time_col;
+  }
+  [[nodiscard]] const Column& value_column() const {
+    return value_col;
+  }
+  [[nodiscard]] const Column& derivative_column() const {
+    return derivative_col;
   }
 
   /**
@@ -247,6 +637,167 @@ struct Signal {
   Signal(TIter&& start, TIter&& end) {
     for (auto i = start; i != end; i++) { this->push_back(*i); }
   }
+
+ private:
+  friend class BufferPool;
+  friend class TraceFile;
+
+  /// Get the sample at the given index without bounds checking.
+  [[nodiscard]] Sample sample_at(size_t i) const {
+    return Sample{time_col[i], value_col[i], derivative_col[i]};
+  }
+
+  /// Throw `std::out_of_range` if there is no sample at the given index.
+  void check_index(size_t i) const;
+
+  /// Compute the derivatives of all the samples from the times and values.
+  void compute_derivatives();
+};
+
+/**
+ * A lazy view of two signals over a common set of time points.
+ *
+ * Iterating over the view yields the values of both signals at every time point of
+ * either of them, in the range where both are defined, in increasing order of time.
+ * This is the same as iterating over the signals returned by `synchronize`, without
+ * creating them.
+ *
+ * The view refers to the columns of the signals, so the signals must outlive the view
+ * and must not be modified while it is in use.
+ */
+class SynchronizedView {
+ public:
+  struct Point {
+    double time;
+    double x;
+    double y;
+  };
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Point;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const Point*;
+    using reference         = const Point&;
+
+    const_iterator() = default;
+
+    reference operator*() const {
+      return point;
+    }
+    pointer operator->() const {
+      return &point;
+    }
+
+    const_iterator& operator++() {
+      view->advance(*this);
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto ret = *this;
+      view->advance(*this);
+      return ret;
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b) {
+      return (a.done == b.done) && (a.done || a.point.time == b.point.time);
+    }
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) {
+      return !(a == b);
+    }
+
+   private:
+    friend class SynchronizedView;
+
+    const SynchronizedView* view = nullptr;
+
+    /// Index of the last sample of each signal at or before the current time.
+    size_t i    = 0;
+    size_t j    = 0;
+    Point point = {};
+    bool done   = true;
+  };
+
+  SynchronizedView(const Signal& x, const Signal& y) :
+      xt{x.times()},
+      xv{x.values()},
+      xd{x.derivatives()},
+      yt{y.times()},
+      yv{y.values()},
+      yd{y.derivatives()} {}
+
+  [[nodiscard]] const_iterator begin() const {
+    auto it = const_iterator{};
+    it.view = this;
+    if (xt.empty() || yt.empty() || end_time() < begin_time()) {
+      return it;
+    }
+    const double t = begin_time();
+    it.i           = last_at(xt, t);
+    it.j           = last_at(yt, t);
+    it.point       = {t, value_at(xt, xv, xd, it.i, t), value_at(yt, yv, yd, it.j, t)};
+    it.done        = false;
+    return it;
+  }
+
+  [[nodiscard]] const_iterator end() const {
+    auto it = const_iterator{};
+    it.view = this;
+    return it;
+  }
+
+  [[nodiscard]] double begin_time() const {
+    return std::max(xt.front(), yt.front());
+  }
+
+  [[nodiscard]] double end_time() const {
+    return std::min(xt.back(), yt.back());
+  }
+
+  /**
+   * An upper bound on the number of points in the view.
+   */
+  [[nodiscard]] size_t size_hint() const {
+    return xt.size() + yt.size();
+  }
+
+ private:
+  /// Get the index of the last time point at or before `t`.
+  static size_t last_at(utils::span<const double> ts, double t) {
+    const auto it = std::upper_bound(ts.begin(), ts.end(), t);
+    return static_cast<size_t>(std::distance(ts.begin(), it)) - 1;
+  }
+
+  static double value_at(
+      utils::span<const double> ts,
+      utils::span<const double> vs,
+      utils::span<const double> ds,
+      size_t k,
+      double t) {
+    return (ts[k] == t) ? vs[k] : vs[k] + ds[k] * (t - ts[k]);
+  }
+
+  void advance(const_iterator& it) const {
+    if (it.point.time >= end_time()) {
+      it.done = true;
+      return;
+    }
+    // As the current time is before the end of both signals, both have a next sample.
+    const double tx = xt[it.i + 1];
+    const double ty = yt[it.j + 1];
+    const double t  = std::min(tx, ty);
+    if (tx == t) {
+      it.i++;
+    }
+    if (ty == t) {
+      it.j++;
+    }
+    it.point = {t, value_at(xt, xv, xd, it.i, t), value_at(yt, yv, yd, it.j, t)};
+  }
+
+  utils::span<const double> xt, xv, xd;
+  utils::span<const double> yt, yv, yd;
 };
 
 /**
@@ -254,7 +805,11 @@ struct Signal {
  * time instances the other is defined.
  *
  * The output signals are confined to the time range where both of them are defined,
- * thus can truncate a signal if the other isn't defined there.
+ * thus can truncate a signal if the other isn't defined there. They share their time
+ * stamps, which are only copied if one of them is modified.
+ *
+ * Kernels that just read the synchronized values once should iterate over a
+ * `SynchronizedView` instead.
  */
 std::tuple<std::shared_ptr<Signal>, std::shared_ptr<Signal>>
 synchronize(const std::shared_ptr<Signal>& x, const std::shared_ptr<Signal>& y);
@@ -262,6 +817,53 @@ synchronize(const std::shared_ptr<Signal>& x, const std::shared_ptr<Signal>& y);
 using SignalPtr = std::shared_ptr<Signal>;
 using Trace     = std::map<std::string, SignalPtr>;
 
+/**
+ * Create a trace where all the channels are sampled at the same time points.
+ *
+ * All the signals in the trace share a single time column, so operations on them
+ * (and on the robustness signals computed from them) don't need to synchronize the
+ * time stamps.
+ */
+Trace make_trace(
+    std::vector<double>&& times,
+    std::map<std::string, std::vector<double>>&& channels);
+
+/**
+ * Create a trace where each channel only keeps its breakpoints (see
+ * `Signal::compressed`), e.g., for piecewise constant channels.
+ *
+ * As the channels generally have different breakpoints, they don't share their time
+ * stamps, but all of them are much shorter than the given time points.
+ */
+Trace make_compressed_trace(
+    const std::vector<double>& times,
+    std::map<std::string, std::vector<double>>&& channels,
+    double tolerance = 0.0);
+
+/**
+ * Make the signals in the trace that are sampled at the same time points share a
+ * single time column.
+ *
+ * The returned signals view the columns of the signals in `trace`. If `synchronized`
+ * is `true`, the signals are assumed to be sampled at the same time points, and only
+ * their number of samples is checked.
+ *
+ * Throws `std::invalid_argument` if `synchronized` is `true` and the signals don't
+ * have the same number of samples.
+ */
+Trace share_time_bases(const Trace& trace, bool synchronized = false);
+
+/**
+ * Restrict the signal to the time range `[start, end]`, clipped to where the signal
+ * is defined.
+ *
+ * Samples are interpolated at the ends of the range if the signal isn't sampled
+ * there. If the signal is already sampled at both ends, the output views the time
+ * stamps and values of `x` instead of copying them. The output is empty if the range
+ * doesn't overlap the signal.
+ */
+SignalPtr slice(const SignalPtr& x, double start, double end);
+
 } // namespace signal_tl::signal
 
 #endif
@@ -5,9 +5,22 @@
 
 // IWYU pragma: begin_exports
 #include "signal_tl/ast.hpp"
+#include "signal_tl/batch.hpp"
+#include "signal_tl/cumulative.hpp"
+#include "signal_tl/discrete.hpp"
 #include "signal_tl/exception.hpp"
+#include "signal_tl/executor.hpp"
+#include "signal_tl/gradient.hpp"
+#include "signal_tl/monitor.hpp"
+#include "signal_tl/plan.hpp"
+#include "signal_tl/profile.hpp"
+#include "signal_tl/result_cache.hpp"
 #include "signal_tl/robustness.hpp"
+#include "signal_tl/satisfaction.hpp"
 #include "signal_tl/signal.hpp"
+#include "signal_tl/simplify.hpp"
+#include "signal_tl/symbol.hpp"
+#include "signal_tl/trace_file.hpp"
 // IWYU pragma: end_exports
 
 namespace signal_tl {
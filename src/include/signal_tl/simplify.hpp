@@ -0,0 +1,43 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_SIMPLIFY_HPP
+#define SIGNAL_TEMPORAL_LOGIC_SIMPLIFY_HPP
+
+#include "signal_tl/ast.hpp" // for Expr
+
+namespace signal_tl::ast {
+
+/// Options to control which rewrites `simplify` applies.
+struct SimplifyOptions {
+  /// If `true`, also apply the rewrites of the temporal operators that only hold for
+  /// the classic robustness (see `semantics::Semantics::Classic`): nested operators of
+  /// the same kind are merged, e.g., `Always(Always(phi, [c, d]), [a, b])` into
+  /// `Always(phi, [a + c, b + d])`, and `Until(true, phi, I)` into
+  /// `Eventually(phi, I)`.
+  bool classic = true;
+};
+
+/// Rewrite the formula into an equivalent formula that is cheaper to evaluate.
+///
+/// The rewrites are:
+///
+/// - Constant folding, e.g., `phi & false` is `false`, `phi | false` is `phi`, and the
+///   temporal operators over constants are the constants;
+/// - Negations are pushed down to the predicates (as De Morgan's laws, and
+///   `~Always(phi)` is `Eventually(~phi)`), where they are absorbed by flipping the
+///   comparison, e.g., `~(x > 1)` is `x <= 1`. This is only done where it doesn't add
+///   negations, e.g., not through `Until` or subformulas that are shared;
+/// - Nested, unshared conjunctions (and disjunctions) are flattened, and the
+///   predicates in them over the same signal, in the same direction, are collapsed to
+///   the tightest one, e.g., `(x > 1) & (x > 2)` is `x > 2`; and
+/// - The temporal rewrites of `SimplifyOptions::classic`.
+///
+/// The robustness of the simplified formula is the same as the original at every
+/// time point where the original is defined (constants are defined over the whole
+/// trace). Subformulas that are shared in the original are shared in the simplified
+/// formula, and subformulas that don't simplify are reused as they are.
+Expr simplify(const Expr& phi, const SimplifyOptions& options = {});
+
+} // namespace signal_tl::ast
+
+#endif
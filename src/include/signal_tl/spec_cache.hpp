@@ -0,0 +1,72 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_SPEC_CACHE_HPP
+#define SIGNAL_TEMPORAL_LOGIC_SPEC_CACHE_HPP
+
+#include "signal_tl/internal/filesystem.hpp" // for path
+#include "signal_tl/parser.hpp"              // for Specification
+
+#include <cstdint>     // for uint64_t
+#include <memory>      // for unique_ptr
+#include <string>      // for string
+#include <string_view> // for string_view
+
+namespace signal_tl {
+
+/// Hash the source of a specification, to key its caches (64-bit FNV-1a).
+uint64_t hash_source(std::string_view source);
+
+/// Serialize the specification in the binary specification cache format.
+///
+/// The format consists of a header, the table of the distinct nodes of the formulas
+/// (in post-order, with the operands of a node given by their indices in the table),
+/// and the names of the formulas and assertions with the index of their root node:
+///
+///     header:  "STLSPEC\0", version (u32), AST version (u32), library hash (u64),
+///              source hash (u64), #nodes (u64), #formulas (u64), #assertions (u64)
+///     nodes:   for each node: kind (u8), followed by its parameters and operands
+///     names:   for each formula, then each assertion: name length (u64), name,
+///              root node (u64)
+///
+/// with all the numbers in native byte order. The library hash is the hash of the
+/// version of the library, so that (along with the version of the AST) the caches are
+/// only loaded by the version that wrote them. Subformulas that are shared (e.g., a
+/// formula used by other formulas) are stored once, and are shared again when the
+/// specification is loaded. Thus, loading a specification doesn't expand the formulas
+/// into trees, and is linear in the size of the source.
+std::string serialize_specification(const Specification& spec, uint64_t source_hash);
+
+/// Load a specification serialized by `serialize_specification`.
+///
+/// Throws `std::invalid_argument` if the data isn't a valid specification cache.
+std::unique_ptr<Specification> deserialize_specification(std::string_view data);
+
+/// Get the source hash of the serialized specification (without loading it).
+///
+/// Throws `std::invalid_argument` if the data doesn't start with a valid header.
+uint64_t serialized_source_hash(std::string_view data);
+
+/// Write the specification parsed from a source with the given hash to a cache file.
+///
+/// The file is written to a temporary file next to it first, which then replaces it,
+/// so that concurrent readers and writers (e.g., the shards of a batch sharing a cache
+/// directory) only see complete caches.
+///
+/// Throws `std::runtime_error` if the file can't be written.
+void write_spec_cache(
+    const stdfs::path& path,
+    const Specification& spec,
+    uint64_t source_hash);
+
+/// Load the specification from a cache file, if it was written for a source with the
+/// given hash.
+///
+/// Returns `nullptr` if the file doesn't exist, was written for another source (or by
+/// another version of the library), or isn't a valid cache, so that the caller can
+/// parse the source instead.
+std::unique_ptr<Specification>
+read_spec_cache(const stdfs::path& path, uint64_t source_hash);
+
+} // namespace signal_tl
+
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_SYMBOL_HPP
+#define SIGNAL_TEMPORAL_LOGIC_SYMBOL_HPP
+
+#include <cstddef>     // for size_t
+#include <functional>  // for hash
+#include <string>      // for string
+#include <string_view> // for string_view
+
+namespace signal_tl {
+
+/// An interned string, used for the names of the signals in predicates.
+///
+/// Each distinct string is stored once, in a table shared by the whole program, and a
+/// symbol only holds a pointer to its string. Thus, copying, comparing and hashing
+/// symbols doesn't touch the strings, and formulas with many predicates over the same
+/// signals don't hold a copy of the name in each predicate. The interned strings are
+/// never freed.
+///
+/// Interning is thread-safe.
+class Symbol {
+ public:
+  /// The empty string.
+  Symbol();
+  Symbol(std::string_view name);
+  Symbol(const std::string& name) : Symbol{std::string_view{name}} {}
+  Symbol(const char* name) : Symbol{std::string_view{name}} {}
+
+  [[nodiscard]] const std::string& str() const {
+    return *interned;
+  }
+
+  operator const std::string&() const {
+    return *interned;
+  }
+
+  bool operator==(const Symbol& other) const {
+    return interned == other.interned;
+  }
+
+  bool operator!=(const Symbol& other) const {
+    return interned != other.interned;
+  }
+
+  /// Symbols are ordered by their strings, and not by the order they were interned
+  /// in.
+  bool operator<(const Symbol& other) const {
+    return interned != other.interned && *interned < *other.interned;
+  }
+
+  /// Get the number of distinct strings interned so far.
+  static size_t count();
+
+ private:
+  const std::string* interned;
+};
+
+} // namespace signal_tl
+
+template <>
+struct std::hash<signal_tl::Symbol> {
+  size_t operator()(const signal_tl::Symbol& symbol) const noexcept {
+    return std::hash<const std::string*>{}(&symbol.str());
+  }
+};
+
+#endif
@@ -0,0 +1,112 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_TRACE_FILE_HPP
+#define SIGNAL_TEMPORAL_LOGIC_TRACE_FILE_HPP
+
+#include "signal_tl/ast.hpp"                 // for Expr
+#include "signal_tl/internal/filesystem.hpp" // for path
+#include "signal_tl/signal.hpp"              // for SignalPtr, Trace
+
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint64_t
+#include <functional>  // for less
+#include <map>         // for map
+#include <memory>      // for shared_ptr
+#include <string>      // for string
+#include <string_view> // for string_view
+#include <vector>      // for vector
+
+namespace signal_tl::signal {
+
+/**
+ * A memory-mapped trace in the columnar binary trace format.
+ *
+ * The file consists of a header, a table of time bases, a table of channels, the
+ * names of the channels, and the columns (as native-endian `double`s, aligned to 8
+ * bytes):
+ *
+ *     header:      "STLTRACE", version (u32), #time bases (u32), #channels (u32),
+ *                  reserved (u32)
+ *     time bases:  for each time base: offset (u64), #samples (u64)
+ *     channels:    for each channel: name offset (u64), name length (u64),
+ *                  time base (u64), value offset (u64), derivative offset (u64)
+ *
+ * where all offsets are in bytes from the start of the file. Channels sampled at the
+ * same time points can share a time base, and the derivatives are stored along with
+ * the values, so loading a channel doesn't need to read any of its samples.
+ *
+ * Opening the file only reads the header and the tables, and `signal()` returns a
+ * signal that views the columns of the mapped file. Thus, only the pages of the
+ * channels that are used (by the evaluation of a formula, say) are read from disk.
+ * The signals keep the mapping alive, so they can outlive the `TraceFile`.
+ *
+ * The columns are not validated when they are loaded. A file written by
+ * `write_trace_file` is valid as long as it is not modified.
+ */
+class TraceFile {
+ public:
+  /**
+   * Map the trace file at the given path.
+   *
+   * Throws `std::runtime_error` if the file can't be mapped, and
+   * `std::invalid_argument` if it isn't a valid trace file (including if two of its
+   * channels have the same name).
+   */
+  explicit TraceFile(const stdfs::path& path);
+
+  /**
+   * Get the names of all the channels in the file.
+   */
+  [[nodiscard]] std::vector<std::string> channels() const;
+
+  [[nodiscard]] bool contains(std::string_view name) const;
+
+  /**
+   * Get the signal for the given channel, as a view of the mapped columns.
+   *
+   * Throws `std::out_of_range` if there is no such channel.
+   */
+  [[nodiscard]] SignalPtr signal(std::string_view name) const;
+
+  /**
+   * Get the trace with all the channels in the file.
+   */
+  [[nodiscard]] Trace trace() const;
+
+  /**
+   * Get the trace with only the given channels.
+   */
+  [[nodiscard]] Trace trace(const std::vector<std::string>& names) const;
+
+  /**
+   * Get the trace with the channels referenced by the formula.
+   */
+  [[nodiscard]] Trace trace(const ast::Expr& phi) const;
+
+ private:
+  struct Mapping;
+  struct Channel {
+    size_t time_base;
+    uint64_t values;
+    uint64_t derivatives;
+  };
+  struct TimeBase {
+    uint64_t offset;
+    uint64_t size;
+  };
+
+  std::shared_ptr<const Mapping> mapping;
+  std::vector<TimeBase> time_bases;
+  std::map<std::string, Channel, std::less<>> channel_table;
+};
+
+/**
+ * Write the trace to a file in the binary trace format (see `TraceFile`).
+ *
+ * Channels that have the same time points share their time base in the file.
+ */
+void write_trace_file(const stdfs::path& path, const Trace& trace);
+
+} // namespace signal_tl::signal
+
+#endif
@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <string>
 #include <variant>
 #include <vector>
 
@@ -78,8 +79,39 @@ struct ParserState {
 struct GlobalParserState {
   std::map<std::string, ast::Expr> formulas;
   std::map<std::string, ast::Expr> assertions;
+
+  /// The names of the formulas, in the order they were defined.
+  std::vector<std::string> formula_order;
+
+  /// When parts of a specification are parsed concurrently, a formula may refer to
+  /// formulas defined in an earlier part. If this is set, such references are
+  /// replaced by placeholders (see `reference_to`), which are resolved once all the
+  /// parts are parsed.
+  bool defer_references = false;
+
+  /// Set if a placeholder was the operand of an operator that simplifies its
+  /// operands (e.g., `implies`), which can't be done until the placeholder is
+  /// resolved. The part must then be parsed again once the earlier parts are known.
+  bool needs_reparse = false;
 };
 
+/// Create a placeholder for a reference to the formula `id`, as a predicate whose
+/// name isn't a valid identifier.
+inline ast::Expr reference_to(const std::string& id) {
+  return ast::Predicate{std::string(1, '\0') + id, ast::ComparisonOp::GE, 0.0};
+}
+
+/// Check if the expression is a placeholder created by `reference_to`.
+inline bool is_reference(const ast::Expr& e) {
+  const auto* p = std::get_if<ast::Predicate>(&e);
+  return p != nullptr && !p->name.str().empty() && p->name.str().front() == '\0';
+}
+
+/// Get the name of the formula that the placeholder refers to.
+inline std::string referenced_formula(const ast::Predicate& placeholder) {
+  return placeholder.name.str().substr(1);
+}
+
 template <typename Rule>
 struct action : peg::nothing<Rule> {};
 
@@ -286,7 +318,7 @@ struct action<OrTerm> : peg::require_apply {
 
 template <>
 struct action<ImpliesTerm> {
-  static void apply0(GlobalParserState&, ParserState& state) {
+  static void apply0(GlobalParserState& global_state, ParserState& state) {
     // We expect the state to contain exactly 2 terms
     assert(state.terms.size() == 2);
     // TODO(anand): Verify the order of the Terms.
@@ -294,6 +326,9 @@ struct action<ImpliesTerm> {
     state.terms.pop_back();
     auto lhs = state.terms.back();
     state.terms.pop_back();
+    if (is_reference(lhs) || is_reference(rhs)) {
+      global_state.needs_reparse = true;
+    }
     state.result = ::signal_tl::Implies(lhs, rhs);
     // There should be exactly 0 terms left now.
     assert(state.terms.empty());
@@ -302,13 +337,16 @@ struct action<ImpliesTerm> {
 
 template <>
 struct action<IffTerm> {
-  static void apply0(GlobalParserState&, ParserState& state) {
+  static void apply0(GlobalParserState& global_state, ParserState& state) {
     // We expect the state to contain exactly 2 terms
     assert(state.terms.size() == 2);
     auto rhs = state.terms.back();
     state.terms.pop_back();
     auto lhs = state.terms.back();
     state.terms.pop_back();
+    if (is_reference(lhs) || is_reference(rhs)) {
+      global_state.needs_reparse = true;
+    }
     state.result = ::signal_tl::Iff(lhs, rhs);
     // There should be exactly 0 terms left now.
     assert(state.terms.empty());
@@ -317,13 +355,16 @@ struct action<IffTerm> {
 
 template <>
 struct action<XorTerm> {
-  static void apply0(GlobalParserState&, ParserState& state) {
+  static void apply0(GlobalParserState& global_state, ParserState& state) {
     // We expect the state to contain exactly 2 terms
     assert(state.terms.size() == 2);
     auto rhs = state.terms.back();
     state.terms.pop_back();
     auto lhs = state.terms.back();
     state.terms.pop_back();
+    if (is_reference(lhs) || is_reference(rhs)) {
+      global_state.needs_reparse = true;
+    }
     state.result = ::signal_tl::Xor(lhs, rhs);
     // There should be exactly 0 terms left now.
     assert(state.terms.empty());
@@ -434,8 +475,14 @@ struct action<Term> {
       // And invalidate the sub-result
       state.result = std::nullopt;
     } else if (!state.identifiers.empty()) { // And if we have an id
-      // Copy the pointer to the formula with the corresponding id
-      state.terms.push_back(global_state.formulas.at(state.identifiers.back()));
+      const auto& id = state.identifiers.back();
+      if (global_state.defer_references && global_state.formulas.count(id) == 0) {
+        // The formula may be defined in an earlier part of the specification.
+        state.terms.push_back(reference_to(id));
+      } else {
+        // Copy the pointer to the formula with the corresponding id
+        state.terms.push_back(global_state.formulas.at(id));
+      }
       state.identifiers.pop_back();
     } else {
       // Otherwise, it doesn't make sense that there are no results, as this
@@ -497,6 +544,7 @@ struct action<DefineFormula> {
           fmt::format("possible redefinition of Formula with id: \"{}\"", it->first),
           in);
     }
+    global_state.formula_order.push_back(id);
 
     assert(state.terms.empty());
   }
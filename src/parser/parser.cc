@@ -3,12 +3,26 @@
 #include "error_messages.hpp" // for control
 #include "grammar.hpp"        // for SpecificationFile
 
+#include "signal_tl/executor.hpp"       // for Executor, TaskGroup, ThreadPool
+#include "signal_tl/internal/utils.hpp" // for overloaded
+#include "signal_tl/spec_cache.hpp"     // for hash_source, read_spec_cache, ...
+
 #include <tao/pegtl/contrib/analyze.hpp> // for analyze
 #include <tao/pegtl/contrib/trace.hpp>   // for standard_trace
+#include <tao/pegtl/memory_input.hpp>    // for memory_input
 #include <tao/pegtl/nothing.hpp>         // for nothing
 #include <tao/pegtl/parse.hpp>           // for parse
+#include <tao/pegtl/read_input.hpp>      // for read_input
 
-#include <stdexcept> // for logic_error
+#include <algorithm>     // for min
+#include <cctype>        // for isspace
+#include <cstdint>       // for uint64_t
+#include <exception>     // for exception
+#include <optional>      // for optional, nullopt
+#include <stdexcept>     // for logic_error, runtime_error
+#include <unordered_map> // for unordered_map
+#include <utility>       // for move, pair
+#include <vector>        // for vector
 
 // #define NDEBUG
 #include <cassert>
@@ -17,12 +31,12 @@ namespace {
 
 namespace peg = tao::pegtl;
 using namespace signal_tl;
+using parser::actions::GlobalParserState;
 
 template <typename ParseInput>
-std::unique_ptr<Specification> _parse(ParseInput&& input) {
+void parse_into(ParseInput& input, GlobalParserState& global_state) {
   // bool success =
   //     peg::parse<grammar::SpecificationFile, peg::nothing, parser::control>(input);
-  auto global_state     = parser::actions::GlobalParserState{};
   auto top_local_state  = parser::actions::ParserState{};
   top_local_state.level = 0;
   bool success =
@@ -30,9 +44,6 @@ std::unique_ptr<Specification> _parse(ParseInput&& input) {
           input, global_state, top_local_state);
   if (success) {
     assert(top_local_state.level == 0);
-    auto spec = std::make_unique<Specification>(
-        std::move(global_state.formulas), std::move(global_state.assertions));
-    return spec;
   } else {
     // LCOV_EXCL_START
     throw std::logic_error(
@@ -40,6 +51,274 @@ std::unique_ptr<Specification> _parse(ParseInput&& input) {
     // LCOV_EXCL_STOP
   }
 }
+
+template <typename ParseInput>
+std::unique_ptr<Specification> _parse(ParseInput&& input) {
+  auto global_state = GlobalParserState{};
+  parse_into(input, global_state);
+  return std::make_unique<Specification>(
+      std::move(global_state.formulas), std::move(global_state.assertions));
+}
+
+/// The `[begin, end)` offsets of the top-level commands in the source.
+using CommandBounds = std::vector<std::pair<size_t, size_t>>;
+
+/// Find the top-level commands (balanced S-expressions) in the source, without
+/// parsing them.
+///
+/// Returns nothing if the source isn't a list of S-expressions, in which case the
+/// parser reports the error.
+std::optional<CommandBounds> split_commands(std::string_view source) {
+  auto commands = CommandBounds{};
+  size_t depth  = 0;
+  size_t begin  = 0;
+  for (size_t i = 0; i < source.size(); i++) {
+    const char c = source[i];
+    if (c == ';') { // Comments run until the end of the line.
+      i = source.find('\n', i);
+      if (i == std::string_view::npos) {
+        break;
+      }
+    } else if (c == '(') {
+      if (depth == 0) {
+        begin = i;
+      }
+      depth++;
+    } else if (c == ')') {
+      if (depth == 0) {
+        return std::nullopt;
+      }
+      depth--;
+      if (depth == 0) {
+        commands.emplace_back(begin, i + 1);
+      }
+    } else if (depth == 0 && std::isspace(static_cast<unsigned char>(c)) == 0) {
+      return std::nullopt;
+    }
+  }
+  if (depth != 0) {
+    return std::nullopt;
+  }
+  return commands;
+}
+
+/// Replaces the placeholders in the formulas of a part of the specification by the
+/// formulas they refer to.
+///
+/// The nodes that don't contain placeholders are kept as they are, and the nodes
+/// that are shared are rebuilt only once, so the formulas share their subformulas
+/// as they do in the sequentially parsed specification.
+class ReferenceResolver {
+ public:
+  /// Resolve the placeholders with the given formulas (from the earlier parts).
+  explicit ReferenceResolver(const std::map<std::string, ast::Expr>& formulas_) :
+      formulas{formulas_} {}
+
+  /// Throws `std::out_of_range` if a placeholder refers to an unknown formula.
+  ast::Expr resolve(const ast::Expr& e) {
+    return resolve_node(e).value_or(e);
+  }
+
+ private:
+  /// Get the node with its placeholders resolved, or nothing if it has none.
+  std::optional<ast::Expr> resolve_node(const ast::Expr& e) {
+    const void* addr = ast::node_address(e);
+    if (addr == nullptr) {
+      if (!parser::actions::is_reference(e)) {
+        return std::nullopt;
+      }
+      const auto& placeholder = std::get<ast::Predicate>(e);
+      return formulas.at(parser::actions::referenced_formula(placeholder));
+    }
+    if (const auto it = memo.find(addr); it != memo.end()) {
+      return it->second;
+    }
+    auto resolved = rebuild(e);
+    memo.emplace(addr, resolved);
+    return resolved;
+  }
+
+  /// Rebuild the node from its resolved operands (as the parser would have built
+  /// it), or return nothing if none of them changed.
+  std::optional<ast::Expr> rebuild(const ast::Expr& e) {
+    using Result = std::optional<ast::Expr>;
+    return std::visit(
+        utils::overloaded{
+            [](const ast::Const&) -> Result { return std::nullopt; },
+            [](const ast::Predicate&) -> Result { return std::nullopt; },
+            [&](const ast::NotPtr& n) -> Result {
+              auto arg = resolve_node(n->arg);
+              return (arg) ? Result{Not(std::move(*arg))} : std::nullopt;
+            },
+            [&](const ast::AndPtr& n) -> Result {
+              auto args = resolve_args(n->args);
+              return (args) ? Result{And(std::move(*args))} : std::nullopt;
+            },
+            [&](const ast::OrPtr& n) -> Result {
+              auto args = resolve_args(n->args);
+              return (args) ? Result{Or(std::move(*args))} : std::nullopt;
+            },
+            [&](const ast::AlwaysPtr& n) -> Result {
+              auto arg = resolve_node(n->arg);
+              return (arg) ? Result{Always(std::move(*arg), n->interval)}
+                           : std::nullopt;
+            },
+            [&](const ast::EventuallyPtr& n) -> Result {
+              auto arg = resolve_node(n->arg);
+              return (arg) ? Result{Eventually(std::move(*arg), n->interval)}
+                           : std::nullopt;
+            },
+            [&](const ast::UntilPtr& n) -> Result {
+              auto lhs = resolve_node(n->args.first);
+              auto rhs = resolve_node(n->args.second);
+              if (!lhs && !rhs) {
+                return std::nullopt;
+              }
+              return Until(
+                  lhs.value_or(n->args.first),
+                  rhs.value_or(n->args.second),
+                  n->interval);
+            }},
+        e);
+  }
+
+  std::optional<std::vector<ast::Expr>>
+  resolve_args(const std::vector<ast::Expr>& args) {
+    auto out     = std::vector<ast::Expr>{};
+    bool changed = false;
+    out.reserve(args.size());
+    for (const auto& arg : args) {
+      auto resolved = resolve_node(arg);
+      changed       = changed || resolved.has_value();
+      out.push_back(resolved.value_or(arg));
+    }
+    return (changed) ? std::optional{std::move(out)} : std::nullopt;
+  }
+
+  const std::map<std::string, ast::Expr>& formulas;
+  std::unordered_map<const void*, std::optional<ast::Expr>> memo;
+};
+
+/// Merge the parts of the specification, in order, into one specification.
+///
+/// Returns `nullptr` if the parts don't make a valid specification.
+std::unique_ptr<Specification> merge_parts(
+    std::string_view source,
+    const CommandBounds& bounds,
+    std::vector<GlobalParserState>& parts) {
+  auto merged   = GlobalParserState{};
+  auto resolver = ReferenceResolver{merged.formulas};
+  for (size_t k = 0; k < parts.size(); k++) {
+    auto& part = parts[k];
+    if (part.needs_reparse) {
+      // Parse the part again, now that the formulas it refers to are known.
+      const auto [begin, end] = bounds[k];
+      auto in                 = peg::memory_input<>(
+          source.data() + begin, end - begin, "from_content");
+      parse_into(in, merged);
+      continue;
+    }
+
+    // Resolve the formulas in the order they were defined, so that the formulas
+    // used by later ones are already resolved.
+    auto formulas = std::vector<std::pair<std::string, ast::Expr>>{};
+    for (const auto& name : part.formula_order) {
+      formulas.emplace_back(name, resolver.resolve(part.formulas.at(name)));
+    }
+    auto assertions = std::vector<std::pair<std::string, ast::Expr>>{};
+    for (const auto& [name, phi] : part.assertions) {
+      assertions.emplace_back(name, resolver.resolve(phi));
+    }
+    for (auto& [name, phi] : formulas) {
+      if (!merged.formulas.emplace(name, std::move(phi)).second) {
+        return nullptr;
+      }
+      merged.formula_order.push_back(name);
+    }
+    for (auto& [name, phi] : assertions) {
+      if (!merged.assertions.emplace(name, std::move(phi)).second) {
+        return nullptr;
+      }
+    }
+  }
+  return std::make_unique<Specification>(
+      std::move(merged.formulas), std::move(merged.assertions));
+}
+
+/// Parse the commands of the specification concurrently, in contiguous parts.
+///
+/// A formula may refer to formulas defined in earlier parts, so these references are
+/// resolved once all the parts are parsed. Returns `nullptr` if the specification
+/// can't be parsed this way (for example, if it isn't valid), so that the caller can
+/// parse it sequentially instead (which reports the errors).
+std::unique_ptr<Specification>
+parse_concurrently(std::string_view source, Executor* executor) {
+  const auto commands = split_commands(source);
+  if (!commands || commands->size() < 2) {
+    return nullptr;
+  }
+  // A few parts per thread, to balance the load.
+  const size_t num_commands = commands->size();
+  const size_t num_parts    = std::min(num_commands, 4 * executor->concurrency());
+
+  auto bounds = CommandBounds(num_parts);
+  auto parts  = std::vector<GlobalParserState>(num_parts);
+  try {
+    auto tasks = TaskGroup{executor};
+    for (size_t k = 0; k < num_parts; k++) {
+      const size_t first = k * num_commands / num_parts;
+      const size_t last  = (k + 1) * num_commands / num_parts - 1;
+      bounds[k]          = {(*commands)[first].first, (*commands)[last].second};
+      tasks.run([&, k]() {
+        const auto [begin, end]   = bounds[k];
+        auto in                   = peg::memory_input<>(
+            source.data() + begin, end - begin, "from_content");
+        parts[k].defer_references = true;
+        parse_into(in, parts[k]);
+      });
+    }
+    tasks.wait();
+    return merge_parts(source, bounds, parts);
+  } catch (const std::exception&) {
+    return nullptr;
+  }
+}
+
+/// Parse the source as configured by the options, where `parse_sequentially` parses
+/// it on the calling thread.
+template <typename ParseSequentially>
+std::unique_ptr<Specification> parse_with_options(
+    std::string_view source,
+    const parser::ParseOptions& options,
+    ParseSequentially&& parse_sequentially) {
+  const uint64_t hash = (options.cache) ? hash_source(source) : 0;
+  if (options.cache) {
+    if (auto spec = read_spec_cache(*options.cache, hash)) {
+      return spec;
+    }
+  }
+
+  auto pool      = std::unique_ptr<ThreadPool>{};
+  auto* executor = options.executor;
+  if (executor == nullptr && options.num_threads != 1) {
+    pool     = std::make_unique<ThreadPool>(options.num_threads);
+    executor = pool.get();
+  }
+  auto spec = (executor != nullptr) ? parse_concurrently(source, executor) : nullptr;
+  if (spec == nullptr) {
+    spec = parse_sequentially();
+  }
+
+  if (options.cache) {
+    try {
+      write_spec_cache(*options.cache, *spec, hash);
+    } catch (const std::runtime_error&) {
+      // The cache only saves time.
+    }
+  }
+  return spec;
+}
+
 } // namespace
 
 namespace signal_tl::parser {
@@ -54,6 +333,20 @@ std::unique_ptr<Specification> from_file(const stdfs::path& input) {
   return _parse(in);
 }
 
+std::unique_ptr<Specification>
+from_string(std::string_view input, const ParseOptions& options) {
+  return parse_with_options(input, options, [&]() { return from_string(input); });
+}
+
+std::unique_ptr<Specification>
+from_file(const stdfs::path& input, const ParseOptions& options) {
+  // The file is read once, for both the source hash and the parser.
+  peg::read_input<> in(input);
+  const auto source =
+      std::string_view{in.begin(), static_cast<size_t>(in.end() - in.begin())};
+  return parse_with_options(source, options, [&]() { return _parse(in); });
+}
+
 } // namespace signal_tl::parser
 
 // LCOV_EXCL_START
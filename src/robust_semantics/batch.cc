@@ -0,0 +1,261 @@
+#include "signal_tl/batch.hpp"
+#include "signal_tl/ast.hpp"
+#include "signal_tl/executor.hpp"
+#include "signal_tl/plan.hpp"
+#include "signal_tl/robustness.hpp"
+#include "signal_tl/simplify.hpp"
+#include "signal_tl/trace_file.hpp"
+
+#include "operators.hpp" // for get_executor, simplify_options
+
+#include <exception>     // for exception
+#include <fmt/format.h>  // for format
+#include <fstream>       // for ifstream, ofstream
+#include <ios>           // for ios
+#include <iterator>      // for istreambuf_iterator
+#include <limits>        // for numeric_limits
+#include <memory>        // for unique_ptr
+#include <mutex>         // for mutex, lock_guard
+#include <optional>      // for optional, nullopt
+#include <stdexcept>     // for invalid_argument, runtime_error
+#include <string>        // for string
+#include <string_view>   // for string_view
+#include <unordered_set> // for unordered_set
+#include <utility>       // for move
+
+namespace signal_tl::semantics {
+
+namespace {
+
+/// Quote a field of the output if it has a separator, a quote, or a line break (as
+/// in RFC 4180). Line breaks are replaced by spaces, as the rows are read back one
+/// line at a time when resuming.
+std::string csv_field(std::string_view field) {
+  if (field.find_first_of(",\"\r\n") == std::string_view::npos) {
+    return std::string{field};
+  }
+  auto out = std::string{"\""};
+  for (const char c : field) {
+    if (c == '"') {
+      out.push_back('"');
+    }
+    out.push_back((c == '\n' || c == '\r') ? ' ' : c);
+  }
+  out.push_back('"');
+  return out;
+}
+
+/// Get the first field of a row, as it is written (i.e., quoted if needed).
+std::string_view first_field(std::string_view row) {
+  if (row.empty() || row.front() != '"') {
+    return row.substr(0, row.find(','));
+  }
+  size_t i = 1;
+  while (i < row.size()) {
+    if (row[i] == '"') {
+      // A doubled quote is a quote in the field.
+      if (i + 1 < row.size() && row[i + 1] == '"') {
+        i += 2;
+        continue;
+      }
+      return row.substr(0, i + 1);
+    }
+    i++;
+  }
+  return row;
+}
+
+std::string get_header(const std::vector<std::string>& names) {
+  auto out = std::string{"trace"};
+  for (const auto& name : names) { out += "," + csv_field(name); }
+  return out + ",error";
+}
+
+std::string_view trim(std::string_view line) {
+  const auto begin = line.find_first_not_of(" \t\r");
+  if (begin == std::string_view::npos) {
+    return {};
+  }
+  const auto end = line.find_last_not_of(" \t\r");
+  return line.substr(begin, end - begin + 1);
+}
+
+/// Get the (quoted) traces that have a row in the output of an earlier run, or
+/// `nullopt` if it doesn't have a header yet. A partial row at the end is dropped
+/// from the file.
+std::optional<std::unordered_set<std::string>>
+read_finished(const stdfs::path& output, const std::string& header) {
+  auto in = std::ifstream{output, std::ios::binary};
+  if (!in) {
+    throw std::runtime_error(
+        fmt::format("Unable to open the results to resume: {}", output.string()));
+  }
+  auto data =
+      std::string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+  in.close();
+
+  // The rows are written one line at a time, so only the last one can be partial.
+  const auto last     = data.rfind('\n');
+  const auto complete = (last == std::string::npos) ? 0 : last + 1;
+  if (complete < data.size()) {
+    stdfs::resize_file(output, complete);
+    data.resize(complete);
+  }
+  if (data.empty()) {
+    return std::nullopt;
+  }
+
+  auto rows      = std::string_view{data};
+  const auto eol = rows.find('\n');
+  if (rows.substr(0, eol) != header) {
+    throw std::invalid_argument(fmt::format(
+        "The results in {} are not of the same formulas: expected the header '{}'",
+        output.string(),
+        header));
+  }
+  rows.remove_prefix(eol + 1);
+
+  auto out = std::unordered_set<std::string>{};
+  while (!rows.empty()) {
+    const auto end = rows.find('\n');
+    out.emplace(first_field(rows.substr(0, end)));
+    rows.remove_prefix(end + 1);
+  }
+  return out;
+}
+
+} // namespace
+
+std::vector<stdfs::path> read_manifest(const stdfs::path& manifest) {
+  auto in = std::ifstream{manifest};
+  if (!in) {
+    throw std::runtime_error(
+        fmt::format("Unable to open trace manifest: {}", manifest.string()));
+  }
+  const auto dir = manifest.parent_path();
+  auto out       = std::vector<stdfs::path>{};
+  auto line      = std::string{};
+  while (std::getline(in, line)) {
+    const auto entry = trim(line);
+    if (entry.empty() || entry.front() == '#') {
+      continue;
+    }
+    const auto path = stdfs::path{std::string{entry}};
+    out.push_back(path.is_relative() ? dir / path : path);
+  }
+  return out;
+}
+
+std::vector<stdfs::path>
+select_shard(const std::vector<stdfs::path>& traces, const Shard& shard) {
+  if (shard.count == 0 || shard.index >= shard.count) {
+    throw std::invalid_argument(fmt::format(
+        "Invalid shard {} of {}: expected an index less than the number of shards",
+        shard.index,
+        shard.count));
+  }
+  auto out = std::vector<stdfs::path>{};
+  out.reserve(traces.size() / shard.count + 1);
+  for (size_t i = shard.index; i < traces.size(); i += shard.count) {
+    out.push_back(traces[i]);
+  }
+  return out;
+}
+
+BatchSummary run_batch(
+    const std::map<std::string, ast::Expr>& formulas,
+    const std::vector<stdfs::path>& traces,
+    const stdfs::path& output,
+    const BatchOptions& options) {
+  auto names    = std::vector<std::string>{};
+  auto compiled = std::map<std::string, ast::Expr>{};
+  for (const auto& [name, phi] : formulas) {
+    names.push_back(name);
+    compiled.emplace(
+        name,
+        options.evaluation.simplify
+            ? ast::simplify(phi, simplify_options(options.evaluation))
+            : phi);
+  }
+  const auto plan   = EvaluationPlan{compiled};
+  const auto header = get_header(names);
+
+  auto finished = std::unordered_set<std::string>{};
+  auto append   = false;
+  if (options.resume && stdfs::exists(output)) {
+    if (auto rows = read_finished(output, header)) {
+      finished = std::move(*rows);
+      append   = true;
+    }
+  }
+
+  auto out = std::ofstream{
+      output, std::ios::binary | (append ? std::ios::app : std::ios::trunc)};
+  if (!out) {
+    throw std::runtime_error(
+        fmt::format("Unable to open the results for writing: {}", output.string()));
+  }
+  if (!append) {
+    out << header << '\n' << std::flush;
+  }
+
+  auto summary = BatchSummary{};
+  auto pending = std::vector<const stdfs::path*>{};
+  for (const auto& path : traces) {
+    if (finished.count(csv_field(path.string())) > 0) {
+      summary.skipped++;
+    } else {
+      pending.push_back(&path);
+    }
+  }
+
+  auto pool     = std::unique_ptr<ThreadPool>{};
+  auto executor = get_executor(options.evaluation, pool);
+
+  // As in `compute_robustness_batch`, each trace is evaluated in its own task, and
+  // the plan is free to evaluate its operations on the same executor.
+  constexpr double NaN   = std::numeric_limits<double>::quiet_NaN();
+  auto trace_options     = options.evaluation;
+  trace_options.executor = executor;
+  trace_options.profile  = nullptr;
+
+  auto mutex                = std::mutex{};
+  const auto evaluate_trace = [&](const stdfs::path& path) {
+    auto row    = csv_field(path.string());
+    auto failed = false;
+    try {
+      const auto file = signal::TraceFile{path};
+      const auto ys   = plan.evaluate(file.trace(plan.signals()), trace_options);
+      for (const auto& y : ys) {
+        row += fmt::format(",{}", (y->empty()) ? NaN : y->front().value);
+      }
+      row += ",\n";
+    } catch (const std::exception& e) {
+      failed = true;
+      row += std::string(names.size(), ',');
+      row += "," + csv_field(e.what()) + "\n";
+    }
+
+    const auto lock = std::lock_guard{mutex};
+    out << row << std::flush;
+    if (failed) {
+      summary.failed++;
+    } else {
+      summary.evaluated++;
+    }
+  };
+
+  auto tasks = TaskGroup{executor};
+  for (const auto* path : pending) {
+    tasks.run([&evaluate_trace, path]() { evaluate_trace(*path); });
+  }
+  tasks.wait();
+
+  if (!out) {
+    throw std::runtime_error(
+        fmt::format("Unable to write the results to: {}", output.string()));
+  }
+  return summary;
+}
+
+} // namespace signal_tl::semantics
@@ -0,0 +1,397 @@
+#include "signal_tl/ast.hpp"
+#include "signal_tl/satisfaction.hpp"
+#include "signal_tl/signal.hpp"
+
+#include "signal_tl/internal/utils.hpp" // for overloaded
+
+#include "operators.hpp" // for get_time_range
+
+#include <algorithm>     // for max, min, upper_bound
+#include <cstddef>       // for size_t
+#include <iterator>      // for prev
+#include <limits>        // for numeric_limits
+#include <optional>      // for optional, nullopt
+#include <stdexcept>     // for out_of_range
+#include <unordered_map> // for unordered_map
+#include <utility>       // for move, pair
+#include <variant>       // for visit
+#include <vector>        // for vector
+
+namespace signal_tl::semantics {
+using namespace signal;
+
+namespace {
+constexpr double TOP = std::numeric_limits<double>::infinity();
+
+/// Append an interval to a set, merging it with the last interval if they overlap.
+/// The intervals must be added in order of their start.
+void append(IntervalSet& xs, TimeInterval x) {
+  if (!xs.empty() && xs.back().second >= x.first) {
+    xs.back().second = std::max(xs.back().second, x.second);
+  } else {
+    xs.push_back(x);
+  }
+}
+
+/// Clamp the range to the domain. If they don't overlap, this is the closest end of
+/// the domain.
+TimeInterval clamp(TimeInterval range, TimeInterval domain) {
+  const auto at = [&domain](double t) {
+    return std::min(std::max(t, domain.first), domain.second);
+  };
+  return {at(range.first), at(range.second)};
+}
+
+IntervalSet clip(const IntervalSet& xs, TimeInterval range) {
+  auto out = IntervalSet{};
+  for (const auto& [lo, hi] : xs) {
+    if (hi >= range.first && lo <= range.second) {
+      out.emplace_back(std::max(lo, range.first), std::min(hi, range.second));
+    }
+  }
+  return out;
+}
+
+IntervalSet intersect(const IntervalSet& xs, const IntervalSet& ys) {
+  auto out = IntervalSet{};
+  for (size_t i = 0, j = 0; i < xs.size() && j < ys.size();) {
+    const double lo = std::max(xs[i].first, ys[j].first);
+    const double hi = std::min(xs[i].second, ys[j].second);
+    if (lo <= hi) {
+      out.emplace_back(lo, hi);
+    }
+    (xs[i].second < ys[j].second) ? i++ : j++;
+  }
+  return out;
+}
+
+IntervalSet unite(const IntervalSet& xs, const IntervalSet& ys) {
+  auto out = IntervalSet{};
+  out.reserve(xs.size() + ys.size());
+  for (size_t i = 0, j = 0; i < xs.size() || j < ys.size();) {
+    const bool take_x = j == ys.size() || (i < xs.size() && xs[i].first <= ys[j].first);
+    append(out, (take_x) ? xs[i++] : ys[j++]);
+  }
+  return out;
+}
+
+/// The complement of the set within the range. As all the intervals are closed, the
+/// boundaries of the set are in both the set and its complement.
+IntervalSet complement(const IntervalSet& xs, TimeInterval range) {
+  const auto clipped = clip(xs, range);
+  if (clipped.empty()) {
+    return {range};
+  }
+  auto out  = IntervalSet{};
+  double lo = range.first;
+  for (const auto& [a, b] : clipped) {
+    if (lo < a) {
+      out.emplace_back(lo, a);
+    }
+    lo = b;
+  }
+  if (lo < range.second) {
+    out.emplace_back(lo, range.second);
+  }
+  return out;
+}
+
+/// Get the interval that contains `t`, if any.
+std::optional<TimeInterval> find(const IntervalSet& xs, double t) {
+  const auto it = std::upper_bound(
+      xs.begin(), xs.end(), t, [](double s, const TimeInterval& x) {
+        return s < x.first;
+      });
+  if (it == xs.begin() || std::prev(it)->second < t) {
+    return std::nullopt;
+  }
+  return *std::prev(it);
+}
+
+bool covers(const IntervalSet& xs, TimeInterval range) {
+  return xs.size() == 1 && xs[0].first <= range.first && range.second <= xs[0].second;
+}
+
+/// The time points `t` for which the window `[t + a, t + b]` meets the set.
+///
+/// As with the robustness, the window is clipped to the end of the signal (i.e., the
+/// signal is extended as a constant after `end`).
+IntervalSet shift_back(const IntervalSet& xs, double a, double b, double end) {
+  auto out = IntervalSet{};
+  out.reserve(xs.size());
+  for (const auto& [lo, hi] : xs) {
+    append(out, {lo - b, (hi >= end) ? TOP : hi - a});
+  }
+  return out;
+}
+
+/// The time points `t` where `xs` holds over `[t, s]` for some `s` in `[t + a, t + b]`
+/// where `ys` holds.
+IntervalSet until_set(
+    const IntervalSet& xs,
+    const IntervalSet& ys,
+    double a,
+    double b,
+    double end) {
+  auto out = IntervalSet{};
+  size_t k = 0;
+  for (const auto& x : xs) {
+    while (k < ys.size() && ys[k].second < x.first) { k++; }
+    // The parts of `ys` in `x`.
+    auto pieces = IntervalSet{};
+    for (size_t m = k; m < ys.size() && ys[m].first <= x.second; m++) {
+      pieces.emplace_back(
+          std::max(ys[m].first, x.first), std::min(ys[m].second, x.second));
+    }
+    for (const auto& y : clip(shift_back(pieces, a, b, end), x)) { append(out, y); }
+  }
+  return out;
+}
+
+/// The time points in the range where the predicate holds.
+IntervalSet
+predicate_set(const Signal& x, ast::ComparisonOp op, double rhs, TimeInterval range) {
+  const double sign = (op == ast::ComparisonOp::GE || op == ast::ComparisonOp::GT)
+                          ? 1.0
+                          : -1.0;
+  const auto ts  = x.times();
+  const auto vs  = x.values();
+  const auto ds  = x.derivatives();
+  const size_t n = ts.size();
+
+  auto out = IntervalSet{};
+  auto it  = std::upper_bound(ts.begin(), ts.end(), range.first);
+  for (size_t i = (it == ts.begin()) ? 0 : static_cast<size_t>(it - ts.begin()) - 1;
+       i < n && ts[i] <= range.second;
+       i++) {
+    const double t0 = ts[i];
+    const double f0 = sign * (vs[i] - rhs);
+    if (i + 1 == n) {
+      if (f0 >= 0) {
+        append(out, {t0, t0});
+      }
+      break;
+    }
+    // The value at the end of the segment, from the left.
+    const double t1 = ts[i + 1];
+    const double f1 = sign * (vs[i] + ds[i] * (t1 - t0) - rhs);
+    if (f0 >= 0 && f1 >= 0) {
+      append(out, {t0, t1});
+    } else if (f0 >= 0) {
+      append(out, {t0, t0 + (t1 - t0) * f0 / (f0 - f1)});
+    } else if (f1 >= 0) {
+      append(out, {t0 + (t1 - t0) * f0 / (f0 - f1), t1});
+    }
+  }
+  return clip(out, range);
+}
+
+/// Evaluates the sets of time points where subformulas hold, over the ranges that
+/// are needed by their parents.
+class Evaluator {
+ public:
+  explicit Evaluator(const Trace& signals) :
+      trace{signals}, time_range{get_time_range(signals)} {}
+
+  /// The range where all the signals used by the formula are defined (which is empty
+  /// if `first > second`).
+  TimeInterval domain(const ast::Expr& phi) {
+    const void* addr = ast::node_address(phi);
+    if (addr != nullptr) {
+      if (const auto it = domains.find(addr); it != domains.end()) {
+        return it->second;
+      }
+    }
+    const auto meet = [this](const auto& args) {
+      auto out = TimeInterval{-TOP, TOP};
+      for (const auto& arg : args) {
+        const auto d = domain(arg);
+        out          = {std::max(out.first, d.first), std::min(out.second, d.second)};
+      }
+      return out;
+    };
+    const auto out = std::visit(
+        utils::overloaded{
+            [&](const ast::Const&) { return time_range; },
+            [&](const ast::Predicate& e) {
+              const auto& x = trace.at(e.name);
+              return (x->empty()) ? TimeInterval{TOP, -TOP}
+                                  : TimeInterval{x->begin_time(), x->end_time()};
+            },
+            [&](const ast::NotPtr& e) { return domain(e->arg); },
+            [&](const ast::AndPtr& e) { return meet(e->args); },
+            [&](const ast::OrPtr& e) { return meet(e->args); },
+            [&](const ast::EventuallyPtr& e) { return domain(e->arg); },
+            [&](const ast::AlwaysPtr& e) { return domain(e->arg); },
+            [&](const ast::UntilPtr& e) {
+              return meet(std::vector<ast::Expr>{e->args.first, e->args.second});
+            }},
+        phi);
+    if (addr != nullptr) {
+      domains.emplace(addr, out);
+    }
+    return out;
+  }
+
+  /// The set of time points where the formula holds, for (at least) the part of the
+  /// range in its domain.
+  const IntervalSet& holds(const ast::Expr& phi, TimeInterval range) {
+    range       = clamp(range, domain(phi));
+    auto& entry = entries[key(phi)];
+    if (entry.computed) {
+      if (entry.range.first <= range.first && range.second <= entry.range.second) {
+        return entry.set;
+      }
+      range = {std::min(range.first, entry.range.first),
+               std::max(range.second, entry.range.second)};
+    }
+    // `entry` stays valid, as references to the elements of an `unordered_map` are
+    // not invalidated by inserting other elements.
+    auto set       = compute(phi, range);
+    entry.range    = range;
+    entry.set      = std::move(set);
+    entry.computed = true;
+    return entry.set;
+  }
+
+  /// Find the interval where the requirement that makes `phi` fail at `t` doesn't
+  /// hold. `phi` must have been evaluated at `t`.
+  TimeInterval violation(const ast::Expr& phi, double t) {
+    const auto& entry = entries.at(key(phi));
+    if (const auto* conj = std::get_if<ast::AndPtr>(&phi)) {
+      for (const auto& arg : (*conj)->args) {
+        const auto it = entries.find(key(arg));
+        if (it != entries.end() && it->second.computed && !find(it->second.set, t)) {
+          return violation(arg, t);
+        }
+      }
+    } else if (const auto* always = std::get_if<ast::AlwaysPtr>(&phi)) {
+      const auto& arg   = (*always)->arg;
+      const auto [a, b] = (*always)->interval.as_double();
+      const auto window = clamp({t + a, t + b}, domain(arg));
+      const auto failed = complement(holds(arg, window), window);
+      if (!failed.empty()) {
+        return violation(arg, failed.front().first);
+      }
+    }
+    const auto failed = find(complement(entry.set, entry.range), t);
+    return failed.value_or(TimeInterval{t, t});
+  }
+
+ private:
+  struct Entry {
+    bool computed = false;
+    TimeInterval range;
+    IntervalSet set;
+  };
+
+  const Trace& trace;
+  TimeInterval time_range;
+  std::unordered_map<const void*, TimeInterval> domains;
+  std::unordered_map<const void*, Entry> entries;
+
+  /// Subformulas held by value (i.e., constants and predicates) are identified by the
+  /// address of the `Expr`, which is stable for the duration of the evaluation.
+  static const void* key(const ast::Expr& phi) {
+    const void* addr = ast::node_address(phi);
+    return (addr != nullptr) ? addr : &phi;
+  }
+
+  IntervalSet compute(const ast::Expr& phi, TimeInterval range) {
+    return std::visit(
+        utils::overloaded{
+            [&](const ast::Const& e) {
+              return (e.value) ? IntervalSet{range} : IntervalSet{};
+            },
+            [&](const ast::Predicate& e) {
+              return predicate_set(*trace.at(e.name), e.op, e.rhs, range);
+            },
+            [&](const ast::NotPtr& e) {
+              return complement(holds(e->arg, range), range);
+            },
+            [&](const ast::AndPtr& e) {
+              // Stop as soon as the conjunction is false over the whole range.
+              auto out = IntervalSet{range};
+              for (const auto& arg : e->args) {
+                out = intersect(out, holds(arg, range));
+                if (out.empty()) {
+                  break;
+                }
+              }
+              return out;
+            },
+            [&](const ast::OrPtr& e) {
+              // Stop as soon as the disjunction is true over the whole range.
+              auto out = IntervalSet{};
+              for (const auto& arg : e->args) {
+                out = unite(out, clip(holds(arg, range), range));
+                if (covers(out, range)) {
+                  break;
+                }
+              }
+              return out;
+            },
+            [&](const ast::EventuallyPtr& e) {
+              const auto [a, b] = e->interval.as_double();
+              const double end  = domain(e->arg).second;
+              const auto& ys    = holds(e->arg, {range.first + a, range.second + b});
+              return clip(shift_back(ys, a, b, end), range);
+            },
+            [&](const ast::AlwaysPtr& e) {
+              // Always is the dual of Eventually.
+              const auto [a, b]  = e->interval.as_double();
+              const auto& arg    = e->arg;
+              const auto dom     = domain(arg);
+              const auto window  = clamp({range.first + a, range.second + b}, dom);
+              const auto failing = complement(holds(arg, window), window);
+              return complement(shift_back(failing, a, b, dom.second), range);
+            },
+            [&](const ast::UntilPtr& e) {
+              const auto [a, b] = e->interval.as_double();
+              const auto common = domain(phi);
+              const auto& xs    = holds(e->args.first, {range.first, range.second + b});
+              const auto& ys =
+                  holds(e->args.second, {range.first + a, range.second + b});
+              return clip(
+                  until_set(clip(xs, common), clip(ys, common), a, b, common.second),
+                  range);
+            }},
+        phi);
+  }
+};
+
+} // namespace
+
+Verdict check_satisfaction(
+    const ast::Expr& phi,
+    const Trace& trace,
+    const SatisfactionOptions& options) {
+  auto eval         = Evaluator{trace};
+  const auto domain = eval.domain(phi);
+  if (domain.first > domain.second) {
+    throw std::out_of_range("The signals used by the formula don't overlap");
+  }
+  const double t = options.time.value_or(domain.first);
+  if (t < domain.first || t > domain.second) {
+    throw std::out_of_range("Time is outside the range of the signals of the formula");
+  }
+
+  auto out      = Verdict{};
+  out.time      = t;
+  out.satisfied = find(eval.holds(phi, {t, t}), t).has_value();
+  if (!out.satisfied && options.find_violation) {
+    out.violation = eval.violation(phi, t);
+  }
+  return out;
+}
+
+IntervalSet compute_satisfaction(const ast::Expr& phi, const Trace& trace) {
+  auto eval         = Evaluator{trace};
+  const auto domain = eval.domain(phi);
+  if (domain.first > domain.second) {
+    return {};
+  }
+  return clip(eval.holds(phi, domain), domain);
+}
+
+} // namespace signal_tl::semantics
@@ -1,24 +1,38 @@
 #include "signal_tl/ast.hpp"
 #include "signal_tl/exception.hpp"
+#include "signal_tl/executor.hpp"
+#include "signal_tl/plan.hpp"
 #include "signal_tl/robustness.hpp"
 #include "signal_tl/signal.hpp"
+#include "signal_tl/simplify.hpp"
 
-#include "minmax.hpp"
+#include "signal_tl/internal/utils.hpp" // for overloaded
 
-#include <algorithm>  // for max, min, transform, for_each
-#include <cassert>    // for assert
-#include <cmath>      // for isinf
-#include <functional> // for negate
-#include <iterator>   // for back_insert_iterator, back_inserter
-#include <limits>     // for numeric_limits
-#include <map>        // for operator!=
-#include <memory>     // for __shared_ptr_access, make_shared
-#include <stdexcept>  // for logic_error
-#include <string>     // for string
-#include <tuple>      // for make_tuple, tuple_element<>::type
-#include <utility>    // for tuple_element<>::type, pair
-#include <variant>    // for visit
-#include <vector>     // for vector
+#include "buffer_pool.hpp" // for BufferPool, acquire_buffer, make_signal
+#include "integral.hpp"
+#include "kernels.hpp" // for affine
+#include "minmax.hpp"
+#include "operators.hpp"
+#include "until.hpp"
+
+#include <algorithm>     // for max, min, transform, for_each, remove_if
+#include <cassert>       // for assert
+#include <cmath>         // for isinf
+#include <exception>     // for current_exception
+#include <fmt/format.h>  // for format
+#include <future>        // for promise, shared_future
+#include <limits>        // for numeric_limits
+#include <map>           // for operator!=
+#include <memory>        // for __shared_ptr_access, make_shared, unique_ptr
+#include <mutex>         // for mutex, unique_lock, lock_guard
+#include <stdexcept>     // for logic_error, out_of_range
+#include <string>        // for string
+#include <tuple>         // for make_tuple, tie, tuple_element<>::type
+#include <unordered_map> // for unordered_map
+#include <unordered_set> // for unordered_set
+#include <utility>       // for tuple_element<>::type, pair, move
+#include <variant>       // for visit
+#include <vector>        // for vector
 
 namespace signal_tl::semantics {
 using namespace signal;
@@ -28,41 +42,201 @@ namespace {
 constexpr double TOP    = std::numeric_limits<double>::infinity();
 constexpr double BOTTOM = -TOP;
 
-SignalPtr compute_until(const SignalPtr& input_x, const SignalPtr& input_y) {
-  const auto [x, y] = synchronize(input_x, input_y);
-  assert(x->size() == y->size());
-  assert(x->begin_time() == y->begin_time());
-  assert(x->end_time() == y->end_time());
+/// Call `f` on each operand of the given formula.
+template <typename F>
+void for_each_child(const ast::Expr& phi, F&& f) {
+  std::visit(
+      utils::overloaded{
+          [](const ast::Const&) {},
+          [](const ast::Predicate&) {},
+          [&](const ast::NotPtr& e) { f(e->arg); },
+          [&](const ast::AndPtr& e) {
+            for (const auto& arg : e->args) { f(arg); }
+          },
+          [&](const ast::OrPtr& e) {
+            for (const auto& arg : e->args) { f(arg); }
+          },
+          [&](const ast::EventuallyPtr& e) { f(e->arg); },
+          [&](const ast::AlwaysPtr& e) { f(e->arg); },
+          [&](const ast::UntilPtr& e) {
+            f(e->args.first);
+            f(e->args.second);
+          }},
+      phi);
+}
+
+/// Memoized robustness signals for the subformulas of a formula.
+///
+/// Subformulas are identified first by the address of their node (as copies of an
+/// `Expr` share the node), and then structurally. Thus, each distinct subformula is
+/// computed once per trace, even if it appears in multiple places in the formula.
+///
+/// The entries are futures, so that if a subformula is requested while it is being
+/// computed on some other thread, we wait for it instead of computing it again.
+///
+/// Each entry counts the parents (and other consumers) that still need it, and is
+/// dropped once the last of them is computed. Thus, the signal of a subformula is
+/// freed (and its buffers reused) as soon as it isn't needed anymore, instead of at
+/// the end of the evaluation.
+struct Memo {
+  struct Entry {
+    std::promise<SignalPtr> promise;
+    std::shared_future<SignalPtr> result = promise.get_future().share();
+    bool started = false;
+    size_t uses  = 0;
+    std::vector<const void*> addresses;
+  };
+
+  std::mutex mutex;
+  std::unordered_map<const void*, size_t> hashes;
+  std::unordered_map<const void*, Entry*> by_address;
+  std::unordered_map<ast::Expr, Entry, ast::ExprHash, ast::ExprEqual> by_structure;
+
+  Memo() : by_structure{0, ast::ExprHash{&hashes}} {}
+
+  /// Get the entry for the given subformula, adding it (along with the entries of
+  /// all its subformulas) if it doesn't exist. Must be called with the lock held.
+  Entry& add(const ast::Expr& phi) {
+    const void* addr = ast::node_address(phi);
+    if (addr != nullptr) {
+      if (const auto it = by_address.find(addr); it != by_address.end()) {
+        return *it->second;
+      }
+    }
+    auto [it, inserted] = by_structure.try_emplace(phi);
+    auto& entry         = it->second;
+    if (addr != nullptr) {
+      by_address.emplace(addr, &entry);
+      entry.addresses.push_back(addr);
+    }
+    if (inserted) {
+      for_each_child(phi, [&](const ast::Expr& arg) { add(arg).uses++; });
+    }
+    return entry;
+  }
 
-  auto sigstack = std::vector<Sample>();
+  /// Mark one use of the given subformula as done.
+  void release(const ast::Expr& phi) {
+    auto lock = std::lock_guard{mutex};
+    auto it   = by_structure.find(phi);
+    if (it == by_structure.end() || --it->second.uses > 0) {
+      return;
+    }
+    for (const void* a : it->second.addresses) { by_address.erase(a); }
+    by_structure.erase(it);
+  }
+};
 
-  // TODO(anand): This doesn't handle crossing signals well...
+/// The robustness signals of the predicates in a formula.
+///
+/// The predicates over the same signal are computed in batches, in a single pass over
+/// the signal for each batch (see `compute_predicates`). When a predicate is needed,
+/// it is computed along with the next few predicates of its group that haven't been
+/// computed yet (in the order of the formula, which is roughly the order in which
+/// they are needed). Each signal is then handed out once, to be memoized in `Memo`,
+/// so that it is freed as soon as it isn't needed anymore. Thus, only a few of the
+/// predicates of a group are kept before they are needed, instead of all of them
+/// (which would take as many signals as there are predicates).
+struct PredicateGroups {
+  /// The largest number of predicates computed in a single pass over a signal.
+  static constexpr size_t BATCH_SIZE = 4;
+
+  struct Group {
+    SignalPtr x;
+    std::vector<std::pair<ast::ComparisonOp, double>> predicates;
+    /// The predicates that were computed, but not handed out yet.
+    std::vector<SignalPtr> signals;
+    std::vector<bool> computed;
+    std::mutex mutex;
+  };
 
-  double prev      = TOP;
-  double max_right = BOTTOM;
+  std::unordered_map<Symbol, Group> groups;
 
-  for (auto [i, j] = std::make_tuple(x->rbegin(), y->rbegin());
-       i != x->rend() && j != y->rend();
-       i++, j++) {
-    max_right = std::max(max_right, j->value);
-    prev      = std::max({j->value, std::min(i->value, prev), -max_right});
-    sigstack.push_back({i->time, prev});
+  PredicateGroups(const ast::Expr& phi, const Trace& trace) {
+    auto visited = std::unordered_set<const void*>{};
+    add(phi, trace, visited);
+    for (auto& [name, group] : groups) {
+      group.signals.resize(group.predicates.size());
+      group.computed.resize(group.predicates.size());
+    }
   }
-  std::reverse(sigstack.begin(), sigstack.end());
-  auto out = std::make_shared<Signal>(sigstack);
-  return out;
-}
 
-SignalPtr compute_until(const SignalPtr&, const SignalPtr&, double, double) {
-  throw not_implemented_error("Bounded compute_until has not been implemented yet.");
-}
+  SignalPtr get(const ast::Predicate& e) {
+    auto& group   = groups.at(e.name);
+    const auto it = std::find(
+        group.predicates.begin(), group.predicates.end(), std::pair{e.op, e.rhs});
+    const auto k = static_cast<size_t>(it - group.predicates.begin());
+
+    // Other threads wait for the batch with their predicate, instead of computing it
+    // again.
+    auto lock = std::lock_guard{group.mutex};
+    if (group.computed[k]) {
+      auto out = std::move(group.signals[k]);
+      // The signal was handed out before, and is needed again.
+      return (out != nullptr) ? out : compute_predicate(group.x, e.op, e.rhs);
+    }
+
+    auto batch   = std::vector<size_t>{};
+    auto compute = std::vector<std::pair<ast::ComparisonOp, double>>{};
+    for (size_t i = k; i < group.predicates.size() && batch.size() < BATCH_SIZE; i++) {
+      if (!group.computed[i]) {
+        batch.push_back(i);
+        compute.push_back(group.predicates[i]);
+      }
+    }
+    auto signals = compute_predicates(group.x, compute);
+    for (size_t i = 0; i < batch.size(); i++) {
+      group.computed[batch[i]] = true;
+      group.signals[batch[i]]  = std::move(signals[i]);
+    }
+    return std::move(group.signals[k]);
+  }
+
+ private:
+  void add(
+      const ast::Expr& phi,
+      const Trace& trace,
+      std::unordered_set<const void*>& visited) {
+    if (const auto* e = std::get_if<ast::Predicate>(&phi)) {
+      auto& group = groups[e->name];
+      if (group.x == nullptr) {
+        group.x = trace.at(e->name);
+      }
+      const auto predicate = std::pair{e->op, e->rhs};
+      if (std::find(group.predicates.begin(), group.predicates.end(), predicate) ==
+          group.predicates.end()) {
+        group.predicates.push_back(predicate);
+      }
+    } else if (const void* addr = ast::node_address(phi); visited.insert(addr).second) {
+      for_each_child(phi, [&](const ast::Expr& arg) { add(arg, trace, visited); });
+    }
+  }
+};
 
 struct RobustnessOp {
   double min_time = 0.0;
   double max_time = std::numeric_limits<double>::infinity();
-  Trace trace     = {};
-
-  RobustnessOp() = default;
+  /// The signals of the trace, rebased onto shared time columns.
+  Trace trace;
+  std::shared_ptr<Memo> memo = std::make_shared<Memo>();
+  std::shared_ptr<PredicateGroups> predicates;
+  /// Pool for the buffers of the intermediate signals.
+  std::shared_ptr<BufferPool> buffers = std::make_shared<BufferPool>();
+  /// Executor for evaluating subformulas concurrently, or `nullptr` if serial.
+  Executor* executor = nullptr;
+  Semantics semantics = Semantics::Classic;
+
+  RobustnessOp(
+      const ast::Expr& phi,
+      const Trace& signals,
+      Executor* exec,
+      const EvaluationOptions& options) :
+      trace{share_time_bases(signals, options.synchronized)},
+      predicates{std::make_shared<PredicateGroups>(phi, trace)},
+      executor{exec},
+      semantics{options.semantics} {
+    std::tie(min_time, max_time) = get_time_range(trace);
+  }
 
   SignalPtr operator()(const ast::Const e) const;
   SignalPtr operator()(const ast::Predicate& e) const;
@@ -74,14 +248,242 @@ struct RobustnessOp {
   SignalPtr operator()(const ast::UntilPtr& e) const;
 };
 
+/// Remove repeated signals (by pointer) from the operands of an And/Or.
+///
+/// As min/max are idempotent, operands that were memoized to the same signal only
+/// need to be used once.
+std::vector<SignalPtr> unique_signals(std::vector<SignalPtr> ys) {
+  auto seen          = std::unordered_set<const Signal*>{};
+  const auto is_dupe = [&seen](const SignalPtr& y) {
+    return !seen.insert(y.get()).second;
+  };
+  ys.erase(std::remove_if(ys.begin(), ys.end(), is_dupe), ys.end());
+  return ys;
+}
+
 SignalPtr compute(const ast::Expr& phi, const RobustnessOp& rob) {
-  return std::visit([&](auto&& e) { return rob(e); }, phi);
+  auto& memo = *rob.memo;
+
+  auto lock   = std::unique_lock{memo.mutex};
+  auto& entry = memo.add(phi);
+  if (entry.started) {
+    auto result = entry.result;
+    // Don't hold the lock while (potentially) waiting for another thread.
+    lock.unlock();
+    return result.get();
+  }
+  entry.started = true;
+  auto promise  = std::move(entry.promise);
+  lock.unlock();
+
+  try {
+    auto scope = BufferPool::Scope{rob.buffers.get()};
+    auto out   = std::visit([&](auto&& e) { return rob(e); }, phi);
+    promise.set_value(out);
+    for_each_child(phi, [&memo](const ast::Expr& arg) { memo.release(arg); });
+    return out;
+  } catch (...) {
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+}
+
+/// Compute the robustness of each of the given subformulas, concurrently if
+/// possible.
+std::vector<SignalPtr>
+compute_all(const std::vector<ast::Expr>& args, const RobustnessOp& rob) {
+  auto ys = std::vector<SignalPtr>(args.size());
+  if (rob.executor == nullptr) {
+    std::transform(args.begin(), args.end(), ys.begin(), [&rob](const auto& arg) {
+      return compute(arg, rob);
+    });
+    return ys;
+  }
+
+  auto tasks = TaskGroup{rob.executor};
+  for (size_t i = 0; i < args.size(); i++) {
+    tasks.run([&, i]() { ys[i] = compute(args[i], rob); });
+  }
+  tasks.wait();
+  return ys;
 }
 
 } // namespace
 
-SignalPtr compute_robustness(const ast::Expr& phi, const signal::Trace& trace, bool) {
-  // Compute the start and end of the trace.
+ast::SimplifyOptions simplify_options(const EvaluationOptions& options) {
+  auto out    = ast::SimplifyOptions{};
+  out.classic = options.semantics == Semantics::Classic;
+  return out;
+}
+
+SignalPtr compute_robustness(
+    const ast::Expr& phi,
+    const signal::Trace& trace,
+    bool synchronized) {
+  auto options         = EvaluationOptions{};
+  options.synchronized = synchronized;
+  return compute_robustness(phi, trace, options);
+}
+
+SignalPtr compute_robustness(
+    const ast::Expr& phi,
+    const signal::Trace& trace,
+    const EvaluationOptions& options) {
+  if (options.simplify) {
+    auto simplified_options     = options;
+    simplified_options.simplify = false;
+    return compute_robustness(
+        ast::simplify(phi, simplify_options(options)), trace, simplified_options);
+  }
+
+  // The windows of the subformulas are propagated in a single pass over the
+  // operations of a plan, whose operands come before the operations using them. A
+  // plan also computes one subformula at a time, so that each one can be profiled
+  // (or looked up in a cache).
+  if (options.window.has_value() || options.profile != nullptr ||
+      options.cache != nullptr) {
+    return EvaluationPlan{phi}.evaluate(trace, options).front();
+  }
+
+  auto pool     = std::unique_ptr<ThreadPool>{};
+  auto executor = get_executor(options, pool);
+
+  auto rob = RobustnessOp{phi, trace, executor, options};
+
+  SignalPtr out = compute(phi, rob);
+
+  return out;
+}
+
+double compute_robustness_at(
+    const ast::Expr& phi,
+    const signal::Trace& trace,
+    double t,
+    const EvaluationOptions& options) {
+  auto at_options   = options;
+  at_options.window = {t, t};
+  const auto y      = compute_robustness(phi, trace, at_options);
+  if (y->empty()) {
+    throw std::out_of_range(
+        fmt::format("Robustness of the formula is undefined at time {}", t));
+  }
+  return y->front().value;
+}
+
+RobustnessMatrix compute_robustness_batch(
+    const std::vector<ast::Expr>& formulas,
+    const std::vector<signal::Trace>& traces,
+    const EvaluationOptions& options) {
+  if (!options.simplify) {
+    return compute_robustness_batch(EvaluationPlan{formulas}, traces, options);
+  }
+  auto simplified = std::vector<ast::Expr>{};
+  simplified.reserve(formulas.size());
+  for (const auto& phi : formulas) {
+    simplified.push_back(ast::simplify(phi, simplify_options(options)));
+  }
+  return compute_robustness_batch(EvaluationPlan{simplified}, traces, options);
+}
+
+RobustnessMatrix compute_robustness_batch(
+    const EvaluationPlan& plan,
+    const std::vector<signal::Trace>& traces,
+    const EvaluationOptions& options) {
+  auto pool     = std::unique_ptr<ThreadPool>{};
+  auto executor = get_executor(options, pool);
+
+  auto out         = RobustnessMatrix{};
+  out.num_formulas = plan.outputs().size();
+  out.num_traces   = traces.size();
+  out.values.resize(out.num_formulas * out.num_traces);
+
+  // The formulas are compiled once, and all of them are evaluated on each trace in a
+  // single task. Each task writes to a disjoint set of entries.
+  constexpr double NaN      = std::numeric_limits<double>::quiet_NaN();
+  auto trace_options        = options;
+  trace_options.executor    = executor;
+  trace_options.profile     = nullptr;
+  const auto evaluate_trace = [&](size_t j) {
+    const auto ys = plan.evaluate(traces[j], trace_options);
+    for (size_t i = 0; i < ys.size(); i++) {
+      const auto& y                      = ys[i];
+      out.values[i * out.num_traces + j] = (y->empty()) ? NaN : y->front().value;
+    }
+  };
+
+  auto tasks = TaskGroup{executor};
+  for (size_t j = 0; j < traces.size(); j++) {
+    tasks.run([&evaluate_trace, j]() { evaluate_trace(j); });
+  }
+  tasks.wait();
+  return out;
+}
+
+RobustnessMatrix compute_robustness_batch(
+    const std::map<std::string, ast::Expr>& formulas,
+    const std::vector<signal::Trace>& traces,
+    const EvaluationOptions& options) {
+  if (!options.simplify) {
+    return compute_robustness_batch(EvaluationPlan{formulas}, traces, options);
+  }
+  auto simplified = std::map<std::string, ast::Expr>{};
+  for (const auto& [name, phi] : formulas) {
+    simplified.emplace(name, ast::simplify(phi, simplify_options(options)));
+  }
+  return compute_robustness_batch(EvaluationPlan{simplified}, traces, options);
+}
+
+SignalPtr RobustnessOp::operator()(const ast::Const e) const {
+  return compute_const(e.value, min_time, max_time);
+}
+
+SignalPtr RobustnessOp::operator()(const ast::Predicate& e) const {
+  return predicates->get(e);
+}
+
+SignalPtr RobustnessOp::operator()(const ast::NotPtr& e) const {
+  return compute_not(compute(e->arg, *this));
+}
+
+SignalPtr RobustnessOp::operator()(const ast::AndPtr& e) const {
+  auto ys = compute_all(e->args, *this);
+  assert(ys.size() == e->args.size());
+  return compute_and(std::move(ys), executor);
+}
+
+SignalPtr RobustnessOp::operator()(const ast::OrPtr& e) const {
+  auto ys = compute_all(e->args, *this);
+  assert(ys.size() == e->args.size());
+  return compute_or(std::move(ys), executor);
+}
+
+SignalPtr RobustnessOp::operator()(const ast::EventuallyPtr& e) const {
+  const auto y = compute(e->arg, *this);
+  return (semantics == Semantics::Filtering) ? compute_average(y, e->interval)
+                                             : compute_eventually(y, e->interval);
+}
+
+SignalPtr RobustnessOp::operator()(const ast::AlwaysPtr& e) const {
+  const auto y = compute(e->arg, *this);
+  return (semantics == Semantics::Filtering) ? compute_average(y, e->interval)
+                                             : compute_always(y, e->interval);
+}
+
+SignalPtr RobustnessOp::operator()(const ast::UntilPtr& e) const {
+  auto ys = compute_all({e->args.first, e->args.second}, *this);
+  return compute_until(ys.at(0), ys.at(1), e->interval);
+}
+
+Executor*
+get_executor(const EvaluationOptions& options, std::unique_ptr<ThreadPool>& pool) {
+  if (options.executor == nullptr && options.num_threads != 1) {
+    pool = std::make_unique<ThreadPool>(options.num_threads);
+    return pool.get();
+  }
+  return options.executor;
+}
+
+std::pair<double, double> get_time_range(const Trace& trace) {
   struct MinMaxTime {
     double begin{TOP};
     double end{BOTTOM};
@@ -94,121 +496,175 @@ SignalPtr compute_robustness(const ast::Expr& phi, const signal::Trace& trace, b
 
   const MinMaxTime minmaxtime =
       std::for_each(trace.cbegin(), trace.cend(), MinMaxTime{});
-  double min_time = minmaxtime.begin;
-  double max_time = minmaxtime.end;
-
-  auto rob = RobustnessOp{min_time, max_time, trace};
-
-  SignalPtr out = compute(phi, rob);
+  return {minmaxtime.begin, minmaxtime.end};
+}
 
-  return out;
+SignalPtr compute_const(bool value, double begin_time, double end_time) {
+  const double val = (value) ? static_cast<double>(TOP) : static_cast<double>(BOTTOM);
+  auto times       = acquire_buffer(2);
+  auto values      = acquire_buffer(2);
+  times.assign({begin_time, end_time});
+  values.assign({val, val});
+  return make_signal(std::move(values), std::move(times), {0.0, 0.0});
 }
 
-SignalPtr RobustnessOp::operator()(const ast::Const e) const {
-  const double val = (e.value) ? static_cast<double>(TOP) : static_cast<double>(BOTTOM);
-  auto samples     = std::vector<Sample>{{min_time, val, 0.0}, {max_time, val, 0.0}};
-  return std::make_shared<Signal>(samples);
+SignalPtr compute_predicate(const SignalPtr& x, ast::ComparisonOp op, double rhs) {
+  return compute_predicates(x, {{op, rhs}}).front();
 }
 
-SignalPtr RobustnessOp::operator()(const ast::Predicate& e) const {
-  const auto& x = trace.at(e.name);
-  auto y        = std::make_shared<Signal>();
-  for (const auto& sample : *x) {
-    const double t = sample.time;
-    const double v = sample.value;
-    switch (e.op) {
+std::vector<SignalPtr> compute_predicates(
+    const SignalPtr& x,
+    const std::vector<std::pair<ast::ComparisonOp, double>>& predicates) {
+  // The robustness of `x > c` is `x - c`, and that of `x < c` is `c - x`.
+  const auto is_lower_bound = [](ast::ComparisonOp op) {
+    switch (op) {
       case ast::ComparisonOp::GE:
       case ast::ComparisonOp::GT:
-        y->push_back(t, v - e.rhs);
-        break;
+        return true;
       case ast::ComparisonOp::LE:
       case ast::ComparisonOp::LT:
-        y->push_back(t, e.rhs - v);
-        break;
+        return false;
+    }
+    throw std::logic_error("Unknown comparison operator in predicate.");
+  };
+  // Share a column of `x` with the outputs, without making them keep `x` alive if it
+  // is already a view.
+  const auto share = [&x](const Column& col) {
+    return (col.is_view()) ? col : Column::view(col.data(), col.size(), x);
+  };
+
+  const size_t n         = x->size();
+  const auto times       = share(x->time_column());
+  const auto derivatives = share(x->derivative_column());
+  auto negated           = Column{};
+
+  auto scales  = std::vector<double>{};
+  auto offsets = std::vector<double>{};
+  auto values  = std::vector<std::vector<double>>{};
+  for (const auto& [op, rhs] : predicates) {
+    const bool lower = is_lower_bound(op);
+    scales.push_back((lower) ? 1.0 : -1.0);
+    offsets.push_back((lower) ? -rhs : rhs);
+    values.push_back(acquire_buffer(n));
+    values.back().resize(n);
+    if (!lower && negated.empty() && n > 0) {
+      auto column = std::make_shared<std::vector<double>>(n);
+      kernels::affine(derivatives.data(), column->data(), n, -1.0, 0.0);
+      negated = Column::view(column->data(), n, column);
+    }
+  }
+
+  // Each block of `x` is read from memory once, and stays in the cache for all the
+  // predicates.
+  constexpr size_t BLOCK = 2048;
+  const double* xs       = x->value_column().data();
+  for (size_t lo = 0; lo < n; lo += BLOCK) {
+    const size_t len = std::min(BLOCK, n - lo);
+    for (size_t i = 0; i < predicates.size(); i++) {
+      kernels::affine(xs + lo, values[i].data() + lo, len, scales[i], offsets[i]);
     }
   }
-  return y;
+
+  auto out = std::vector<SignalPtr>{};
+  out.reserve(predicates.size());
+  for (size_t i = 0; i < predicates.size(); i++) {
+    auto ts = times;
+    auto ds = (scales[i] > 0) ? derivatives : negated;
+    out.push_back(make_signal(std::move(values[i]), std::move(ts), std::move(ds)));
+  }
+  return out;
 }
 
-SignalPtr RobustnessOp::operator()(const ast::NotPtr& e) const {
-  auto x   = compute(e->arg, *this);
-  auto vec = std::vector<Sample>{};
-  vec.reserve(x->size());
-  std::transform(x->begin(), x->end(), std::back_inserter(vec), std::negate<>());
-  return std::make_shared<Signal>(vec);
+SignalPtr compute_not(const SignalPtr& y) {
+  return y->affine(-1.0, 0.0);
 }
 
-SignalPtr RobustnessOp::operator()(const ast::AndPtr& e) const {
-  auto ys = std::vector<SignalPtr>{};
-  ys.reserve(e->args.size());
-  std::transform(
-      e->args.begin(), e->args.end(), std::back_inserter(ys), [this](const auto arg) {
-        return compute(arg, *this);
-      });
-  assert(ys.size() == e->args.size());
+SignalPtr compute_and(std::vector<SignalPtr> ys, Executor* executor) {
+  ys = unique_signals(std::move(ys));
+  if (executor != nullptr) {
+    return compute_elementwise_min(ys, *executor);
+  }
   return compute_elementwise_min(ys);
 }
 
-SignalPtr RobustnessOp::operator()(const ast::OrPtr& e) const {
-  auto ys = std::vector<SignalPtr>{};
-  ys.reserve(e->args.size());
-  std::transform(
-      e->args.begin(), e->args.end(), std::back_inserter(ys), [this](const auto arg) {
-        return compute(arg, *this);
-      });
-  assert(ys.size() == e->args.size());
+SignalPtr compute_or(std::vector<SignalPtr> ys, Executor* executor) {
+  ys = unique_signals(std::move(ys));
+  if (executor != nullptr) {
+    return compute_elementwise_max(ys, *executor);
+  }
   return compute_elementwise_max(ys);
 }
 
-SignalPtr RobustnessOp::operator()(const ast::EventuallyPtr& e) const {
-  auto y = compute(e->arg, *this);
-  if (!e->interval.has_value()) {
+SignalPtr compute_eventually(const SignalPtr& y, const ast::Interval& interval) {
+  if (interval.is_zero_to_inf()) {
     return compute_max_seq(y);
   }
 
-  const auto [a, b] = e->interval.as_double();
+  const auto [a, b] = interval.as_double();
   if (b - a < 0) {
     throw std::logic_error("Eventually operator: b < a in interval [a,b]");
   } else if (b - a == 0) {
+    // NOTE: The window isn't shifted to `a` (unlike in `discrete`, where `[a, a]` is a
+    // shift by `a` steps).
     return y;
-  } else if (b - a >= y->end_time() - y->begin_time()) {
+  } else if (a == 0 && b >= y->end_time() - y->begin_time()) {
     return compute_max_seq(y);
   } else {
     return compute_max_seq(y, a, b);
   }
 }
 
-SignalPtr RobustnessOp::operator()(const ast::AlwaysPtr& e) const {
-  auto y = compute(e->arg, *this);
-  if (!e->interval.has_value()) {
+SignalPtr compute_always(const SignalPtr& y, const ast::Interval& interval) {
+  if (interval.is_zero_to_inf()) {
     return compute_min_seq(y);
   }
 
-  const auto [a, b] = e->interval.as_double();
+  const auto [a, b] = interval.as_double();
   if (b - a < 0) {
     throw std::logic_error("Always operator: b < a in interval [a,b]");
   } else if (b - a == 0) {
+    // NOTE: The window isn't shifted to `a` (unlike in `discrete`, where `[a, a]` is a
+    // shift by `a` steps).
     return y;
-  } else if (b - a >= y->end_time() - y->begin_time()) {
+  } else if (a == 0 && b >= y->end_time() - y->begin_time()) {
     return compute_min_seq(y);
   } else {
     return compute_min_seq(y, a, b);
   }
 }
 
-SignalPtr RobustnessOp::operator()(const ast::UntilPtr& e) const {
-  auto y1 = compute(e->args.first, *this);
-  auto y2 = compute(e->args.second, *this);
-  if (!e->interval.has_value()) {
-    return compute_until(y1, y2);
-  }
-
-  const auto [a, b] = e->interval.as_double();
-  if (std::isinf(b) && a == 0) {
+SignalPtr compute_until(
+    const SignalPtr& y1,
+    const SignalPtr& y2,
+    const ast::Interval& interval) {
+  const auto [a, b] = interval.as_double();
+  if (b - a < 0) {
+    throw std::logic_error("Until operator: b < a in interval [a,b]");
+  } else if (std::isinf(b) && a == 0) {
     return compute_until(y1, y2);
   } else {
     return compute_until(y1, y2, a, b);
   }
 }
 
+SignalPtr compute_average(const SignalPtr& y, const ast::Interval& interval) {
+  const auto [a, b] = interval.as_double();
+  if (b - a < 0) {
+    throw std::logic_error("Filtering operator: b < a in interval [a,b]");
+  } else if (a == 0 && std::isinf(b)) {
+    return integral::compute_average_seq(y);
+  }
+  return integral::compute_average_seq(y, a, b);
+}
+
+SignalPtr compute_integral(const SignalPtr& y, const ast::Interval& interval) {
+  const auto [a, b] = interval.as_double();
+  if (b - a < 0) {
+    throw std::logic_error("Cumulative operator: b < a in interval [a,b]");
+  } else if (a == 0 && std::isinf(b)) {
+    return integral::compute_integral_seq(y);
+  }
+  return integral::compute_integral_seq(y, a, b);
+}
+
 } // namespace signal_tl::semantics
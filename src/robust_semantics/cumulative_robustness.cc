@@ -0,0 +1,160 @@
+#include "signal_tl/cumulative.hpp"
+#include "signal_tl/ast.hpp"
+#include "signal_tl/executor.hpp"
+#include "signal_tl/robustness.hpp"
+#include "signal_tl/signal.hpp"
+
+#include "buffer_pool.hpp" // for BufferPool, acquire_buffer, make_signal
+#include "operators.hpp"   // for compute_and, compute_integral, get_executor, ...
+
+#include <algorithm>     // for max, min
+#include <cmath>         // for isinf
+#include <memory>        // for make_shared, unique_ptr
+#include <stdexcept>     // for invalid_argument
+#include <unordered_map> // for unordered_map
+#include <utility>       // for move, pair
+#include <variant>       // for visit
+#include <vector>        // for vector
+
+namespace signal_tl::semantics {
+using namespace signal;
+
+namespace {
+
+/**
+ * Get the positive (or negative) part of the signal, i.e., `max(y, 0)` (or
+ * `min(y, 0)`).
+ *
+ * The points where the signal crosses 0 are added, so the output is exact.
+ */
+SignalPtr clip(const SignalPtr& y, bool positive) {
+  const auto ts  = y->times();
+  const auto ys  = y->values();
+  const size_t n = y->size();
+
+  const auto part = [positive](double v) {
+    return (positive) ? std::max(v, 0.0) : std::min(v, 0.0);
+  };
+  auto times  = acquire_buffer(n);
+  auto values = acquire_buffer(n);
+  for (size_t i = 0; i < n; i++) {
+    times.push_back(ts[i]);
+    values.push_back(part(ys[i]));
+    if (i + 1 < n && (ys[i] < 0) != (ys[i + 1] < 0) && ys[i] != 0 && ys[i + 1] != 0 &&
+        !std::isinf(ys[i]) && !std::isinf(ys[i + 1])) {
+      const double t = ts[i] - ys[i] * (ts[i + 1] - ts[i]) / (ys[i + 1] - ys[i]);
+      if (ts[i] < t && t < ts[i + 1]) {
+        times.push_back(t);
+        values.push_back(0.0);
+      }
+    }
+  }
+  return make_signal(std::move(values), std::move(times));
+}
+
+struct CumulativeOp {
+  std::pair<double, double> time_range;
+  /// The signals of the trace, rebased onto shared time columns.
+  Trace trace;
+  /// The robustness of the subformulas, by the address of their nodes.
+  std::unordered_map<const void*, CumulativeRobustness> memo;
+  Executor* executor = nullptr;
+
+  CumulativeOp(const Trace& signals, Executor* exec, bool synchronized) :
+      trace{share_time_bases(signals, synchronized)}, executor{exec} {
+    time_range = get_time_range(trace);
+  }
+
+  CumulativeRobustness compute(const ast::Expr& phi) {
+    const void* addr = ast::node_address(phi);
+    if (addr != nullptr) {
+      if (const auto it = memo.find(addr); it != memo.end()) {
+        return it->second;
+      }
+    }
+    auto out = std::visit([this](const auto& e) { return (*this)(e); }, phi);
+    if (addr != nullptr) {
+      memo.emplace(addr, out);
+    }
+    return out;
+  }
+
+  CumulativeRobustness operator()(const ast::Const& e) {
+    const auto [begin, end] = time_range;
+    auto zero = make_signal({0.0, 0.0}, {begin, end}, {0.0, 0.0});
+    auto top  = compute_const(e.value, begin, end);
+    if (e.value) {
+      return {std::move(top), std::move(zero)};
+    }
+    return {std::move(zero), std::move(top)};
+  }
+
+  CumulativeRobustness operator()(const ast::Predicate& e) {
+    const auto y = compute_predicate(trace.at(e.name), e.op, e.rhs);
+    return {clip(y, true), clip(y, false)};
+  }
+
+  CumulativeRobustness operator()(const ast::NotPtr& e) {
+    const auto y = compute(e->arg);
+    return {compute_not(y.negative), compute_not(y.positive)};
+  }
+
+  CumulativeRobustness operator()(const ast::AndPtr& e) {
+    auto [pos, neg] = compute_all(e->args);
+    return {
+        compute_and(std::move(pos), executor), compute_and(std::move(neg), executor)};
+  }
+
+  CumulativeRobustness operator()(const ast::OrPtr& e) {
+    auto [pos, neg] = compute_all(e->args);
+    return {compute_or(std::move(pos), executor), compute_or(std::move(neg), executor)};
+  }
+
+  CumulativeRobustness operator()(const ast::EventuallyPtr& e) {
+    const auto y = compute(e->arg);
+    return {
+        compute_integral(y.positive, e->interval),
+        compute_integral(y.negative, e->interval)};
+  }
+
+  CumulativeRobustness operator()(const ast::AlwaysPtr& e) {
+    const auto y = compute(e->arg);
+    return {
+        compute_always(y.positive, e->interval),
+        compute_always(y.negative, e->interval)};
+  }
+
+  CumulativeRobustness operator()(const ast::UntilPtr&) {
+    throw std::invalid_argument(
+        "Until is not supported by the cumulative robustness semantics");
+  }
+
+  /// Compute the positive and negative robustness of each of the operands.
+  std::pair<std::vector<SignalPtr>, std::vector<SignalPtr>>
+  compute_all(const std::vector<ast::Expr>& args) {
+    auto out = std::pair<std::vector<SignalPtr>, std::vector<SignalPtr>>{};
+    for (const auto& arg : args) {
+      auto y = compute(arg);
+      out.first.push_back(std::move(y.positive));
+      out.second.push_back(std::move(y.negative));
+    }
+    return out;
+  }
+};
+
+} // namespace
+
+CumulativeRobustness compute_cumulative_robustness(
+    const ast::Expr& phi,
+    const Trace& trace,
+    const EvaluationOptions& options) {
+  auto pool     = std::unique_ptr<ThreadPool>{};
+  auto executor = get_executor(options, pool);
+  auto buffers  = std::make_shared<BufferPool>();
+  auto scope    = BufferPool::Scope{buffers.get()};
+
+  auto op = CumulativeOp{trace, executor, options.synchronized};
+  return op.compute(phi);
+}
+
+} // namespace signal_tl::semantics
@@ -0,0 +1,384 @@
+#include "signal_tl/discrete.hpp"
+#include "signal_tl/ast.hpp"
+#include "signal_tl/internal/utils.hpp"
+#include "signal_tl/plan.hpp"
+#include "signal_tl/signal.hpp"
+
+#include "buffer_pool.hpp" // for make_signal
+
+#include <algorithm>    // for min, max, equal
+#include <cmath>        // for ceil, floor, isinf, abs
+#include <cstddef>      // for size_t
+#include <deque>        // for deque
+#include <fmt/format.h> // for format
+#include <functional>   // for greater, less
+#include <limits>       // for numeric_limits
+#include <stdexcept>    // for invalid_argument, logic_error, out_of_range
+#include <utility>      // for move, pair
+#include <variant>      // for get_if, get
+#include <vector>       // for vector
+
+namespace signal_tl::discrete {
+using semantics::EvaluationPlan;
+using OpCode = EvaluationPlan::OpCode;
+using Values = std::vector<double>;
+using Input  = utils::span<const double>;
+
+namespace {
+
+constexpr double TOP    = std::numeric_limits<double>::infinity();
+constexpr double BOTTOM = -TOP;
+
+/// Relative tolerance when converting times to steps, such that, e.g., `0.3 / 0.1`
+/// is 3 steps.
+constexpr double STEP_TOLERANCE = 1e-9;
+
+/// Get `min(i + d, last)` without overflowing (as `d` may be `npos`).
+constexpr size_t clamp_add(size_t i, size_t d, size_t last) {
+  return (d >= last - i) ? last : i + d;
+}
+
+/// Get the value at each step that is the optimum of `x` over the window
+/// `[i + a, i + b]` (clipped to the last step), where `Better{}(u, v)` if `u` is
+/// strictly better than `v`, using a monotonic wedge of the steps in the window.
+template <typename Better>
+void compute_windowed(const Values& x, size_t a, size_t b, Values& out) {
+  const auto better = Better{};
+  const size_t n    = x.size();
+  out.resize(n);
+  if (n == 0) {
+    return;
+  }
+  const size_t last = n - 1;
+
+  if (b == EvaluationPlan::npos) {
+    // The window always extends to the last step, so this is the optimum of the
+    // suffix starting at the window start.
+    auto suffix = Values(n);
+    suffix[last] = x[last];
+    for (size_t i = last; i-- > 0;) {
+      suffix[i] = better(x[i], suffix[i + 1]) ? x[i] : suffix[i + 1];
+    }
+    for (size_t i = 0; i < n; i++) { out[i] = suffix[clamp_add(i, a, last)]; }
+    return;
+  }
+
+  // The front of the wedge (at `head`) is the optimum of the window, and the values
+  // are strictly worse towards the back. As both ends of the window move forward,
+  // each step is pushed and popped at most once.
+  auto wedge  = std::vector<size_t>{};
+  size_t head = 0;
+  size_t next = 0; // The next step to enter the window.
+  wedge.reserve(std::min(n, b - a + 1));
+  for (size_t i = 0; i < n; i++) {
+    const size_t lo = clamp_add(i, a, last);
+    const size_t hi = clamp_add(i, b, last);
+    for (; next <= hi; next++) {
+      while (wedge.size() > head && !better(x[wedge.back()], x[next])) {
+        wedge.pop_back();
+      }
+      wedge.push_back(next);
+    }
+    while (wedge[head] < lo) { head++; }
+    out[i] = x[wedge[head]];
+  }
+}
+
+/// Get `z_i = min(x_i, max(y_i, z_{i + 1}))` at each step, i.e., the unbounded Until.
+void compute_until(const Values& x, const Values& y, Values& out) {
+  const size_t n = x.size();
+  out.resize(n);
+  if (n == 0) {
+    return;
+  }
+  double prev  = std::min(x.back(), y.back());
+  out.back()   = prev;
+  for (size_t i = n - 1; i-- > 0;) {
+    prev   = std::min(x[i], std::max(y[i], prev));
+    out[i] = prev;
+  }
+}
+
+/// Get `max_{j in [i + a, i + b]} min(y_j, min_{k = i, ..., j} x_k)` at each step,
+/// where the window is clipped to the last step.
+///
+/// This is the algorithm of the continuous-time (bounded) Until, where the windows
+/// are indexed by steps: see `compute_until` in "until.cc".
+void compute_until(const Values& x, const Values& y, size_t a, size_t b, Values& out) {
+  const size_t n = x.size();
+  out.resize(n);
+  if (n == 0) {
+    return;
+  }
+  const size_t last = n - 1;
+
+  auto window = std::deque<std::pair<size_t, double>>{};
+  auto x_min  = std::deque<size_t>{};
+
+  size_t e = n; // The next step to enter the window is e - 1.
+  for (size_t i = n; i-- > 0;) {
+    const size_t lo = clamp_add(i, a, last);
+    const size_t hi = clamp_add(i, b, last);
+
+    while (!x_min.empty() && x[x_min.front()] >= x[i]) { x_min.pop_front(); }
+    x_min.push_front(i);
+
+    if (!window.empty() && window.back().second >= x[i]) {
+      size_t merged = 0;
+      while (!window.empty() && window.back().second >= x[i]) {
+        merged = window.back().first;
+        window.pop_back();
+      }
+      window.emplace_back(merged, x[i]);
+    }
+
+    for (; e > i && e - 1 >= lo; e--) {
+      const size_t j = e - 1;
+      if (j > hi) {
+        continue;
+      }
+      while (x_min.back() > j) { x_min.pop_back(); }
+      const double u = std::min(y[j], x[x_min.back()]);
+      while (!window.empty() && window.front().second <= u) { window.pop_front(); }
+      window.emplace_front(j, u);
+    }
+
+    while (window.back().first > hi) { window.pop_back(); }
+    out[i] = window.back().second;
+  }
+}
+
+/// Reduce the operands elementwise, where `Better{}(u, v)` if `u` is better than `v`.
+template <typename Better>
+void compute_reduce(const std::vector<const Values*>& ys, Values& out) {
+  const auto better = Better{};
+  out               = *ys.front();
+  for (size_t k = 1; k < ys.size(); k++) {
+    const auto& y = *ys[k];
+    for (size_t i = 0; i < out.size(); i++) {
+      out[i] = better(y[i], out[i]) ? y[i] : out[i];
+    }
+  }
+}
+
+void compute_op(
+    const EvaluationPlan::Op& op,
+    const std::vector<Input>& inputs,
+    const std::vector<Values>& results,
+    size_t n,
+    double period,
+    Values& out) {
+  const auto arg = [&](size_t i) -> const Values& { return results[op.args[i]]; };
+
+  switch (op.code) {
+    case OpCode::Const:
+      out.assign(n, (op.value) ? TOP : BOTTOM);
+      return;
+    case OpCode::Predicate: {
+      const auto x = inputs[op.slot];
+      out.resize(n);
+      const bool ge = op.comparison == ast::ComparisonOp::GE ||
+                      op.comparison == ast::ComparisonOp::GT;
+      const double scale = (ge) ? 1.0 : -1.0;
+      for (size_t i = 0; i < n; i++) { out[i] = scale * (x[i] - op.rhs); }
+      return;
+    }
+    case OpCode::Not: {
+      const auto& y = arg(0);
+      out.resize(n);
+      for (size_t i = 0; i < n; i++) { out[i] = -y[i]; }
+      return;
+    }
+    case OpCode::And:
+    case OpCode::Or: {
+      auto ys = std::vector<const Values*>{};
+      ys.reserve(op.args.size());
+      for (const size_t i : op.args) { ys.push_back(&results[i]); }
+      if (op.code == OpCode::And) {
+        compute_reduce<std::less<>>(ys, out);
+      } else {
+        compute_reduce<std::greater<>>(ys, out);
+      }
+      return;
+    }
+    case OpCode::Eventually: {
+      const auto [a, b] = to_steps(op.interval, period);
+      compute_windowed<std::greater<>>(arg(0), a, b, out);
+      return;
+    }
+    case OpCode::Always: {
+      const auto [a, b] = to_steps(op.interval, period);
+      compute_windowed<std::less<>>(arg(0), a, b, out);
+      return;
+    }
+    case OpCode::Until: {
+      const auto [a, b] = to_steps(op.interval, period);
+      if (a == 0 && b == EvaluationPlan::npos) {
+        compute_until(arg(0), arg(1), out);
+      } else {
+        compute_until(arg(0), arg(1), a, b, out);
+      }
+      return;
+    }
+  }
+  throw std::logic_error("Unknown operation in evaluation plan.");
+}
+
+/// Evaluate the plan over the `n` values of the signals of the plan (in the order of
+/// `plan.signals()`), which are only read and must outlive the evaluation.
+Values evaluate(
+    const EvaluationPlan& plan,
+    const std::vector<Input>& inputs,
+    size_t n,
+    double period) {
+  // Free the results as soon as they aren't used anymore, and reuse their buffers.
+  const auto& ops = plan.ops();
+  auto results    = std::vector<Values>(ops.size());
+  auto uses       = std::vector<size_t>(ops.size());
+  auto free       = std::vector<Values>{};
+  for (size_t i = 0; i < ops.size(); i++) { uses[i] = ops[i].uses; }
+  for (size_t i = 0; i < ops.size(); i++) {
+    auto out = Values{};
+    if (!free.empty()) {
+      out = std::move(free.back());
+      free.pop_back();
+    }
+    compute_op(ops[i], inputs, results, n, period, out);
+    results[i] = std::move(out);
+    for (const size_t j : ops[i].args) {
+      if (uses[j] != EvaluationPlan::npos && --uses[j] == 0) {
+        free.push_back(std::move(results[j]));
+      }
+    }
+  }
+  return std::move(results[plan.outputs().front()]);
+}
+
+} // namespace
+
+std::pair<size_t, size_t> to_steps(const ast::Interval& interval, double period) {
+  if (!(period > 0)) {
+    throw std::invalid_argument("The sampling period must be positive.");
+  }
+  size_t a = 0;
+  size_t b = EvaluationPlan::npos;
+  if (const auto* pa = std::get_if<unsigned long long int>(&interval.low)) {
+    a = *pa;
+  } else {
+    const double steps = std::get<double>(interval.low) / period;
+    a = static_cast<size_t>(std::ceil(steps - STEP_TOLERANCE * std::max(1.0, steps)));
+  }
+  if (const auto* pb = std::get_if<unsigned long long int>(&interval.high)) {
+    b = *pb;
+  } else if (const double high = std::get<double>(interval.high); !std::isinf(high)) {
+    const double steps = high / period;
+    b = static_cast<size_t>(std::floor(steps + STEP_TOLERANCE * std::max(1.0, steps)));
+  }
+  if (b < a) {
+    const auto [low, high] = interval.as_double();
+    throw std::invalid_argument(fmt::format(
+        "The interval [{}, {}] doesn't contain any step of length {}.",
+        low,
+        high,
+        period));
+  }
+  return {a, b};
+}
+
+std::vector<double> compute_robustness(
+    const EvaluationPlan& plan,
+    const DiscreteTrace& trace,
+    double period) {
+  if (plan.outputs().size() != 1) {
+    throw std::invalid_argument(
+        "The plan must be compiled from a single formula to compute its robustness.");
+  }
+
+  auto inputs = std::vector<Input>{};
+  inputs.reserve(plan.signals().size());
+  for (const auto& name : plan.signals()) {
+    const auto it = trace.find(name);
+    if (it == trace.end()) {
+      throw std::out_of_range(fmt::format("No signal named `{}` in the trace.", name));
+    }
+    inputs.emplace_back(it->second.data(), it->second.size());
+  }
+  size_t n = 0;
+  if (!inputs.empty()) {
+    n = inputs.front().size();
+  } else if (!trace.empty()) {
+    n = trace.begin()->second.size();
+  }
+  for (size_t k = 0; k < inputs.size(); k++) {
+    if (inputs[k].size() != n) {
+      throw std::invalid_argument(fmt::format(
+          "Signal `{}` has {} values, but signal `{}` has {}.",
+          plan.signals()[k],
+          inputs[k].size(),
+          plan.signals().front(),
+          n));
+    }
+  }
+  return evaluate(plan, inputs, n, period);
+}
+
+std::vector<double>
+compute_robustness(const ast::Expr& phi, const DiscreteTrace& trace, double period) {
+  return compute_robustness(EvaluationPlan{phi}, trace, period);
+}
+
+signal::SignalPtr compute_robustness(const ast::Expr& phi, const signal::Trace& trace) {
+  const auto plan = EvaluationPlan{phi};
+
+  // All the signals must share the time points of the first one.
+  auto reference = signal::SignalPtr{};
+  auto inputs    = std::vector<Input>{};
+  inputs.reserve(plan.signals().size());
+  for (const auto& name : plan.signals()) {
+    const auto& x = trace.at(name);
+    if (reference == nullptr) {
+      reference = x;
+    } else if (
+        x->size() != reference->size() ||
+        !std::equal(x->times().begin(), x->times().end(), reference->times().begin())) {
+      throw std::invalid_argument(fmt::format(
+          "Signal `{}` isn't sampled at the same time points as signal `{}`.",
+          name,
+          plan.signals().front()));
+    }
+    // The values are read in place, as the trace outlives the evaluation.
+    inputs.push_back(x->values());
+  }
+  if (reference == nullptr) {
+    throw std::invalid_argument(
+        "The formula must use a signal to get the time points of the robustness.");
+  }
+
+  const auto ts = reference->times();
+  double period = 1.0;
+  if (ts.size() > 1) {
+    period = (ts.back() - ts.front()) / static_cast<double>(ts.size() - 1);
+    for (size_t i = 1; i < ts.size(); i++) {
+      if (std::abs(ts[i] - ts[i - 1] - period) > 1e-6 * period) {
+        throw std::invalid_argument(fmt::format(
+            "The signals aren't sampled uniformly: time[{}] = {} and time[{}] = {}, "
+            "but the average sampling period is {}.",
+            i - 1,
+            ts[i - 1],
+            i,
+            ts[i],
+            period));
+      }
+    }
+  }
+
+  // The result shares the time points of the signals.
+  const auto& times = reference->time_column();
+  auto rob          = evaluate(plan, inputs, reference->size(), period);
+  auto shared = (times.is_view())
+                    ? times
+                    : signal::Column::view(times.data(), times.size(), reference);
+  return signal::make_signal(signal::Column{std::move(rob)}, std::move(shared));
+}
+
+} // namespace signal_tl::discrete
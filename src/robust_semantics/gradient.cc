@@ -0,0 +1,295 @@
+#include "signal_tl/gradient.hpp"
+#include "signal_tl/ast.hpp"
+#include "signal_tl/plan.hpp"
+#include "signal_tl/robustness.hpp"
+#include "signal_tl/signal.hpp"
+
+#include "operators.hpp" // for get_time_range
+
+#include <algorithm>    // for lower_bound, max, merge, min, sort, unique, ...
+#include <cmath>        // for abs
+#include <cstddef>      // for size_t
+#include <fmt/format.h> // for format
+#include <iterator>     // for back_inserter
+#include <limits>       // for numeric_limits
+#include <map>          // for map
+#include <optional>     // for optional
+#include <stdexcept>    // for invalid_argument, out_of_range
+#include <utility>      // for pair, move
+#include <vector>       // for vector
+
+namespace signal_tl::semantics {
+using namespace signal;
+
+namespace {
+
+using Op     = EvaluationPlan::Op;
+using OpCode = EvaluationPlan::OpCode;
+
+/// The value of the signal at `t`, clamped to where it is defined.
+double value_at(const Signal& y, double t) {
+  const auto ts  = y.times();
+  const size_t k = std::upper_bound(ts.begin(), ts.end(), t) - ts.begin();
+  return (k == 0) ? y.front().value : y[k - 1].interpolate(t);
+}
+
+/// The time points of `y` in `[lo, hi]` where its minimum (or maximum) can be, i.e.,
+/// the ends and the samples in between.
+std::vector<double> candidates(const Signal& y, double lo, double hi) {
+  const auto ts = y.times();
+  auto out      = std::vector<double>{lo};
+  for (auto it = std::upper_bound(ts.begin(), ts.end(), lo);
+       it != ts.end() && *it < hi;
+       it++) {
+    out.push_back(*it);
+  }
+  if (hi > lo) {
+    out.push_back(hi);
+  }
+  return out;
+}
+
+/// The slope of `y` right after (or right before) `t`.
+double slope_at(const Signal& y, double t, bool right) {
+  const auto ts = y.times();
+  size_t k      = (right) ? std::upper_bound(ts.begin(), ts.end(), t) - ts.begin()
+                          : std::lower_bound(ts.begin(), ts.end(), t) - ts.begin();
+  return (k == 0 || k == ts.size()) ? 0.0 : y[k - 1].derivative;
+}
+
+/// Check if `a` and `b` are equal, up to rounding.
+bool ties(double a, double b) {
+  return std::abs(a - b) <= 1e-12 * std::max(1.0, std::abs(a));
+}
+
+/// Follows the operands that attain the robustness of each operation, and collects
+/// the partial derivatives with respect to the samples of the inputs.
+///
+/// Where the minimum (or maximum) over time of a temporal operator is at a kink of
+/// its operand (e.g., where the operands of an `Or` cross), the time of the optimum
+/// moves with the samples, and the gradient is the combination of the gradients on
+/// both sides of the kink (weighted by their slopes) for which the optimum is
+/// stationary.
+struct Backward {
+  const std::vector<Op>& ops;
+  const std::vector<SignalPtr>& results;
+  const std::vector<SignalPtr>& inputs;
+  /// The partial derivatives, by slot and sample index.
+  std::map<std::pair<size_t, size_t>, double> partials;
+
+  /// Propagate `weight`, the derivative with respect to the robustness of the
+  /// operation `i` at time `t`. The operands of `And` and `Or` that tie at `t` are
+  /// chosen by their values at `t + offset`, i.e., on one side of a kink.
+  void run(size_t i, double t, double weight, double offset = 0.0) {
+    const auto& op = ops[i];
+    switch (op.code) {
+      case OpCode::Const:
+        return;
+      case OpCode::Predicate:
+        return predicate(op, t, weight);
+      case OpCode::Not:
+        return run(op.args[0], t, -weight, offset);
+      case OpCode::And:
+      case OpCode::Or: {
+        const bool maximize = op.code == OpCode::Or;
+        size_t best         = op.args[0];
+        double best_value   = value_at(*results[best], t + offset);
+        for (const size_t a : op.args) {
+          const double v = value_at(*results[a], t + offset);
+          if ((maximize) ? v > best_value : v < best_value) {
+            best       = a;
+            best_value = v;
+          }
+        }
+        return run(best, t, weight, offset);
+      }
+      case OpCode::Eventually:
+      case OpCode::Always:
+        return optimum(op, t, weight, offset);
+      case OpCode::Until:
+        return until(op, t, weight);
+    }
+  }
+
+  void predicate(const Op& op, double t, double weight) {
+    const auto& x  = *inputs[op.slot];
+    const auto ts  = x.times();
+    const size_t n = x.size();
+    if (op.comparison == ast::ComparisonOp::LE ||
+        op.comparison == ast::ComparisonOp::LT) {
+      weight = -weight;
+    }
+
+    size_t k = std::upper_bound(ts.begin(), ts.end(), t) - ts.begin();
+    k        = (k == 0) ? 0 : k - 1;
+    if (k + 1 < n && t > ts[k]) {
+      const double w = (t - ts[k]) / (ts[k + 1] - ts[k]);
+      partials[{op.slot, k}] += weight * (1 - w);
+      partials[{op.slot, k + 1}] += weight * w;
+    } else {
+      partials[{op.slot, k}] += weight;
+    }
+  }
+
+  /// The robustness of `Eventually` (`Always`) at `t` is the maximum (minimum) of the
+  /// operand over `[t + a, t + b]`. The optimum is chosen at `t + offset`, and if it
+  /// is at an end of the window, it moves along with it.
+  void optimum(const Op& op, double t, double weight, double offset) {
+    const auto& y       = *results[op.args[0]];
+    const auto [a, b]   = op.interval.as_double();
+    const bool maximize = op.code == OpCode::Eventually;
+
+    const double lo   = std::min(t + offset + a, y.end_time());
+    const double hi   = std::min(t + offset + b, y.end_time());
+    const auto points = candidates(y, lo, hi);
+    size_t best       = 0;
+    for (size_t k = 1; k < points.size(); k++) {
+      const double v = value_at(y, points[k]);
+      if ((maximize) ? v > value_at(y, points[best]) : v < value_at(y, points[best])) {
+        best = k;
+      }
+    }
+    if (best == 0 || best + 1 == points.size()) {
+      const double end = (best == 0) ? t + a : t + b;
+      return run(op.args[0], std::min(end, y.end_time()), weight, offset);
+    }
+    const double at = points[best];
+
+    // Follow the operands on the side(s) of the optimum, close enough to it that
+    // nothing else changes in between.
+    const double left  = slope_at(y, at, false);
+    const double right = slope_at(y, at, true);
+    const double delta = 1e-6 * std::min(at - points[best - 1], points[best + 1] - at);
+    if ((maximize) ? (left > 0 && right < 0) : (left < 0 && right > 0)) {
+      const double w = right / (right - left);
+      run(op.args[0], at, weight * w, -delta);
+      run(op.args[0], at, weight * (1 - w), delta);
+    } else if (right == 0 || left == 0) {
+      // The optimum is on a plateau, whose value doesn't depend on where it starts.
+      run(op.args[0], at, weight, (right == 0) ? delta : -delta);
+    } else {
+      run(op.args[0], at, weight);
+    }
+  }
+
+  /// The robustness of `y1 U[a, b] y2` at `t` is the maximum over `s` in
+  /// `[t + a, t + b]` of the minimum of `y2` at `s` and of `y1` over `[t, s]`.
+  void until(const Op& op, double t, double weight) {
+    const auto& y1    = *results[op.args[0]];
+    const auto& y2    = *results[op.args[1]];
+    const auto [a, b] = op.interval.as_double();
+    const double end  = std::min(y1.end_time(), y2.end_time());
+    const double lo   = std::min(t + a, end);
+    const double hi   = std::min(t + b, end);
+
+    // Both operands are linear between the samples of either of them, so the
+    // optimum is at one of the samples, or where they cross in between.
+    auto points       = std::vector<double>{};
+    const auto first  = candidates(y1, t, hi);
+    const auto second = candidates(y2, t, hi);
+    std::merge(
+        first.begin(),
+        first.end(),
+        second.begin(),
+        second.end(),
+        std::back_inserter(points));
+    points.push_back(lo);
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    for (size_t k = 0, n = points.size(); k + 1 < n; k++) {
+      const double p = points[k], q = points[k + 1];
+      const double f = value_at(y1, p) - value_at(y2, p);
+      const double g = value_at(y1, q) - value_at(y2, q);
+      if ((f < 0 && g > 0) || (f > 0 && g < 0)) {
+        points.push_back(p + (q - p) * f / (f - g));
+      }
+    }
+    std::sort(points.begin(), points.end());
+
+    constexpr double TOP = std::numeric_limits<double>::infinity();
+    // The minimum of `y1` since `t`, and where it is.
+    double min_first = TOP, min_at = t;
+    // The best value, and where the operands that attain it are.
+    double best = -TOP, first_at = t, second_at = lo;
+    double second_weight = 1.0;
+    for (const double s : points) {
+      if (const double v = value_at(y1, s); v <= min_first) {
+        min_first = v;
+        min_at    = s;
+      }
+      const double v2 = value_at(y2, s);
+      if (s < lo || std::min(v2, min_first) <= best) {
+        continue;
+      }
+      best      = std::min(v2, min_first);
+      first_at  = min_at;
+      second_at = s;
+      if (!ties(v2, min_first)) {
+        second_weight = (v2 < min_first) ? 1.0 : 0.0;
+        continue;
+      }
+      // Where `y2` rises through a falling `y1`, the optimum moves with both.
+      const double d1 = slope_at(y1, s, true);
+      const double d2 = slope_at(y2, s, true);
+      second_weight   = (min_at == s && d2 > 0 && d1 < 0) ? d1 / (d1 - d2) : 0.0;
+    }
+    if (second_weight > 0) {
+      run(op.args[1], second_at, weight * second_weight);
+    }
+    if (second_weight < 1) {
+      run(op.args[0], first_at, weight * (1 - second_weight));
+    }
+  }
+};
+
+} // namespace
+
+RobustnessGradient compute_robustness_gradient(
+    const ast::Expr& phi,
+    const Trace& trace,
+    std::optional<double> time,
+    const EvaluationOptions& options) {
+  if (options.semantics != Semantics::Classic) {
+    throw std::invalid_argument(
+        "Gradients are only supported for the classic robustness semantics");
+  }
+  const auto plan = EvaluationPlan{phi};
+
+  auto inputs = std::vector<SignalPtr>{};
+  for (const auto& name : plan.signals()) { inputs.push_back(trace.at(name)); }
+
+  // The robustness starts where all the signals that it uses are defined.
+  if (!time.has_value()) {
+    time = get_time_range(trace).first;
+    for (const auto& x : inputs) {
+      if (!x->empty()) {
+        time = std::max(*time, x->begin_time());
+      }
+    }
+  }
+  const double t = *time;
+
+  auto window_options   = options;
+  window_options.window = {t, t};
+  const auto results    = plan.evaluate_ops(trace, window_options);
+  const size_t root     = plan.outputs().front();
+  if (results[root]->empty()) {
+    throw std::out_of_range(
+        fmt::format("Robustness of the formula is undefined at time {}", t));
+  }
+
+  auto backward = Backward{plan.ops(), results, inputs, {}};
+  backward.run(root, t, 1.0);
+
+  auto out  = RobustnessGradient{};
+  out.time  = t;
+  out.value = value_at(*results[root], t);
+  for (const auto& [key, derivative] : backward.partials) {
+    if (derivative != 0.0) {
+      out.gradient.push_back({plan.signals()[key.first], key.second, derivative});
+    }
+  }
+  return out;
+}
+
+} // namespace signal_tl::semantics
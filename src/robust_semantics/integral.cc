@@ -0,0 +1,192 @@
+#include "integral.hpp"
+#include "buffer_pool.hpp" // for acquire_buffer, release_buffer, make_signal
+
+#include <algorithm> // for min, merge, unique
+#include <cmath>     // for isinf
+#include <cstddef>   // for size_t
+#include <iterator>  // for back_inserter
+#include <limits>    // for numeric_limits
+#include <utility>   // for move
+#include <vector>    // for vector
+
+namespace signal_tl::integral {
+using namespace signal;
+
+namespace {
+
+constexpr double TOP = std::numeric_limits<double>::infinity();
+
+/**
+ * The integral of a signal from its start up to some time.
+ *
+ * The robustness can be infinite (e.g., for constants), and the differences of
+ * infinite prefix sums are undefined. So, the lengths of the segments where the
+ * signal is at +/-inf are summed separately from the (finite) areas of the others.
+ */
+struct Area {
+  double finite = 0.0;
+  double top    = 0.0;
+  double bottom = 0.0;
+
+  /// Add the part of length `dt` of the segment from `v0` to `v1`, with the given
+  /// area (if it is finite).
+  void add(double v0, double v1, double area, double dt) {
+    if (std::isinf(v0) || std::isinf(v1)) {
+      top += (v0 == TOP || v1 == TOP) ? dt : 0.0;
+      bottom += (v0 == -TOP || v1 == -TOP) ? dt : 0.0;
+    } else {
+      finite += area;
+    }
+  }
+
+  /// The integral between `lo` and `hi`, i.e., `hi - lo`.
+  [[nodiscard]] static double between(const Area& lo, const Area& hi) {
+    const bool is_top    = hi.top > lo.top;
+    const bool is_bottom = hi.bottom > lo.bottom;
+    if (is_top && is_bottom) {
+      return std::numeric_limits<double>::quiet_NaN();
+    } else if (is_top) {
+      return TOP;
+    } else if (is_bottom) {
+      return -TOP;
+    }
+    return hi.finite - lo.finite;
+  }
+};
+
+/// The time stamps of the output of a kernel over `x`, sampled at the same points.
+Column same_times(const SignalPtr& x) {
+  if (x->time_column().is_view()) {
+    return Column{x->time_column()};
+  }
+  auto times = acquire_buffer(x->size());
+  times.assign(x->times().begin(), x->times().end());
+  return times;
+}
+
+/// The time stamps of the output of a windowed kernel over `x`: its samples, and the
+/// points in its domain where an end of the window `[t + a, t + b]` is at a sample.
+Column window_times(const SignalPtr& x, double a, double b) {
+  const auto ts = x->times();
+  // The samples shifted by -d (from the first one in the domain).
+  const auto shifted = [&](double d) {
+    auto out = acquire_buffer(ts.size());
+    for (const double t : ts) {
+      if (t - d >= ts.front()) {
+        out.push_back(t - d);
+      }
+    }
+    return out;
+  };
+  auto shifted_a = shifted(a);
+  auto shifted_b = shifted(b);
+  auto ends      = acquire_buffer(shifted_a.size() + shifted_b.size());
+  std::merge(
+      shifted_a.begin(),
+      shifted_a.end(),
+      shifted_b.begin(),
+      shifted_b.end(),
+      std::back_inserter(ends));
+  release_buffer(std::move(shifted_a));
+  release_buffer(std::move(shifted_b));
+
+  auto times = acquire_buffer(ts.size() + ends.size());
+  std::merge(ts.begin(), ts.end(), ends.begin(), ends.end(), std::back_inserter(times));
+  release_buffer(std::move(ends));
+  times.erase(std::unique(times.begin(), times.end()), times.end());
+  if (times.size() == ts.size()) {
+    release_buffer(std::move(times));
+    return same_times(x);
+  }
+  return times;
+}
+
+/// Compute the integral of `x` over `[t + a, t + b]` at each sample `t`, and where an
+/// end of the window is at a sample. If `average` is set, divide it by the length of
+/// the window.
+SignalPtr compute_window(const SignalPtr& x, double a, double b, bool average) {
+  const auto ts  = x->times();
+  const auto xs  = x->values();
+  const size_t n = x->size();
+
+  // The integral from the start of `x` up to each of its samples.
+  auto prefix = std::vector<Area>(n);
+  for (size_t i = 0; i + 1 < n; i++) {
+    const double dt = ts[i + 1] - ts[i];
+    prefix[i + 1]   = prefix[i];
+    prefix[i + 1].add(xs[i], xs[i + 1], (xs[i] + xs[i + 1]) * dt / 2, dt);
+  }
+
+  // The integral up to `t`, where `k` is advanced to the last sample at or before
+  // `t`. The queries must be made in increasing order of `t`.
+  const auto area_at = [&](double t, size_t& k) {
+    while (k + 1 < n && ts[k + 1] <= t) { k++; }
+    auto out = prefix[k];
+    if (k + 1 < n && t > ts[k]) {
+      out.add(xs[k], xs[k + 1], x->area(t, k), t - ts[k]);
+    }
+    return out;
+  };
+
+  // Between these points, the ends of the window are on a single segment each, so
+  // they are where the result changes its shape.
+  auto times            = window_times(x, a, b);
+  const double end_time = x->end_time();
+  auto values           = acquire_buffer(times.size());
+  size_t lo_idx = 0, hi_idx = 0;
+  for (const double t : times) {
+    const double lo = std::min(t + a, end_time);
+    const double hi = std::min(t + b, end_time);
+
+    const auto lo_area = area_at(lo, lo_idx);
+    const auto hi_area = area_at(hi, hi_idx);
+    double value       = Area::between(lo_area, hi_area);
+    if (average) {
+      value = (hi > lo) ? value / (hi - lo) : (*x)[lo_idx].interpolate(lo);
+    }
+    values.push_back(value);
+  }
+  return make_signal(std::move(values), std::move(times));
+}
+
+/// Compute the integral of `x` from each sample to the end. If `average` is set,
+/// divide it by the length of the window.
+SignalPtr compute_suffix(const SignalPtr& x, bool average) {
+  const auto ts  = x->times();
+  const auto xs  = x->values();
+  const size_t n = x->size();
+
+  auto values = acquire_buffer(n);
+  values.resize(n);
+  double sum = 0.0;
+  for (size_t i = n; i-- > 0;) {
+    if (i + 1 < n) {
+      sum += (xs[i] + xs[i + 1]) * (ts[i + 1] - ts[i]) / 2;
+    }
+    values[i] = sum;
+    if (average) {
+      values[i] = (i + 1 < n) ? sum / (ts[n - 1] - ts[i]) : xs[i];
+    }
+  }
+  return make_signal(std::move(values), same_times(x));
+}
+
+} // namespace
+
+SignalPtr compute_integral_seq(const SignalPtr& x) {
+  return compute_suffix(x, false);
+}
+
+SignalPtr compute_integral_seq(const SignalPtr& x, double a, double b) {
+  return compute_window(x, a, b, false);
+}
+
+SignalPtr compute_average_seq(const SignalPtr& x) {
+  return compute_suffix(x, true);
+}
+
+SignalPtr compute_average_seq(const SignalPtr& x, double a, double b) {
+  return compute_window(x, a, b, true);
+}
+
+} // namespace signal_tl::integral
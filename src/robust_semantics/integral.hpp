@@ -0,0 +1,41 @@
+#ifndef SIGNAL_TEMPORAL_LOGIC_INTEGRAL_HPP
+#define SIGNAL_TEMPORAL_LOGIC_INTEGRAL_HPP
+
+#include "signal_tl/signal.hpp"
+
+namespace signal_tl::integral {
+
+/**
+ * Compute the integral of the signal from each of its samples to its end, in a single
+ * (backward) pass.
+ */
+signal::SignalPtr compute_integral_seq(const signal::SignalPtr& x);
+
+/**
+ * Compute the integral of the signal over the window `[t + a, t + b]` (clamped to the
+ * end of the signal) at each of its samples `t`, and at the points where an end of the
+ * window is at a sample (where the result changes its shape).
+ *
+ * The integrals over the windows are the differences of the prefix sums of the areas
+ * of the segments of the signal, so each window costs O(1) instead of O(W), for a
+ * window with W samples.
+ */
+signal::SignalPtr compute_integral_seq(const signal::SignalPtr& x, double a, double b);
+
+/**
+ * Compute the average value of the signal (i.e., its integral divided by the length
+ * of the window) from each of its samples to its end.
+ *
+ * The average over an empty window (at the end of the signal) is the value there.
+ */
+signal::SignalPtr compute_average_seq(const signal::SignalPtr& x);
+
+/**
+ * Compute the average value of the signal over the window `[t + a, t + b]` (clamped
+ * to the end of the signal), at the same time points as `compute_integral_seq`.
+ */
+signal::SignalPtr compute_average_seq(const signal::SignalPtr& x, double a, double b);
+
+} // namespace signal_tl::integral
+
+#endif
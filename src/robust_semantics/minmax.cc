@@ -1,67 +1,354 @@
 #include "minmax.hpp"
-#include "mono_wedge.h" // for mono_wedge_update
-
-#include <algorithm>  // for max, reverse
-#include <deque>      // for _Deque_iterator, deque, operator-
-#include <functional> // for greater_equal, less_equal
-#include <iterator>   // for prev, next, begin
-#include <limits>     // for numeric_limits
-#include <memory>     // for __shared_ptr_access, make_shared
-#include <numeric>    // for accumulate
-#include <tuple>      // for make_tuple, tuple_element<>::type
-#include <utility>    // for tuple_element<>::type
+#include "buffer_pool.hpp" // for acquire_buffer, make_signal, BufferPool
+#include "kernels.hpp"     // for elementwise_min, elementwise_max
+
+#include <algorithm>   // for all_of, max, min, equal, push_heap, pop_heap, sort, ...
+#include <array>       // for array
+#include <cmath>       // for abs, isfinite
+#include <cstdint>     // for uint8_t
+#include <functional>  // for greater_equal, less_equal
+#include <iterator>    // for prev, next, begin
+#include <limits>      // for numeric_limits
+#include <memory>      // for __shared_ptr_access, make_shared
+#include <type_traits> // for is_same_v
+#include <utility>     // for tuple_element<>::type, move, pair
+#include <vector>      // for vector
 
 #include <cassert> // for assert
 
 namespace signal_tl::minmax {
 using namespace signal;
 
+namespace {
+
+/**
+ * Compute the pointwise winner of `comp` between `x` and `y`.
+ *
+ * For the comparisons used by `compute_elementwise_min`/`compute_elementwise_max`,
+ * this uses the vectorized kernels. `chose_y[i]` is set to `1` if `y[i]` wins.
+ */
+template <typename Compare>
+void select_pointwise(
+    const double* x,
+    const double* y,
+    double* out,
+    std::uint8_t* chose_y,
+    size_t n,
+    Compare comp) {
+  if constexpr (std::is_same_v<Compare, std::less_equal<>>) {
+    kernels::elementwise_min(x, y, out, chose_y, n);
+  } else if constexpr (std::is_same_v<Compare, std::greater_equal<>>) {
+    kernels::elementwise_max(x, y, out, chose_y, n);
+  } else {
+    for (size_t i = 0; i < n; i++) {
+      const bool pick_x = comp(Sample{0.0, x[i]}, Sample{0.0, y[i]});
+      out[i]            = (pick_x) ? x[i] : y[i];
+      chose_y[i]        = (pick_x) ? 0 : 1;
+    }
+  }
+}
+
+/**
+ * Compute the pointwise winner of `comp` between all the signals in a single pass.
+ *
+ * The breakpoints of all the signals are merged using a heap of cursors (one per
+ * signal). Between two consecutive breakpoints, every signal is linear, so the winner
+ * can only change where another signal with a better slope crosses it, and each such
+ * crossing is added to the output. Thus, the output has a sample at each breakpoint
+ * (of any of the signals) in the range where all of them are defined, and at each
+ * point where the winner changes.
+ *
+ * If all the signals share the same time column, the breakpoints are just the shared
+ * time stamps, so the heap isn't needed.
+ */
+template <typename Compare>
+SignalPtr compute_minmax_kway(const std::vector<SignalPtr>& xs, Compare comp) {
+  const size_t k = xs.size();
+  assert(k > 0);
+
+  double begin_time = -std::numeric_limits<double>::infinity();
+  double end_time   = std::numeric_limits<double>::infinity();
+  size_t capacity   = 0;
+  for (const auto& x : xs) {
+    begin_time = std::max(begin_time, x->begin_time());
+    end_time   = std::min(end_time, x->end_time());
+    capacity += x->size();
+  }
+  if (end_time < begin_time) {
+    // The signals don't overlap.
+    return std::make_shared<Signal>();
+  }
+  const auto& time_col = xs[0]->time_column();
+  const bool shared    = std::all_of(xs.begin(), xs.end(), [&](const SignalPtr& x) {
+    return x->time_column().data() == time_col.data() &&
+           x->time_column().size() == time_col.size();
+  });
+
+  // `a` is strictly better than `b`.
+  const auto better = [&comp](double a, double b) {
+    return !comp(Sample{0.0, b}, Sample{0.0, a});
+  };
+
+  // For each signal, the index of the last sample at or before the current time.
+  auto idx = std::vector<size_t>(k);
+  // The next breakpoint of each signal, as a min-heap of (time, signal).
+  using Cursor       = std::pair<double, size_t>;
+  auto cursors       = std::vector<Cursor>{};
+  const auto later   = [](const Cursor& a, const Cursor& b) {
+    return a.first > b.first;
+  };
+  const auto advance = [&](size_t j) {
+    if (shared) {
+      return;
+    }
+    const auto ts = xs[j]->times();
+    if (idx[j] + 1 < ts.size() && ts[idx[j] + 1] <= end_time) {
+      cursors.emplace_back(ts[idx[j] + 1], j);
+      std::push_heap(cursors.begin(), cursors.end(), later);
+    }
+  };
+  cursors.reserve(k);
+  for (size_t j = 0; j < k; j++) {
+    const auto ts = xs[j]->times();
+    idx[j]        = static_cast<size_t>(
+        std::prev(std::upper_bound(ts.begin(), ts.end(), begin_time)) - ts.begin());
+    advance(j);
+  }
+
+  // Same as `Signal::at`, the values at the samples are exact, as the slopes of the
+  // segments towards infinite values are infinite (and `inf * 0` is NaN).
+  const auto value_at = [&](size_t j, double t) {
+    const double t0 = xs[j]->times()[idx[j]];
+    const double x0 = xs[j]->values()[idx[j]];
+    return (t == t0) ? x0 : x0 + xs[j]->derivatives()[idx[j]] * (t - t0);
+  };
+  const auto slope = [&](size_t j) { return xs[j]->derivatives()[idx[j]]; };
+
+  auto out_times  = acquire_buffer(capacity);
+  auto out_values = acquire_buffer(capacity);
+
+  double t = begin_time;
+  for (;;) {
+    // The winner at `t`, where ties are broken by the slope, i.e., it is also the
+    // winner right after `t`.
+    size_t w       = 0;
+    double w_value = value_at(0, t);
+    for (size_t j = 1; j < k; j++) {
+      const double v = value_at(j, t);
+      if (better(v, w_value) || (v == w_value && better(slope(j), slope(w)))) {
+        w       = j;
+        w_value = v;
+      }
+    }
+    out_times.push_back(t);
+    out_values.push_back(w_value);
+    if (t >= end_time) {
+      break;
+    }
+
+    // Add the crossings before the next breakpoint. The slope of the winner improves
+    // at each crossing, so there are at most `k - 1` of them.
+    double next_t = (cursors.empty()) ? end_time : cursors.front().first;
+    if (shared) {
+      next_t = (idx[0] + 1 < time_col.size()) ? time_col[idx[0] + 1] : end_time;
+    }
+    for (double s = t;;) {
+      double crossing = next_t;
+      size_t next_w   = w;
+      for (size_t j = 0; j < k; j++) {
+        if (j == w || !better(slope(j), slope(w))) {
+          continue;
+        }
+        const double c = s + (value_at(j, s) - value_at(w, s)) / (slope(w) - slope(j));
+        // A crossing at the next breakpoint is left to it, which picks the winner
+        // (by slope, on ties) at its own time stamp.
+        const bool earlier =
+            c < crossing || (c == crossing && better(slope(j), slope(next_w)));
+        if (s < c && c < next_t && earlier) {
+          crossing = c;
+          next_w   = j;
+        }
+      }
+      if (next_w == w) {
+        break;
+      }
+      out_times.push_back(crossing);
+      out_values.push_back(value_at(next_w, crossing));
+      s = crossing;
+      w = next_w;
+    }
+
+    // Move the cursors that are at the next breakpoint.
+    if (shared) {
+      for (auto& i : idx) { i++; }
+    }
+    while (!cursors.empty() && cursors.front().first <= next_t) {
+      std::pop_heap(cursors.begin(), cursors.end(), later);
+      const size_t j = cursors.back().second;
+      cursors.pop_back();
+      idx[j]++;
+      advance(j);
+    }
+    t = next_t;
+  }
+
+  if (shared && out_times.size() == time_col.size() && time_col.is_view()) {
+    release_buffer(std::move(out_times));
+    return make_signal(std::move(out_values), Column{time_col});
+  }
+  return make_signal(std::move(out_values), std::move(out_times));
+}
+
+/**
+ * Compute the pointwise winner of `comp` between two signals with different time
+ * stamps, reading the synchronized values directly from a `SynchronizedView`.
+ */
+template <typename Compare>
+SignalPtr compute_minmax_unaligned(const Signal& x, const Signal& y, Compare comp) {
+  const auto view = SynchronizedView{x, y};
+  auto out_times  = acquire_buffer(view.size_hint());
+  auto out_values = acquire_buffer(view.size_hint());
+
+  auto prev        = SynchronizedView::Point{};
+  bool prev_pick_x = false;
+  for (auto it = view.begin(); it != view.end(); it++) {
+    const auto p      = *it;
+    const bool pick_x = comp(Sample{0.0, p.x}, Sample{0.0, p.y});
+    if (it != view.begin() && pick_x != prev_pick_x) {
+      // Both signals are linear between the two points, so they intersect where
+      // their difference changes sign.
+      const double d0 = prev.x - prev.y;
+      const double d1 = p.x - p.y;
+      if (d0 * d1 < 0) {
+        const double dt = p.time - prev.time;
+        const double t  = prev.time + dt * d0 / (d0 - d1);
+        if (prev.time < t && t < p.time) {
+          out_times.push_back(t);
+          out_values.push_back(prev.x + (p.x - prev.x) * (t - prev.time) / dt);
+        }
+      }
+    }
+    out_times.push_back(p.time);
+    out_values.push_back((pick_x) ? p.x : p.y);
+    prev        = p;
+    prev_pick_x = pick_x;
+  }
+
+  return make_signal(std::move(out_values), std::move(out_times));
+}
+
+/**
+ * A double-ended queue of indices in a ring buffer, for the wedges of the windowed
+ * min/max. The capacity is a power of two, and only grows (by doubling) if the
+ * window holds more samples than ever before.
+ */
+class RingBuffer {
+ public:
+  [[nodiscard]] bool empty() const {
+    return count == 0;
+  }
+  [[nodiscard]] size_t front() const {
+    return buffer[head];
+  }
+  [[nodiscard]] size_t back() const {
+    return buffer[(head + count - 1) & (buffer.size() - 1)];
+  }
+  void pop_front() {
+    head = (head + 1) & (buffer.size() - 1);
+    count--;
+  }
+  void pop_back() {
+    count--;
+  }
+  void push_back(size_t value) {
+    if (count == buffer.size()) {
+      grow();
+    }
+    buffer[(head + count) & (buffer.size() - 1)] = value;
+    count++;
+  }
+
+ private:
+  std::vector<size_t> buffer = std::vector<size_t>(64);
+  size_t head                = 0;
+  size_t count               = 0;
+
+  void grow() {
+    auto larger = std::vector<size_t>(2 * buffer.size());
+    for (size_t i = 0; i < count; i++) {
+      larger[i] = buffer[(head + i) & (buffer.size() - 1)];
+    }
+    buffer = std::move(larger);
+    head   = 0;
+  }
+};
+
+/// Check if the signals are defined at the same time points.
+bool same_times(const Signal& x, const Signal& y) {
+  const auto xt = x.times();
+  const auto yt = y.times();
+  return xt.size() == yt.size() &&
+         (xt.data() == yt.data() || std::equal(xt.begin(), xt.end(), yt.begin()));
+}
+
+} // namespace
+
 template <typename Compare>
 SignalPtr compute_minmax_pair(
-    const SignalPtr& input_x,
-    const SignalPtr& input_y,
+    const SignalPtr& x,
+    const SignalPtr& y,
     Compare comp,
     bool synchronized) {
-  const auto [x, y] = (synchronized) ? std::make_tuple(input_x, input_y)
-                                     : synchronize(input_x, input_y);
+  if (!synchronized && !same_times(*x, *y)) {
+    return compute_minmax_unaligned(*x, *y, comp);
+  }
   assert(x->size() == y->size());
   assert(x->begin_time() == y->begin_time());
-
   assert(x->end_time() == y->end_time());
 
-  // Used to keep track of the signal from which the last minmax winner was chosen.
-  enum struct Chosen { X, Y, NONE };
-  Chosen last_chosen = Chosen::NONE;
-
-  auto out = std::make_shared<Signal>();
-
-  for (auto [i, j] = std::make_tuple(x->begin(), y->begin());
-       i != x->end() && j != y->end();
-       i++, j++) {
-    if (comp(*i, *j)) {
-      if (last_chosen == Chosen::Y) {
-        double intercept_time = std::prev(j)->time_intersect(*std::prev(i));
-        if (intercept_time > out->end_time() && intercept_time != i->time) {
-          out->push_back(
-              Sample{intercept_time, std::prev(j)->interpolate(intercept_time)});
-        }
-      }
-      out->push_back(*i);
-      last_chosen = Chosen::X;
-    } else {
-      if (last_chosen == Chosen::X) {
-        double intercept_time = std::prev(i)->time_intersect(*std::prev(j));
-        if (intercept_time > out->end_time() && intercept_time != j->time) {
-          out->push_back(
-              Sample{intercept_time, std::prev(i)->interpolate(intercept_time)});
+  const auto ts  = x->times();
+  const size_t n = x->size();
+
+  // First, compute the pointwise winners over the (synchronized) value columns...
+  auto values = acquire_buffer(n);
+  values.resize(n);
+  auto chose_y = std::vector<std::uint8_t>(n);
+  select_pointwise(
+      x->values().data(), y->values().data(), values.data(), chose_y.data(), n, comp);
+
+  // ... and then add the points where the signals intersect, i.e., wherever the
+  // winner switches from one signal to the other.
+  auto out_times  = acquire_buffer(n);
+  auto out_values = acquire_buffer(n);
+
+  const auto xv = x->values();
+  const auto yv = y->values();
+  for (size_t i = 0; i < n; i++) {
+    if (i > 0 && chose_y[i] != chose_y[i - 1]) {
+      // Both signals are linear between the two samples, so they intersect where
+      // their difference changes sign.
+      const double d0 = xv[i - 1] - yv[i - 1];
+      const double d1 = xv[i] - yv[i];
+      if (d0 * d1 < 0) {
+        const double w = d0 / (d0 - d1);
+        const double t = ts[i - 1] + (ts[i] - ts[i - 1]) * w;
+        if (out_times.back() < t && t < ts[i]) {
+          out_times.push_back(t);
+          out_values.push_back(xv[i - 1] + (xv[i] - xv[i - 1]) * w);
         }
       }
-      out->push_back(*j);
-      last_chosen = Chosen::Y;
     }
+    out_times.push_back(ts[i]);
+    out_values.push_back(values[i]);
   }
+  release_buffer(std::move(values));
 
-  return out;
+  if (out_times.size() == n && x->time_column().is_view()) {
+    // No intersections were added, so the output can share the time column of `x`.
+    release_buffer(std::move(out_times));
+    return make_signal(std::move(out_values), Column{x->time_column()});
+  }
+  return make_signal(std::move(out_values), std::move(out_times));
 }
 
 template <typename Compare>
@@ -77,71 +364,225 @@ compute_minmax_pair(const std::vector<SignalPtr>& xs, Compare comp, bool synchro
     return compute_minmax_pair(xs[0], xs[1], comp, synchronized);
   }
 
-  // TODO(anand): Parallel execution policy?
-  SignalPtr out = std::accumulate(
-      std::next(xs.cbegin()),
-      xs.cend(),
-      xs.at(0),
-      [&comp, &synchronized](const SignalPtr a, const SignalPtr b) {
-        return compute_minmax_pair(a, b, comp, synchronized);
+  return compute_minmax_kway(xs, comp);
+}
+
+template <typename Compare>
+SignalPtr compute_minmax_pair(
+    const std::vector<SignalPtr>& xs,
+    Compare comp,
+    Executor& executor,
+    bool synchronized) {
+  if (xs.size() <= 2) {
+    return compute_minmax_pair(xs, comp, synchronized);
+  }
+  // Split the signals into (at most) one group per thread, and merge each group
+  // concurrently before merging the results.
+  const size_t num_groups = std::min(executor.concurrency(), xs.size() / 2);
+  if (num_groups <= 1) {
+    return compute_minmax_kway(xs, comp);
+  }
+
+  // The tasks may run on other threads, so they have to use the pool explicitly.
+  auto* const pool = BufferPool::current();
+  auto partial     = std::vector<SignalPtr>(num_groups);
+  {
+    auto tasks = TaskGroup{&executor};
+    for (size_t g = 0; g < num_groups; g++) {
+      tasks.run([&, g]() {
+        auto scope       = BufferPool::Scope{pool};
+        const auto first = std::next(xs.begin(), g * xs.size() / num_groups);
+        const auto last  = std::next(xs.begin(), (g + 1) * xs.size() / num_groups);
+        partial[g] = compute_minmax_kway(std::vector<SignalPtr>{first, last}, comp);
       });
-  return out;
+    }
+    tasks.wait();
+  }
+  return compute_minmax_kway(partial, comp);
 }
 
 template <typename Compare>
 SignalPtr compute_minmax_seq(const SignalPtr& x, Compare comp) {
-  auto opt = x->back();
-  auto z   = std::vector<Sample>{};
-  z.reserve(2 * x->size());
-  z.push_back(x->back());
+  if (x->empty()) {
+    return x;
+  }
+  const auto ts  = x->times();
+  const auto xs  = x->values();
+  const size_t n = x->size();
+
+  auto times  = acquire_buffer(2 * n);
+  auto values = acquire_buffer(2 * n);
 
-  for (auto i = std::next(x->rbegin()); i != x->rend(); i++) {
-    opt = (comp(*i, opt)) ? *i : opt;
-    z.push_back({i->time, opt.value});
+  // `u` is strictly better than `v`.
+  const auto better = [&comp](double u, double v) {
+    return !comp(Sample{0.0, v}, Sample{0.0, u});
+  };
+  // Going backwards, `opt` is the optimum of the samples after the current segment.
+  // Where the segment is (strictly) better than it at its start, but not at its end,
+  // the result follows the segment from the point where it crosses `opt`.
+  double opt = xs[n - 1];
+  times.push_back(ts[n - 1]);
+  values.push_back(opt);
+  for (size_t i = n - 1; i-- > 0;) {
+    if (better(xs[i], opt)) {
+      if (better(opt, xs[i + 1]) && std::isfinite(xs[i]) && std::isfinite(xs[i + 1])) {
+        const double w = (opt - xs[i]) / (xs[i + 1] - xs[i]);
+        times.push_back(ts[i] + (ts[i + 1] - ts[i]) * w);
+        values.push_back(opt);
+      }
+      opt = xs[i];
+    }
+    times.push_back(ts[i]);
+    values.push_back(opt);
   }
 
-  std::reverse(z.begin(), z.end());
-  return std::make_shared<Signal>(z);
+  std::reverse(times.begin(), times.end());
+  std::reverse(values.begin(), values.end());
+  return make_signal(std::move(values), std::move(times));
 }
 
 template <typename Compare>
 SignalPtr compute_minmax_seq(const SignalPtr& x, double a, double b, Compare comp) {
-  const auto width      = b - a;
-  const auto begin_time = x->begin_time();
-  const auto end_time   = x->end_time();
+  if (x->empty()) {
+    return x;
+  }
+  const auto ts         = x->times();
+  const auto xs         = x->values();
+  const auto ds         = x->derivatives();
+  const size_t n        = x->size();
+  const double end_time = ts[n - 1];
 
-  auto x_ = (a == 0)
-                ? x
-                : x->resize_shift(
-                      begin_time + width, end_time + width, x->back().value, -width);
+  // `u` is at least as good as `v`.
+  const auto better = [&comp](double u, double v) {
+    return comp(Sample{0.0, u}, Sample{0.0, v});
+  };
+  // The value of `x` at `s`, where `k` is the number of samples at or before `s` (the
+  // ends of the window only move to the next segment of `x` at the events below).
+  const auto value_at = [&](double s, size_t k) {
+    return (k >= n) ? xs[n - 1] : xs[k - 1] + ds[k - 1] * (s - ts[k - 1]);
+  };
 
-  auto z       = std::make_shared<Signal>();
-  auto samples = std::deque<Sample>{x_->begin(), x_->end()};
-  auto window  = std::deque<Sample>{};
+  // The result is piecewise-linear, and its breakpoints are where an end of the
+  // window [t + a, t + b] is at a sample of `x` (the events), and where the values at
+  // the ends of the window and the optimum of the samples inside it cross each
+  // other. Between two events, the samples inside the window are the same, i.e., the
+  // samples with index in [lo, hi), and the ends of the window are on a single
+  // segment of `x` each.
+  size_t lo = 0;
+  size_t hi = 0;
+  // Move the (indices of the) ends of the window past the events at or before `t`.
+  const auto advance = [&](double t) {
+    while (lo < n && ts[lo] - a <= t) { lo++; }
+    while (hi < n && ts[hi] - b <= t) { hi++; }
+  };
+  // The wedge of the samples inside the window, whose values are strictly worse from
+  // the front to the back, as indices into a ring buffer.
+  auto wedge       = RingBuffer{};
+  size_t next      = 0;
+  const auto inner = [&]() {
+    for (; next < hi; next++) {
+      while (!wedge.empty() && better(xs[next], xs[wedge.back()])) { wedge.pop_back(); }
+      wedge.push_back(next);
+    }
+    while (!wedge.empty() && wedge.front() < lo) { wedge.pop_front(); }
+  };
 
-  auto i = std::begin(samples);
-  // -- Read in values in [0, width)
-  for (; i->time < x->begin_time() + width; i++) {
-    mono_wedge::mono_wedge_update(window, *i, comp);
-  }
+  auto out_times  = acquire_buffer(2 * n);
+  auto out_values = acquire_buffer(2 * n);
+  // Add a breakpoint, replacing the last one if it is on the line between its
+  // neighbors.
+  const auto emit = [&](double t, double v) {
+    const size_t m = out_times.size();
+    if (m >= 2) {
+      const double t0 = out_times[m - 2], v0 = out_values[m - 2];
+      const double t1 = out_times[m - 1], v1 = out_values[m - 1];
+      const double lhs = (v1 - v0) * (t - t1);
+      const double rhs = (v - v1) * (t1 - t0);
+      const double tol = 1e-12 * (std::abs(lhs) + std::abs(rhs));
+      if ((v0 == v1 && v1 == v) || std::abs(lhs - rhs) <= tol) {
+        out_times.back()  = t;
+        out_values.back() = v;
+        return;
+      }
+    }
+    out_times.push_back(t);
+    out_values.push_back(v);
+  };
+
+  double t = ts[0];
+  advance(t);
+  inner();
+  const auto opt = [&](double u, double v) { return (better(u, v)) ? u : v; };
+  double lo_value = value_at(std::min(t + a, end_time), lo);
+  double hi_value = value_at(std::min(t + b, end_time), hi);
+  bool has_inner  = !wedge.empty();
+  double c        = (has_inner) ? xs[wedge.front()] : 0.0;
+  emit(t, (has_inner) ? opt(opt(lo_value, hi_value), c) : opt(lo_value, hi_value));
+
+  while (t < end_time) {
+    double t_next = end_time;
+    if (lo < n) {
+      t_next = std::min(t_next, ts[lo] - a);
+    }
+    if (hi < n) {
+      t_next = std::min(t_next, ts[hi] - b);
+    }
+    const double lo_next = value_at(std::min(t_next + a, end_time), lo);
+    const double hi_next = value_at(std::min(t_next + b, end_time), hi);
 
-  // -- Stream in the rest of the signal.
-  for (; i != samples.end(); i++) {
-    if (i->time - a > window.front().time) {
-      // Add the sample for time M.front + a
-      i = samples.insert(
-          i,
-          Sample{
-              window.front().time + a,
-              std::prev(i)->interpolate(window.front().time + a),
-              0.0});
+    // The crossings of the (linear) values at the ends, and the (constant) optimum
+    // inside the window, that are on the optimum of the three (up to rounding, as the
+    // last sample ties with the upper end once the window is clipped to it).
+    struct Crossing {
+      double t;
+      double value;
+    };
+    auto crossings      = std::array<Crossing, 3>{};
+    size_t num_crossing = 0;
+    const double dt     = t_next - t;
+    const auto cross    = [&](double f0, double f1, double g0, double g1, auto third) {
+      const double d0 = f0 - g0;
+      const double d1 = f1 - g1;
+      if (!(d0 * d1 < 0) || !std::isfinite(d0) || !std::isfinite(d1)) {
+        return;
+      }
+      const double w   = d0 / (d0 - d1);
+      const double v   = f0 + (f1 - f0) * w;
+      const double u   = third(w);
+      const double tol = 1e-12 * (std::abs(u) + std::abs(v));
+      if (better(v, u) || std::abs(u - v) <= tol) {
+        crossings[num_crossing++] = Crossing{t + dt * w, v};
+      }
+    };
+    const auto lo_line = [&](double w) { return lo_value + (lo_next - lo_value) * w; };
+    const auto hi_line = [&](double w) { return hi_value + (hi_next - hi_value) * w; };
+    cross(lo_value, lo_next, hi_value, hi_next, [&](double w) {
+      return (has_inner) ? c : lo_line(w);
+    });
+    if (has_inner) {
+      cross(lo_value, lo_next, c, c, hi_line);
+      cross(hi_value, hi_next, c, c, lo_line);
     }
-    mono_wedge::mono_wedge_update(window, *i, comp);
-    while (window.front().time <= i->time - a) { window.pop_front(); }
-    z->push_back(i->time, i->value);
+    const auto earlier = [](const Crossing& l, const Crossing& r) { return l.t < r.t; };
+    std::sort(crossings.begin(), crossings.begin() + num_crossing, earlier);
+    for (size_t k = 0; k < num_crossing; k++) {
+      if (t < crossings[k].t && crossings[k].t < t_next) {
+        emit(crossings[k].t, crossings[k].value);
+      }
+    }
+    const double end_value = opt(lo_next, hi_next);
+    emit(t_next, (has_inner) ? opt(end_value, c) : end_value);
+
+    t = t_next;
+    advance(t);
+    inner();
+    lo_value  = value_at(std::min(t + a, end_time), lo);
+    hi_value  = value_at(std::min(t + b, end_time), hi);
+    has_inner = !wedge.empty();
+    c         = (has_inner) ? xs[wedge.front()] : 0.0;
   }
 
-  return z->simplify();
+  return make_signal(std::move(out_values), std::move(out_times));
 }
 
 SignalPtr
@@ -162,6 +603,20 @@ SignalPtr compute_elementwise_max(const std::vector<SignalPtr>& xs, bool synchro
   return compute_minmax_pair(xs, std::greater_equal<>(), synchronized);
 }
 
+SignalPtr compute_elementwise_min(
+    const std::vector<SignalPtr>& xs,
+    Executor& executor,
+    bool synchronized) {
+  return compute_minmax_pair(xs, std::less_equal<>(), executor, synchronized);
+}
+
+SignalPtr compute_elementwise_max(
+    const std::vector<SignalPtr>& xs,
+    Executor& executor,
+    bool synchronized) {
+  return compute_minmax_pair(xs, std::greater_equal<>(), executor, synchronized);
+}
+
 SignalPtr compute_max_seq(const SignalPtr& x) {
   return compute_minmax_seq(x, std::greater_equal<>());
 }
@@ -1,6 +1,7 @@
 #ifndef SIGNAL_TEMPORAL_LOGIC_MINMAX_HPP
 #define SIGNAL_TEMPORAL_LOGIC_MINMAX_HPP
 
+#include "signal_tl/executor.hpp"
 #include "signal_tl/signal.hpp"
 
 #include <vector>
@@ -47,8 +48,30 @@ signal::SignalPtr compute_elementwise_max(
     bool synchronized = false);
 
 /**
- * Compute the rolling min/max of a signal, i.e., at time t, the min/max value is the
- * sample with min/max value in the window [t, t + inf).
+ * Compute the element-wise minimum/maximum (depending on value of Compare) between
+ * multiple signals, as a parallel tree reduction on the given executor.
+ */
+template <typename Compare>
+signal::SignalPtr compute_minmax_pair(
+    const std::vector<signal::SignalPtr>& xs,
+    Compare comp,
+    Executor& executor,
+    bool synchronized = false);
+
+signal::SignalPtr compute_elementwise_min(
+    const std::vector<signal::SignalPtr>& xs,
+    Executor& executor,
+    bool synchronized = false);
+
+signal::SignalPtr compute_elementwise_max(
+    const std::vector<signal::SignalPtr>& xs,
+    Executor& executor,
+    bool synchronized = false);
+
+/**
+ * Compute the rolling min/max of a signal, i.e., at time t, the min/max value of the
+ * signal over the window [t, t + inf), with a breakpoint where it starts following
+ * the signal.
  */
 template <typename Compare>
 signal::SignalPtr compute_minmax_seq(const signal::SignalPtr& x, Compare comp);
@@ -0,0 +1,189 @@
+#include "signal_tl/ast.hpp"
+#include "signal_tl/monitor.hpp"
+#include "signal_tl/signal.hpp"
+
+#include "signal_tl/fmt.hpp" // IWYU pragma: keep
+
+#include <exception>    // for make_exception_ptr
+#include <fmt/format.h> // for format
+#include <future>       // for promise, future
+#include <map>          // for map, multimap
+#include <memory>       // for unique_ptr, make_unique
+#include <optional>     // for optional, nullopt
+#include <stdexcept>    // for invalid_argument, logic_error, out_of_range
+#include <string>       // for string
+#include <utility>      // for move
+#include <vector>       // for vector
+
+namespace signal_tl::semantics {
+using namespace signal;
+
+namespace {
+
+/// A formula of the group, with the requests for its robustness that aren't settled
+/// yet.
+struct Formula {
+  std::string name;
+  OnlineMonitor monitor;
+  RobustnessCallback callback;
+  /// The last settled sample.
+  std::optional<Sample> last = std::nullopt;
+  std::multimap<double, std::promise<Sample>> pending;
+
+  Formula(std::string _name, const ast::Expr& phi, RobustnessCallback on_update) :
+      name{std::move(_name)}, monitor{phi}, callback{std::move(on_update)} {}
+
+  /// Fail the request for the robustness after `t`, which will never be settled.
+  void unsettled(std::promise<Sample>& request, double t) const {
+    request.set_exception(std::make_exception_ptr(std::out_of_range(fmt::format(
+        "The robustness of '{}' has no samples at or after {}", this->name, t))));
+  }
+
+  /// Deliver the samples that the monitor settled since the last time.
+  void deliver() {
+    const auto samples = monitor.poll();
+    if (samples.empty()) {
+      return;
+    }
+    for (const auto& s : samples) {
+      while (!pending.empty() && pending.begin()->first <= s.time) {
+        pending.begin()->second.set_value(s);
+        pending.erase(pending.begin());
+      }
+    }
+    last = samples.back();
+    if (callback) {
+      callback(name, samples);
+    }
+  }
+};
+
+} // namespace
+
+struct MonitorGroup::Impl {
+  std::vector<std::unique_ptr<Formula>> formulas;
+  std::map<std::string, Formula*> by_name;
+  /// The formulas using each channel.
+  std::multimap<std::string, Formula*> routes;
+  /// The last sample of each channel that is used.
+  std::map<std::string, Sample> last_samples;
+  bool finished = false;
+};
+
+MonitorGroup::MonitorGroup() : impl{std::make_unique<Impl>()} {}
+
+MonitorGroup::~MonitorGroup() = default;
+
+MonitorGroup::MonitorGroup(MonitorGroup&&) noexcept = default;
+MonitorGroup& MonitorGroup::operator=(MonitorGroup&&) noexcept = default;
+
+void MonitorGroup::add(
+    const std::string& name,
+    const ast::Expr& phi,
+    RobustnessCallback on_update) {
+  if (impl->finished) {
+    throw std::logic_error("Cannot add formulas to a monitor group that has finished.");
+  }
+  if (impl->by_name.count(name) > 0) {
+    throw std::invalid_argument(
+        fmt::format("The monitor group already has a formula named '{}'", name));
+  }
+  auto formula = std::make_unique<Formula>(name, phi, std::move(on_update));
+  for (const auto& channel : ast::signal_names(phi)) {
+    impl->routes.emplace(channel, formula.get());
+  }
+  impl->by_name.emplace(name, formula.get());
+  impl->formulas.push_back(std::move(formula));
+}
+
+void MonitorGroup::push_back(const std::string& channel, double time, double value) {
+  if (impl->finished) {
+    throw std::logic_error("Cannot add samples to a monitor group that has finished.");
+  }
+  const auto [begin, end] = impl->routes.equal_range(channel);
+  if (begin == end) {
+    return;
+  }
+  const auto sample = Sample{time, value};
+  if (auto it = impl->last_samples.find(channel); it != impl->last_samples.end()) {
+    if (time <= it->second.time) {
+      throw std::invalid_argument(fmt::format(
+          "Trying to append a Sample timestamped at or before the end_time of channel "
+          "\"{}\", i.e., time is not strictly monotonically increasing. "
+          "Current end_time is {}, given Sample is {}.",
+          channel,
+          it->second.time,
+          sample));
+    }
+    it->second = sample;
+  } else {
+    impl->last_samples.emplace(channel, sample);
+  }
+
+  for (auto it = begin; it != end; it++) {
+    it->second->monitor.push_back(channel, sample);
+    it->second->deliver();
+  }
+}
+
+void MonitorGroup::hold(const std::string& channel, double time) {
+  const auto it = impl->last_samples.find(channel);
+  if (it != impl->last_samples.end() && it->second.time < time) {
+    this->push_back(channel, time, it->second.value);
+  }
+}
+
+void MonitorGroup::advance_to(double time) {
+  // Holding a channel only changes its own entry, so the iterator stays valid.
+  for (const auto& [channel, last] : impl->last_samples) {
+    if (last.time < time) {
+      this->push_back(channel, time, last.value);
+    }
+  }
+}
+
+std::future<Sample>
+MonitorGroup::settled_sample(const std::string& name, double t) {
+  auto& formula = *impl->by_name.at(name);
+  if (formula.last.has_value() && t < formula.last->time) {
+    throw std::invalid_argument(fmt::format(
+        "The robustness of '{}' after {} was already delivered (settled until {})",
+        name,
+        t,
+        formula.last->time));
+  }
+  auto request = std::promise<Sample>{};
+  auto out     = request.get_future();
+  if (formula.last.has_value() && t == formula.last->time) {
+    request.set_value(*formula.last);
+  } else if (impl->finished) {
+    formula.unsettled(request, t);
+  } else {
+    formula.pending.emplace(t, std::move(request));
+  }
+  return out;
+}
+
+double MonitorGroup::settled_until(const std::string& name) const {
+  return impl->by_name.at(name)->monitor.settled_until();
+}
+
+void MonitorGroup::finish() {
+  if (impl->finished) {
+    return;
+  }
+  impl->finished = true;
+  for (auto& formula : impl->formulas) {
+    formula->monitor.finish();
+    formula->deliver();
+    // There are no samples past the end of the streams.
+    for (auto& [t, request] : formula->pending) { formula->unsettled(request, t); }
+    formula->pending.clear();
+  }
+}
+
+bool MonitorGroup::finished() const {
+  return impl->finished;
+}
+
+} // namespace signal_tl::semantics
@@ -0,0 +1,714 @@
+#include "signal_tl/monitor.hpp"
+
+#include "signal_tl/ast.hpp"
+#include "signal_tl/signal.hpp"
+
+#include "signal_tl/fmt.hpp" // IWYU pragma: keep
+
+#include "minmax.hpp"
+#include "mono_wedge.h" // for mono_wedge_update
+#include "until.hpp"
+
+#include <algorithm>    // for any_of, lower_bound, max, min, sort
+#include <array>        // for array
+#include <cmath>        // for abs, isfinite, isinf
+#include <deque>        // for deque
+#include <fmt/format.h> // for format
+#include <functional>   // for less_equal, greater_equal
+#include <iterator>     // for prev
+#include <limits>       // for numeric_limits
+#include <map>          // for multimap
+#include <memory>       // for unique_ptr, make_unique
+#include <optional>     // for optional
+#include <stdexcept>    // for invalid_argument, logic_error
+#include <string>       // for string
+#include <utility>      // for move, pair
+#include <variant>      // for visit
+#include <vector>       // for vector
+
+namespace signal_tl::semantics {
+using namespace signal;
+
+namespace {
+constexpr double TOP    = std::numeric_limits<double>::infinity();
+constexpr double BOTTOM = -TOP;
+
+/// Linearly interpolate the value at time `t` between two consecutive samples.
+double lerp(const Sample& lhs, const Sample& rhs, double t) {
+  if (lhs.value == rhs.value) {
+    // Also takes care of constant (infinite) signals.
+    return lhs.value;
+  }
+  return lhs.value + (rhs.value - lhs.value) * (t - lhs.time) / (rhs.time - lhs.time);
+}
+
+/// A node in the online monitor.
+///
+/// Each node produces a stream of settled output samples, which is consumed by its
+/// parent node (or by the monitor, for the root node).
+struct Node {
+  /// Settled samples that have not yet been consumed by the parent.
+  std::deque<Sample> out;
+
+  virtual ~Node() = default;
+
+  /// Consume any new samples produced by the children and settle as many output
+  /// samples as possible.
+  virtual void update() = 0;
+
+  /// Settle all remaining output samples, given that the input streams are done.
+  virtual void finish() = 0;
+};
+
+/// Time instance up to which the monitor has seen samples (from any signal).
+///
+/// Used to generate samples for constant nodes, as they are defined everywhere.
+struct Clock {
+  double now = BOTTOM;
+};
+
+struct ConstNode : Node {
+  const Clock& clock;
+  double value;
+  double last_time = BOTTOM;
+
+  ConstNode(const Clock& c, bool val) : clock{c}, value{(val) ? TOP : BOTTOM} {}
+
+  void update() override {
+    if (clock.now > last_time) {
+      out.push_back(Sample{clock.now, value});
+      last_time = clock.now;
+    }
+  }
+
+  void finish() override {
+    update();
+  }
+};
+
+struct PredicateNode : Node {
+  ast::ComparisonOp op;
+  double rhs;
+
+  PredicateNode(ast::ComparisonOp operation, double constant) :
+      op{operation}, rhs{constant} {}
+
+  void push(const Sample& s) {
+    switch (op) {
+      case ast::ComparisonOp::GE:
+      case ast::ComparisonOp::GT:
+        out.push_back(Sample{s.time, s.value - rhs});
+        break;
+      case ast::ComparisonOp::LE:
+      case ast::ComparisonOp::LT:
+        out.push_back(Sample{s.time, rhs - s.value});
+        break;
+    }
+  }
+
+  void update() override {}
+  void finish() override {}
+};
+
+struct NotNode : Node {
+  std::unique_ptr<Node> arg;
+
+  NotNode(std::unique_ptr<Node> child) : arg{std::move(child)} {}
+
+  void update() override {
+    arg->update();
+    for (; !arg->out.empty(); arg->out.pop_front()) {
+      const auto& s = arg->out.front();
+      out.push_back(Sample{s.time, -s.value});
+    }
+  }
+
+  void finish() override {
+    arg->finish();
+    update();
+  }
+};
+
+/// Element-wise min/max of two streams.
+///
+/// The streams are synchronized on the fly: an output sample is settled at time `t`
+/// once both operands are known at `t`, and an additional sample is inserted
+/// wherever the operands cross.
+template <typename Compare>
+struct MinMaxNode : Node {
+  std::unique_ptr<Node> lhs;
+  std::unique_ptr<Node> rhs;
+  Compare comp;
+
+  /// Last consumed sample from each operand.
+  std::optional<Sample> prev_x, prev_y;
+  /// Last emitted synchronized time point, along with the operand values.
+  std::optional<Sample> last_x, last_y;
+
+  MinMaxNode(std::unique_ptr<Node> x, std::unique_ptr<Node> y, Compare c) :
+      lhs{std::move(x)}, rhs{std::move(y)}, comp{c} {}
+
+  void emit(double t, double xv, double yv) {
+    if (last_x.has_value()) {
+      const double t0 = last_x->time;
+      const double d0 = last_x->value - last_y->value;
+      const double d1 = xv - yv;
+      if (std::isfinite(d0) && std::isfinite(d1) &&
+          ((d0 < 0 && d1 > 0) || (d0 > 0 && d1 < 0))) {
+        const double tc = t0 + (t - t0) * d0 / (d0 - d1);
+        if (tc > t0 && tc < t) {
+          out.push_back(Sample{tc, lerp(*last_x, Sample{t, xv}, tc)});
+        }
+      }
+    }
+    out.push_back(Sample{t, (comp(xv, yv)) ? xv : yv});
+    last_x = Sample{t, xv};
+    last_y = Sample{t, yv};
+  }
+
+  void update() override {
+    lhs->update();
+    rhs->update();
+    auto& xs = lhs->out;
+    auto& ys = rhs->out;
+
+    while (!xs.empty() && !ys.empty()) {
+      const Sample& x = xs.front();
+      const Sample& y = ys.front();
+      const double t  = std::min(x.time, y.time);
+
+      if (x.time > t && !prev_x.has_value()) {
+        // `x` hasn't started yet, so we can't settle anything before it.
+        prev_y = y;
+        ys.pop_front();
+        continue;
+      }
+      if (y.time > t && !prev_y.has_value()) {
+        prev_x = x;
+        xs.pop_front();
+        continue;
+      }
+
+      const double xv = (x.time == t) ? x.value : lerp(*prev_x, x, t);
+      const double yv = (y.time == t) ? y.value : lerp(*prev_y, y, t);
+      emit(t, xv, yv);
+
+      if (x.time == t) {
+        prev_x = x;
+        xs.pop_front();
+      }
+      if (y.time == t) {
+        prev_y = y;
+        ys.pop_front();
+      }
+    }
+  }
+
+  void finish() override {
+    lhs->finish();
+    rhs->finish();
+    update();
+  }
+};
+
+/// Windowed min/max of a stream over the window [t + a, t + b].
+///
+/// Same as in the offline algorithm (see `minmax::compute_minmax_seq`), the output has
+/// breakpoints where an end of the window is at an input sample, i.e., at `s`, `s - a`
+/// and `s - b` for each input sample time `s`, and where the values at the ends of the
+/// window and the optimum of the samples inside it cross each other. A breakpoint `t`
+/// is settled once the input stream reaches `t + b`. Its value is computed from a
+/// monotonic wedge of the input samples in the window, along with the (interpolated)
+/// values at the boundaries of the window.
+template <typename Compare>
+struct WindowNode : Node {
+  std::unique_ptr<Node> arg;
+  double a;
+  double b;
+  Compare comp;
+
+  /// Input samples from the one at (or right before) the lower bound of the next
+  /// window, to the latest input sample.
+  std::deque<Sample> buffer;
+  /// Monotonic wedge of the input samples in the current window.
+  std::deque<Sample> wedge;
+  /// Breakpoints that have not been settled yet, where the lower end of the window is
+  /// at an input sample, and at the input samples. (The ones where the upper end of
+  /// the window is at an input sample are settled as soon as the sample arrives.)
+  std::deque<double> at_lower;
+  std::deque<double> at_sample;
+
+  /// Time of the first input sample, where the output starts.
+  double begin_time = TOP;
+  /// Last settled breakpoint, along with the values at the ends of its window.
+  double last_time     = BOTTOM;
+  double last_lo_value = 0.0;
+  double last_hi_value = 0.0;
+
+  WindowNode(std::unique_ptr<Node> child, double low, double high, Compare c) :
+      arg{std::move(child)}, a{low}, b{high}, comp{c} {}
+
+  /// Value of the input stream at time `t`, where `t` is in the range of `buffer`.
+  [[nodiscard]] double value_at(double t) const {
+    constexpr auto comp_time = [](const Sample& s, double time) {
+      return s.time < time;
+    };
+    auto it = std::lower_bound(buffer.begin(), buffer.end(), t, comp_time);
+    if (it == buffer.end()) {
+      return buffer.back().value;
+    } else if (it->time == t || it == buffer.begin()) {
+      return it->value;
+    }
+    return lerp(*std::prev(it), *it, t);
+  }
+
+  /// Add the crossings between the last breakpoint and `t`, where the ends of the
+  /// window move linearly (from the values at the last breakpoint to the given ones),
+  /// and the optimum of the samples inside the window (if any) is constant.
+  void add_crossings(
+      double t,
+      double lo_value,
+      double hi_value,
+      const std::optional<double>& inner) {
+    const double dt = t - last_time;
+    const auto lo_line = [&](double w) {
+      return last_lo_value + (lo_value - last_lo_value) * w;
+    };
+    const auto hi_line = [&](double w) {
+      return last_hi_value + (hi_value - last_hi_value) * w;
+    };
+
+    // Only the crossings that are on the optimum of the three are breakpoints. Once
+    // the window is clipped to the end of the input, the last sample is both the
+    // upper end and inside the window, so the crossings tie with the third one,
+    // which must hold up to rounding.
+    auto crossings       = std::array<Sample, 3>{};
+    size_t num_crossings = 0;
+    const auto cross     = [&](double f0, double f1, double g0, double g1, auto third) {
+      const double d0 = f0 - g0;
+      const double d1 = f1 - g1;
+      if (!(d0 * d1 < 0) || !std::isfinite(d0) || !std::isfinite(d1)) {
+        return;
+      }
+      const double w   = d0 / (d0 - d1);
+      const double v   = f0 + (f1 - f0) * w;
+      const double u   = third(w);
+      const double tol = 1e-12 * (std::abs(u) + std::abs(v));
+      if (comp(v, u) || std::abs(u - v) <= tol) {
+        crossings[num_crossings++] = Sample{last_time + dt * w, v};
+      }
+    };
+    cross(last_lo_value, lo_value, last_hi_value, hi_value, [&](double w) {
+      return (inner.has_value()) ? *inner : lo_line(w);
+    });
+    if (inner.has_value()) {
+      const double c = *inner;
+      cross(last_lo_value, lo_value, c, c, hi_line);
+      cross(last_hi_value, hi_value, c, c, lo_line);
+    }
+
+    const auto earlier = [](const Sample& lhs, const Sample& rhs) {
+      return lhs.time < rhs.time;
+    };
+    std::sort(crossings.begin(), crossings.begin() + num_crossings, earlier);
+    double prev = last_time;
+    for (size_t k = 0; k < num_crossings; k++) {
+      if (prev < crossings[k].time && crossings[k].time < t) {
+        out.push_back(crossings[k]);
+        prev = crossings[k].time;
+      }
+    }
+  }
+
+  /// Settle the breakpoint at `t`, where the input stream is known up to `t + b` (or
+  /// has ended), and the wedge has no samples after `t + b`.
+  void settle(double t) {
+    if (t < begin_time || t <= last_time) {
+      return;
+    }
+    const double end = buffer.back().time;
+    const double lo  = std::min(t + a, end);
+    const double hi  = std::min(t + b, end);
+    while (!wedge.empty() && wedge.front().time < lo) { wedge.pop_front(); }
+
+    const double lo_value = value_at(lo);
+    const double hi_value = value_at(hi);
+    auto inner            = std::optional<double>{};
+    if (!wedge.empty()) {
+      inner = wedge.front().value;
+    }
+    if (last_time >= begin_time) {
+      add_crossings(t, lo_value, hi_value, inner);
+    }
+
+    double opt = (comp(hi_value, lo_value)) ? hi_value : lo_value;
+    if (inner.has_value() && comp(*inner, opt)) {
+      opt = *inner;
+    }
+    out.push_back(Sample{t, opt});
+    last_time     = t;
+    last_lo_value = lo_value;
+    last_hi_value = hi_value;
+
+    // The next window starts after `lo`, so we don't need the older samples to
+    // interpolate the boundaries.
+    while (buffer.size() > 1 && buffer[1].time <= lo) { buffer.pop_front(); }
+  }
+
+  /// Settle the pending breakpoints up to `limit`, in order of time.
+  void settle_pending(double limit) {
+    while (true) {
+      auto& next = (at_lower.empty() ||
+                    (!at_sample.empty() && at_sample.front() < at_lower.front()))
+                       ? at_sample
+                       : at_lower;
+      if (next.empty() || next.front() > limit) {
+        return;
+      }
+      settle(next.front());
+      next.pop_front();
+    }
+  }
+
+  void consume(const Sample& s) {
+    if (buffer.empty()) {
+      begin_time = s.time;
+    }
+    buffer.push_back(s);
+    // The sample is only inside the windows after `s - b`, so the breakpoints up to
+    // there are settled before it enters the wedge.
+    settle_pending(s.time - b);
+    settle(s.time - b);
+
+    const auto by_value = [&](const Sample& lhs, const Sample& rhs) {
+      return comp(lhs.value, rhs.value);
+    };
+    mono_wedge::mono_wedge_update(wedge, s, by_value);
+    if (a > 0) {
+      at_lower.push_back(s.time - a);
+    }
+    at_sample.push_back(s.time);
+  }
+
+  void update() override {
+    arg->update();
+    for (; !arg->out.empty(); arg->out.pop_front()) { consume(arg->out.front()); }
+  }
+
+  void finish() override {
+    arg->finish();
+    update();
+    if (buffer.empty()) {
+      return;
+    }
+    // The windows are truncated to the end of the input, so everything up to there
+    // can be settled.
+    settle_pending(buffer.back().time);
+  }
+};
+
+/// Bounded Until, over the window [t + a, t + b].
+///
+/// The value at `t` only depends on the operands over [t, t + b], so the output is
+/// settled up to `T - b`, where `T` is the time up to which both operands are known.
+/// The operands are buffered from the last settled sample on, and the offline
+/// algorithm is run over the buffers whenever the output can be settled further.
+/// Thus, each update costs time linear in the number of samples in a window.
+struct UntilNode : Node {
+  std::unique_ptr<Node> lhs;
+  std::unique_ptr<Node> rhs;
+  double a;
+  double b;
+
+  /// Samples of the operands, from the ones at (or right before) the last settled
+  /// sample, to the latest ones.
+  std::deque<Sample> xs;
+  std::deque<Sample> ys;
+  /// Time of the last settled sample.
+  double last_time = BOTTOM;
+  /// Time up to which the output was settled by the last run.
+  double settled = BOTTOM;
+
+  UntilNode(std::unique_ptr<Node> x, std::unique_ptr<Node> y, double low, double high) :
+      lhs{std::move(x)}, rhs{std::move(y)}, a{low}, b{high} {}
+
+  /// Settle the output samples up to `upper`.
+  void settle(double upper) {
+    const auto z = compute_until(
+        std::make_shared<Signal>(xs), std::make_shared<Signal>(ys), a, b);
+    for (const auto& s : *z) {
+      if (s.time > last_time && s.time <= upper) {
+        out.push_back(Sample{s.time, s.value});
+        last_time = s.time;
+      }
+    }
+    settled = upper;
+
+    // The next values only depend on the operands after the last settled sample.
+    const auto trim = [&](std::deque<Sample>& samples) {
+      while (samples.size() > 1 && samples[1].time <= last_time) {
+        samples.pop_front();
+      }
+    };
+    trim(xs);
+    trim(ys);
+  }
+
+  void update() override {
+    lhs->update();
+    rhs->update();
+    for (; !lhs->out.empty(); lhs->out.pop_front()) { xs.push_back(lhs->out.front()); }
+    for (; !rhs->out.empty(); rhs->out.pop_front()) { ys.push_back(rhs->out.front()); }
+    if (xs.empty() || ys.empty()) {
+      return;
+    }
+    if (const double upper = std::min(xs.back().time, ys.back().time) - b;
+        upper > settled) {
+      settle(upper);
+    }
+  }
+
+  void finish() override {
+    lhs->finish();
+    rhs->finish();
+    update();
+    if (!xs.empty() && !ys.empty()) {
+      settle(TOP);
+    }
+  }
+};
+
+/// Operators with unbounded horizons, i.e., with intervals [a, inf).
+///
+/// Their output can only be settled at the end of the input streams, so these are
+/// buffered until then, and the output is computed using the offline algorithms.
+struct BufferedNode : Node {
+  enum struct Op { Always, Eventually, Until };
+
+  Op op;
+  std::vector<std::unique_ptr<Node>> args;
+  std::vector<SignalPtr> inputs;
+  /// The interval of the operator.
+  std::pair<double, double> interval = {0.0, TOP};
+
+  BufferedNode(Op operation, std::vector<std::unique_ptr<Node>> children) :
+      op{operation}, args{std::move(children)} {
+    for (size_t i = 0; i < args.size(); i++) {
+      inputs.push_back(std::make_shared<Signal>());
+    }
+  }
+
+  void update() override {
+    for (size_t i = 0; i < args.size(); i++) {
+      args[i]->update();
+      for (; !args[i]->out.empty(); args[i]->out.pop_front()) {
+        inputs[i]->push_back(args[i]->out.front());
+      }
+    }
+  }
+
+  void finish() override {
+    for (auto& arg : args) { arg->finish(); }
+    update();
+    if (std::any_of(inputs.begin(), inputs.end(), [](const SignalPtr& x) {
+          return x->empty();
+        })) {
+      return;
+    }
+
+    const auto [a, b] = interval;
+    SignalPtr y;
+    switch (op) {
+      case Op::Always:
+        y = (a == 0) ? minmax::compute_min_seq(inputs.at(0))
+                     : minmax::compute_min_seq(inputs.at(0), a, b);
+        break;
+      case Op::Eventually:
+        y = (a == 0) ? minmax::compute_max_seq(inputs.at(0))
+                     : minmax::compute_max_seq(inputs.at(0), a, b);
+        break;
+      case Op::Until:
+        y = (a == 0) ? compute_until(inputs.at(0), inputs.at(1))
+                     : compute_until(inputs.at(0), inputs.at(1), a, b);
+        break;
+    }
+    for (const auto& s : *y) { out.push_back(Sample{s.time, s.value}); }
+  }
+};
+
+/// Builds the tree of monitor nodes for a given formula.
+struct NodeBuilder {
+  const Clock& clock;
+  std::multimap<std::string, PredicateNode*>& channels;
+
+  std::unique_ptr<Node> operator()(const ast::Const e) const {
+    return std::make_unique<ConstNode>(clock, e.value);
+  }
+
+  std::unique_ptr<Node> operator()(const ast::Predicate& e) const {
+    auto node = std::make_unique<PredicateNode>(e.op, e.rhs);
+    channels.insert({e.name, node.get()});
+    return node;
+  }
+
+  std::unique_ptr<Node> operator()(const ast::NotPtr& e) const {
+    return std::make_unique<NotNode>(build(e->arg));
+  }
+
+  template <typename Compare>
+  std::unique_ptr<Node> fold(const std::vector<ast::Expr>& args, Compare comp) const {
+    // Same as the offline algorithm, we fold the arguments from the left.
+    auto node = build(args.at(0));
+    for (size_t i = 1; i < args.size(); i++) {
+      node = std::make_unique<MinMaxNode<Compare>>(
+          std::move(node), build(args.at(i)), comp);
+    }
+    return node;
+  }
+
+  std::unique_ptr<Node> operator()(const ast::AndPtr& e) const {
+    return fold(e->args, std::less_equal<>());
+  }
+
+  std::unique_ptr<Node> operator()(const ast::OrPtr& e) const {
+    return fold(e->args, std::greater_equal<>());
+  }
+
+  template <typename Compare>
+  std::unique_ptr<Node> temporal(
+      const ast::Expr& arg,
+      const ast::Interval& interval,
+      BufferedNode::Op unbounded_op,
+      Compare comp) const {
+    auto child = build(arg);
+    const auto [a, b] = interval.as_double();
+    if (std::isinf(b)) {
+      auto children = std::vector<std::unique_ptr<Node>>{};
+      children.push_back(std::move(child));
+      auto node = std::make_unique<BufferedNode>(unbounded_op, std::move(children));
+      node->interval = {a, b};
+      return node;
+    } else if (b - a < 0) {
+      throw std::logic_error("Temporal operator: b < a in interval [a,b]");
+    } else if (b - a == 0) {
+      // Same as the offline semantics, windows of zero width aren't shifted.
+      return child;
+    }
+    return std::make_unique<WindowNode<Compare>>(std::move(child), a, b, comp);
+  }
+
+  std::unique_ptr<Node> operator()(const ast::AlwaysPtr& e) const {
+    return temporal(e->arg, e->interval, BufferedNode::Op::Always, std::less_equal<>());
+  }
+
+  std::unique_ptr<Node> operator()(const ast::EventuallyPtr& e) const {
+    return temporal(
+        e->arg, e->interval, BufferedNode::Op::Eventually, std::greater_equal<>());
+  }
+
+  std::unique_ptr<Node> operator()(const ast::UntilPtr& e) const {
+    const auto [a, b] = e->interval.as_double();
+    if (b - a < 0) {
+      throw std::logic_error("Until operator: b < a in interval [a,b]");
+    } else if (!std::isinf(b)) {
+      return std::make_unique<UntilNode>(
+          build(e->args.first), build(e->args.second), a, b);
+    }
+    auto children = std::vector<std::unique_ptr<Node>>{};
+    children.push_back(build(e->args.first));
+    children.push_back(build(e->args.second));
+    auto node =
+        std::make_unique<BufferedNode>(BufferedNode::Op::Until, std::move(children));
+    node->interval = {a, b};
+    return node;
+  }
+
+  [[nodiscard]] std::unique_ptr<Node> build(const ast::Expr& phi) const {
+    return std::visit([&](auto&& e) { return (*this)(e); }, phi);
+  }
+};
+
+} // namespace
+
+struct OnlineMonitor::Impl {
+  Clock clock;
+  std::multimap<std::string, PredicateNode*> channels;
+  /// The end time of each signal seen so far.
+  std::map<std::string, double> end_times;
+  std::unique_ptr<Node> root;
+  double settled_until = BOTTOM;
+  bool finished        = false;
+
+  Impl(const ast::Expr& phi) {
+    root = NodeBuilder{clock, channels}.build(phi);
+  }
+};
+
+OnlineMonitor::OnlineMonitor(const ast::Expr& phi) :
+    impl{std::make_unique<Impl>(phi)} {}
+
+OnlineMonitor::~OnlineMonitor() = default;
+
+OnlineMonitor::OnlineMonitor(OnlineMonitor&&) noexcept = default;
+OnlineMonitor& OnlineMonitor::operator=(OnlineMonitor&&) noexcept = default;
+
+void OnlineMonitor::push_back(const std::string& name, Sample sample) {
+  if (impl->finished) {
+    throw std::logic_error("Cannot add samples to a monitor that has finished.");
+  }
+  const auto [begin, end] = impl->channels.equal_range(name);
+  if (begin == end) {
+    return;
+  }
+
+  if (auto it = impl->end_times.find(name); it != impl->end_times.end()) {
+    if (sample.time <= it->second) {
+      throw std::invalid_argument(fmt::format(
+          "Trying to append a Sample timestamped at or before the end_time of signal "
+          "\"{}\", i.e., time is not strictly monotonically increasing. "
+          "Current end_time is {}, given Sample is {}.",
+          name,
+          it->second,
+          sample));
+    }
+    it->second = sample.time;
+  } else {
+    impl->end_times.insert({name, sample.time});
+  }
+  impl->clock.now = std::max(impl->clock.now, sample.time);
+
+  for (auto it = begin; it != end; it++) { it->second->push(sample); }
+  impl->root->update();
+}
+
+void OnlineMonitor::push_back(const std::string& name, double time, double value) {
+  this->push_back(name, Sample{time, value});
+}
+
+void OnlineMonitor::finish() {
+  if (!impl->finished) {
+    impl->root->finish();
+    impl->finished = true;
+  }
+}
+
+std::vector<Sample> OnlineMonitor::poll() {
+  auto& out = impl->root->out;
+  auto ret  = std::vector<Sample>{out.begin(), out.end()};
+  out.clear();
+  if (!ret.empty()) {
+    impl->settled_until = ret.back().time;
+  }
+  return ret;
+}
+
+double OnlineMonitor::settled_until() const {
+  const auto& out = impl->root->out;
+  return (out.empty()) ? impl->settled_until : out.back().time;
+}
+
+bool OnlineMonitor::finished() const {
+  return impl->finished;
+}
+
+} // namespace signal_tl::semantics
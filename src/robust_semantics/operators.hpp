@@ -0,0 +1,92 @@
+#ifndef SIGNAL_TEMPORAL_LOGIC_OPERATORS_HPP
+#define SIGNAL_TEMPORAL_LOGIC_OPERATORS_HPP
+
+#include "signal_tl/ast.hpp"
+#include "signal_tl/executor.hpp"
+#include "signal_tl/robustness.hpp"
+#include "signal_tl/signal.hpp"
+#include "signal_tl/simplify.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace signal_tl::semantics {
+
+/**
+ * The robustness of each operator, given the robustness signals of its operands.
+ *
+ * These are shared by the recursive evaluation of an `ast::Expr` and the evaluation
+ * of a compiled `Plan`. The n-ary operators reduce their operands concurrently if
+ * `executor` isn't `nullptr`.
+ */
+signal::SignalPtr compute_const(bool value, double begin_time, double end_time);
+
+signal::SignalPtr
+compute_predicate(const signal::SignalPtr& x, ast::ComparisonOp op, double rhs);
+
+/**
+ * The robustness of each of the predicates `x ~ c` over the signal `x`, given by their
+ * comparisons and constants, in a single pass over `x`.
+ *
+ * The robustness signals only have their own values: they view the time stamps and
+ * the derivatives of `x` (or, for `x < c` and `x <= c`, a single column of negated
+ * derivatives shared by all of them) instead of copying them.
+ */
+std::vector<signal::SignalPtr> compute_predicates(
+    const signal::SignalPtr& x,
+    const std::vector<std::pair<ast::ComparisonOp, double>>& predicates);
+
+signal::SignalPtr compute_not(const signal::SignalPtr& y);
+
+signal::SignalPtr compute_and(std::vector<signal::SignalPtr> ys, Executor* executor);
+
+signal::SignalPtr compute_or(std::vector<signal::SignalPtr> ys, Executor* executor);
+
+signal::SignalPtr
+compute_eventually(const signal::SignalPtr& y, const ast::Interval& interval);
+
+signal::SignalPtr
+compute_always(const signal::SignalPtr& y, const ast::Interval& interval);
+
+signal::SignalPtr compute_until(
+    const signal::SignalPtr& y1,
+    const signal::SignalPtr& y2,
+    const ast::Interval& interval);
+
+/**
+ * The average of `y` over the interval, i.e., the robustness of `Eventually` and
+ * `Always` with the filtering semantics.
+ */
+signal::SignalPtr
+compute_average(const signal::SignalPtr& y, const ast::Interval& interval);
+
+/**
+ * The integral of `y` over the interval, i.e., the robustness of `Eventually` with
+ * the cumulative semantics.
+ */
+signal::SignalPtr
+compute_integral(const signal::SignalPtr& y, const ast::Interval& interval);
+
+/**
+ * Get the executor to use for the given options, creating a thread pool (owned by
+ * `pool`) if needed.
+ */
+Executor*
+get_executor(const EvaluationOptions& options, std::unique_ptr<ThreadPool>& pool);
+
+/**
+ * Get the options to simplify formulas for the given options, as the temporal
+ * rewrites only hold for the classic semantics.
+ */
+ast::SimplifyOptions simplify_options(const EvaluationOptions& options);
+
+/**
+ * Get the earliest start time and the latest end time of the signals in the trace,
+ * i.e., the time range of the robustness of constants.
+ */
+std::pair<double, double> get_time_range(const signal::Trace& trace);
+
+} // namespace signal_tl::semantics
+
+#endif
@@ -0,0 +1,720 @@
+#include "signal_tl/plan.hpp"
+#include "signal_tl/ast.hpp"
+#include "signal_tl/executor.hpp"
+#include "signal_tl/profile.hpp"
+#include "signal_tl/result_cache.hpp"
+#include "signal_tl/robustness.hpp"
+#include "signal_tl/signal.hpp"
+
+#include "signal_tl/internal/utils.hpp" // for overloaded
+
+#include "buffer_pool.hpp" // for BufferPool, allocated_bytes
+#include "operators.hpp"   // for compute_and, compute_or, get_executor, ...
+
+#include <algorithm>     // for find, max, min, sort, stable_sort, transform
+#include <cassert>       // for assert
+#include <chrono>        // for duration, steady_clock
+#include <cstdint>       // for uint64_t
+#include <cstring>       // for memcpy
+#include <fmt/format.h>  // for format
+#include <limits>        // for numeric_limits
+#include <map>           // for map
+#include <memory>        // for make_shared, unique_ptr
+#include <numeric>       // for iota
+#include <optional>      // for optional, nullopt
+#include <stdexcept>     // for invalid_argument, logic_error
+#include <string>        // for string
+#include <unordered_map> // for unordered_map
+#include <utility>       // for move, pair
+#include <variant>       // for visit
+#include <vector>        // for vector
+
+namespace signal_tl::semantics {
+using namespace signal;
+
+namespace {
+
+using Op     = EvaluationPlan::Op;
+using OpCode = EvaluationPlan::OpCode;
+
+bool is_temporal(const Op& op) {
+  return op.code == OpCode::Eventually || op.code == OpCode::Always ||
+         op.code == OpCode::Until;
+}
+
+/// Lowers formulas to operations, in post-order, merging equal subformulas.
+///
+/// As in the memo of the recursive evaluation, subformulas are identified by the
+/// address of their node first, and then structurally.
+struct Compiler {
+  std::vector<Op> ops;
+  std::vector<ast::Expr> formulas;
+  std::map<std::string, size_t> slots;
+
+  std::unordered_map<const void*, size_t> hashes;
+  std::unordered_map<const void*, size_t> by_address;
+  std::unordered_map<ast::Expr, size_t, ast::ExprHash, ast::ExprEqual> by_structure;
+
+  Compiler() : by_structure{0, ast::ExprHash{&hashes}} {}
+
+  /// Get the index of the operation computing `phi`, adding it (and its operands) if
+  /// needed.
+  size_t add(const ast::Expr& phi) {
+    const void* addr = ast::node_address(phi);
+    if (addr != nullptr) {
+      if (const auto it = by_address.find(addr); it != by_address.end()) {
+        return it->second;
+      }
+    }
+    if (const auto it = by_structure.find(phi); it != by_structure.end()) {
+      if (addr != nullptr) {
+        by_address.emplace(addr, it->second);
+      }
+      return it->second;
+    }
+
+    auto op = lower(phi);
+    for (const size_t arg : op.args) {
+      op.level   = std::max(op.level, ops[arg].level + 1);
+      op.horizon = std::max(op.horizon, ops[arg].horizon);
+    }
+    if (is_temporal(op)) {
+      op.horizon += op.interval.as_double().second;
+    }
+    ops.push_back(std::move(op));
+    formulas.push_back(phi);
+
+    const size_t idx = ops.size() - 1;
+    by_structure.emplace(phi, idx);
+    if (addr != nullptr) {
+      by_address.emplace(addr, idx);
+    }
+    return idx;
+  }
+
+  /// Create the operation for `phi`, adding its operands.
+  Op lower(const ast::Expr& phi) {
+    auto op = Op{};
+    std::visit(
+        utils::overloaded{
+            [&](const ast::Const& e) {
+              op.code  = OpCode::Const;
+              op.value = e.value;
+            },
+            [&](const ast::Predicate& e) {
+              op.code       = OpCode::Predicate;
+              op.slot       = slots.try_emplace(e.name, slots.size()).first->second;
+              op.comparison = e.op;
+              op.rhs        = e.rhs;
+            },
+            [&](const ast::NotPtr& e) {
+              op.code = OpCode::Not;
+              op.args = {add(e->arg)};
+            },
+            [&](const ast::AndPtr& e) {
+              op.code = OpCode::And;
+              op.args = add_all(e->args);
+            },
+            [&](const ast::OrPtr& e) {
+              op.code = OpCode::Or;
+              op.args = add_all(e->args);
+            },
+            [&](const ast::EventuallyPtr& e) {
+              op.code     = OpCode::Eventually;
+              op.args     = {add(e->arg)};
+              op.interval = e->interval;
+            },
+            [&](const ast::AlwaysPtr& e) {
+              op.code     = OpCode::Always;
+              op.args     = {add(e->arg)};
+              op.interval = e->interval;
+            },
+            [&](const ast::UntilPtr& e) {
+              op.code     = OpCode::Until;
+              op.args     = {add(e->args.first), add(e->args.second)};
+              op.interval = e->interval;
+            }},
+        phi);
+    return op;
+  }
+
+  /// Add the operands of an And/Or. As min/max are idempotent, repeated operands are
+  /// only used once.
+  std::vector<size_t> add_all(const std::vector<ast::Expr>& args) {
+    auto out = std::vector<size_t>{};
+    for (const auto& arg : args) {
+      const size_t idx = add(arg);
+      if (std::find(out.begin(), out.end(), idx) == out.end()) {
+        out.push_back(idx);
+      }
+    }
+    return out;
+  }
+};
+
+using Window = std::pair<double, double>;
+
+/// Compute the result of a single operation, given the results of its operands.
+///
+/// If `window` is set, the result is only computed over it, and is empty if any of
+/// the operands is empty (i.e., the window doesn't overlap their robustness).
+SignalPtr apply(
+    const Op& op,
+    std::vector<SignalPtr> operands,
+    const std::vector<SignalPtr>& inputs,
+    Window time_range,
+    const std::optional<Window>& window,
+    Semantics semantics,
+    Executor* executor) {
+  const auto arg = [&operands](size_t i) { return operands[i]; };
+  if (window.has_value()) {
+    for (const auto& y : operands) {
+      if (y->empty()) {
+        return std::make_shared<Signal>();
+      }
+    }
+    time_range = {
+        std::max(time_range.first, window->first),
+        std::min(time_range.second, window->second)};
+  }
+
+  switch (op.code) {
+    case OpCode::Const:
+      if (time_range.second < time_range.first) {
+        return std::make_shared<Signal>();
+      }
+      return compute_const(op.value, time_range.first, time_range.second);
+    case OpCode::Predicate: {
+      const auto& x = inputs[op.slot];
+      return compute_predicate(
+          (window.has_value()) ? slice(x, window->first, window->second) : x,
+          op.comparison,
+          op.rhs);
+    }
+    case OpCode::Not:
+      return compute_not(arg(0));
+    case OpCode::And:
+      return compute_and(std::move(operands), executor);
+    case OpCode::Or:
+      return compute_or(std::move(operands), executor);
+    case OpCode::Eventually:
+      if (semantics == Semantics::Filtering) {
+        return compute_average(arg(0), op.interval);
+      }
+      return compute_eventually(arg(0), op.interval);
+    case OpCode::Always:
+      if (semantics == Semantics::Filtering) {
+        return compute_average(arg(0), op.interval);
+      }
+      return compute_always(arg(0), op.interval);
+    case OpCode::Until:
+      return compute_until(arg(0), arg(1), op.interval);
+  }
+  throw std::logic_error("Unknown operation in evaluation plan.");
+}
+
+/// Get the time range over which the result of each operation is needed to compute
+/// the outputs over `window`.
+///
+/// The temporal operators need their operands up to their horizon past the end of
+/// the window. The operands also start where the window starts (and not at the start
+/// of the interval of the operator), as the robustness of the temporal operators is
+/// sampled at the time points of their operands.
+std::vector<Window> get_windows(
+    const std::vector<Op>& ops,
+    const std::vector<size_t>& outputs,
+    Window window) {
+  constexpr double TOP = std::numeric_limits<double>::infinity();
+
+  auto out        = std::vector<Window>(ops.size(), {TOP, -TOP});
+  const auto need = [&out](size_t i, double lo, double hi) {
+    out[i] = {std::min(out[i].first, lo), std::max(out[i].second, hi)};
+  };
+  for (const size_t i : outputs) { need(i, window.first, window.second); }
+
+  // The operands come before the operations using them, so the windows of the users
+  // of an operation are final by the time it is reached.
+  for (size_t i = ops.size(); i-- > 0;) {
+    const auto& op      = ops[i];
+    const auto [lo, hi] = out[i];
+    double horizon      = 0.0;
+    if (is_temporal(op)) {
+      horizon = op.interval.as_double().second;
+    }
+    for (const size_t a : op.args) { need(a, lo, hi + horizon); }
+  }
+  return out;
+}
+
+/// Whether the result of an operation is kept in a `ResultCache`: the outputs, and
+/// the temporal operators, as the others are cheap to compute from their operands.
+bool is_cached(const Op& op) {
+  return op.uses == EvaluationPlan::npos || is_temporal(op);
+}
+
+uint64_t bits_of(double x) {
+  uint64_t out = 0;
+  std::memcpy(&out, &x, sizeof(out));
+  return out;
+}
+
+/// Get the key of the result of each operation in a `ResultCache`.
+///
+/// The key of an operation combines its parameters with the keys of its operands, so
+/// it depends on the whole subformula, and on the samples of the signals that its
+/// predicates use (but not on their names). The results of constants also depend on
+/// the time range of the trace, and, if the results are restricted to windows, each
+/// key has the window of its operation.
+std::vector<uint64_t> get_cache_keys(
+    const std::vector<Op>& ops,
+    const std::vector<SignalPtr>& inputs,
+    Window time_range,
+    const std::vector<Window>& windows,
+    Semantics semantics) {
+  // The signals that share their time stamps only hash them once.
+  auto time_keys = std::map<std::pair<const double*, size_t>, uint64_t>{};
+  auto channels  = std::vector<uint64_t>{};
+  channels.reserve(inputs.size());
+  for (const auto& x : inputs) {
+    const auto ts = x->times();
+    auto it       = time_keys.find({ts.data(), ts.size()});
+    if (it == time_keys.end()) {
+      it = time_keys.emplace(std::make_pair(ts.data(), ts.size()), fingerprint(ts))
+               .first;
+    }
+    channels.push_back(fingerprint_combine(it->second, fingerprint(x->values())));
+  }
+
+  auto keys = std::vector<uint64_t>(ops.size());
+  for (size_t i = 0; i < ops.size(); i++) {
+    const auto& op = ops[i];
+    uint64_t key =
+        fingerprint_combine(ResultCache::VERSION, static_cast<uint64_t>(op.code));
+    key = fingerprint_combine(key, static_cast<uint64_t>(semantics));
+    switch (op.code) {
+      case OpCode::Const:
+        key = fingerprint_combine(key, static_cast<uint64_t>(op.value));
+        key = fingerprint_combine(key, bits_of(time_range.first));
+        key = fingerprint_combine(key, bits_of(time_range.second));
+        break;
+      case OpCode::Predicate:
+        key = fingerprint_combine(key, static_cast<uint64_t>(op.comparison));
+        key = fingerprint_combine(key, bits_of(op.rhs));
+        key = fingerprint_combine(key, channels[op.slot]);
+        break;
+      case OpCode::Eventually:
+      case OpCode::Always:
+      case OpCode::Until: {
+        const auto [a, b] = op.interval.as_double();
+        key               = fingerprint_combine(key, bits_of(a));
+        key               = fingerprint_combine(key, bits_of(b));
+        break;
+      }
+      case OpCode::Not:
+      case OpCode::And:
+      case OpCode::Or:
+        break;
+    }
+
+    auto args = std::vector<uint64_t>{};
+    args.reserve(op.args.size());
+    for (const size_t a : op.args) { args.push_back(keys[a]); }
+    // As min/max are commutative, the order of the operands doesn't matter.
+    if (op.code == OpCode::And || op.code == OpCode::Or) {
+      std::sort(args.begin(), args.end());
+    }
+    for (const uint64_t arg : args) { key = fingerprint_combine(key, arg); }
+
+    if (!windows.empty()) {
+      key = fingerprint_combine(key, bits_of(windows[i].first));
+      key = fingerprint_combine(key, bits_of(windows[i].second));
+    }
+    keys[i] = key;
+  }
+  return keys;
+}
+
+/// Replace the samples of `x` from `time` on with the samples of `tail`, copying `x`
+/// first if it is shared (e.g., with a result that was returned, or another result).
+void splice(SignalPtr& x, double time, const SignalPtr& tail) {
+  if (x->empty() || time <= x->begin_time()) {
+    x = tail;
+    return;
+  }
+  if (x.use_count() > 1) {
+    x = std::make_shared<Signal>(*x);
+  }
+  x->truncate(time);
+  x->append_sorted(tail->times(), tail->values(), tail->derivatives());
+}
+
+} // namespace
+
+EvaluationPlan::EvaluationPlan(const ast::Expr& phi) :
+    EvaluationPlan{std::vector<ast::Expr>{phi}} {}
+
+EvaluationPlan::EvaluationPlan(const std::map<std::string, ast::Expr>& formulas) :
+    EvaluationPlan{[&formulas]() {
+      auto exprs = std::vector<ast::Expr>{};
+      exprs.reserve(formulas.size());
+      for (const auto& [name, phi] : formulas) { exprs.push_back(phi); }
+      return exprs;
+    }()} {}
+
+EvaluationPlan::EvaluationPlan(const std::vector<ast::Expr>& formulas) {
+  auto compiler = Compiler{};
+  auto outputs  = std::vector<size_t>{};
+  outputs.reserve(formulas.size());
+  for (const auto& phi : formulas) { outputs.push_back(compiler.add(phi)); }
+
+  operations  = std::move(compiler.ops);
+  op_formulas = std::move(compiler.formulas);
+
+  // Number the slots in the order of the names.
+  auto slot_of = std::vector<size_t>(compiler.slots.size());
+  for (const auto& [name, slot] : compiler.slots) {
+    slot_of[slot] = signal_names.size();
+    signal_names.push_back(name);
+  }
+  for (auto& op : operations) {
+    if (op.code == OpCode::Predicate) {
+      op.slot = slot_of[op.slot];
+    }
+    for (const size_t a : op.args) { operations[a].uses++; }
+  }
+  for (const size_t out : outputs) { operations[out].uses = npos; }
+  output_ops = std::move(outputs);
+
+  // The post-order is best for serial evaluation, as the operands of an operation are
+  // (mostly) computed right before it, but evaluating concurrently needs the levels.
+  by_level.resize(operations.size());
+  std::iota(by_level.begin(), by_level.end(), 0);
+  std::stable_sort(by_level.begin(), by_level.end(), [this](size_t a, size_t b) {
+    return operations[a].level < operations[b].level;
+  });
+}
+
+std::vector<SignalPtr>
+EvaluationPlan::evaluate(const Trace& trace, const EvaluationOptions& options) const {
+  auto inputs = Trace{};
+  for (const auto& name : signal_names) { inputs[name] = trace.at(name); }
+  return run(inputs, get_time_range(trace), options);
+}
+
+std::vector<SignalPtr> EvaluationPlan::evaluate(
+    const std::vector<SignalPtr>& inputs,
+    const EvaluationOptions& options) const {
+  if (inputs.size() != signal_names.size()) {
+    throw std::invalid_argument(
+        "Number of input signals doesn't match the number of signals in the plan");
+  }
+  auto trace = Trace{};
+  for (size_t i = 0; i < inputs.size(); i++) { trace[signal_names[i]] = inputs[i]; }
+  return run(trace, get_time_range(trace), options);
+}
+
+std::vector<SignalPtr> EvaluationPlan::evaluate_ops(
+    const Trace& trace,
+    const EvaluationOptions& options) const {
+  auto inputs = Trace{};
+  for (const auto& name : signal_names) { inputs[name] = trace.at(name); }
+  return run(inputs, get_time_range(trace), options, true);
+}
+
+std::vector<SignalPtr> EvaluationPlan::run(
+    const Trace& trace,
+    std::pair<double, double> time_range,
+    const EvaluationOptions& options,
+    bool keep_all) const {
+  using Clock         = std::chrono::steady_clock;
+  auto* const profile = options.profile;
+  const auto started  = (profile != nullptr) ? Clock::now() : Clock::time_point{};
+
+  auto pool     = std::unique_ptr<ThreadPool>{};
+  auto executor = get_executor(options, pool);
+  auto buffers  = std::make_shared<BufferPool>();
+
+  auto inputs = std::vector<SignalPtr>{};
+  inputs.reserve(signal_names.size());
+  for (auto& [name, x] : share_time_bases(trace, options.synchronized)) {
+    inputs.push_back(std::move(x));
+  }
+  assert(inputs.size() == signal_names.size());
+
+  auto results = std::vector<SignalPtr>(operations.size());
+  auto uses    = std::vector<size_t>(operations.size());
+  std::transform(operations.begin(), operations.end(), uses.begin(), [](const Op& op) {
+    return op.uses;
+  });
+  // Drop the operands that aren't needed after the operation `i`.
+  const auto release = [&](size_t i) {
+    if (keep_all) {
+      return;
+    }
+    for (const size_t a : operations[i].args) {
+      if (uses[a] != npos && --uses[a] == 0) {
+        results[a].reset();
+      }
+    }
+  };
+
+  auto windows = std::vector<Window>{};
+  if (options.window.has_value()) {
+    windows = get_windows(operations, output_ops, *options.window);
+  }
+
+  // Look up the results in the cache, from the outputs down, so that the operations
+  // that are only needed by cached results are skipped.
+  auto* const cache = options.cache;
+  auto keys         = std::vector<uint64_t>{};
+  auto cached       = std::vector<bool>(operations.size(), false);
+  auto needed       = std::vector<bool>(operations.size(), true);
+  if (cache != nullptr) {
+    keys = get_cache_keys(operations, inputs, time_range, windows, options.semantics);
+    needed.assign(operations.size(), keep_all);
+    for (const size_t i : output_ops) { needed[i] = true; }
+    for (size_t i = operations.size(); i-- > 0;) {
+      const auto& op = operations[i];
+      if (!needed[i]) {
+        continue;
+      }
+      if (is_cached(op) && (results[i] = cache->find(keys[i])) != nullptr) {
+        cached[i] = true;
+        continue;
+      }
+      for (const size_t a : op.args) { needed[a] = true; }
+    }
+    // Only the operations that are computed use (and release) their operands.
+    for (size_t i = 0; i < operations.size(); i++) {
+      if (uses[i] != npos) {
+        uses[i] = 0;
+      }
+    }
+    for (size_t i = 0; i < operations.size(); i++) {
+      if (!needed[i] || cached[i]) {
+        continue;
+      }
+      for (const size_t a : operations[i].args) {
+        if (uses[a] != npos) {
+          uses[a]++;
+        }
+      }
+    }
+  }
+  const auto skipped = [&](size_t i) { return !needed[i] || cached[i]; };
+  // Compute the operation `i`, restricted to its window (if any).
+  const auto semantics = options.semantics;
+  const auto compute   = [&](size_t i, Executor* exec) {
+    const auto& op = operations[i];
+    auto operands  = std::vector<SignalPtr>{};
+    operands.reserve(op.args.size());
+    for (const size_t a : op.args) { operands.push_back(results[a]); }
+    if (windows.empty()) {
+      return apply(
+          op, std::move(operands), inputs, time_range, std::nullopt, semantics, exec);
+    }
+    const auto [lo, hi] = windows[i];
+    const auto y        = apply(
+        op, std::move(operands), inputs, time_range, windows[i], semantics, exec);
+    return slice(y, lo, hi);
+  };
+
+  // Record the statistics of the operation `i` (using its operands, which are only
+  // released after it is done).
+  if (profile != nullptr) {
+    profile->nodes.assign(operations.size(), NodeProfile{});
+    for (size_t i = 0; i < operations.size(); i++) {
+      if (cached[i]) {
+        auto& node          = profile->nodes[i];
+        node.formula        = op_formulas[i];
+        node.operands       = operations[i].args;
+        node.output_samples = results[i]->size();
+        node.cached         = true;
+      }
+    }
+  }
+  const auto compute_profiled = [&](size_t i, Executor* exec) {
+    if (profile == nullptr) {
+      return compute(i, exec);
+    }
+    const auto start   = Clock::now();
+    const size_t bytes = allocated_bytes();
+    auto y             = compute(i, exec);
+
+    auto& node           = profile->nodes[i];
+    const auto& op       = operations[i];
+    node.seconds         = std::chrono::duration<double>(Clock::now() - start).count();
+    node.bytes_allocated = allocated_bytes() - bytes;
+    node.formula         = op_formulas[i];
+    node.operands        = op.args;
+    node.output_samples  = y->size();
+    size_t largest       = 0;
+    if (op.code == OpCode::Predicate) {
+      node.input_samples = largest = inputs[op.slot]->size();
+    }
+    for (const size_t a : op.args) {
+      node.input_samples += results[a]->size();
+      largest = std::max(largest, results[a]->size());
+    }
+    node.added_samples = (y->size() > largest) ? y->size() - largest : 0;
+    return y;
+  };
+  const auto compute_cached = [&](size_t i, Executor* exec) {
+    auto y = compute_profiled(i, exec);
+    if (cache != nullptr && is_cached(operations[i])) {
+      cache->insert(keys[i], y);
+    }
+    return y;
+  };
+
+  if (executor == nullptr) {
+    auto scope = BufferPool::Scope{buffers.get()};
+    for (size_t i = 0; i < operations.size(); i++) {
+      if (skipped(i)) {
+        continue;
+      }
+      results[i] = compute_cached(i, nullptr);
+      release(i);
+    }
+  } else {
+    // The operations on a level are independent, so they are computed concurrently.
+    for (size_t first = 0; first < by_level.size();) {
+      const size_t level = operations[by_level[first]].level;
+      size_t last        = first;
+      while (last < by_level.size() && operations[by_level[last]].level == level) {
+        last++;
+      }
+
+      auto tasks = TaskGroup{executor};
+      for (size_t k = first; k < last; k++) {
+        if (skipped(by_level[k])) {
+          continue;
+        }
+        tasks.run([&, i = by_level[k]]() {
+          auto scope = BufferPool::Scope{buffers.get()};
+          results[i] = compute_cached(i, executor);
+        });
+      }
+      tasks.wait();
+      for (size_t k = first; k < last; k++) {
+        if (!skipped(by_level[k])) {
+          release(by_level[k]);
+        }
+      }
+      first = last;
+    }
+  }
+
+  if (profile != nullptr) {
+    profile->seconds = std::chrono::duration<double>(Clock::now() - started).count();
+  }
+  if (keep_all) {
+    return results;
+  }
+  auto out = std::vector<SignalPtr>{};
+  out.reserve(output_ops.size());
+  for (const size_t i : output_ops) { out.push_back(results[i]); }
+  return out;
+}
+
+IncrementalEvaluation::IncrementalEvaluation(
+    EvaluationPlan plan,
+    const Trace& trace,
+    const EvaluationOptions& options) :
+    compiled{std::move(plan)}, eval_options{options} {
+  eval_options.window  = std::nullopt;
+  eval_options.profile = nullptr;
+  for (const auto& name : compiled.signals()) { inputs.push_back(trace.at(name)); }
+  op_results = compiled.evaluate_ops(trace, eval_options);
+}
+
+void IncrementalEvaluation::append(const Trace& chunk) {
+  constexpr double TOP = std::numeric_limits<double>::infinity();
+  const auto& names    = compiled.signals();
+
+  // Check all the chunks before appending any of them. The results are exact up to
+  // the end of the shortest signal, less their horizons.
+  double end    = TOP;
+  auto extended = std::vector<size_t>{};
+  for (size_t k = 0; k < names.size(); k++) {
+    const auto& x = inputs[k];
+    end           = (x->empty()) ? -TOP : std::min(end, x->end_time());
+    const auto it = chunk.find(names[k]);
+    if (it == chunk.end() || it->second->empty()) {
+      continue;
+    }
+    if (!x->empty() && it->second->begin_time() <= x->end_time()) {
+      throw std::invalid_argument(fmt::format(
+          "Samples appended to '{}' must be after its end at {}, got a sample at {}",
+          names[k],
+          x->end_time(),
+          it->second->begin_time()));
+    }
+    extended.push_back(k);
+  }
+  if (extended.empty()) {
+    return;
+  }
+  for (const size_t k : extended) {
+    auto& x = inputs[k];
+    if (x.use_count() > 1) {
+      x = std::make_shared<Signal>(*x);
+    }
+    const auto& c = *chunk.at(names[k]);
+    x->append_sorted(c.times(), c.values(), c.derivatives());
+  }
+
+  auto time_range = Window{TOP, -TOP};
+  for (const auto& x : inputs) {
+    time_range = {
+        std::min(time_range.first, x->begin_time()),
+        std::max(time_range.second, x->end_time())};
+  }
+
+  auto pool     = std::unique_ptr<ThreadPool>{};
+  auto executor = get_executor(eval_options, pool);
+  auto buffers  = std::make_shared<BufferPool>();
+  auto scope    = BufferPool::Scope{buffers.get()};
+
+  // The operands come first, so they are updated by the time they are used. Each
+  // operation is recomputed from where its result may have changed, which only needs
+  // its operands from there.
+  const auto& ops = compiled.ops();
+  for (size_t i = 0; i < ops.size(); i++) {
+    const auto& op  = ops[i];
+    const double lo = end - op.horizon;
+    auto operands   = std::vector<SignalPtr>{};
+    operands.reserve(op.args.size());
+    for (const size_t a : op.args) {
+      operands.push_back(slice(op_results[a], lo, TOP));
+    }
+    const auto tail = apply(
+        op,
+        std::move(operands),
+        inputs,
+        time_range,
+        Window{lo, TOP},
+        eval_options.semantics,
+        executor);
+    splice(op_results[i], lo, slice(tail, lo, TOP));
+  }
+}
+
+std::vector<SignalPtr> IncrementalEvaluation::outputs() const {
+  auto out = std::vector<SignalPtr>{};
+  out.reserve(compiled.outputs().size());
+  for (const size_t i : compiled.outputs()) { out.push_back(op_results[i]); }
+  return out;
+}
+
+SignalPtr compute_robustness(
+    const EvaluationPlan& plan,
+    const Trace& trace,
+    const EvaluationOptions& options) {
+  if (plan.outputs().size() != 1) {
+    throw std::invalid_argument("Plan must compute exactly one formula");
+  }
+  return plan.evaluate(trace, options).front();
+}
+
+} // namespace signal_tl::semantics
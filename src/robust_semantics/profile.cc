@@ -0,0 +1,50 @@
+#include "signal_tl/profile.hpp"
+
+#include "signal_tl/fmt.hpp" // IWYU pragma: keep
+
+#include <fmt/format.h> // for format, format_to, memory_buffer
+#include <iterator>     // for back_inserter
+#include <string>       // for string
+
+namespace signal_tl::semantics {
+
+std::string EvaluationProfile::report() const {
+  constexpr size_t MAX_WIDTH = 60;
+
+  auto out = fmt::memory_buffer{};
+  fmt::format_to(
+      std::back_inserter(out),
+      "{:>5} {:>10} {:>6} {:>10} {:>10} {:>10} {:>12}  {}\n",
+      "node",
+      "time (ms)",
+      "share",
+      "in",
+      "out",
+      "added",
+      "allocated",
+      "formula");
+  for (size_t i = 0; i < nodes.size(); i++) {
+    const auto& node = nodes[i];
+    auto formula =
+        fmt::format("{}{}", (node.cached) ? "(cached) " : "", node.formula);
+    if (formula.size() > MAX_WIDTH) {
+      formula = formula.substr(0, MAX_WIDTH - 3) + "...";
+    }
+    const double share = (seconds > 0) ? 100 * node.seconds / seconds : 0.0;
+    fmt::format_to(
+        std::back_inserter(out),
+        "{:>5} {:>10.3f} {:>5.1f}% {:>10} {:>10} {:>10} {:>12}  {}\n",
+        i,
+        1e3 * node.seconds,
+        share,
+        node.input_samples,
+        node.output_samples,
+        node.added_samples,
+        node.bytes_allocated,
+        formula);
+  }
+  fmt::format_to(std::back_inserter(out), "total: {:.3f} ms\n", 1e3 * seconds);
+  return fmt::to_string(out);
+}
+
+} // namespace signal_tl::semantics
@@ -0,0 +1,161 @@
+#include "signal_tl/result_cache.hpp"
+#include "signal_tl/trace_file.hpp"
+
+#include <cstring>      // for memcpy
+#include <exception>    // for exception
+#include <fmt/format.h> // for format
+#include <random>       // for random_device
+#include <string>       // for string
+#include <system_error> // for error_code
+#include <utility>      // for move
+
+namespace signal_tl::semantics {
+using namespace signal;
+
+namespace {
+
+/// The name of the channel of the result in its file.
+constexpr const char* CHANNEL = "robustness";
+
+uint64_t bits_of(double x) {
+  uint64_t out = 0;
+  std::memcpy(&out, &x, sizeof(out));
+  return out;
+}
+
+} // namespace
+
+uint64_t fingerprint(utils::span<const double> column) {
+  // Two interleaved chains, as each step depends on the previous one.
+  uint64_t even  = fingerprint_combine(0, column.size());
+  uint64_t odd   = fingerprint_combine(1, column.size());
+  const size_t n = column.size();
+  size_t i       = 0;
+  for (; i + 1 < n; i += 2) {
+    even = fingerprint_combine(even, bits_of(column[i]));
+    odd  = fingerprint_combine(odd, bits_of(column[i + 1]));
+  }
+  if (i < n) {
+    even = fingerprint_combine(even, bits_of(column[i]));
+  }
+  return fingerprint_combine(even, odd);
+}
+
+uint64_t fingerprint(const Signal& x) {
+  return fingerprint_combine(fingerprint(x.times()), fingerprint(x.values()));
+}
+
+ResultCache::ResultCache(size_t _max_samples) : max_samples{_max_samples} {}
+
+ResultCache::ResultCache(stdfs::path directory, size_t _max_samples) :
+    dir{std::move(directory)}, max_samples{_max_samples} {
+  auto ec = std::error_code{};
+  stdfs::create_directories(*dir, ec);
+}
+
+stdfs::path ResultCache::path_of(uint64_t key) const {
+  return *dir / fmt::format("{:016x}.stltrace", key);
+}
+
+SignalPtr ResultCache::find(uint64_t key) {
+  {
+    const auto lock = std::lock_guard{mutex};
+    if (const auto it = by_key.find(key); it != by_key.end()) {
+      entries.splice(entries.begin(), entries, it->second);
+      counts.hits++;
+      return it->second->second;
+    }
+    if (!dir.has_value()) {
+      counts.misses++;
+      return nullptr;
+    }
+  }
+
+  // The file is read without holding the lock, as the files are only replaced as a
+  // whole (see `insert`).
+  auto y          = SignalPtr{};
+  const auto path = path_of(key);
+  auto ec         = std::error_code{};
+  if (stdfs::exists(path, ec)) {
+    try {
+      y = TraceFile{path}.signal(CHANNEL);
+    } catch (const std::exception&) {
+      // A file that can't be read (e.g., written by something else) is a miss.
+    }
+  }
+
+  const auto lock = std::lock_guard{mutex};
+  if (y == nullptr) {
+    counts.misses++;
+    return nullptr;
+  }
+  counts.hits++;
+  counts.disk_hits++;
+  remember(key, y);
+  return y;
+}
+
+void ResultCache::insert(uint64_t key, const SignalPtr& y) {
+  {
+    const auto lock = std::lock_guard{mutex};
+    remember(key, y);
+  }
+  if (!dir.has_value()) {
+    return;
+  }
+
+  // Write to a temporary file first, so that concurrent readers (in this process or
+  // in others) never see a partial file.
+  const auto path = path_of(key);
+  const auto tmp  = stdfs::path{
+      path.string() + fmt::format(".{:016x}.tmp", fingerprint_combine(
+                                                       std::random_device{}(), key))};
+  try {
+    write_trace_file(tmp, Trace{{CHANNEL, y}});
+    stdfs::rename(tmp, path);
+  } catch (const std::exception&) {
+    // The cache only saves time.
+    auto ec = std::error_code{};
+    stdfs::remove(tmp, ec);
+  }
+}
+
+void ResultCache::remember(uint64_t key, const SignalPtr& y) {
+  if (const auto it = by_key.find(key); it != by_key.end()) {
+    num_samples -= it->second->second->size();
+    entries.erase(it->second);
+    by_key.erase(it);
+  }
+  if (y->size() > max_samples) {
+    return;
+  }
+  entries.emplace_front(key, y);
+  by_key.emplace(key, entries.begin());
+  num_samples += y->size();
+  while (num_samples > max_samples) {
+    const auto& [oldest, x] = entries.back();
+    num_samples -= x->size();
+    by_key.erase(oldest);
+    entries.pop_back();
+    counts.evicted++;
+  }
+}
+
+void ResultCache::clear() {
+  const auto lock = std::lock_guard{mutex};
+  entries.clear();
+  by_key.clear();
+  num_samples = 0;
+}
+
+size_t ResultCache::size() const {
+  const auto lock = std::lock_guard{mutex};
+  return entries.size();
+}
+
+ResultCache::Stats ResultCache::stats() const {
+  const auto lock = std::lock_guard{mutex};
+  return counts;
+}
+
+} // namespace signal_tl::semantics
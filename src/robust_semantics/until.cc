@@ -0,0 +1,481 @@
+#include "until.hpp"
+
+#include "signal_tl/signal.hpp"
+
+#include "buffer_pool.hpp" // for acquire_buffer, release_buffer, make_signal
+#include "minmax.hpp"      // for compute_elementwise_min, compute_min_seq
+
+#include <algorithm> // for min, max, reverse
+#include <array>     // for array
+#include <cassert>   // for assert
+#include <cmath>     // for abs, isfinite, isinf
+#include <cstddef>   // for size_t
+#include <deque>     // for deque
+#include <limits>    // for numeric_limits
+#include <memory>    // for make_shared
+#include <utility>   // for move, pair, swap
+#include <vector>    // for vector
+
+namespace signal_tl::semantics {
+using namespace signal;
+
+namespace {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+/// The largest (average) number of samples in the windows of bounded Until for which
+/// they are scanned, rather than kept in monotonic wedges (see `ScannedWindow`).
+constexpr double MAX_SCANNED_WIDTH = 24;
+
+/// Interpolate between `x0` and `x1`, keeping constant (possibly infinite) segments.
+double lerp(double x0, double x1, double w) {
+  return (x0 == x1 || w == 0) ? x0 : x0 + (x1 - x0) * w;
+}
+
+/**
+ * The value columns of the operands of Until over a common set of time points.
+ */
+struct Columns {
+  std::vector<double> times;
+  std::vector<double> xs;
+  std::vector<double> ys;
+
+  /// Get buffers that can hold `n` samples from the buffer pool.
+  void reserve(size_t n) {
+    times = acquire_buffer(n);
+    xs    = acquire_buffer(n);
+    ys    = acquire_buffer(n);
+  }
+
+  /// Return the (remaining) buffers to the buffer pool.
+  void release() {
+    release_buffer(std::move(times));
+    release_buffer(std::move(xs));
+    release_buffer(std::move(ys));
+  }
+
+  void push_back(double t, double x, double y) {
+    times.push_back(t);
+    xs.push_back(x);
+    ys.push_back(y);
+  }
+
+  [[nodiscard]] size_t size() const {
+    return times.size();
+  }
+};
+
+/**
+ * Synchronize the two signals, and add the time points where they cross.
+ *
+ * Between two consecutive points of the output, both signals are linear and one of
+ * them is always less than or equal to the other, so `min(x, y)` is linear too.
+ */
+Columns synchronize_with_crossings(const SignalPtr& x, const SignalPtr& y) {
+  auto out  = Columns{};
+  auto prev = SynchronizedView::Point{};
+  const auto add = [&](const SynchronizedView::Point& p) {
+    if (!out.times.empty()) {
+      const double d0 = prev.x - prev.y;
+      const double d1 = p.x - p.y;
+      if (d0 * d1 < 0) {
+        const double dt = p.time - prev.time;
+        const double t  = prev.time + dt * d0 / (d0 - d1);
+        if (prev.time < t && t < p.time) {
+          const double v = prev.x + (p.x - prev.x) * (t - prev.time) / dt;
+          out.push_back(t, v, v);
+        }
+      }
+    }
+    out.push_back(p.time, p.x, p.y);
+    prev = p;
+  };
+
+  // Signals that share their time points (e.g., the channels of a trace made with
+  // `make_trace`) are read directly, without merging the time stamps.
+  if (x->time_column().data() == y->time_column().data() &&
+      x->size() == y->size()) {
+    const auto ts  = x->times();
+    const auto xs  = x->values();
+    const auto ys  = y->values();
+    const size_t n = ts.size();
+    out.reserve(2 * n);
+    for (size_t i = 0; i < n; i++) { add({ts[i], xs[i], ys[i]}); }
+    return out;
+  }
+
+  const auto view = SynchronizedView{*x, *y};
+  out.reserve(2 * view.size_hint());
+  for (const auto p : view) { add(p); }
+  return out;
+}
+
+/**
+ * The samples in the window of `until_within`, kept in monotonic wedges, which takes
+ * O(1) amortized time per sample for any window.
+ *
+ * Samples enter the window at the front and leave it at the back (both wedges are
+ * ordered by increasing index from front to back), as the window moves towards the
+ * start of the signals:
+ *
+ * - `terms` holds the candidates (j, u_j) for the supremum of
+ *   u_j = min(y_j, min_{k <= j} x_k) over the samples in the window, with strictly
+ *   increasing u_j. A new sample clamps every u_j by its x value, which merges all
+ *   the candidates with u_j >= x into the one among them that stays in the window the
+ *   longest.
+ * - `x_min` holds the candidates for the minimum of x, with strictly decreasing x.
+ */
+class WedgeWindow {
+ public:
+  explicit WedgeWindow(const Columns& cols_) : cols{cols_} {}
+
+  void push_front(size_t j) {
+    const double x = cols.xs[j];
+    if (!terms.empty() && terms.back().second >= x) {
+      size_t merged = 0;
+      while (!terms.empty() && terms.back().second >= x) {
+        merged = terms.back().first;
+        terms.pop_back();
+      }
+      terms.emplace_back(merged, x);
+    }
+    const double u = std::min(cols.ys[j], x);
+    while (!terms.empty() && terms.front().second <= u) { terms.pop_front(); }
+    terms.emplace_front(j, u);
+
+    while (!x_min.empty() && cols.xs[x_min.front()] >= x) { x_min.pop_front(); }
+    x_min.push_front(j);
+  }
+
+  /// Remove the samples after `last`.
+  void pop_back_after(size_t last) {
+    while (!terms.empty() && terms.back().first > last) { terms.pop_back(); }
+    while (!x_min.empty() && x_min.back() > last) { x_min.pop_back(); }
+  }
+
+  /// The minimum of x and the supremum of the terms over the window.
+  [[nodiscard]] std::pair<double, double> summary() const {
+    if (terms.empty()) {
+      return {INF, -INF};
+    }
+    return {cols.xs[x_min.back()], terms.back().second};
+  }
+
+ private:
+  const Columns& cols;
+  std::deque<std::pair<size_t, double>> terms;
+  std::deque<size_t> x_min;
+};
+
+/**
+ * The samples in the window of `until_within`, which are scanned for every summary.
+ * This takes O(W) time for windows of W samples, but is faster than the wedges for
+ * narrow windows.
+ */
+class ScannedWindow {
+ public:
+  explicit ScannedWindow(const Columns& cols_) :
+      cols{cols_}, first{cols_.size()}, last{cols_.size()} {}
+
+  void push_front(size_t j) {
+    assert(j + 1 == first);
+    first = j;
+  }
+
+  /// Remove the samples after `end`.
+  void pop_back_after(size_t end) {
+    last = std::min(last, end + 1);
+  }
+
+  /// The minimum of x and the supremum of the terms over the window.
+  [[nodiscard]] std::pair<double, double> summary() const {
+    double inf_x = INF;
+    double opt   = -INF;
+    for (size_t j = first; j < last; j++) {
+      inf_x = std::min(inf_x, cols.xs[j]);
+      opt   = std::max(opt, std::min(cols.ys[j], inf_x));
+    }
+    return {inf_x, opt};
+  }
+
+ private:
+  const Columns& cols;
+  size_t first; // The samples in the window are [first, last).
+  size_t last;
+};
+
+/**
+ * The samples in the window of `until_within` for an infinite window, which never
+ * leave it, so its summary is updated as they enter.
+ */
+class GrowingWindow {
+ public:
+  explicit GrowingWindow(const Columns& cols_) : cols{cols_} {}
+
+  void push_front(size_t j) {
+    const double x = cols.xs[j];
+    inf_x          = std::min(inf_x, x);
+    opt            = std::max(std::min(opt, x), std::min(cols.ys[j], x));
+  }
+
+  void pop_back_after([[maybe_unused]] size_t last) {
+    assert(last + 1 == cols.size());
+  }
+
+  /// The minimum of x and the supremum of the terms over the window.
+  [[nodiscard]] std::pair<double, double> summary() const {
+    return {inf_x, opt};
+  }
+
+ private:
+  const Columns& cols;
+  double inf_x = INF;
+  double opt   = -INF;
+};
+
+/**
+ * Compute
+ *
+ *    w(t) = sup_{t' in [t, t + c]} min(y(t'), inf_{[t, t']} x)
+ *
+ * over the synchronized columns, where the window is clipped to the end of the
+ * signals (so an infinite `c` gives the unbounded Until).
+ *
+ * Let m = min(x, y), which is linear between the points of `cols`. Between two
+ * consecutive points of the grid made of the time points t_j and t_j - c, the samples
+ * J strictly after t and in the window are the same, and x(t), m(t) and
+ * mu(t) = m(min(t + c, end)) are linear. Splitting the window at the samples in J
+ * gives
+ *
+ *    w(t) = max(m(t), min(x(t), max(D, min(mu(t), C))))
+ *
+ * with the constants C = min_{j in J} x_j and D = max_{j in J} u_j, where
+ * u_j = min(y_j, min_{k in J, k <= j} x_k). So the breakpoints of the result are the
+ * points of the grid, and the crossings of these lines between them.
+ */
+template <typename Window>
+SignalPtr until_within(const Columns& cols, double c) {
+  const auto& ts        = cols.times;
+  const auto& xs        = cols.xs;
+  const auto& ys        = cols.ys;
+  const size_t n        = cols.size();
+  const double end_time = ts.back();
+
+  // The values at `s`, where `k` is the last sample at or before `s`.
+  const auto value_at = [&](const std::vector<double>& vs, size_t k, double s) {
+    if (ts[k] == s) {
+      return vs[k];
+    }
+    return lerp(vs[k], vs[k + 1], (s - ts[k]) / (ts[k + 1] - ts[k]));
+  };
+  // A point of the grid, with the values of x, m and mu there.
+  struct Point {
+    double t;
+    double x;
+    double m;
+    double mu;
+  };
+  // The last samples at or before `s` and `min(s + c, end)`, which only move
+  // backwards, like the points of the grid.
+  size_t p            = n - 1;
+  size_t q            = n - 1;
+  const auto point_at = [&](double s) {
+    const double u = std::min(s + c, end_time);
+    while (ts[p] > s) { p--; }
+    while (ts[q] > u) { q--; }
+    const double x = value_at(xs, p, s);
+    return Point{
+        s,
+        x,
+        std::min(x, value_at(ys, p, s)),
+        std::min(value_at(xs, q, u), value_at(ys, q, u))};
+  };
+
+  auto out_times  = acquire_buffer(2 * n);
+  auto out_values = acquire_buffer(2 * n);
+  // Add a breakpoint (going backwards), replacing the last one if it is on the line
+  // between its neighbors.
+  const auto emit = [&](double t, double v) {
+    const size_t m = out_times.size();
+    if (m >= 2) {
+      const double t0 = out_times[m - 2], v0 = out_values[m - 2];
+      const double t1 = out_times[m - 1], v1 = out_values[m - 1];
+      const double lhs = (v1 - v0) * (t - t1);
+      const double rhs = (v - v1) * (t1 - t0);
+      const double tol = 1e-12 * (std::abs(lhs) + std::abs(rhs));
+      if ((v0 == v1 && v1 == v) || std::abs(lhs - rhs) <= tol) {
+        out_times.back()  = t;
+        out_values.back() = v;
+        return;
+      }
+    }
+    out_times.push_back(t);
+    out_values.push_back(v);
+  };
+
+  auto window = Window{cols};
+  size_t next = n; // The next sample to enter the window is next - 1.
+  size_t last = n; // The samples after `last - 1` have left the window.
+  // The grid is generated backwards, by merging the time points (the next one is
+  // ts[rest - 1]) and the ones shifted by -c (the next one is ts[rest_shifted - 1]).
+  size_t rest         = n - 1;
+  size_t rest_shifted = n;
+
+  auto right = point_at(end_time);
+  emit(right.t, right.m);
+  while (rest > 0) {
+    while (rest_shifted > 0 && ts[rest_shifted - 1] - c >= right.t) { rest_shifted--; }
+    double t = ts[rest - 1];
+    if (rest_shifted > 0 && ts[rest_shifted - 1] - c > t) {
+      t = ts[rest_shifted - 1] - c;
+    } else {
+      rest--;
+    }
+    const auto left     = point_at(t);
+    const double t_next = right.t;
+
+    for (; next > 0 && ts[next - 1] >= t_next; next--) { window.push_front(next - 1); }
+    while (ts[last - 1] > std::min(t + c, end_time)) { last--; }
+    window.pop_back_after(last - 1);
+    const auto [inf_x, opt] = window.summary();
+
+    // As m <= x, the result is clamp(I, m, x) with I = clamp(mu, D, max(C, D)), so
+    // it has breakpoints where mu crosses the bounds of I, and where each piece of I
+    // crosses m or x. The lines are functions of w in [0, 1] over [t, t_next].
+    const double lo  = opt;
+    const double hi  = std::max(inf_x, opt);
+    const auto clamp = [](double v, double l, double h) {
+      return std::min(std::max(v, l), h);
+    };
+    const auto x_at  = [&](double w) { return lerp(left.x, right.x, w); };
+    const auto m_at  = [&](double w) { return lerp(left.m, right.m, w); };
+    const auto mu_at = [&](double w) { return lerp(left.mu, right.mu, w); };
+    const auto inner = [&](double w) { return clamp(mu_at(w), lo, hi); };
+    const auto value = [&](double w) { return clamp(inner(w), m_at(w), x_at(w)); };
+
+    // The points in (w0, w1) where a difference of two lines, with the values `d0`
+    // and `d1` at w0 and w1, changes sign, from w0 to w1.
+    struct Crossings {
+      std::array<double, 2> ws{};
+      size_t size = 0;
+
+      void add(double w0, double w1, double d0, double d1) {
+        if (d0 * d1 < 0 && std::isfinite(d0) && std::isfinite(d1)) {
+          ws[size++] = w0 + (w1 - w0) * d0 / (d0 - d1);
+          if (size == 2 && (ws[0] - w0) / (w1 - w0) > (ws[1] - w0) / (w1 - w0)) {
+            std::swap(ws[0], ws[1]);
+          }
+        }
+      }
+    };
+
+    // The pieces of I, from w = 1 down to w = 0.
+    auto ends = Crossings{};
+    ends.add(1.0, 0.0, right.mu - lo, left.mu - lo);
+    ends.add(1.0, 0.0, right.mu - hi, left.mu - hi);
+
+    const double dt = t_next - t;
+    double w0       = 1.0;
+    for (size_t i = 0; i <= ends.size; i++) {
+      const double w1 = (i < ends.size) ? ends.ws[i] : 0.0;
+      const double i0 = inner(w0);
+      const double i1 = inner(w1);
+      auto crossings  = Crossings{};
+      crossings.add(w0, w1, i0 - m_at(w0), i1 - m_at(w1));
+      crossings.add(w0, w1, i0 - x_at(w0), i1 - x_at(w1));
+      for (size_t j = 0; j < crossings.size; j++) {
+        if (const double s = t + dt * crossings.ws[j]; t < s && s < t_next) {
+          emit(s, value(crossings.ws[j]));
+        }
+      }
+      if (const double s = t + dt * w1; t < s && s < t_next) {
+        emit(s, value(w1));
+      }
+      w0 = w1;
+    }
+    emit(t, value(0.0));
+    right = left;
+  }
+
+  std::reverse(out_times.begin(), out_times.end());
+  std::reverse(out_values.begin(), out_values.end());
+  return make_signal(std::move(out_values), std::move(out_times));
+}
+
+/**
+ * Get `w(min(t + a, end))` over the domain [begin, end] of `w`.
+ */
+SignalPtr shift_back(const SignalPtr& w, double a) {
+  const double begin_time = w->begin_time();
+  const double end_time   = w->end_time();
+
+  auto times  = acquire_buffer(w->size() + 1);
+  auto values = acquire_buffer(w->size() + 1);
+  times.push_back(begin_time);
+  values.push_back(w->at(std::min(begin_time + a, end_time)).value);
+  for (const auto s : *w) {
+    if (s.time - a > begin_time) {
+      times.push_back(s.time - a);
+      values.push_back(s.value);
+    }
+  }
+  if (times.back() < end_time) {
+    times.push_back(end_time);
+    values.push_back(w->back().value);
+  }
+  return make_signal(std::move(values), std::move(times));
+}
+
+} // namespace
+
+SignalPtr compute_until(const SignalPtr& input_x, const SignalPtr& input_y) {
+  auto cols = synchronize_with_crossings(input_x, input_y);
+  if (cols.times.empty()) {
+    cols.release();
+    return std::make_shared<Signal>();
+  }
+  auto out = until_within<GrowingWindow>(cols, INF);
+  cols.release();
+  return out;
+}
+
+SignalPtr compute_until(
+    const SignalPtr& input_x,
+    const SignalPtr& input_y,
+    double a,
+    double b) {
+  assert(0 <= a && a <= b);
+
+  auto cols = synchronize_with_crossings(input_x, input_y);
+  if (cols.times.empty()) {
+    cols.release();
+    return std::make_shared<Signal>();
+  }
+  const double duration = cols.times.back() - cols.times.front();
+  // The average number of samples in a window (of the Until over [0, b - a]).
+  const double width = (duration > 0) ? std::min((b - a) / duration, 1.0) *
+                                            static_cast<double>(cols.size())
+                                      : 0.0;
+  auto w = SignalPtr{};
+  if (std::isinf(b)) {
+    w = until_within<GrowingWindow>(cols, INF);
+  } else if (width <= MAX_SCANNED_WIDTH) {
+    w = until_within<ScannedWindow>(cols, b - a);
+  } else {
+    w = until_within<WedgeWindow>(cols, b - a);
+  }
+  if (a == 0) {
+    cols.release();
+    return w;
+  }
+
+  // For t' >= t + a, inf_{[t, t']} x = min(inf_{[t, t + a]} x, inf_{[t + a, t']} x), so
+  //
+  //    (x U[a, b] y)(t) = min((G[0, a] x)(t), (x U[0, b - a] y)(t + a)).
+  release_buffer(std::move(cols.ys));
+  const auto x = make_signal(std::move(cols.xs), std::move(cols.times));
+  return minmax::compute_elementwise_min(
+      minmax::compute_min_seq(x, 0, a), shift_back(w, a));
+}
+
+} // namespace signal_tl::semantics
@@ -0,0 +1,27 @@
+#ifndef SIGNAL_TEMPORAL_LOGIC_UNTIL_HPP
+#define SIGNAL_TEMPORAL_LOGIC_UNTIL_HPP
+
+#include "signal_tl/signal.hpp"
+
+namespace signal_tl::semantics {
+
+/**
+ * Compute the robustness of the unbounded Until operator, given the robustness
+ * signals of its operands.
+ */
+signal::SignalPtr
+compute_until(const signal::SignalPtr& input_x, const signal::SignalPtr& input_y);
+
+/**
+ * Compute the robustness of the bounded Until operator, with the interval [a, b],
+ * given the robustness signals of its operands.
+ */
+signal::SignalPtr compute_until(
+    const signal::SignalPtr& input_x,
+    const signal::SignalPtr& input_y,
+    double a,
+    double b);
+
+} // namespace signal_tl::semantics
+
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+
+#ifndef SIGNALTL_TESTS_HELPERS_HPP
+#define SIGNALTL_TESTS_HELPERS_HPP
+
+#include "signal_tl/signal.hpp" // for Signal, SignalPtr, Trace
+
+#include <catch2/catch.hpp> // for Approx, INFO, REQUIRE
+
+#include <cmath>   // for sin, cos
+#include <cstddef> // for size_t
+#include <memory>  // for make_shared
+#include <utility> // for forward, move
+#include <vector>  // for vector
+
+/// Fixtures and assertions that are shared by the tests.
+namespace helpers {
+
+using signal_tl::signal::Signal;
+using signal_tl::signal::SignalPtr;
+using signal_tl::signal::Trace;
+
+/// Get the value of `x` at `t`, interpolated between the samples, and extended by the
+/// first (or last) value before (or after) the signal.
+inline double value_at(const Signal& x, double t) {
+  if (t <= x.begin_time()) {
+    return x.front().value;
+  } else if (t >= x.end_time()) {
+    return x.back().value;
+  }
+  return x.at(t).value;
+}
+
+/// Check that two signals are the same piecewise-linear function.
+///
+/// Evaluations can choose different (but equivalent) sampling points, e.g., in the
+/// parallel reductions, so the signals are compared at the samples of both.
+inline void require_same(const SignalPtr& actual, const SignalPtr& expected) {
+  REQUIRE(actual->begin_time() == Approx(expected->begin_time()));
+  REQUIRE(actual->end_time() == Approx(expected->end_time()));
+  for (const auto s : *actual) {
+    INFO("Sample at t = " << s.time);
+    REQUIRE(s.value == Approx(value_at(*expected, s.time)).margin(1e-9));
+  }
+  for (const auto s : *expected) {
+    INFO("Sample at t = " << s.time);
+    REQUIRE(s.value == Approx(value_at(*actual, s.time)).margin(1e-9));
+  }
+}
+
+/// Check that two signals have exactly the same samples.
+inline void require_identical(const SignalPtr& actual, const SignalPtr& expected) {
+  REQUIRE(actual->size() == expected->size());
+  for (size_t i = 0; i < actual->size(); i++) {
+    REQUIRE(actual->at_idx(i).time == expected->at_idx(i).time);
+    REQUIRE(actual->at_idx(i).value == expected->at_idx(i).value);
+  }
+}
+
+/// Sample `f` at the given time points.
+template <typename F>
+SignalPtr sample_signal(F&& f, std::vector<double> times) {
+  auto values = std::vector<double>{};
+  values.reserve(times.size());
+  for (const double t : times) { values.push_back(f(t)); }
+  return std::make_shared<Signal>(std::move(values), std::move(times));
+}
+
+/// Sample `f` at the `n` time points `start + dt * i`.
+template <typename F>
+SignalPtr sample_signal(F&& f, size_t n, double dt = 0.1, double start = 0.0) {
+  auto times = std::vector<double>{};
+  times.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    times.push_back(start + dt * static_cast<double>(i));
+  }
+  return sample_signal(std::forward<F>(f), std::move(times));
+}
+
+/// Get the trace that most of the tests are run on, with `n` samples of
+///
+/// - `x = sin(t + phase)`,
+/// - `y = cos(2t - phase)`, sampled halfway between the samples of the others, and
+/// - `z = sin(t / 3) - 0.2`,
+///
+/// every 0.1 time units.
+inline Trace get_trace(size_t n = 500, double phase = 0.0) {
+  const auto x = [=](double t) { return std::sin(t + phase); };
+  const auto y = [=](double t) { return std::cos(2 * t - phase); };
+  const auto z = [](double t) { return std::sin(t / 3) - 0.2; };
+  return Trace{
+      {"x", sample_signal(x, n)},
+      {"y", sample_signal(y, n, 0.1, 0.05)},
+      {"z", sample_signal(z, n)}};
+}
+
+} // namespace helpers
+
+#endif
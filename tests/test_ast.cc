@@ -0,0 +1,155 @@
+#include "signal_tl/signal_tl.hpp" // for Expr, Predicate, Always, compute_robustness
+#include "signal_tl/fmt.hpp"       // IWYU pragma: keep
+
+#include <catch2/catch.hpp> // for AssertionHandler, operator""_catch_sr
+#include <fmt/format.h>     // for format
+
+#include <cmath>         // for sin
+#include <set>           // for set
+#include <memory>        // for make_shared
+#include <string>        // for string, to_string
+#include <thread>        // for thread
+#include <unordered_map> // for unordered_map
+#include <utility>       // for move
+#include <vector>        // for vector
+
+namespace stl = signal_tl;
+using signal_tl::ast::Expr;
+using signal_tl::ast::ExprEqual;
+using signal_tl::ast::ExprHash;
+
+TEST_CASE("Structurally equal expressions are equal and hash equally", "[ast]") {
+  const auto make_phi = []() {
+    return stl::Always(
+        (stl::Predicate("x") > 0.5) & ~(stl::Predicate("y") < 1),
+        stl::ast::Interval{0.0, 2.0});
+  };
+  // Two separately constructed formulas share no nodes.
+  const auto phi1 = make_phi();
+  const auto phi2 = make_phi();
+  REQUIRE(stl::ast::node_address(phi1) != stl::ast::node_address(phi2));
+  REQUIRE(ExprEqual{}(phi1, phi2));
+  REQUIRE(ExprHash{}(phi1) == ExprHash{}(phi2));
+
+  auto cache = std::unordered_map<const void*, size_t>{};
+  REQUIRE(ExprHash{&cache}(phi1) == ExprHash{}(phi1));
+  REQUIRE_FALSE(cache.empty());
+
+  const auto different = GENERATE(
+      Expr{stl::Predicate("x") > 0.5},
+      stl::Always((stl::Predicate("x") > 0.5) & ~(stl::Predicate("y") < 1)),
+      stl::Always(
+          (stl::Predicate("x") > 0.5) & ~(stl::Predicate("y") <= 1),
+          stl::ast::Interval{0.0, 2.0}),
+      stl::Always(
+          ~(stl::Predicate("y") < 1) & (stl::Predicate("x") > 0.5),
+          stl::ast::Interval{0.0, 2.0}),
+      stl::Eventually(
+          (stl::Predicate("x") > 0.5) & ~(stl::Predicate("y") < 1),
+          stl::ast::Interval{0.0, 2.0}));
+  REQUIRE_FALSE(ExprEqual{}(phi1, different));
+}
+
+TEST_CASE("Shared subformulas give the same robustness", "[ast][robustness]") {
+  auto x = std::make_shared<stl::signal::Signal>();
+  auto y = std::make_shared<stl::signal::Signal>();
+  for (int i = 0; i < 100; i++) {
+    const double t = 0.1 * i;
+    x->push_back(t, std::sin(t));
+    y->push_back(t, std::sin(2 * t));
+  }
+  const auto trace = stl::signal::Trace{{"x", x}, {"y", y}};
+
+  // `shared` uses the same subformula node multiple times, while `unshared`
+  // constructs a copy of it each time.
+  const auto make_sub = []() {
+    return stl::Eventually(
+        (stl::Predicate("x") > 0) | (stl::Predicate("y") < 0.5),
+        stl::ast::Interval{0.0, 1.0});
+  };
+  const auto sub      = make_sub();
+  const auto shared   = stl::And({sub, ~sub, stl::Always(sub)});
+  const auto unshared = stl::And({make_sub(), ~make_sub(), stl::Always(make_sub())});
+
+  const auto expected = stl::compute_robustness(unshared, trace);
+  const auto actual   = stl::compute_robustness(shared, trace);
+  REQUIRE(actual->size() == expected->size());
+  for (size_t i = 0; i < actual->size(); i++) {
+    REQUIRE(actual->at_idx(i).time == expected->at_idx(i).time);
+    REQUIRE(actual->at_idx(i).value == expected->at_idx(i).value);
+  }
+}
+
+TEST_CASE("Signal names are interned", "[ast]") {
+  const auto name = std::string{"interned_signal"};
+  const auto x    = stl::Symbol{name};
+  const auto n    = stl::Symbol::count();
+  REQUIRE(stl::Symbol{"interned_signal"} == x);
+  REQUIRE(&stl::Symbol{name + ""}.str() == &x.str());
+  REQUIRE(stl::Symbol::count() == n);
+  REQUIRE(stl::Symbol{"other_signal"} != x);
+  REQUIRE(stl::Symbol{"a"} < stl::Symbol{"b"});
+  REQUIRE_FALSE(stl::Symbol{"b"} < stl::Symbol{"a"});
+
+  const auto p = stl::Predicate(name) > 1;
+  REQUIRE(p.name == x);
+  REQUIRE(p.name.str() == name);
+  REQUIRE(fmt::format("{}", p.name) == name);
+  REQUIRE(fmt::format("[{:>17}]", p.name) == "[  interned_signal]");
+  REQUIRE(fmt::format("{}", p) == "(interned_signal > 1)");
+  REQUIRE(stl::ast::signal_names(p & (stl::Predicate("y") < 0)) ==
+          std::set<std::string>{"interned_signal", "y"});
+}
+
+TEST_CASE("Conjunctions and disjunctions are flattened", "[ast]") {
+  auto preds = std::vector<Expr>{};
+  for (int i = 0; i < 10; i++) {
+    preds.emplace_back(stl::Predicate("x" + std::to_string(i)) > i);
+  }
+
+  // Built one operand at a time, in place.
+  auto phi = preds[0];
+  auto psi = preds[0];
+  for (size_t i = 1; i < preds.size(); i++) {
+    phi = std::move(phi) & preds[i];
+    psi = std::move(psi) | preds[i];
+  }
+  REQUIRE(ExprEqual{}(phi, stl::And(preds)));
+  REQUIRE(ExprEqual{}(psi, stl::Or(preds)));
+
+  // Expressions that are shared are never modified.
+  const auto shared = stl::And({preds[0], preds[1]});
+  auto copy         = shared;
+  const auto out    = std::move(copy) & preds[2];
+  REQUIRE(std::get<stl::ast::AndPtr>(shared)->args.size() == 2);
+  REQUIRE(std::get<stl::ast::AndPtr>(out)->args.size() == 3);
+  auto self = stl::And({preds[0], preds[1]});
+  self      = std::move(self) & self;
+  REQUIRE(std::get<stl::ast::AndPtr>(self)->args.size() == 4);
+
+  // Constants simplify the expression.
+  REQUIRE(ExprEqual{}(shared & stl::Const(true), shared));
+  REQUIRE(ExprEqual{}(shared & stl::Const(false), stl::Const(false)));
+  REQUIRE(ExprEqual{}(stl::Or(preds) | stl::Const(true), stl::Const(true)));
+  REQUIRE(ExprEqual{}(Expr{stl::Or(preds)} | stl::Const(true), stl::Const(true)));
+}
+
+TEST_CASE("Formulas can be freed on other threads", "[ast]") {
+  auto formulas = std::vector<Expr>{};
+  for (int i = 0; i < 10000; i++) {
+    const auto x = stl::Predicate("x") > i;
+    formulas.push_back(stl::Always(stl::Eventually(x, {0.0, 1.0}) | ~x, {0.0, 2.0}));
+  }
+  // Catch2 assertions aren't thread-safe, so the result is checked afterwards.
+  size_t num_args = 0;
+  auto other      = std::thread{[&num_args, moved = std::move(formulas)]() mutable {
+    const auto phi = stl::And(std::move(moved));
+    num_args       = std::get<stl::ast::AndPtr>(phi)->args.size();
+  }};
+  other.join();
+  REQUIRE(num_args == 10000);
+
+  // The nodes freed by the other thread are reused.
+  const auto phi = stl::Always(stl::Predicate("y") > 0);
+  REQUIRE(ExprEqual{}(phi, stl::Always(stl::Predicate("y") > 0)));
+}
@@ -0,0 +1,176 @@
+#include "signal_tl/batch.hpp"                // for run_batch, read_manifest, ...
+#include "signal_tl/internal/filesystem.hpp" // for temp_directory_path, remove_all
+#include "signal_tl/signal_tl.hpp"           // for Predicate, Always, Trace, ...
+
+#include "helpers.hpp" // for get_trace
+
+#include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo, StringRef
+
+#include <fstream>   // for ifstream, ofstream
+#include <map>       // for map
+#include <set>       // for set
+#include <stdexcept> // for invalid_argument
+#include <string>    // for string, getline, stod, to_string
+#include <vector>    // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+using helpers::get_trace;
+
+namespace {
+
+/// A temporary directory with `n` trace files, removed at the end of the test.
+struct TraceDir {
+  stdfs::path dir;
+  std::vector<stdfs::path> files;
+  std::vector<Trace> traces;
+
+  explicit TraceDir(size_t n) :
+      dir{stdfs::temp_directory_path() / "signal_tl_test_batch"} {
+    stdfs::remove_all(dir);
+    stdfs::create_directories(dir);
+    for (size_t i = 0; i < n; i++) {
+      traces.push_back(get_trace(100, 0.3 * static_cast<double>(i)));
+      files.push_back(dir / ("trace" + std::to_string(i) + ".stltrace"));
+      write_trace_file(files.back(), traces.back());
+    }
+  }
+  TraceDir(const TraceDir&)            = delete;
+  TraceDir& operator=(const TraceDir&) = delete;
+  ~TraceDir() {
+    stdfs::remove_all(dir);
+  }
+};
+
+std::vector<std::string> read_lines(const stdfs::path& path) {
+  auto in    = std::ifstream{path};
+  auto lines = std::vector<std::string>{};
+  auto line  = std::string{};
+  while (std::getline(in, line)) { lines.push_back(line); }
+  return lines;
+}
+
+std::vector<std::string> split(const std::string& row) {
+  auto out   = std::vector<std::string>{};
+  size_t pos = 0;
+  while (true) {
+    const auto end = row.find(',', pos);
+    out.push_back(row.substr(pos, end - pos));
+    if (end == std::string::npos) {
+      return out;
+    }
+    pos = end + 1;
+  }
+}
+
+} // namespace
+
+TEST_CASE("Trace manifests are read and sharded", "[batch]") {
+  const auto dir = TraceDir{0};
+  {
+    auto out = std::ofstream{dir.dir / "manifest.txt"};
+    out << "# The traces of the test\n"
+        << "a.stltrace\n"
+        << "\n"
+        << "  sub/b.stltrace  \r\n"
+        << "/abs/c.stltrace\n"
+        << "d.stltrace";
+  }
+  const auto traces = stl::read_manifest(dir.dir / "manifest.txt");
+  REQUIRE(
+      traces == std::vector<stdfs::path>{
+                    dir.dir / "a.stltrace",
+                    dir.dir / "sub/b.stltrace",
+                    "/abs/c.stltrace",
+                    dir.dir / "d.stltrace"});
+  REQUIRE_THROWS_AS(stl::read_manifest(dir.dir / "missing.txt"), std::runtime_error);
+
+  // Every trace is in exactly one of the shards.
+  auto all = std::vector<stdfs::path>{};
+  for (size_t i = 0; i < 3; i++) {
+    const auto shard = stl::select_shard(traces, {i, 3});
+    REQUIRE(shard.front() == traces[i]);
+    all.insert(all.end(), shard.begin(), shard.end());
+  }
+  REQUIRE(all.size() == traces.size());
+  REQUIRE(std::set<stdfs::path>(all.begin(), all.end()).size() == traces.size());
+  REQUIRE(stl::select_shard(traces, {}) == traces);
+  REQUIRE_THROWS_AS(stl::select_shard(traces, {3, 3}), std::invalid_argument);
+  REQUIRE_THROWS_AS(stl::select_shard(traces, {0, 0}), std::invalid_argument);
+}
+
+TEST_CASE("Batches of trace files are evaluated", "[batch]") {
+  const auto dir = TraceDir{6};
+  const auto x   = stl::Predicate("x");
+  const auto y   = stl::Predicate("y");
+  const auto formulas =
+      std::map<std::string, Expr>{{"always", stl::Always(x > -0.5, {0.0, 2.0})},
+                                  {"until", stl::Until(x > 0, y > 0.5)}};
+  const auto expected = stl::compute_robustness_batch(formulas, dir.traces);
+
+  // A trace without the signals of the formulas can't be evaluated.
+  auto traces = dir.files;
+  traces.push_back(dir.dir / "no_y.stltrace");
+  write_trace_file(traces.back(), Trace{{"x", dir.traces[0].at("x")}});
+
+  const auto output             = dir.dir / "results.csv";
+  auto options                  = stl::BatchOptions{};
+  options.evaluation.num_threads = 4;
+
+  const auto check_results = [&]() {
+    const auto lines = read_lines(output);
+    REQUIRE(lines.size() == traces.size() + 1);
+    REQUIRE(lines.front() == "trace,always,until,error");
+    auto seen = std::set<std::string>{};
+    for (size_t k = 1; k < lines.size(); k++) {
+      const auto fields = split(lines[k]);
+      REQUIRE(fields.size() == 4);
+      REQUIRE(seen.insert(fields[0]).second);
+      if (fields[0] == traces.back().string()) {
+        REQUIRE(fields[1].empty());
+        REQUIRE(!fields[3].empty());
+        continue;
+      }
+      size_t j = 0;
+      while (dir.files[j].string() != fields[0]) { j++; }
+      REQUIRE(std::stod(fields[1]) == Approx(expected.at(0, j)));
+      REQUIRE(std::stod(fields[2]) == Approx(expected.at(1, j)));
+      REQUIRE(fields[3].empty());
+    }
+  };
+
+  const auto summary = stl::run_batch(formulas, traces, output, options);
+  REQUIRE(summary.evaluated == dir.files.size());
+  REQUIRE(summary.failed == 1);
+  REQUIRE(summary.skipped == 0);
+  check_results();
+
+  SECTION("Interrupted batches are resumed") {
+    // Drop the last two rows, leaving part of one of them, as a killed run would.
+    auto lines = read_lines(output);
+    {
+      auto out = std::ofstream{output, std::ios::binary | std::ios::trunc};
+      for (size_t k = 0; k + 2 < lines.size(); k++) { out << lines[k] << '\n'; }
+      out << lines[lines.size() - 2].substr(0, 10);
+    }
+    options.resume     = true;
+    const auto resumed = stl::run_batch(formulas, traces, output, options);
+    REQUIRE(resumed.skipped == traces.size() - 2);
+    REQUIRE(resumed.evaluated + resumed.failed == 2);
+    check_results();
+
+    // Nothing is left to do.
+    const auto again = stl::run_batch(formulas, traces, output, options);
+    REQUIRE(again.skipped == traces.size());
+    check_results();
+  }
+
+  SECTION("Results of other formulas aren't resumed") {
+    options.resume = true;
+    auto other     = formulas;
+    other.erase("until");
+    REQUIRE_THROWS_AS(
+        stl::run_batch(other, traces, output, options), std::invalid_argument);
+  }
+}
@@ -0,0 +1,88 @@
+#include "signal_tl/signal_tl.hpp" // for Signal, Predicate, compute_robust...
+
+#include "buffer_pool.hpp" // for BufferPool, acquire_buffer, make_signal
+
+#include <catch2/catch.hpp> // for AssertionHandler, operator""_catch_sr
+
+#include <memory>  // for make_shared
+#include <utility> // for move
+#include <vector>  // for vector
+
+using namespace signal_tl::signal;
+
+TEST_CASE("Buffer pool reuses released buffers", "[signal][pool]") {
+  auto pool = std::make_shared<BufferPool>();
+
+  auto a           = pool->acquire(100);
+  const auto* data = a.data();
+  REQUIRE(a.empty());
+  REQUIRE(a.capacity() >= 100);
+  a.assign(100, 1.0);
+  pool->release(std::move(a));
+
+  // Too large for the released buffer.
+  auto b = pool->acquire(1000);
+  REQUIRE(b.capacity() >= 1000);
+  REQUIRE(pool->stats().reused == 0);
+
+  auto c = pool->acquire(50);
+  REQUIRE(c.empty());
+  REQUIRE(c.data() == data);
+  REQUIRE(pool->stats().reused == 1);
+  REQUIRE(pool->stats().acquired == 3);
+}
+
+TEST_CASE("Pooled signals return their columns to the pool", "[signal][pool]") {
+  auto pool = std::make_shared<BufferPool>();
+
+  auto sig = pool->make_signal({1.0, 3.0, 2.0}, {0.0, 1.0, 3.0});
+  REQUIRE(sig->size() == 3);
+  REQUIRE(sig->at_idx(0).derivative == Approx(2.0));
+  REQUIRE(sig->at_idx(1).derivative == Approx(-0.5));
+  REQUIRE(sig->at_idx(2).derivative == Approx(0.0));
+
+  REQUIRE(pool->stats().released == 0);
+  sig.reset();
+  REQUIRE(pool->stats().released == 3);
+
+  SECTION("Signals can outlive the pool") {
+    auto other = pool->make_signal({1.0, 2.0}, {0.0, 1.0});
+    pool.reset();
+    REQUIRE(other->back().value == 2.0);
+    REQUIRE_NOTHROW(other.reset());
+  }
+}
+
+TEST_CASE("Kernels use the pool of the current thread", "[signal][pool]") {
+  auto pool = std::make_shared<BufferPool>();
+  auto x    = std::make_shared<Signal>(
+      std::vector<double>{0.0, 1.0, 0.5}, std::vector<double>{0.0, 1.0, 2.0});
+
+  REQUIRE(BufferPool::current() == nullptr);
+  {
+    auto scope = BufferPool::Scope{pool.get()};
+    REQUIRE(BufferPool::current() == pool.get());
+
+    auto y = x->affine(-1.0, 1.0);
+    REQUIRE(y->size() == 3);
+    REQUIRE(y->at_idx(2).value == Approx(0.5));
+    REQUIRE(pool->stats().acquired == 3);
+    y.reset();
+
+    // The columns of `y` are reused.
+    auto z = x->affine(2.0, 0.0);
+    REQUIRE(pool->stats().reused == 3);
+    REQUIRE(z->at_idx(1).derivative == Approx(-1.0));
+
+    {
+      auto inner = BufferPool::Scope{nullptr};
+      REQUIRE(BufferPool::current() == nullptr);
+    }
+    REQUIRE(BufferPool::current() == pool.get());
+  }
+  REQUIRE(BufferPool::current() == nullptr);
+
+  // Without a pool, the signals are allocated as usual.
+  auto y = make_signal({1.0, 2.0}, {0.0, 1.0});
+  REQUIRE(y->front().derivative == Approx(1.0));
+}
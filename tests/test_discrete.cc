@@ -0,0 +1,216 @@
+#include "signal_tl/signal_tl.hpp" // for Predicate, Eventually, Always, Until, compu...
+
+#include "helpers.hpp" // for value_at
+
+#include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo, StringRef
+
+#include <algorithm> // for min, max
+#include <cmath>     // for sin, cos
+#include <cstddef>   // for size_t
+#include <limits>    // for numeric_limits
+#include <memory>    // for make_shared
+#include <stdexcept> // for invalid_argument, out_of_range
+#include <vector>    // for vector
+
+namespace stl = signal_tl;
+namespace discrete = signal_tl::discrete;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+using signal_tl::discrete::DiscreteTrace;
+using helpers::value_at;
+
+namespace {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+/// Two signals sampled every `period`, with many local optima.
+DiscreteTrace get_values(size_t n = 300) {
+  auto x = std::vector<double>{};
+  auto y = std::vector<double>{};
+  for (size_t i = 0; i < n; i++) {
+    const auto k = static_cast<double>(i);
+    x.push_back(std::sin(0.3 * k) + 0.5 * std::cos(1.7 * k));
+    y.push_back(std::cos(0.2 * k) - 0.4 * std::sin(2.3 * k));
+  }
+  return DiscreteTrace{{"x", x}, {"y", y}};
+}
+
+Trace to_trace(const DiscreteTrace& values, double period) {
+  auto trace = Trace{};
+  for (const auto& [name, xs] : values) {
+    auto ts = std::vector<double>{};
+    for (size_t i = 0; i < xs.size(); i++) {
+      ts.push_back(period * static_cast<double>(i));
+    }
+    trace.emplace(name, std::make_shared<Signal>(xs, ts));
+  }
+  return trace;
+}
+
+/// The optimum of `x` over the window `[i + a, i + b]` (clipped to the end) at each
+/// step, straight from the definition.
+std::vector<double>
+brute_windowed(const std::vector<double>& x, size_t a, size_t b, bool maximum) {
+  const size_t n = x.size();
+  auto out       = std::vector<double>(n);
+  for (size_t i = 0; i < n; i++) {
+    const size_t lo = std::min(i + a, n - 1);
+    const size_t hi = std::min(i + b, n - 1);
+    double opt      = x[lo];
+    for (size_t j = lo; j <= hi; j++) {
+      opt = (maximum) ? std::max(opt, x[j]) : std::min(opt, x[j]);
+    }
+    out[i] = opt;
+  }
+  return out;
+}
+
+std::vector<double> brute_until(
+    const std::vector<double>& x,
+    const std::vector<double>& y,
+    size_t a,
+    size_t b) {
+  const size_t n = x.size();
+  auto out       = std::vector<double>(n);
+  for (size_t i = 0; i < n; i++) {
+    const size_t lo = std::min(i + a, n - 1);
+    const size_t hi = std::min(i + b, n - 1);
+    double best     = -INF;
+    double x_min    = INF;
+    for (size_t j = i; j <= hi; j++) {
+      x_min = std::min(x_min, x[j]);
+      if (j >= lo) {
+        best = std::max(best, std::min(y[j], x_min));
+      }
+    }
+    out[i] = best;
+  }
+  return out;
+}
+
+} // namespace
+
+TEST_CASE("Discrete robustness matches the continuous robustness", "[discrete]") {
+  // If the windows start and end at samples, and their operands are linear between
+  // the samples, the optima over the windows are attained at the samples.
+  const double period = GENERATE(1.0, 0.1);
+  const auto x        = stl::Predicate("x") > 0.2;
+  const auto y        = stl::Predicate("y") <= 0.5;
+  const auto phi      = GENERATE_COPY(
+      Expr{x},
+      Expr{~y},
+      Expr{x & y},
+      Expr{stl::Eventually(x)},
+      Expr{stl::Eventually(x, {0.0, 1.0})},
+      Expr{stl::Always(y, {1.0, 2.0})},
+      Expr{stl::Always(x, {1.0, 3.0}) | y},
+      Expr{stl::Eventually(y, {2.0, INF})});
+  const auto values     = get_values();
+  const auto trace      = to_trace(values, period);
+  const auto rob        = discrete::compute_robustness(phi, values, period);
+  const auto continuous = stl::compute_robustness(phi, trace);
+  REQUIRE(rob.size() == values.at("x").size());
+  for (size_t i = 0; i < rob.size(); i++) {
+    const double t = period * static_cast<double>(i);
+    REQUIRE(rob[i] == Approx(value_at(*continuous, t)).margin(1e-9));
+  }
+
+  // The result over signals sampled uniformly is a signal at the same time points.
+  const auto sig = discrete::compute_robustness(phi, trace);
+  REQUIRE(sig->size() == rob.size());
+  for (size_t i = 0; i < rob.size(); i++) {
+    REQUIRE(sig->at_idx(i).time == trace.at("x")->at_idx(i).time);
+    REQUIRE(sig->at_idx(i).value == Approx(rob[i]).margin(1e-12));
+  }
+}
+
+TEST_CASE("Discrete temporal operators match their definitions", "[discrete]") {
+  const auto values = get_values();
+  const auto& xs    = values.at("x");
+  const auto& ys    = values.at("y");
+  const auto x      = stl::Predicate("x") >= 0;
+  const auto y      = stl::Predicate("y") >= 0;
+  const size_t n    = xs.size();
+
+  const auto [a, b] = GENERATE(
+      std::pair<size_t, size_t>{0, 0},
+      std::pair<size_t, size_t>{0, 4},
+      std::pair<size_t, size_t>{3, 3},
+      std::pair<size_t, size_t>{2, 17},
+      std::pair<size_t, size_t>{5, 1000});
+  const auto interval = stl::ast::Interval{
+      static_cast<unsigned long long>(a), static_cast<unsigned long long>(b)};
+
+  const auto f = discrete::compute_robustness(stl::Eventually(x, interval), values);
+  REQUIRE(f == brute_windowed(xs, a, b, true));
+  const auto g = discrete::compute_robustness(stl::Always(y, interval), values);
+  REQUIRE(g == brute_windowed(ys, a, b, false));
+  const auto u = discrete::compute_robustness(stl::Until(x, y, interval), values);
+  REQUIRE(u == brute_until(xs, ys, a, b));
+
+  // Unbounded operators.
+  const auto uu = discrete::compute_robustness(stl::Until(x, y), values);
+  REQUIRE(uu == brute_until(xs, ys, 0, n));
+  const auto fu = discrete::compute_robustness(stl::Eventually(x), values);
+  REQUIRE(fu == brute_windowed(xs, 0, n, true));
+
+  // Nested operators.
+  const auto phi = stl::Always(stl::Eventually(x, interval) | ~y, {1ULL, 6ULL});
+  auto inner     = brute_windowed(xs, a, b, true);
+  for (size_t i = 0; i < n; i++) { inner[i] = std::max(inner[i], -ys[i]); }
+  REQUIRE(
+      discrete::compute_robustness(phi, values) ==
+      brute_windowed(inner, 1, 6, false));
+}
+
+TEST_CASE("Windows of a single step shift the signal", "[discrete]") {
+  const auto values = get_values();
+  const auto trace  = to_trace(values, 0.1);
+  const auto& xs    = values.at("x");
+  const auto phi    = stl::Eventually(stl::Predicate("x") >= 0, {3ULL, 3ULL});
+
+  const auto rob = discrete::compute_robustness(phi, trace);
+  for (size_t i = 0; i + 3 < xs.size(); i++) {
+    REQUIRE(rob->at_idx(i).value == xs[i + 3]);
+  }
+  // Whereas the continuous-time operators return their operand for windows of zero
+  // width.
+  const auto continuous = stl::compute_robustness(phi, trace);
+  for (size_t i = 0; i < xs.size(); i++) {
+    REQUIRE(continuous->at_idx(i).value == xs[i]);
+  }
+}
+
+TEST_CASE("Intervals are converted to steps", "[discrete]") {
+  using discrete::to_steps;
+  using Steps = std::pair<size_t, size_t>;
+
+  REQUIRE(to_steps({2ULL, 5ULL}, 0.1) == Steps{2, 5});
+  REQUIRE(to_steps({0.0, 0.3}, 0.1) == Steps{0, 3});
+  REQUIRE(to_steps({0.25, 1.0}, 0.1) == Steps{3, 10});
+  REQUIRE(to_steps({0.7, 2.9}, 1.0) == Steps{1, 2});
+  REQUIRE(to_steps({}, 0.5) == Steps{0, stl::EvaluationPlan::npos});
+
+  REQUIRE_THROWS_AS(to_steps({0.2, 0.8}, 1.0), std::invalid_argument);
+  REQUIRE_THROWS_AS(to_steps({0.0, 1.0}, 0.0), std::invalid_argument);
+}
+
+TEST_CASE("Discrete robustness checks its inputs", "[discrete]") {
+  const auto phi = stl::Predicate("x") > 0 & stl::Eventually(stl::Predicate("y") > 0);
+
+  auto values = get_values();
+  REQUIRE_THROWS_AS(
+      discrete::compute_robustness(stl::Predicate("z") > 0, values),
+      std::out_of_range);
+  values.at("y").pop_back();
+  REQUIRE_THROWS_AS(discrete::compute_robustness(phi, values), std::invalid_argument);
+
+  // The signals must be sampled uniformly, at the same time points.
+  auto trace = to_trace(get_values(), 0.5);
+  trace.at("y")->push_back(1e3, 0.0);
+  trace.at("x")->push_back(1e3, 0.0);
+  REQUIRE_THROWS_AS(discrete::compute_robustness(phi, trace), std::invalid_argument);
+  trace = to_trace(get_values(), 0.5);
+  trace.at("y") = to_trace(get_values(), 0.25).at("y");
+  REQUIRE_THROWS_AS(discrete::compute_robustness(phi, trace), std::invalid_argument);
+}
@@ -0,0 +1,111 @@
+#include "signal_tl/signal_tl.hpp" // for compute_robustness_gradient, Predicate
+#include "signal_tl/fmt.hpp"       // IWYU pragma: keep
+
+#include "helpers.hpp" // for sample_signal
+
+#include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo
+
+#include <cmath>        // for abs, sin, cos
+#include <fmt/format.h> // for format
+#include <stdexcept>    // for invalid_argument, out_of_range
+#include <string>       // for string
+#include <vector>       // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+using helpers::sample_signal;
+
+namespace {
+
+/// Get the trace, with `dx` added to the sample at `index` of the signal `name`.
+Trace get_trace(double dx = 0.0, const std::string& name = "", size_t index = 0) {
+  // Irregular sampling.
+  auto ts = std::vector<double>{};
+  for (size_t i = 0; i < 200; i++) {
+    ts.push_back(0.1 * static_cast<double>(i) + 0.03 * std::sin(i));
+  }
+  const double at   = ts.at(index);
+  const auto nudged = [&](const std::string& channel, double v, double t) {
+    return (channel == name && t == at) ? v + dx : v;
+  };
+  const auto x = [&](double t) {
+    return nudged("x", std::sin(1.3 * t) + 0.1 * std::cos(7 * t), t);
+  };
+  const auto y = [&](double t) { return nudged("y", std::cos(0.7 * t), t); };
+  return Trace{{"x", sample_signal(x, ts)}, {"y", sample_signal(y, ts)}};
+}
+
+/// The derivative of the robustness at `t` with respect to a sample, with central
+/// differences.
+double finite_difference(const Expr& phi, double t, const std::string& name, size_t i) {
+  constexpr double h = 1e-6;
+  const double hi    = stl::compute_robustness_at(phi, get_trace(h, name, i), t);
+  const double lo    = stl::compute_robustness_at(phi, get_trace(-h, name, i), t);
+  return (hi - lo) / (2 * h);
+}
+
+} // namespace
+
+TEST_CASE("Gradients of the robustness match finite differences", "[gradient]") {
+  const auto x     = stl::Predicate("x") > 0.2;
+  const auto y     = stl::Predicate("y") <= 0.5;
+  const auto phi   = GENERATE_COPY(
+      Expr{x},
+      Expr{~y},
+      Expr{x & y},
+      Expr{stl::Eventually(x, {0.0, 1.0})},
+      Expr{stl::Always(x | y, {0.5, 2.0})},
+      Expr{stl::Always(stl::Eventually(x, {0.0, 0.7}), {0.0, 3.0})},
+      Expr{stl::Eventually(y) & stl::Always(~x, {0.0, 1.5})},
+      Expr{stl::Until(x, y, {0.0, 4.0})});
+  const auto trace = get_trace();
+  const double t   = GENERATE(0.0, 0.55, 4.37);
+
+  const auto grad = stl::compute_robustness_gradient(phi, trace, t);
+  INFO(fmt::format("{} at {}", phi, t));
+  REQUIRE(grad.time == t);
+  REQUIRE(grad.value == Approx(stl::compute_robustness_at(phi, trace, t)));
+  REQUIRE(!grad.gradient.empty());
+  REQUIRE(grad.gradient.size() <= 4);
+
+  double total = 0.0;
+  for (const auto& entry : grad.gradient) {
+    const double expected = finite_difference(phi, t, entry.signal, entry.index);
+    REQUIRE(entry.derivative == Approx(expected).margin(1e-4));
+    total += std::abs(entry.derivative);
+  }
+  // The robustness is the (interpolated) value of a single predicate or, where a
+  // temporal operator is optimal at a kink, a combination of two of them.
+  REQUIRE(total == Approx(1.0));
+
+  // The other samples around the time point don't affect the robustness.
+  for (const auto name : {"x", "y"}) {
+    for (size_t i = 0; i < 60; i += 3) {
+      bool nonzero = false;
+      for (const auto& entry : grad.gradient) {
+        nonzero = nonzero || (entry.signal == name && entry.index == i);
+      }
+      if (!nonzero) {
+        REQUIRE(finite_difference(phi, t, name, i) == Approx(0.0).margin(1e-6));
+      }
+    }
+  }
+}
+
+TEST_CASE("Gradients are computed at the start by default", "[gradient]") {
+  const auto phi   = stl::Always(stl::Predicate("x") > 0, {0.0, 1.0});
+  const auto trace = get_trace();
+
+  const auto grad = stl::compute_robustness_gradient(phi, trace);
+  REQUIRE(grad.time == 0.0);
+  REQUIRE(grad.value == Approx(stl::compute_robustness(phi, trace)->front().value));
+
+  REQUIRE_THROWS_AS(
+      stl::compute_robustness_gradient(phi, trace, 100.0), std::out_of_range);
+  auto options      = stl::EvaluationOptions{};
+  options.semantics = stl::Semantics::Filtering;
+  REQUIRE_THROWS_AS(
+      stl::compute_robustness_gradient(phi, trace, 0.0, options),
+      std::invalid_argument);
+}
@@ -0,0 +1,87 @@
+#include "kernels.hpp" // for affine, elementwise_min, elementwise_max
+
+#include <catch2/catch.hpp> // for AssertionHandler, operator""_catch_sr
+
+#include <cmath>   // for isnan
+#include <cstdint> // for uint8_t
+#include <limits>  // for numeric_limits
+#include <random>  // for default_random_engine, uniform_real_distribution
+#include <vector>  // for vector
+
+namespace kernels = signal_tl::kernels;
+
+namespace {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+/// Random values, with some ties, infinities and NaNs thrown in.
+std::vector<double> get_values(size_t n, unsigned seed) {
+  auto rng  = std::default_random_engine{seed};
+  auto dist = std::uniform_real_distribution<>{-1.0, 1.0};
+  auto out  = std::vector<double>(n);
+  for (size_t i = 0; i < n; i++) {
+    switch (i % 11) {
+      case 3:
+        out[i] = INF;
+        break;
+      case 5:
+        out[i] = -INF;
+        break;
+      case 7:
+        out[i] = NaN;
+        break;
+      case 9:
+        out[i] = 0.5;
+        break;
+      default:
+        out[i] = dist(rng);
+    }
+  }
+  return out;
+}
+
+bool same(double a, double b) {
+  return (std::isnan(a) && std::isnan(b)) || a == b;
+}
+
+} // namespace
+
+TEST_CASE("Vectorized kernels match the scalar kernels", "[kernels]") {
+  INFO("Using " << kernels::simd_level_name(kernels::simd_level()));
+  // Sizes that are not multiples of the vector widths exercise the tails.
+  const size_t n = GENERATE(0, 1, 3, 7, 8, 17, 1000);
+  const auto x   = get_values(n, 1);
+  const auto y   = get_values(n, 2);
+
+  SECTION("affine") {
+    auto expected = std::vector<double>(n);
+    auto actual   = std::vector<double>(n);
+    kernels::scalar::affine(x.data(), expected.data(), n, -1.5, 0.25);
+    kernels::affine(x.data(), actual.data(), n, -1.5, 0.25);
+    for (size_t i = 0; i < n; i++) { REQUIRE(same(actual[i], expected[i])); }
+  }
+
+  SECTION("elementwise min/max") {
+    auto expected   = std::vector<double>(n);
+    auto actual     = std::vector<double>(n);
+    auto expected_y = std::vector<std::uint8_t>(n);
+    auto actual_y   = std::vector<std::uint8_t>(n);
+
+    kernels::scalar::elementwise_min(
+        x.data(), y.data(), expected.data(), expected_y.data(), n);
+    kernels::elementwise_min(x.data(), y.data(), actual.data(), actual_y.data(), n);
+    for (size_t i = 0; i < n; i++) {
+      REQUIRE(same(actual[i], expected[i]));
+      REQUIRE(actual_y[i] == expected_y[i]);
+    }
+
+    kernels::scalar::elementwise_max(
+        x.data(), y.data(), expected.data(), expected_y.data(), n);
+    kernels::elementwise_max(x.data(), y.data(), actual.data(), actual_y.data(), n);
+    for (size_t i = 0; i < n; i++) {
+      REQUIRE(same(actual[i], expected[i]));
+      REQUIRE(actual_y[i] == expected_y[i]);
+    }
+  }
+}
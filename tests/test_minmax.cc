@@ -0,0 +1,276 @@
+#include "signal_tl/signal_tl.hpp" // for Signal, SignalPtr
+
+#include "helpers.hpp" // for value_at
+#include "minmax.hpp"  // for compute_min_seq, compute_max_seq
+
+#include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo
+
+#include <algorithm> // for max, min
+#include <cmath>     // for sin, isnan
+#include <iterator>  // for next
+#include <limits>    // for numeric_limits
+#include <map>       // for map
+#include <memory>    // for make_shared
+#include <string>    // for string, to_string
+#include <utility>   // for make_pair, move
+#include <vector>    // for vector
+
+using namespace signal_tl::signal;
+namespace minmax = signal_tl::minmax;
+using helpers::value_at;
+
+namespace {
+
+constexpr double TOP = std::numeric_limits<double>::infinity();
+
+SignalPtr get_signal(size_t n) {
+  auto sig = std::make_shared<Signal>();
+  double t = 0;
+  for (size_t i = 0; i < n; i++) {
+    sig->push_back(t, std::sin(t) + std::sin(3.7 * t));
+    // Irregular sampling.
+    t += (i % 3 == 0) ? 0.05 : 0.2;
+  }
+  return sig;
+}
+
+/// Brute force computation of the min (or max) of `x` over [t + a, t + b].
+template <bool IsMin>
+double window_opt(const Signal& x, double t, double a, double b) {
+  const double lo = std::min(t + a, x.end_time());
+  const double hi = std::min(t + b, x.end_time());
+
+  double opt       = value_at(x, lo);
+  const auto merge = [&](double v) {
+    opt = IsMin ? std::min(opt, v) : std::max(opt, v);
+  };
+  merge(value_at(x, hi));
+  for (const auto& s : x) {
+    if (lo <= s.time && s.time <= hi) {
+      merge(s.value);
+    }
+  }
+  return opt;
+}
+
+} // namespace
+
+TEST_CASE("Windowed min/max matches brute force", "[robustness][minmax]") {
+  const auto x = get_signal(200);
+
+  const auto [a, b] = GENERATE(
+      std::make_pair(0.0, 0.01),
+      std::make_pair(0.0, 0.5),
+      std::make_pair(0.0, 3.0),
+      std::make_pair(0.1, 0.15),
+      std::make_pair(1.0, 2.5),
+      std::make_pair(10.0, 1000.0));
+
+  const auto min = minmax::compute_min_seq(x, a, b);
+  const auto max = minmax::compute_max_seq(x, a, b);
+  REQUIRE(min->begin_time() == x->begin_time());
+  REQUIRE(min->end_time() == x->end_time());
+
+  for (const auto& s : *x) {
+    INFO("Interval [" << a << ", " << b << "] at t = " << s.time);
+    REQUIRE(value_at(*min, s.time) == Approx(window_opt<true>(*x, s.time, a, b)));
+    REQUIRE(value_at(*max, s.time) == Approx(window_opt<false>(*x, s.time, a, b)));
+  }
+}
+
+TEST_CASE("Windowed min/max is exact between the samples", "[robustness][minmax]") {
+  const auto x = get_signal(200);
+
+  const auto [a, b] = GENERATE(
+      std::make_pair(0.0, 0.01),
+      std::make_pair(0.0, 0.5),
+      std::make_pair(0.1, 0.15),
+      std::make_pair(1.0, 2.5));
+
+  // The result is piecewise-linear between its own breakpoints, so it matches the
+  // optimum over the window at any time point, and the same holds for a signal
+  // resampled on a finer grid (which has the same values between the samples).
+  const auto min = minmax::compute_min_seq(x, a, b);
+  const auto max = minmax::compute_max_seq(x, a, b);
+  auto fine      = std::make_shared<Signal>();
+  for (auto it = x->begin(); std::next(it) != x->end(); it++) {
+    const double dt = (std::next(it)->time - it->time) / 10;
+    for (int k = 0; k < 10; k++) {
+      fine->push_back(it->time + k * dt, it->interpolate(it->time + k * dt));
+    }
+  }
+  fine->push_back(x->back());
+  const auto fine_min = minmax::compute_min_seq(fine, a, b);
+
+  for (double t = 0; t <= fine->end_time(); t += 3e-3) {
+    INFO("Interval [" << a << ", " << b << "] at t = " << t);
+    REQUIRE(value_at(*min, t) == Approx(window_opt<true>(*x, t, a, b)).margin(1e-12));
+    REQUIRE(value_at(*max, t) == Approx(window_opt<false>(*x, t, a, b)).margin(1e-12));
+    REQUIRE(value_at(*fine_min, t) == Approx(value_at(*min, t)).margin(1e-9));
+  }
+  REQUIRE(min->size() < fine_min->size());
+}
+
+TEST_CASE("Unbounded min/max is exact between the samples", "[robustness][minmax]") {
+  const auto x   = get_signal(200);
+  const auto min = minmax::compute_min_seq(x);
+  const auto max = minmax::compute_max_seq(x);
+
+  for (double t = 0; t <= x->end_time(); t += 3e-3) {
+    INFO("At t = " << t);
+    REQUIRE(value_at(*min, t) == Approx(window_opt<true>(*x, t, 0, TOP)).margin(1e-12));
+    REQUIRE(value_at(*max, t) == Approx(window_opt<false>(*x, t, 0, TOP)).margin(1e-12));
+  }
+}
+
+TEST_CASE("N-ary min/max matches the pointwise envelope", "[robustness][minmax]") {
+  auto xs = std::vector<SignalPtr>{};
+  for (size_t j = 0; j < 9; j++) {
+    auto x          = std::make_shared<Signal>();
+    const double dt = 0.05 * static_cast<double>(j + 1);
+    for (size_t i = 0; i * dt < 10 + 0.1 * static_cast<double>(j); i++) {
+      const double t = dt * static_cast<double>(i);
+      x->push_back(t, std::sin((1 + 0.3 * static_cast<double>(j)) * t + j));
+    }
+    xs.push_back(x);
+  }
+  // All the signals are constant in the middle, so they are all tied there.
+  for (auto& x : xs) {
+    auto times  = std::vector<double>{x->times().begin(), x->times().end()};
+    auto values = std::vector<double>{x->values().begin(), x->values().end()};
+    for (size_t i = 0; i < times.size(); i++) {
+      if (4 <= times[i] && times[i] <= 5) {
+        values[i] = 0.5;
+      }
+    }
+    x = std::make_shared<Signal>(std::move(values), std::move(times));
+  }
+
+  const auto num  = GENERATE(3, 4, 9);
+  const auto args = std::vector<SignalPtr>{xs.begin(), std::next(xs.begin(), num)};
+
+  auto pool       = signal_tl::ThreadPool{3};
+  const auto min  = minmax::compute_elementwise_min(args);
+  const auto max  = minmax::compute_elementwise_max(args);
+  const auto pmin = minmax::compute_elementwise_min(args, pool);
+
+  REQUIRE(min->begin_time() == 0);
+  REQUIRE(min->end_time() == Approx(args.front()->end_time()));
+
+  auto points = std::vector<double>{min->times().begin(), min->times().end()};
+  points.insert(points.end(), max->times().begin(), max->times().end());
+  for (double t = 0; t < min->end_time(); t += 1e-2) { points.push_back(t); }
+
+  for (const double t : points) {
+    double lo = TOP;
+    double hi = -TOP;
+    for (const auto& x : args) {
+      lo = std::min(lo, value_at(*x, t));
+      hi = std::max(hi, value_at(*x, t));
+    }
+    INFO("Envelope of " << num << " signals at t = " << t);
+    REQUIRE(value_at(*min, t) == Approx(lo).margin(1e-9));
+    REQUIRE(value_at(*max, t) == Approx(hi).margin(1e-9));
+    REQUIRE(value_at(*pmin, t) == Approx(lo).margin(1e-9));
+  }
+}
+
+TEST_CASE("N-ary min/max has no crossings at the breakpoints", "[robustness][minmax]") {
+  // `a` and `b` cross exactly at the sample at t = 1.
+  const auto times = std::vector{0.0, 1.0, 2.0};
+  const auto trace = Trace{
+      {"a", std::make_shared<Signal>(std::vector{0.0, 2.0, 2.0}, times)},
+      {"b", std::make_shared<Signal>(std::vector{1.0, 2.0, 3.0}, times)},
+      {"c", std::make_shared<Signal>(std::vector{-5.0, -5.0, -5.0}, times)}};
+  const auto a   = signal_tl::Predicate("a") > 0;
+  const auto b   = signal_tl::Predicate("b") > 0;
+  const auto c   = signal_tl::Predicate("c") > 0;
+  const auto phi = GENERATE_COPY(
+      signal_tl::ast::Expr{signal_tl::Or({a, b, c})},
+      signal_tl::ast::Expr{(a | b) | c});
+
+  const auto rob = signal_tl::compute_robustness(phi, trace);
+  REQUIRE(rob->size() == 3);
+  for (size_t i = 0; i < rob->size(); i++) {
+    REQUIRE(rob->at_idx(i).time == times[i]);
+  }
+  REQUIRE(rob->at_idx(0).value == 1.0);
+  REQUIRE(rob->at_idx(1).value == 2.0);
+  REQUIRE(rob->at_idx(2).value == 3.0);
+}
+
+TEST_CASE("N-ary min/max keeps infinite values", "[robustness][minmax]") {
+  // The segments towards (and from) the infinite values have infinite slopes.
+  const auto x = std::make_shared<Signal>(
+      std::vector{0.0, 1.0, TOP, TOP, 2.0}, std::vector{0.0, 1.0, 2.0, 3.0, 4.0});
+  const auto y = std::make_shared<Signal>(
+      std::vector{3.0, -TOP, 0.5}, std::vector{0.0, 1.5, 4.0});
+  const auto z = std::make_shared<Signal>(
+      std::vector{2.0, 2.0, 2.0}, std::vector{0.0, 1.0, 4.0});
+
+  const auto min = minmax::compute_elementwise_min({x, y, z});
+  const auto max = minmax::compute_elementwise_max({x, y, z});
+  for (const auto& s : *min) { REQUIRE_FALSE(std::isnan(s.value)); }
+  for (const auto& s : *max) { REQUIRE_FALSE(std::isnan(s.value)); }
+  // At the samples, as the segments with infinite slopes are steps.
+  for (const double t : {0.0, 1.0, 1.5, 2.0, 3.0, 4.0}) {
+    INFO("At t = " << t);
+    const double u = value_at(*x, t);
+    const double v = value_at(*y, t);
+    const double w = value_at(*z, t);
+    REQUIRE(value_at(*min, t) == std::min({u, v, w}));
+    REQUIRE(value_at(*max, t) == std::max({u, v, w}));
+  }
+}
+
+TEST_CASE("Min/max over a shared time base matches the envelope", "[minmax]") {
+  auto times    = std::vector<double>{};
+  auto channels = std::map<std::string, std::vector<double>>{};
+  for (size_t i = 0; i < 200; i++) { times.push_back(0.05 * static_cast<double>(i)); }
+  for (size_t j = 0; j < 5; j++) {
+    auto& values = channels["x" + std::to_string(j)];
+    for (const double t : times) {
+      values.push_back(std::sin((1 + 0.4 * static_cast<double>(j)) * t + j));
+    }
+  }
+  const auto trace = make_trace(std::move(times), std::move(channels));
+
+  const auto num = GENERATE(2, 5);
+  auto args      = std::vector<SignalPtr>{};
+  for (const auto& [name, x] : trace) { args.push_back(x); }
+  args.resize(num);
+
+  const auto min = minmax::compute_elementwise_min(args);
+  const auto max = minmax::compute_elementwise_max(args);
+  REQUIRE(min->begin_time() == 0);
+  REQUIRE(min->end_time() == Approx(args.front()->end_time()));
+
+  auto points = std::vector<double>{min->times().begin(), min->times().end()};
+  points.insert(points.end(), max->times().begin(), max->times().end());
+  for (double t = 0; t < min->end_time(); t += 1e-2) { points.push_back(t); }
+  for (const double t : points) {
+    double lo = TOP;
+    double hi = -TOP;
+    for (const auto& x : args) {
+      lo = std::min(lo, value_at(*x, t));
+      hi = std::max(hi, value_at(*x, t));
+    }
+    INFO("Envelope of " << num << " signals at t = " << t);
+    REQUIRE(value_at(*min, t) == Approx(lo).margin(1e-9));
+    REQUIRE(value_at(*max, t) == Approx(hi).margin(1e-9));
+  }
+
+  SECTION("Outputs without intersections share the time base") {
+    const auto& x   = args.front();
+    const auto y    = x->affine(1.0, 1.0);
+    const auto z    = x->affine(1.0, 2.0);
+    const auto mins = {
+        minmax::compute_elementwise_min(x, y),
+        minmax::compute_elementwise_min({x, y, z}),
+    };
+    for (const auto& out : mins) {
+      REQUIRE(out->times().data() == x->times().data());
+      REQUIRE(out->values()[3] == x->values()[3]);
+    }
+  }
+}
@@ -0,0 +1,376 @@
+#include "signal_tl/signal_tl.hpp" // for Signal, Predicate, compute_robust...
+
+#include "helpers.hpp" // for require_same, value_at
+
+#include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo
+
+#include <algorithm> // for max, min
+#include <chrono>    // for seconds
+#include <cmath>     // for sin, cos
+#include <future>    // for future, future_status
+#include <limits>    // for numeric_limits
+#include <map>       // for map
+#include <memory>    // for make_shared, shared_ptr
+#include <random>    // for mt19937, uniform_int_distribution
+#include <stdexcept> // for invalid_argument, logic_error, out_of_range
+#include <string>    // for string
+#include <utility>   // for pair
+#include <vector>    // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+using helpers::require_same;
+using helpers::value_at;
+
+namespace {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+SignalPtr make_signal(double (*f)(double), double dt, size_t n, double t0 = 0.0) {
+  auto sig = std::make_shared<Signal>();
+  for (size_t i = 0; i < n; i++) {
+    const double t = t0 + dt * static_cast<double>(i);
+    sig->push_back(t, f(t));
+  }
+  return sig;
+}
+
+double slow_sin(double t) {
+  return std::sin(t / 2);
+}
+
+double fast_cos(double t) {
+  return std::cos(3 * t) / 2;
+}
+
+/// Run the monitor over the trace, feeding the signals in order of their timestamps.
+std::vector<Sample> run_monitor(const Expr& phi, const Trace& trace) {
+  auto monitor = stl::OnlineMonitor{phi};
+  auto cursors = std::map<std::string, size_t>{};
+  for (const auto& [name, sig] : trace) { cursors[name] = 0; }
+
+  auto out = std::vector<Sample>{};
+  while (true) {
+    const std::string* next = nullptr;
+    double next_time        = 0.0;
+    for (const auto& [name, i] : cursors) {
+      const auto& sig = trace.at(name);
+      if (i == sig->size()) {
+        continue;
+      }
+      if (next == nullptr || sig->at_idx(i).time < next_time) {
+        next      = &name;
+        next_time = sig->at_idx(i).time;
+      }
+    }
+    if (next == nullptr) {
+      break;
+    }
+    auto& i = cursors.at(*next);
+    monitor.push_back(*next, trace.at(*next)->at_idx(i));
+    i++;
+    for (const auto& s : monitor.poll()) { out.push_back(s); }
+  }
+  monitor.finish();
+  for (const auto& s : monitor.poll()) { out.push_back(s); }
+  return out;
+}
+
+/// Brute force computation of the windowed minimum of `x` in `[t + a, t + b]`.
+double window_min(const Signal& x, double t, double a, double b) {
+  const double lo = t + a;
+  const double hi = std::min(t + b, x.end_time());
+  double opt      = std::min(value_at(x, lo), value_at(x, hi));
+  for (auto i = x.begin_at(lo); i != x.end() && i->time <= hi; i++) {
+    opt = std::min(opt, i->value);
+  }
+  return opt;
+}
+
+} // namespace
+
+TEST_CASE("Online monitor matches offline robustness", "[robustness][online]") {
+  const auto trace = Trace{
+      {"x", make_signal(slow_sin, 0.5, 100)},
+      {"y", make_signal(fast_cos, 0.3, 150)},
+      {"z", make_signal(fast_cos, 0.5, 100)}};
+
+  auto phi = GENERATE(
+      Expr{stl::Predicate("x") > 0.1},
+      Expr{~(stl::Predicate("x") > 0.1)},
+      Expr{(stl::Predicate("x") > 0) & (stl::Predicate("z") < 0.25)},
+      Expr{(stl::Predicate("x") > 0) | (stl::Predicate("y") < 0.25)},
+      stl::And(
+          {stl::Predicate("x") > 0, stl::Predicate("z") < 0.25, ~stl::Const(false)}),
+      stl::Always(stl::Predicate("x") > 0),
+      stl::Eventually(stl::Predicate("x") > 0 | (stl::Predicate("z") < 0)),
+      stl::Until(
+          stl::Predicate("x") > -0.5,
+          stl::Predicate("z") > 0.25,
+          stl::ast::Interval{0.5, 2.0}));
+
+  const auto expected = stl::compute_robustness(phi, trace);
+  const auto actual   = run_monitor(phi, trace);
+
+  REQUIRE(actual.size() == expected->size());
+  for (size_t i = 0; i < actual.size(); i++) {
+    INFO("Sample index " << i);
+    REQUIRE(actual[i].time == Approx(expected->at_idx(i).time));
+    REQUIRE(actual[i].value == Approx(expected->at_idx(i).value));
+  }
+}
+
+TEST_CASE("Online monitor computes bounded windows", "[robustness][online]") {
+  const auto x     = make_signal(slow_sin, 0.25, 200);
+  const auto trace = Trace{{"x", x}};
+
+  const double a = GENERATE(0.0, 0.3, 2.0);
+  const double b = GENERATE(0.5, 3.0, 7.1);
+  if (b <= a) {
+    return;
+  }
+
+  SECTION("Always") {
+    const auto phi = stl::Always(stl::Predicate("x") > 0, stl::ast::Interval{a, b});
+    const auto out = run_monitor(phi, trace);
+    REQUIRE_FALSE(out.empty());
+    REQUIRE(out.front().time == Approx(x->begin_time()));
+    for (const auto& s : out) {
+      INFO("Sample at t = " << s.time);
+      REQUIRE(s.value == Approx(window_min(*x, s.time, a, b)));
+    }
+  }
+
+  SECTION("Eventually") {
+    const auto phi = stl::Eventually(stl::Predicate("x") < 0, stl::ast::Interval{a, b});
+    const auto out = run_monitor(phi, trace);
+    REQUIRE_FALSE(out.empty());
+    for (const auto& s : out) {
+      INFO("Sample at t = " << s.time);
+      REQUIRE(s.value == Approx(-window_min(*x, s.time, a, b)));
+    }
+  }
+}
+
+TEST_CASE("Online monitor has the breakpoints of the offline robustness", "[online]") {
+  const auto trace = Trace{
+      {"x", make_signal(slow_sin, 0.25, 200)},
+      {"y", make_signal(fast_cos, 0.3, 150, 0.1)}};
+  const auto x = stl::Predicate("x") > 0;
+  const auto y = stl::Predicate("y") < 0.25;
+
+  const auto phi = GENERATE_COPY(
+      Expr{stl::Always(x, stl::ast::Interval{0.3, 3.0})},
+      Expr{stl::Eventually(x | y, stl::ast::Interval{0.0, 0.7})},
+      Expr{stl::Eventually(y, stl::ast::Interval{2.0, 7.1})},
+      Expr{stl::Always(x, stl::ast::Interval{2.0, INF})},
+      Expr{stl::Until(x, y, stl::ast::Interval{0.0, 1.3})},
+      Expr{stl::Until(x, y, stl::ast::Interval{0.5, INF})});
+
+  auto actual = std::make_shared<Signal>();
+  for (const auto& s : run_monitor(phi, trace)) { actual->push_back(s); }
+  require_same(actual, stl::compute_robustness(phi, trace));
+}
+
+TEST_CASE("Online monitor settles values incrementally", "[robustness][online]") {
+  const auto phi = stl::Always(stl::Predicate("x") > 0, stl::ast::Interval{0.0, 1.0});
+  auto monitor   = stl::OnlineMonitor{phi};
+
+  for (int i = 0; i < 100; i++) {
+    const double t = 0.1 * i;
+    monitor.push_back("x", t, slow_sin(t));
+    // Everything before t - 1 must be settled, and nothing after it.
+    REQUIRE(monitor.settled_until() <= t - 1.0 + 1e-9);
+    if (t >= 1.1) {
+      REQUIRE(monitor.settled_until() >= t - 1.1 - 1e-9);
+    }
+  }
+
+  REQUIRE_THROWS(monitor.push_back("x", 5.0, 0.0));
+  REQUIRE_NOTHROW(monitor.push_back("unused", 5.0, 0.0));
+
+  monitor.finish();
+  REQUIRE(monitor.finished());
+  REQUIRE(monitor.settled_until() == Approx(9.9));
+  REQUIRE_THROWS(monitor.push_back("x", 10.0, 0.0));
+
+  // The same goes for bounded Until.
+  const auto psi = stl::Until(
+      stl::Predicate("x") > -0.5,
+      stl::Predicate("y") > 0,
+      stl::ast::Interval{0.5, 2.0});
+  auto until = stl::OnlineMonitor{psi};
+  for (int i = 0; i < 100; i++) {
+    const double t = 0.1 * i;
+    until.push_back("x", t, slow_sin(t));
+    until.push_back("y", t, fast_cos(t));
+    REQUIRE(until.settled_until() <= t - 2.0 + 1e-9);
+    if (t >= 2.1) {
+      REQUIRE(until.settled_until() >= t - 2.1 - 1e-9);
+    }
+  }
+}
+
+TEST_CASE("Monitor groups route channels to formulas", "[robustness][online]") {
+  const auto trace = Trace{
+      {"x", make_signal(slow_sin, 0.5, 100)},
+      {"y", make_signal(fast_cos, 0.3, 150, 0.1)},
+      {"z", make_signal(fast_cos, 0.5, 100)}};
+  const auto formulas = std::map<std::string, Expr>{
+      {"bounded",
+       stl::Always(
+           (stl::Predicate("x") > 0) | (stl::Predicate("y") < 0.25),
+           stl::ast::Interval{0.0, 1.5})},
+      {"predicate", stl::Predicate("z") < 0.25},
+      {"unbounded", stl::Eventually(stl::Predicate("x") > 0.9)}};
+
+  auto group    = stl::MonitorGroup{};
+  auto received = std::map<std::string, std::vector<Sample>>{};
+  for (const auto& [name, phi] : formulas) {
+    group.add(name, phi, [&received](const std::string& formula, const auto& samples) {
+      auto& out = received[formula];
+      out.insert(out.end(), samples.begin(), samples.end());
+    });
+  }
+  REQUIRE_THROWS_AS(group.add("predicate", stl::Const(true)), std::invalid_argument);
+
+  // Feed the channels one after the other, in chunks, as if they arrived from
+  // different streams.
+  auto requests = std::vector<std::pair<double, std::future<Sample>>>{};
+  for (size_t i = 0; i < 150; i += 10) {
+    for (const auto& [name, x] : trace) {
+      for (size_t k = i; k < std::min(i + 10, x->size()); k++) {
+        const auto s = x->at_idx(k);
+        group.push_back(name, s.time, s.value);
+      }
+    }
+    if (i == 50) {
+      requests.emplace_back(30.2, group.settled_sample("bounded", 30.2));
+      requests.emplace_back(40.0, group.settled_sample("bounded", 40.0));
+    }
+  }
+  group.push_back("unused", 0.0, 0.0);
+  REQUIRE(group.settled_until("predicate") == Approx(49.5));
+
+  // The unbounded formula is only settled at the end, and the robustness ends with
+  // the shortest channel.
+  REQUIRE(received.count("unbounded") == 0);
+  auto unbounded = group.settled_sample("unbounded", 10.0);
+  auto after_end = group.settled_sample("bounded", 45.0);
+  group.finish();
+  REQUIRE(group.finished());
+  REQUIRE(unbounded.get().time == Approx(10.0));
+  REQUIRE_THROWS_AS(after_end.get(), std::out_of_range);
+  REQUIRE_THROWS_AS(group.push_back("x", 100.0, 0.0), std::logic_error);
+
+  for (const auto& [name, phi] : formulas) {
+    const auto expected = stl::compute_robustness(phi, trace);
+    const auto& actual  = received.at(name);
+    INFO(name);
+    REQUIRE(actual.front().time == Approx(expected->begin_time()));
+    REQUIRE(actual.back().time == Approx(expected->end_time()));
+    for (const auto& s : actual) {
+      REQUIRE(s.value == Approx(value_at(*expected, s.time)).margin(1e-9));
+    }
+  }
+  const auto bounded = stl::compute_robustness(formulas.at("bounded"), trace);
+  for (auto& [t, request] : requests) {
+    const auto s = request.get();
+    REQUIRE(s.time >= t);
+    REQUIRE(s.time < t + 0.3);
+    REQUIRE(s.value == Approx(value_at(*bounded, s.time)).margin(1e-9));
+  }
+  REQUIRE_THROWS_AS(group.settled_sample("bounded", 0.0), std::invalid_argument);
+  REQUIRE_THROWS_AS(group.settled_sample("missing", 0.0), std::out_of_range);
+}
+
+TEST_CASE("Monitor groups hold quiet channels", "[robustness][online]") {
+  const auto x   = stl::Predicate("x");
+  const auto y   = stl::Predicate("y");
+  auto group     = stl::MonitorGroup{};
+  const auto phi = stl::Always((x > 0) & (y > 0), stl::ast::Interval{0.0, 1.0});
+  group.add("phi", phi);
+
+  // `y` is only sent when it changes, so it holds back the robustness.
+  group.push_back("y", 0.0, 1.0);
+  for (int i = 0; i < 50; i++) {
+    group.push_back("x", 0.1 * i, 1.0 + slow_sin(0.1 * i));
+  }
+  REQUIRE(group.settled_until("phi") <= 0.0);
+  auto request = group.settled_sample("phi", 2.0);
+  REQUIRE(request.wait_for(std::chrono::seconds{0}) != std::future_status::ready);
+
+  // Once it is known to be unchanged, the robustness is settled up to the horizon.
+  group.advance_to(4.9);
+  REQUIRE(group.settled_until("phi") >= 3.9 - 1e-9);
+  REQUIRE(request.wait_for(std::chrono::seconds{0}) == std::future_status::ready);
+  const auto s = request.get();
+  REQUIRE(s.time == Approx(2.0));
+  REQUIRE(s.value == Approx(1.0));
+
+  // Held channels can only be appended to after the time they were held to.
+  REQUIRE_THROWS_AS(group.push_back("y", 4.0, 2.0), std::invalid_argument);
+  group.hold("y", 2.0);
+  group.hold("y", 6.0);
+  REQUIRE_NOTHROW(group.push_back("y", 6.5, 2.0));
+}
+
+TEST_CASE("Online monitor clips windows at the end of the trace", "[online]") {
+  auto x = std::make_shared<Signal>();
+  double a = 0.0;
+  double b = 0.0;
+
+  SECTION("Crossings tied with the last sample") {
+    // Right before the end, the lower end of the window crosses the last sample,
+    // which is both inside the window and at its (clipped) upper end.
+    const auto samples = std::vector<std::pair<double, double>>{
+        {0.0, -0.5},
+        {0.5, 0.0},
+        {1.25, 1.5},
+        {2.75, 0.5},
+        {4.25, -2.5},
+        {4.75, -0.75},
+        {5.5, 1.75},
+        {6.75, 3.0},
+        {7.75, 1.0},
+        {9.0, -2.0},
+        {10.0, -0.75}};
+    for (const auto& [t, v] : samples) { x->push_back(t, v); }
+    a = 1.0;
+    b = 4.25;
+  }
+
+  SECTION("Random traces") {
+    // Piecewise-linear traces on a coarse grid, so that the ends of the windows often
+    // hit the samples and the end of the trace.
+    auto rng    = std::mt19937{GENERATE(range(1U, 51U))};
+    auto steps  = std::uniform_int_distribution<int>{1, 6};
+    auto values = std::uniform_int_distribution<int>{-12, 12};
+    auto ends   = std::uniform_int_distribution<int>{0, 24};
+
+    double t = 0.0;
+    for (int i = 0; i < 12; i++) {
+      x->push_back(t, 0.25 * values(rng));
+      t += 0.25 * steps(rng);
+    }
+    a = 0.25 * ends(rng);
+    b = a + 0.25 * (1 + ends(rng));
+  }
+
+  INFO("Interval [" << a << ", " << b << "]");
+  const auto trace    = Trace{{"x", x}};
+  const auto interval = stl::ast::Interval{a, b};
+  for (const auto& phi :
+       {Expr{stl::Always(stl::Predicate("x") > 0, interval)},
+        Expr{stl::Eventually(stl::Predicate("x") > 0, interval)}}) {
+    auto actual = std::make_shared<Signal>();
+    for (const auto& s : run_monitor(phi, trace)) { actual->push_back(s); }
+    const auto expected = stl::compute_robustness(phi, trace);
+    require_same(actual, expected);
+    for (double t = x->begin_time(); t <= x->end_time(); t += 0.0625) {
+      INFO("Robustness at t = " << t);
+      REQUIRE(value_at(*actual, t) == Approx(value_at(*expected, t)).margin(1e-9));
+    }
+  }
+}
@@ -0,0 +1,137 @@
+#include "signal_tl/signal_tl.hpp" // for Signal, Predicate, compute_robust...
+
+#include "helpers.hpp" // for get_trace, require_same
+
+#include <catch2/catch.hpp> // for AssertionHandler, operator""_catch_sr
+
+#include <atomic>     // for atomic
+#include <functional> // for function
+#include <map>        // for map
+#include <stdexcept>  // for runtime_error
+#include <string>     // for string
+#include <vector>     // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+using helpers::get_trace;
+using helpers::require_same;
+
+namespace {
+
+/// An executor that never runs the tasks it is given.
+struct BlackHoleExecutor : stl::Executor {
+  void submit(std::function<void()>) override {}
+  [[nodiscard]] size_t concurrency() const override {
+    return 4;
+  }
+};
+
+Expr get_phi() {
+  const auto x      = stl::Predicate("x") > 0;
+  const auto y      = stl::Predicate("y") < 0.5;
+  const auto z      = stl::Predicate("z") >= 0.1;
+  const auto shared = stl::Eventually(x | ~y);
+  return stl::And(
+      {shared,
+       stl::Always(shared | z),
+       stl::Or({x, y, z, ~x, stl::Eventually(z)}),
+       stl::Until(y, z),
+       ~shared});
+}
+
+} // namespace
+
+TEST_CASE("Task groups complete nested tasks", "[parallel]") {
+  // With a single thread, nested groups can only complete if the waiting thread
+  // runs the pending tasks itself.
+  const size_t num_threads = GENERATE(1, 4);
+  auto pool                = stl::ThreadPool{num_threads};
+  REQUIRE(pool.concurrency() == num_threads);
+
+  auto count = std::atomic<int>{0};
+  {
+    auto outer = stl::TaskGroup{&pool};
+    for (int i = 0; i < 8; i++) {
+      outer.run([&]() {
+        auto inner = stl::TaskGroup{&pool};
+        for (int j = 0; j < 8; j++) {
+          inner.run([&]() { count++; });
+        }
+        inner.wait();
+      });
+    }
+    outer.wait();
+  }
+  REQUIRE(count == 64);
+
+  auto failing = stl::TaskGroup{&pool};
+  failing.run([]() { throw std::runtime_error("failed"); });
+  failing.run([&]() { count++; });
+  REQUIRE_THROWS_AS(failing.wait(), std::runtime_error);
+  REQUIRE(count == 65);
+}
+
+TEST_CASE("Parallel robustness matches serial robustness", "[parallel][robustness]") {
+  const auto trace    = get_trace();
+  const auto phi      = get_phi();
+  const auto expected = stl::compute_robustness(phi, trace);
+
+  SECTION("Thread count") {
+    auto options        = stl::EvaluationOptions{};
+    options.num_threads = GENERATE(0, 2, 8);
+    require_same(stl::compute_robustness(phi, trace, options), expected);
+  }
+
+  SECTION("Shared thread pool") {
+    auto pool        = stl::ThreadPool{3};
+    auto options     = stl::EvaluationOptions{};
+    options.executor = &pool;
+    for (int i = 0; i < 4; i++) {
+      require_same(stl::compute_robustness(phi, trace, options), expected);
+    }
+  }
+
+  SECTION("Executor that doesn't run tasks") {
+    auto executor    = BlackHoleExecutor{};
+    auto options     = stl::EvaluationOptions{};
+    options.executor = &executor;
+    require_same(stl::compute_robustness(phi, trace, options), expected);
+  }
+}
+
+TEST_CASE("Batch robustness matches individual evaluations", "[parallel][robustness]") {
+  auto traces = std::vector<Trace>{get_trace(), get_trace(), get_trace()};
+  // Make the traces different from each other.
+  traces[1]["x"] = traces[1]["x"]->affine(2.0, -0.5);
+  traces[2]["z"] = traces[2]["z"]->shift(1.0)->affine(1.0, 0.3);
+
+  const auto formulas = std::vector<Expr>{
+      get_phi(),
+      stl::Predicate("x") > 0.25,
+      stl::Eventually(stl::Predicate("z") < 0),
+      stl::Always(~(stl::Predicate("y") < -0.9) | stl::Predicate("x") > 0)};
+
+  auto options        = stl::EvaluationOptions{};
+  options.num_threads = GENERATE(1, 4);
+  const auto out      = stl::compute_robustness_batch(formulas, traces, options);
+
+  REQUIRE(out.num_formulas == formulas.size());
+  REQUIRE(out.num_traces == traces.size());
+  REQUIRE(out.values.size() == formulas.size() * traces.size());
+  for (size_t i = 0; i < formulas.size(); i++) {
+    for (size_t j = 0; j < traces.size(); j++) {
+      const auto expected = stl::compute_robustness(formulas[i], traces[j]);
+      REQUIRE(out.at(i, j) == Approx(expected->front().value));
+    }
+  }
+
+  const auto named = std::map<std::string, Expr>{
+      {"b", formulas[1]}, {"a", formulas[0]}};
+  const auto out_named = stl::compute_robustness_batch(named, traces, options);
+  REQUIRE(out_named.num_formulas == 2);
+  for (size_t j = 0; j < traces.size(); j++) {
+    REQUIRE(out_named.at(0, j) == Approx(out.at(0, j)));
+    REQUIRE(out_named.at(1, j) == Approx(out.at(1, j)));
+  }
+}
@@ -1,9 +1,11 @@
 #include "signal_tl/internal/filesystem.hpp"
 #include "signal_tl/parser.hpp"
+#include "signal_tl/spec_cache.hpp"
 
 #include <catch2/catch.hpp>
 #include <iostream>
 
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -61,3 +63,91 @@ TEST_CASE("Parsing of file input specifications", "[parser][file-input]") {
     }
   }
 }
+
+namespace {
+
+/// A specification with `k` formulas, each referring to the previous ones.
+std::string generated_spec(size_t k) {
+  auto out = std::ostringstream{};
+  out << "; Generated specification\n";
+  out << "(define-formula phi0 (< p 0))\n";
+  for (size_t i = 1; i < k; i++) {
+    out << "(define-formula phi" << i << " (and phi" << i - 1 << " (always (> x " << i
+        << ".5)) (eventually (not phi" << i / 2 << "))))\n";
+    if (i % 7 == 0) {
+      // Operators that simplify their operands, over formulas from anywhere.
+      out << "(define-formula psi" << i << " (implies phi" << i / 3 << " (iff true phi"
+          << i - 1 << ")))\n";
+      out << "(assert a" << i << " (xor psi" << i << " ; inline comment (\n phi" << i
+          << "))\n";
+    }
+  }
+  out << "(assert monitor phi" << k - 1 << ")\n";
+  return out.str();
+}
+
+void require_equal(
+    const signal_tl::Specification& lhs,
+    const signal_tl::Specification& rhs) {
+  using signal_tl::ast::ExprEqual;
+  REQUIRE(lhs.formulas.size() == rhs.formulas.size());
+  REQUIRE(lhs.assertions.size() == rhs.assertions.size());
+  for (const auto& [name, phi] : lhs.formulas) {
+    REQUIRE(ExprEqual{}(phi, rhs.formulas.at(name)));
+  }
+  for (const auto& [name, phi] : lhs.assertions) {
+    REQUIRE(ExprEqual{}(phi, rhs.assertions.at(name)));
+  }
+}
+
+} // namespace
+
+TEST_CASE("Specifications are parsed concurrently", "[parser][concurrent]") {
+  auto options        = signal_tl::parser::ParseOptions{};
+  options.num_threads = GENERATE(2, 0);
+
+  SECTION("Concurrent parsing gives the same specification") {
+    const auto spec = generated_spec(200);
+    require_equal(
+        *signal_tl::parser::from_string(spec),
+        *signal_tl::parser::from_string(spec, options));
+  }
+
+  SECTION("Errors are reported as in sequential parsing") {
+    const auto invalid_spec = GENERATE(values({
+        "(define-formula phi1 (< p 0))\n"
+        "(define-formula phi2 (and phi1 phi3))\n"
+        "(define-formula phi3 (> q 0))\n",
+        "(define-formula phi1 (< p 0))\n"
+        "(define-formula phi2 (> q 0))\n"
+        "(define-formula phi1 (> q 0))\n",
+        "(define-formula phi1 (< p 0))\n"
+        "(assert phi1 phi1)\n"
+        "(assert phi1 (not phi1))\n",
+        "(define-formula phi1 (< p 0))\n"
+        "(define-formula phi2 (> q 0)))\n",
+    }));
+    REQUIRE_THROWS(signal_tl::parser::from_string(invalid_spec));
+    REQUIRE_THROWS(signal_tl::parser::from_string(invalid_spec, options));
+  }
+}
+
+TEST_CASE("Parsed specifications are cached", "[parser][cache]") {
+  const auto source = generated_spec(50);
+  const auto path   = stdfs::temp_directory_path() / "signal_tl_test_parser.stlspec";
+  stdfs::remove(path);
+
+  auto options  = signal_tl::parser::ParseOptions{};
+  options.cache = path;
+  const auto parsed = signal_tl::parser::from_string(source, options);
+  REQUIRE(stdfs::exists(path));
+  REQUIRE(
+      signal_tl::read_spec_cache(path, signal_tl::hash_source(source)) != nullptr);
+
+  // The cache is used for the same source only.
+  require_equal(*parsed, *signal_tl::parser::from_string(source, options));
+  const auto other = signal_tl::parser::from_string(generated_spec(20), options);
+  REQUIRE(other->formulas.size() < parsed->formulas.size());
+  REQUIRE(signal_tl::read_spec_cache(path, signal_tl::hash_source(source)) == nullptr);
+  stdfs::remove(path);
+}
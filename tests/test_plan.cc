@@ -0,0 +1,186 @@
+#include "signal_tl/signal_tl.hpp" // for EvaluationPlan, Predicate, compute_robust...
+
+#include "helpers.hpp" // for get_trace, require_same
+
+#include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo
+
+#include <cmath>     // for isinf
+#include <memory>    // for make_shared
+#include <stdexcept> // for invalid_argument, out_of_range
+#include <string>    // for string
+#include <utility>   // for pair
+#include <vector>    // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+using Plan = signal_tl::EvaluationPlan;
+using helpers::get_trace;
+using helpers::require_same;
+
+namespace {
+
+/// The samples of the trace in `[start, end)`.
+Trace get_chunk(const Trace& trace, double start, double end) {
+  auto out = Trace{};
+  for (const auto& [name, x] : trace) {
+    auto y = std::make_shared<Signal>();
+    for (const auto s : *x) {
+      if (start <= s.time && s.time < end) {
+        y->push_back(s.time, s.value);
+      }
+    }
+    out[name] = y;
+  }
+  return out;
+}
+
+} // namespace
+
+TEST_CASE("Formulas are compiled into a flat plan", "[robustness][plan]") {
+  const auto y      = stl::Predicate("y") < 0.5;
+  const auto shared = stl::Eventually(stl::Predicate("x") > 0 | ~y);
+  // `x > 0` and `y < 0.5` are also built separately, so they have to be merged
+  // structurally.
+  const auto phi = stl::And(
+      {shared,
+       stl::Always(shared | (stl::Predicate("z") >= 0.1)),
+       stl::Until(stl::Predicate("y") < 0.5, stl::Predicate("x") > 0),
+       ~shared});
+  const auto plan = Plan{phi};
+
+  // x > 0, y < 0.5, z >= 0.1, ~y, Or, Eventually, Or, Always, Until, ~shared, And
+  REQUIRE(plan.ops().size() == 11);
+  REQUIRE(plan.signals() == std::vector<std::string>{"x", "y", "z"});
+  REQUIRE(plan.outputs() == std::vector<size_t>{10});
+
+  auto uses = std::vector<size_t>(plan.ops().size());
+  for (size_t i = 0; i < plan.ops().size(); i++) {
+    for (const size_t arg : plan.ops()[i].args) {
+      REQUIRE(arg < i);
+      REQUIRE(plan.ops()[arg].level < plan.ops()[i].level);
+      uses[arg]++;
+    }
+  }
+  for (size_t i = 0; i + 1 < plan.ops().size(); i++) {
+    REQUIRE(plan.ops()[i].uses == uses[i]);
+  }
+  REQUIRE(plan.ops().back().uses == Plan::npos);
+
+  const auto trace    = get_trace(300);
+  const auto expected = stl::compute_robustness(phi, trace);
+
+  SECTION("Serial evaluation") {
+    require_same(stl::compute_robustness(plan, trace), expected);
+  }
+
+  SECTION("Concurrent evaluation") {
+    auto options        = stl::EvaluationOptions{};
+    options.num_threads = GENERATE(2, 4);
+    for (int i = 0; i < 3; i++) {
+      require_same(stl::compute_robustness(plan, trace, options), expected);
+    }
+  }
+
+  SECTION("Evaluation with the signals in slots") {
+    const auto inputs =
+        std::vector<SignalPtr>{trace.at("x"), trace.at("y"), trace.at("z")};
+    const auto out = plan.evaluate(inputs);
+    REQUIRE(out.size() == 1);
+    require_same(out.front(), expected);
+
+    REQUIRE_THROWS_AS(
+        plan.evaluate(std::vector<SignalPtr>{trace.at("x")}), std::invalid_argument);
+  }
+
+  SECTION("Missing signals") {
+    auto partial = trace;
+    partial.erase("z");
+    REQUIRE_THROWS_AS(plan.evaluate(partial), std::out_of_range);
+  }
+}
+
+TEST_CASE("Plans compile multiple formulas together", "[robustness][plan]") {
+  const auto x        = stl::Predicate("x") > 0;
+  const auto formulas = std::vector<Expr>{
+      stl::Always(x), stl::Eventually(stl::Predicate("x") > 0), x, stl::Const(true)};
+  const auto plan = Plan{formulas};
+
+  // The predicate is shared by all of the formulas.
+  REQUIRE(plan.ops().size() == 4);
+  REQUIRE(plan.outputs().size() == 4);
+  REQUIRE(plan.outputs()[2] == plan.ops()[plan.outputs()[0]].args.front());
+
+  const auto trace = get_trace(300);
+  const auto out   = plan.evaluate(trace);
+  REQUIRE(out.size() == formulas.size());
+  for (size_t i = 0; i < formulas.size(); i++) {
+    require_same(out[i], stl::compute_robustness(formulas[i], trace));
+  }
+
+  REQUIRE_THROWS_AS(stl::compute_robustness(plan, trace), std::invalid_argument);
+}
+
+TEST_CASE("Plans know the horizons of the operations", "[robustness][plan]") {
+  const auto x = stl::Predicate("x") > 0;
+  const auto y = stl::Predicate("y") < 0.5;
+  const auto g   = stl::Always(y, {1.0, 2.0});
+  const auto phi = stl::Always(x, {0.0, 1.0}) &
+                   stl::Eventually(stl::Until(y, x, {0.0, 0.5}) | g, {0.5, 1.5});
+  const auto plan = Plan{{phi, stl::Always(phi), stl::Not(x)}};
+  REQUIRE(plan.ops()[plan.outputs()[0]].horizon == Approx(3.5));
+  REQUIRE(std::isinf(plan.ops()[plan.outputs()[1]].horizon));
+  REQUIRE(plan.ops()[plan.outputs()[2]].horizon == 0.0);
+}
+
+TEST_CASE("Appended traces are evaluated incrementally", "[robustness][plan]") {
+  const auto x         = stl::Predicate("x");
+  const auto y         = stl::Predicate("y");
+  const auto z         = stl::Predicate("z");
+  const auto semantics = GENERATE(stl::Semantics::Classic, stl::Semantics::Filtering);
+  const auto phi       = GENERATE_COPY(
+      Expr{stl::Always(x > 0, {0.0, 1.0})},
+      Expr{stl::Eventually((x > 0.2) & (y < 0.5), {0.5, 2.0}) | (z > 0)},
+      Expr{stl::Always(stl::Eventually(y > 0, {0.0, 0.7}), {1.0, 3.0})},
+      Expr{stl::Until(x > 0, y > 0.5, {0.0, 1.5}) & stl::Const(true)},
+      Expr{stl::Eventually(x > 0.9) | stl::Always(z < 0.1, {0.0, 0.4})});
+
+  const auto trace  = get_trace(300);
+  auto options      = stl::EvaluationOptions{};
+  options.semantics = semantics;
+
+  const auto plan    = Plan{phi};
+  const auto initial = get_chunk(trace, 0.0, 10.0);
+  auto state         = stl::IncrementalEvaluation{plan, initial, options};
+  const auto first   = state.outputs().front();
+  const auto size    = first->size();
+
+  const auto chunks =
+      std::vector<std::pair<double, double>>{{10.0, 10.5}, {10.5, 21.0}, {21.0, 40.0}};
+  for (const auto& [start, end] : chunks) {
+    state.append(get_chunk(trace, start, end));
+    const auto expected = plan.evaluate(get_chunk(trace, 0.0, end), options);
+    require_same(state.outputs().front(), expected.front());
+  }
+
+  // The results that were returned before aren't changed by the appends.
+  REQUIRE(first->size() == size);
+  require_same(first, plan.evaluate(initial, options).front());
+}
+
+TEST_CASE("Invalid appends are rejected", "[robustness][plan]") {
+  const auto trace = get_trace(300);
+  const auto plan  = Plan{(stl::Predicate("x") > 0) & (stl::Predicate("y") > 0)};
+  auto state       = stl::IncrementalEvaluation{plan, get_chunk(trace, 0.0, 10.0)};
+  const auto end   = state.outputs().front()->end_time();
+
+  // Nothing is appended if any of the chunks overlaps its signal.
+  auto chunk = get_chunk(trace, 10.0, 20.0);
+  chunk["y"] = get_chunk(trace, 5.0, 20.0).at("y");
+  REQUIRE_THROWS_AS(state.append(chunk), std::invalid_argument);
+  REQUIRE(state.outputs().front()->end_time() == end);
+
+  // Signals that aren't used are ignored.
+  state.append(Trace{{"w", get_chunk(trace, 0.0, 1.0).at("x")}});
+  REQUIRE(state.outputs().front()->end_time() == end);
+}
@@ -0,0 +1,89 @@
+#include "signal_tl/signal_tl.hpp" // for EvaluationProfile, Predicate, compute_rob...
+
+#include "helpers.hpp" // for get_trace
+
+#include <catch2/catch.hpp> // for operator==, SourceLineInfo, StringRef
+
+#include <string> // for string
+#include <vector> // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+using signal_tl::ast::ExprEqual;
+using helpers::get_trace;
+
+TEST_CASE("Profiles record the statistics of each subformula", "[profile]") {
+  const auto x     = stl::Predicate("x") > 0;
+  const auto y     = stl::Predicate("y") < 0.5;
+  const auto phi   = stl::Always(x | stl::Eventually(y, {0.0, 1.0}), {0.0, 5.0}) & x;
+  const auto trace = get_trace();
+  const auto plan  = stl::EvaluationPlan{phi};
+
+  auto options        = stl::EvaluationOptions{};
+  options.num_threads = GENERATE(1, 2);
+  auto profile        = stl::EvaluationProfile{};
+  options.profile     = &profile;
+
+  const auto rob      = stl::compute_robustness(phi, trace, options);
+  const auto expected = stl::compute_robustness(phi, trace);
+  REQUIRE(rob->size() == expected->size());
+
+  // There is a node for each distinct subformula (`x > 0` is used twice).
+  REQUIRE(profile.nodes.size() == plan.ops().size());
+  REQUIRE(profile.nodes.size() == 6);
+  REQUIRE(ExprEqual{}(profile.nodes.back().formula, phi));
+  REQUIRE(profile.nodes.back().output_samples == rob->size());
+
+  double total = 0.0;
+  for (size_t i = 0; i < profile.nodes.size(); i++) {
+    const auto& node = profile.nodes[i];
+    REQUIRE(node.seconds >= 0);
+    total += node.seconds;
+    size_t inputs = 0;
+    for (const size_t a : node.operands) {
+      REQUIRE(a < i);
+      inputs += profile.nodes[a].output_samples;
+    }
+    if (!node.operands.empty()) {
+      REQUIRE(node.input_samples == inputs);
+    }
+  }
+  REQUIRE(total <= profile.seconds);
+
+  // The predicates read the whole signals, and the `Or` synchronizes its operands,
+  // which aren't sampled at the same time points.
+  const auto& pred = profile.nodes.front();
+  REQUIRE(pred.operands.empty());
+  REQUIRE(pred.input_samples == trace.at("x")->size());
+  const auto sync = Expr{x | stl::Eventually(y, {0.0, 1.0})};
+  for (const auto& node : profile.nodes) {
+    if (ExprEqual{}(node.formula, sync)) {
+      REQUIRE(node.added_samples > 0);
+    }
+  }
+
+  const auto report = profile.report();
+  REQUIRE(report.find("total: ") != std::string::npos);
+  REQUIRE(report.find("(x > 0)") != std::string::npos);
+}
+
+TEST_CASE("Profiles count the buffers that are allocated", "[profile]") {
+  const auto phi   = stl::Eventually(stl::Predicate("x") > 0, {0.0, 1.0});
+  const auto trace = get_trace();
+
+  auto options    = stl::EvaluationOptions{};
+  auto profile    = stl::EvaluationProfile{};
+  options.profile = &profile;
+  const auto rob  = stl::compute_robustness(phi, trace, options);
+
+  // At least the columns of each result are new buffers.
+  size_t bytes = 0;
+  for (const auto& node : profile.nodes) { bytes += node.bytes_allocated; }
+  REQUIRE(bytes >= 2 * rob->size() * sizeof(double));
+
+  // The queries at a time point are profiled, too.
+  REQUIRE(stl::compute_robustness_at(phi, trace, 1.0, options) > -1);
+  REQUIRE(profile.nodes.size() == 2);
+  REQUIRE(profile.nodes.back().output_samples == 1);
+}
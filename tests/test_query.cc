@@ -0,0 +1,119 @@
+#include "signal_tl/signal_tl.hpp" // for compute_robustness, compute_robustness_at
+
+#include "helpers.hpp" // for sample_signal, value_at
+
+#include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo
+
+#include <cmath>     // for sin, cos
+#include <memory>    // for make_shared
+#include <stdexcept> // for out_of_range
+#include <vector>    // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+using helpers::sample_signal;
+using helpers::value_at;
+
+namespace {
+
+/// The signals are sampled at multiples of 0.25, so the windows of the temporal
+/// operators start and end on samples.
+Trace get_trace() {
+  const auto x = [](double t) { return std::sin(t); };
+  const auto y = [](double t) { return std::cos(t / 2); };
+  return Trace{{"x", sample_signal(x, 400, 0.25)}, {"y", sample_signal(y, 400, 0.25)}};
+}
+
+std::vector<Expr> get_formulas() {
+  const auto x = stl::Predicate("x") > 0.2;
+  const auto y = stl::Predicate("y") < 0.5;
+  return {
+      x,
+      stl::Always(x | y, {0.0, 2.0}),
+      stl::Eventually(x & ~y, {1.0, 3.0}),
+      stl::Always(stl::Eventually(y, {0.0, 1.5}), {0.5, 2.5}),
+      stl::Until(~x, y, {0.0, 4.0}),
+      stl::Eventually(y) & stl::Always(x, {0.0, 1.0}),
+      stl::Const(true) | stl::Always(x, {0.25, 0.75}),
+  };
+}
+
+} // namespace
+
+TEST_CASE("Robustness can be computed at a single time", "[robustness][query]") {
+  const auto trace = get_trace();
+
+  for (const auto& phi : get_formulas()) {
+    const auto expected = stl::compute_robustness(phi, trace);
+    for (const double t : {0.0, 10.0, 37.5, 90.25, expected->end_time()}) {
+      REQUIRE(
+          stl::compute_robustness_at(phi, trace, t) ==
+          Approx(value_at(*expected, t)).margin(1e-9));
+    }
+  }
+
+  const auto phi = stl::Always(stl::Predicate("x") > 0, {0.0, 1.0});
+  REQUIRE_THROWS_AS(stl::compute_robustness_at(phi, trace, -1.0), std::out_of_range);
+  REQUIRE_THROWS_AS(stl::compute_robustness_at(phi, trace, 200.0), std::out_of_range);
+}
+
+TEST_CASE("Robustness at a single time matches wide windows", "[robustness][query]") {
+  const auto trace = Trace{{"y", std::make_shared<Signal>(std::vector<Sample>{
+                                      {0.0, 2.0}, {1.0, 0.0}, {2.0, 1.0}})}};
+  const auto y     = stl::Predicate("y") < 2;
+
+  // Windows at least as wide as the trace are clipped to its end, so they all have
+  // follow y < 2 until t = 0.5, where it reaches the minimum over the later samples.
+  const auto phi = GENERATE_COPY(
+      Expr{stl::Always(y, {0.0, 1.99})},
+      Expr{stl::Always(y, {0.0, 2.0})},
+      Expr{stl::Always(y, {0.0, 5.0})},
+      Expr{stl::Always(y)},
+      Expr{~stl::Eventually(~y, {0.0, 2.0})},
+      Expr{~stl::Eventually(~y)});
+  const auto rob = stl::compute_robustness(phi, trace);
+  for (const double t : {0.0, 0.25, 0.5, 0.75, 1.0, 1.5, 2.0}) {
+    INFO("At t = " << t);
+    const double expected = stl::compute_robustness_at(phi, trace, t);
+    REQUIRE(value_at(*rob, t) == Approx(expected).margin(1e-9));
+  }
+  REQUIRE(value_at(*rob, 0.25) == Approx(0.5));
+}
+
+TEST_CASE("Robustness can be computed over a window", "[robustness][query]") {
+  const auto trace = get_trace();
+  auto options     = stl::EvaluationOptions{};
+  options.window   = {20.0, 30.0};
+
+  for (const auto& phi : get_formulas()) {
+    const auto expected = stl::compute_robustness(phi, trace);
+    const auto actual   = stl::compute_robustness(phi, trace, options);
+    REQUIRE(actual->begin_time() == 20.0);
+    REQUIRE(actual->end_time() == 30.0);
+    for (const auto s : *actual) {
+      REQUIRE(s.value == Approx(value_at(*expected, s.time)).margin(1e-9));
+    }
+  }
+
+  SECTION("Windows are clipped to the robustness") {
+    options.window    = {95.0, 120.0};
+    const auto phi    = stl::Always(stl::Predicate("x") > 0, {0.0, 1.0});
+    const auto actual = stl::compute_robustness(phi, trace, options);
+    REQUIRE(actual->begin_time() == 95.0);
+    REQUIRE(actual->end_time() == trace.at("x")->end_time());
+
+    options.window = {120.0, 130.0};
+    REQUIRE(stl::compute_robustness(phi, trace, options)->empty());
+  }
+
+  SECTION("Batches are evaluated at the start of the window") {
+    const auto formulas = get_formulas();
+    const auto matrix =
+        stl::compute_robustness_batch(formulas, std::vector{trace, trace}, options);
+    for (size_t i = 0; i < formulas.size(); i++) {
+      const auto expected = stl::compute_robustness_at(formulas[i], trace, 20.0);
+      REQUIRE(matrix.at(i, 1) == Approx(expected).margin(1e-9));
+    }
+  }
+}
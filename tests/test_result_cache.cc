@@ -0,0 +1,195 @@
+#include "signal_tl/internal/filesystem.hpp" // for temp_directory_path, remove_all
+#include "signal_tl/signal_tl.hpp"           // for ResultCache, Predicate, Always, ...
+
+#include "helpers.hpp" // for get_trace, require_identical
+
+#include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo, StringRef
+
+#include <memory> // for make_shared
+#include <vector> // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+using helpers::get_trace;
+using helpers::require_identical;
+
+namespace {
+
+/// A temporary directory for a cache, removed at the end of the test.
+struct CacheDir {
+  stdfs::path dir = stdfs::temp_directory_path() / "signal_tl_test_result_cache";
+
+  CacheDir() {
+    stdfs::remove_all(dir);
+  }
+  CacheDir(const CacheDir&)            = delete;
+  CacheDir& operator=(const CacheDir&) = delete;
+  ~CacheDir() {
+    stdfs::remove_all(dir);
+  }
+};
+
+} // namespace
+
+TEST_CASE("Signals have content fingerprints", "[cache]") {
+  const auto trace = get_trace(500, 0.0);
+  const auto& x    = *trace.at("x");
+  REQUIRE(stl::fingerprint(x) == stl::fingerprint(Signal{x}));
+  REQUIRE(stl::fingerprint(x) != stl::fingerprint(*get_trace(500, 0.1).at("x")));
+  REQUIRE(stl::fingerprint(x) != stl::fingerprint(*trace.at("y")));
+
+  // Shifting a single value changes the fingerprint.
+  auto z = Signal{x};
+  z.truncate(x.end_time());
+  z.push_back(x.end_time(), x.back().value + 1e-12);
+  REQUIRE(stl::fingerprint(z) != stl::fingerprint(x));
+}
+
+TEST_CASE("Results are cached in memory", "[cache]") {
+  const auto x      = stl::Predicate("x") > 0;
+  const auto y      = stl::Predicate("y") < 0.5;
+  const auto shared = stl::Always(x | stl::Eventually(y, {0.0, 1.0}), {0.0, 5.0});
+  const auto phi    = shared & x;
+  const auto trace  = get_trace(500, 0.0);
+
+  auto cache          = stl::ResultCache{};
+  auto options        = stl::EvaluationOptions{};
+  options.num_threads = GENERATE(1, 2);
+  options.cache       = &cache;
+  const auto expected = stl::compute_robustness(phi, trace);
+
+  const auto first = stl::compute_robustness(phi, trace, options);
+  require_identical(first, expected);
+  REQUIRE(cache.stats().hits == 0);
+  // The output, `Always`, and `Eventually`.
+  REQUIRE(cache.size() == 3);
+
+  SECTION("Evaluating again finds the result") {
+    auto profile     = stl::EvaluationProfile{};
+    options.profile  = &profile;
+    const auto again = stl::compute_robustness(phi, trace, options);
+    REQUIRE(again == first);
+    REQUIRE(cache.stats().hits == 1);
+    REQUIRE(cache.stats().misses == 3);
+    REQUIRE(profile.nodes.back().cached);
+    // Nothing else is computed.
+    for (const auto& node : profile.nodes) { REQUIRE(node.input_samples == 0); }
+  }
+
+  SECTION("Shared subformulas are found") {
+    const auto psi = shared | (y & x);
+    require_identical(
+        stl::compute_robustness(psi, trace, options),
+        stl::compute_robustness(psi, trace));
+    REQUIRE(cache.stats().hits == 1);
+  }
+
+  SECTION("Signals are identified by their samples") {
+    // Renaming the signals (and adding others) doesn't change the results.
+    const auto renamed = Trace{
+        {"a", trace.at("x")},
+        {"b", trace.at("y")},
+        {"c", get_trace(500, 1.0).at("x")}};
+    const auto a   = stl::Predicate("a") > 0;
+    const auto b   = stl::Predicate("b") < 0.5;
+    const auto psi = stl::Always(a | stl::Eventually(b, {0.0, 1.0}), {0.0, 5.0}) & a;
+    REQUIRE(stl::compute_robustness(psi, renamed, options) == first);
+
+    // But changing the samples does, except for the subformulas that don't use them.
+    const auto other =
+        Trace{{"x", get_trace(500, 0.5).at("x")}, {"y", trace.at("y")}};
+    require_identical(
+        stl::compute_robustness(phi, other, options),
+        stl::compute_robustness(phi, other));
+    REQUIRE(cache.stats().hits == 2);
+  }
+
+  SECTION("Results over windows are keyed by the window") {
+    const double at = stl::compute_robustness_at(phi, trace, 10.0, options);
+    REQUIRE(at == Approx(stl::compute_robustness_at(phi, trace, 10.0)));
+    REQUIRE(stl::compute_robustness_at(phi, trace, 10.0, options) == at);
+    REQUIRE(
+        stl::compute_robustness_at(phi, trace, 20.0, options) ==
+        Approx(stl::compute_robustness_at(phi, trace, 20.0)));
+  }
+
+  SECTION("The semantics are part of the key") {
+    options.semantics = stl::Semantics::Filtering;
+    auto plain        = stl::EvaluationOptions{};
+    plain.semantics   = stl::Semantics::Filtering;
+    require_identical(
+        stl::compute_robustness(phi, trace, options),
+        stl::compute_robustness(phi, trace, plain));
+  }
+}
+
+TEST_CASE("Caches evict the least recently used results", "[cache]") {
+  const auto get_signal = [](double v) {
+    return std::make_shared<Signal>(
+        std::vector{v, v + 1, v, v + 1}, std::vector{0.0, 1.0, 2.0, 3.0});
+  };
+  auto cache = stl::ResultCache{10};
+  cache.insert(1, get_signal(1.0));
+  cache.insert(2, get_signal(2.0));
+  REQUIRE(cache.find(1) != nullptr);
+  // The third result doesn't fit, so the second one (which is now the oldest) goes.
+  cache.insert(3, get_signal(3.0));
+  REQUIRE(cache.size() == 2);
+  REQUIRE(cache.find(2) == nullptr);
+  REQUIRE(cache.find(1)->front().value == 1.0);
+  REQUIRE(cache.find(3)->front().value == 3.0);
+  REQUIRE(cache.stats().evicted == 1);
+
+  // Results larger than the cache aren't kept.
+  auto large = std::make_shared<Signal>();
+  for (int i = 0; i < 11; i++) { large->push_back(i, 0.0); }
+  cache.insert(4, large);
+  REQUIRE(cache.find(4) == nullptr);
+  REQUIRE(cache.size() == 2);
+
+  cache.clear();
+  REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("Results are kept on disk", "[cache]") {
+  const auto dir  = CacheDir{};
+  const auto x    = stl::Predicate("x") > 0;
+  const auto y    = stl::Predicate("y") < 0.5;
+  const auto phis = std::vector<Expr>{
+      stl::Always(x, {0.0, 2.0}), stl::Until(x, y, {0.0, 3.0}), stl::Eventually(y)};
+  auto traces = std::vector<Trace>{};
+  for (int i = 0; i < 4; i++) { traces.push_back(get_trace(500, 0.3 * i)); }
+  const auto expected = stl::compute_robustness_batch(phis, traces);
+
+  auto options        = stl::EvaluationOptions{};
+  options.num_threads = 2;
+  {
+    auto cache        = stl::ResultCache{dir.dir};
+    options.cache     = &cache;
+    const auto values = stl::compute_robustness_batch(phis, traces, options);
+    REQUIRE(values.values == expected.values);
+    REQUIRE(cache.stats().hits == 0);
+  }
+
+  // A new cache (e.g., in the next run) reads the results back.
+  auto cache        = stl::ResultCache{dir.dir};
+  options.cache     = &cache;
+  const auto values = stl::compute_robustness_batch(phis, traces, options);
+  REQUIRE(values.values == expected.values);
+  REQUIRE(cache.stats().misses == 0);
+  REQUIRE(cache.stats().disk_hits == phis.size() * traces.size());
+
+  // The results that were read are then kept in memory.
+  REQUIRE(stl::compute_robustness_batch(phis, traces, options).values == values.values);
+  REQUIRE(cache.stats().disk_hits == phis.size() * traces.size());
+
+  // Files that aren't results are misses.
+  for (const auto& entry : stdfs::directory_iterator{dir.dir}) {
+    stdfs::resize_file(entry.path(), 16);
+  }
+  auto broken   = stl::ResultCache{dir.dir};
+  options.cache = &broken;
+  REQUIRE(stl::compute_robustness_batch(phis, traces, options).values == values.values);
+  REQUIRE(broken.stats().hits == 0);
+}
@@ -0,0 +1,149 @@
+#include "signal_tl/signal_tl.hpp" // for check_satisfaction, compute_robustness
+
+#include "helpers.hpp" // for value_at
+#include "minmax.hpp"  // for compute_max_seq, compute_min_seq
+
+#include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo
+
+#include <cmath>     // for abs, sin
+#include <memory>    // for make_shared
+#include <random>    // for mt19937, uniform_real_distribution
+#include <stdexcept> // for out_of_range
+#include <vector>    // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+namespace minmax = signal_tl::minmax;
+using helpers::value_at;
+
+namespace {
+
+/// A random walk, sampled at random time points.
+SignalPtr get_signal(std::mt19937& rng, double begin) {
+  auto step = std::uniform_real_distribution<double>{-1.0, 1.0};
+  auto dt   = std::uniform_real_distribution<double>{0.05, 0.5};
+  auto x    = std::make_shared<Signal>();
+  double v  = step(rng);
+  for (double t = begin; t < 20.0; t += dt(rng)) {
+    x->push_back(t, v);
+    v += step(rng);
+  }
+  return x;
+}
+
+bool holds_at(const stl::IntervalSet& set, double t) {
+  for (const auto& [lo, hi] : set) {
+    if (lo <= t && t <= hi) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+TEST_CASE("Boolean verdicts match the sign of the robustness", "[satisfaction]") {
+  auto rng         = std::mt19937{GENERATE(1U, 2U, 3U, 4U, 5U)};
+  const auto trace = Trace{
+      {"x", get_signal(rng, 0.0)},
+      {"y", get_signal(rng, 0.5)},
+      {"z", get_signal(rng, 0.2)}};
+
+  const auto x        = stl::Predicate("x") > 0;
+  const auto y        = stl::Predicate("y") <= 0.5;
+  const auto z        = stl::Predicate("z") >= -0.5;
+  const auto formulas = std::vector<Expr>{
+      x,
+      ~y,
+      x & y,
+      x | y | ~z,
+      stl::Always(x | y),
+      stl::Eventually(x & ~y),
+      stl::Always(stl::Eventually(z)),
+      stl::Eventually(stl::Always(~z)),
+      stl::Until(y, x & z),
+      stl::Always(stl::Until(~x, y) | z),
+      stl::Const(true) & stl::Eventually(stl::Const(false) | x)};
+
+  for (const auto& phi : formulas) {
+    const auto rob     = stl::compute_robustness(phi, trace);
+    const auto verdict = stl::check_satisfaction(phi, trace);
+    REQUIRE(verdict.time == rob->begin_time());
+    if (std::abs(rob->front().value) > 1e-9) {
+      REQUIRE(verdict.satisfied == (rob->front().value > 0));
+    }
+
+    // The satisfaction set matches the robustness at every sample.
+    const auto set = stl::compute_satisfaction(phi, trace);
+    for (const auto s : *rob) {
+      if (std::abs(s.value) > 1e-9) {
+        INFO("Sample at t = " << s.time);
+        REQUIRE(holds_at(set, s.time) == (s.value > 0));
+      }
+    }
+  }
+}
+
+TEST_CASE("Bounded temporal operators hold over their windows", "[satisfaction]") {
+  auto rng         = std::mt19937{GENERATE(7U, 8U, 9U)};
+  const auto trace = Trace{{"x", get_signal(rng, 0.0)}};
+  const auto x     = stl::Predicate("x") > 0.2;
+  const auto a     = GENERATE(0.0, 0.7, 2.0);
+  const auto b     = a + GENERATE(0.3, 1.5, 4.0);
+
+  const auto y          = trace.at("x")->affine(1.0, -0.2);
+  const auto eventually = minmax::compute_max_seq(y, a, b);
+  const auto always     = minmax::compute_min_seq(y, a, b);
+  const auto ev_set     = stl::compute_satisfaction(stl::Eventually(x, {a, b}), trace);
+  const auto alw_set    = stl::compute_satisfaction(stl::Always(x, {a, b}), trace);
+  for (size_t i = 0; i < y->size(); i++) {
+    const double t = y->at_idx(i).time;
+    INFO("Sample at t = " << t << " with window [" << a << ", " << b << "]");
+    const double ev  = value_at(*eventually, t);
+    const double alw = value_at(*always, t);
+    if (std::abs(ev) > 1e-9) {
+      REQUIRE(holds_at(ev_set, t) == (ev > 0));
+    }
+    if (std::abs(alw) > 1e-9) {
+      REQUIRE(holds_at(alw_set, t) == (alw > 0));
+    }
+
+    auto options = stl::SatisfactionOptions{};
+    options.time = t;
+    const auto v = stl::check_satisfaction(stl::Eventually(x, {a, b}), trace, options);
+    REQUIRE(v.satisfied == holds_at(ev_set, t));
+  }
+}
+
+TEST_CASE("Violated formulas report where they fail", "[satisfaction]") {
+  const auto x = std::make_shared<Signal>(
+      std::vector<double>{1.0, 1.0, -1.0, -1.0, 1.0, 1.0},
+      std::vector<double>{0.0, 1.0, 2.0, 3.0, 4.0, 10.0});
+  const auto y = std::make_shared<Signal>(
+      std::vector<double>{1.0, 1.0}, std::vector<double>{0.0, 10.0});
+  const auto trace = Trace{{"x", x}, {"y", y}};
+
+  auto options           = stl::SatisfactionOptions{};
+  options.find_violation = true;
+
+  const auto phi = stl::Predicate("y") > 0 & stl::Always(stl::Predicate("x") >= 0);
+  const auto v   = stl::check_satisfaction(phi, trace, options);
+  REQUIRE(v.time == 0.0);
+  REQUIRE(!v.satisfied);
+  REQUIRE(v.violation.has_value());
+  REQUIRE(v.violation->first == Approx(1.5));
+  REQUIRE(v.violation->second == Approx(3.5));
+
+  // The window of a bounded Always ends before the violation.
+  const auto psi = stl::Always(stl::Predicate("x") >= 0, {0.0, 1.0});
+  REQUIRE(stl::check_satisfaction(psi, trace).satisfied);
+
+  options.time = 5.0;
+  const auto w = stl::check_satisfaction(phi, trace, options);
+  REQUIRE(w.satisfied);
+  REQUIRE(!w.violation.has_value());
+
+  options.time = 11.0;
+  REQUIRE_THROWS_AS(stl::check_satisfaction(phi, trace, options), std::out_of_range);
+}
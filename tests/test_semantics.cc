@@ -0,0 +1,329 @@
+#include "signal_tl/signal_tl.hpp" // for compute_robustness, compute_cumulative_rob...
+
+#include "helpers.hpp"   // for value_at
+#include "integral.hpp"  // for compute_integral_seq, compute_average_seq
+#include "operators.hpp" // for compute_predicates
+
+#include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo
+
+#include <algorithm> // for max, min
+#include <cmath>     // for sin
+#include <limits>    // for numeric_limits
+#include <map>       // for map
+#include <memory>    // for make_shared
+#include <stdexcept> // for invalid_argument
+#include <string>    // for string
+#include <utility>   // for pair
+#include <vector>    // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+namespace integral = signal_tl::integral;
+using helpers::value_at;
+
+namespace {
+
+constexpr double TOP = std::numeric_limits<double>::infinity();
+
+SignalPtr get_signal(size_t n) {
+  auto sig = std::make_shared<Signal>();
+  double t = 0;
+  for (size_t i = 0; i < n; i++) {
+    sig->push_back(t, std::sin(t) + std::sin(3.7 * t));
+    // Irregular sampling.
+    t += (i % 3 == 0) ? 0.05 : 0.2;
+  }
+  return sig;
+}
+
+/// The integral of `x` over `[lo, hi]`, with the trapezoidal rule over a fine grid.
+double integrate(const Signal& x, double lo, double hi) {
+  constexpr size_t steps = 20000;
+  const double dt        = (hi - lo) / steps;
+  double sum             = 0.0;
+  for (size_t i = 0; i < steps; i++) {
+    const double t = lo + dt * static_cast<double>(i);
+    sum += (value_at(x, t) + value_at(x, t + dt)) * dt / 2;
+  }
+  return sum;
+}
+
+} // namespace
+
+TEST_CASE("Integrals over windows", "[integral]") {
+  const auto x = std::make_shared<Signal>(
+      std::vector{0.0, 2.0, 2.0, 0.0}, std::vector{0.0, 1.0, 2.0, 4.0});
+
+  SECTION("Integrals up to the end") {
+    const auto y = integral::compute_integral_seq(x);
+    REQUIRE(y->size() == 4);
+    REQUIRE(y->at_idx(0).value == Approx(5.0));
+    REQUIRE(y->at_idx(1).value == Approx(4.0));
+    REQUIRE(y->at_idx(2).value == Approx(2.0));
+    REQUIRE(y->at_idx(3).value == 0.0);
+
+    const auto z = integral::compute_average_seq(x);
+    REQUIRE(z->at_idx(0).value == Approx(1.25));
+    REQUIRE(z->at_idx(2).value == Approx(1.0));
+    REQUIRE(z->at_idx(3).value == 0.0);
+  }
+
+  SECTION("Bounded windows") {
+    const auto y = integral::compute_integral_seq(x, 1.0, 2.0);
+    REQUIRE(value_at(*y, 0.0) == Approx(2.0));
+    REQUIRE(value_at(*y, 1.0) == Approx(1.5));
+    REQUIRE(value_at(*y, 2.0) == Approx(0.5));
+    REQUIRE(value_at(*y, 4.0) == 0.0);
+
+    const auto z = integral::compute_average_seq(x, 0.0, 1.0);
+    REQUIRE(value_at(*z, 0.0) == Approx(1.0));
+    REQUIRE(value_at(*z, 1.0) == Approx(2.0));
+    REQUIRE(value_at(*z, 2.0) == Approx(1.5));
+    // The window is empty at the end of the signal.
+    REQUIRE(value_at(*z, 4.0) == 0.0);
+  }
+
+  SECTION("Windows ending at a sample") {
+    const auto spike = std::make_shared<Signal>(
+        std::vector{0.0, 0.0, 10.0, 0.0, 0.0}, std::vector{0.0, 5.0, 5.5, 6.0, 10.0});
+    // At t = 4, the window [t + 1, t + 2] is [5, 6], which holds the whole spike, so
+    // the result has a breakpoint there (and where the spike enters and leaves).
+    const auto z = integral::compute_average_seq(spike, 1.0, 2.0);
+    REQUIRE(value_at(*z, 4.0) == Approx(5.0));
+    REQUIRE(value_at(*z, 3.0) == 0.0);
+    REQUIRE(value_at(*z, 3.5) == Approx(2.5));
+    REQUIRE(value_at(*z, 4.5) == Approx(2.5));
+    REQUIRE(value_at(*z, 5.0) == Approx(0.0));
+    for (const auto s : *z) {
+      const double lo = std::min(s.time + 1.0, spike->end_time());
+      const double hi = std::min(s.time + 2.0, spike->end_time());
+      const double expected =
+          (hi > lo) ? integrate(*spike, lo, hi) / (hi - lo) : value_at(*spike, lo);
+      REQUIRE(s.value == Approx(expected).margin(1e-6));
+    }
+
+    auto options      = stl::EvaluationOptions{};
+    options.semantics = stl::Semantics::Filtering;
+    const auto trace  = Trace{{"x", spike}};
+    const auto ev     = stl::Eventually(stl::Predicate("x") > 0, {1.0, 2.0});
+    REQUIRE(
+        value_at(*stl::compute_robustness(ev, trace, options), 4.0) ==
+        Approx(stl::compute_robustness_at(ev, trace, 4.0, options)));
+    // The whole spike is in the window of `ev` for a total time of 1 over [0, 5].
+    const auto alw = stl::Always(ev, {0.0, 5.0});
+    REQUIRE(value_at(*stl::compute_robustness(alw, trace, options), 0.0) == Approx(1.0));
+  }
+
+  SECTION("Irregularly sampled signals") {
+    const auto sig = get_signal(200);
+    const double a = GENERATE(0.0, 0.3, 1.0);
+    const double b = a + GENERATE(0.25, 2.0);
+    const auto y   = integral::compute_integral_seq(sig, a, b);
+    REQUIRE(y->size() >= sig->size());
+    for (size_t i = 0; i < y->size(); i += 7) {
+      const double t  = y->at_idx(i).time;
+      const double lo = std::min(t + a, sig->end_time());
+      const double hi = std::min(t + b, sig->end_time());
+      REQUIRE(y->at_idx(i).value == Approx(integrate(*sig, lo, hi)).margin(1e-6));
+    }
+  }
+
+  SECTION("Infinite values") {
+    const auto inf = std::make_shared<Signal>(
+        std::vector{1.0, 1.0, TOP, TOP, 1.0}, std::vector{0.0, 1.0, 2.0, 3.0, 4.0});
+    const auto y = integral::compute_integral_seq(inf, 0.0, 0.5);
+    REQUIRE(value_at(*y, 0.0) == Approx(0.5));
+    // Segments with an infinite end are infinite.
+    REQUIRE(value_at(*y, 1.0) == TOP);
+    REQUIRE(value_at(*y, 3.0) == TOP);
+    REQUIRE(value_at(*y, 4.0) == 0.0);
+    REQUIRE(integral::compute_integral_seq(inf)->front().value == TOP);
+    REQUIRE(integral::compute_average_seq(inf, 0.0, 1.0)->front().value == 1.0);
+  }
+}
+
+TEST_CASE("Robustness with the filtering semantics", "[robustness][filtering]") {
+  const auto x      = stl::Predicate("x") > 0.5;
+  const auto trace  = Trace{{"x", get_signal(300)}};
+  auto options      = stl::EvaluationOptions{};
+  options.semantics = stl::Semantics::Filtering;
+
+  const auto y   = stl::compute_robustness(x, trace);
+  const double a = GENERATE(0.0, 0.5);
+  const double b = a + 1.0;
+
+  const auto ev = stl::compute_robustness(stl::Eventually(x, {a, b}), trace, options);
+  const auto expected = integral::compute_average_seq(y, a, b);
+  REQUIRE(ev->size() == expected->size());
+  for (size_t i = 0; i < ev->size(); i++) {
+    REQUIRE(ev->at_idx(i).value == Approx(expected->at_idx(i).value));
+  }
+
+  // As the average is linear, `Always` and `Eventually` are dual to each other.
+  const auto alw = stl::compute_robustness(stl::Always(x, {a, b}), trace, options);
+  const auto dual =
+      stl::compute_robustness(~stl::Eventually(~x, {a, b}), trace, options);
+  for (size_t i = 0; i < ev->size(); i++) {
+    REQUIRE(alw->at_idx(i).value == Approx(ev->at_idx(i).value));
+    REQUIRE(dual->at_idx(i).value == Approx(ev->at_idx(i).value));
+  }
+
+  // Plans and windowed queries use the same semantics.
+  const auto phi  = stl::Always(x | stl::Eventually(~x, {0.0, 0.5}), {a, b});
+  const auto tree = stl::compute_robustness(phi, trace, options);
+  const auto plan = stl::compute_robustness(stl::EvaluationPlan{phi}, trace, options);
+  REQUIRE(plan->size() == tree->size());
+  for (size_t i = 0; i < tree->size(); i++) {
+    REQUIRE(plan->at_idx(i).value == Approx(tree->at_idx(i).value));
+  }
+  // The averages are interpolated linearly between their breakpoints, so the samples
+  // added at the ends of a window change the (nested) averages slightly.
+  const double t = tree->at_idx(100).time;
+  REQUIRE(
+      stl::compute_robustness_at(phi, trace, t, options) ==
+      Approx(tree->at_idx(100).value).epsilon(1e-3));
+}
+
+TEST_CASE("Robustness with the cumulative semantics", "[robustness][cumulative]") {
+  const auto x     = stl::Predicate("x") > 0.5;
+  const auto sig   = get_signal(300);
+  const auto trace = Trace{{"x", sig}};
+
+  SECTION("Predicates are split into their positive and negative parts") {
+    const auto [pos, neg] = stl::compute_cumulative_robustness(x, trace);
+    for (const auto& t : {0.0, 0.125, 3.3, sig->end_time()}) {
+      const double v = value_at(*sig, t) - 0.5;
+      REQUIRE(value_at(*pos, t) == Approx(std::max(v, 0.0)).margin(1e-9));
+      REQUIRE(value_at(*neg, t) == Approx(std::min(v, 0.0)).margin(1e-9));
+    }
+    for (const auto s : *pos) { REQUIRE(s.value >= 0.0); }
+    for (const auto s : *neg) { REQUIRE(s.value <= 0.0); }
+
+    // Negations swap them.
+    const auto [not_pos, not_neg] = stl::compute_cumulative_robustness(~x, trace);
+    REQUIRE(not_pos->size() == neg->size());
+    for (size_t i = 0; i < neg->size(); i++) {
+      REQUIRE(not_pos->at_idx(i).value == -neg->at_idx(i).value);
+      REQUIRE(not_neg->at_idx(i).value == -pos->at_idx(i).value);
+    }
+  }
+
+  SECTION("Eventually integrates over its interval") {
+    const auto [pos, neg] = stl::compute_cumulative_robustness(x, trace);
+    const auto [ev_pos, ev_neg] =
+        stl::compute_cumulative_robustness(stl::Eventually(x, {0.0, 2.0}), trace);
+    for (size_t i = 0; i < ev_pos->size(); i += 11) {
+      const double t  = ev_pos->at_idx(i).time;
+      const double hi = std::min(t + 2.0, sig->end_time());
+      REQUIRE(ev_pos->at_idx(i).value == Approx(integrate(*pos, t, hi)).margin(1e-6));
+      REQUIRE(ev_neg->at_idx(i).value == Approx(integrate(*neg, t, hi)).margin(1e-6));
+    }
+
+    // Satisfying the operand for longer is better (at the samples, which both
+    // integrals have).
+    const auto [longer, _] =
+        stl::compute_cumulative_robustness(stl::Eventually(x, {0.0, 4.0}), trace);
+    for (const auto s : *sig) {
+      REQUIRE(value_at(*longer, s.time) >= value_at(*ev_pos, s.time) - 1e-12);
+    }
+  }
+
+  SECTION("Constants") {
+    const auto [pos, neg] = stl::compute_cumulative_robustness(
+        stl::Const(true) & stl::Always(x, {0.0, 1.0}), trace);
+    REQUIRE(pos->front().value >= 0.0);
+    REQUIRE(neg->front().value <= 0.0);
+  }
+
+  REQUIRE_THROWS_AS(
+      stl::compute_cumulative_robustness(stl::Until(x, ~x), trace),
+      std::invalid_argument);
+}
+
+TEST_CASE("Robustness over compressed traces", "[robustness][compression]") {
+  // Piecewise constant channels, logged at the same high rate.
+  auto times    = std::vector<double>{};
+  auto channels = std::map<std::string, std::vector<double>>{};
+  for (size_t i = 0; i < 2000; i++) {
+    times.push_back(0.01 * static_cast<double>(i));
+    channels["mode"].push_back(static_cast<double>((i / 150) % 3));
+    channels["setpoint"].push_back(0.5 * static_cast<double>((i / 400) % 2));
+  }
+  const auto raw        = make_trace(std::vector{times}, std::map{channels});
+  const auto compressed = make_compressed_trace(times, std::move(channels));
+  REQUIRE(compressed.at("mode")->size() < raw.at("mode")->size() / 50);
+  REQUIRE(compressed.at("setpoint")->size() < raw.at("setpoint")->size() / 100);
+
+  const auto mode     = stl::Predicate("mode");
+  const auto setpoint = stl::Predicate("setpoint");
+  const auto phi      = stl::Always(
+      (mode >= 1) | stl::Eventually(setpoint > 0.25 & mode < 2, {0.0, 1.5}),
+      {0.0, 4.0});
+
+  // The robustness is the same, from far fewer samples.
+  const auto expected = stl::compute_robustness(phi, raw);
+  const auto rob      = stl::compute_robustness(phi, compressed);
+  for (const double t : times) {
+    REQUIRE(value_at(*rob, t) == Approx(value_at(*expected, t)).margin(1e-12));
+  }
+}
+
+TEST_CASE("Predicates over the same signal are computed together", "[robustness]") {
+  using signal_tl::ast::ComparisonOp;
+  const auto x          = get_signal(5000);
+  const auto predicates = std::vector<std::pair<ComparisonOp, double>>{
+      {ComparisonOp::GT, 0.5},
+      {ComparisonOp::LE, -0.25},
+      {ComparisonOp::GE, 1.0},
+      {ComparisonOp::LT, 0.0}};
+  const auto ys = stl::semantics::compute_predicates(x, predicates);
+  REQUIRE(ys.size() == predicates.size());
+  for (size_t i = 0; i < ys.size(); i++) {
+    const auto& [op, c] = predicates[i];
+    const double sign   = (op == ComparisonOp::GT || op == ComparisonOp::GE) ? 1 : -1;
+    const auto expected = x->affine(sign, -sign * c);
+    REQUIRE(ys[i]->size() == x->size());
+    for (size_t j = 0; j < x->size(); j++) {
+      REQUIRE(ys[i]->at_idx(j).time == expected->at_idx(j).time);
+      REQUIRE(ys[i]->at_idx(j).value == expected->at_idx(j).value);
+      REQUIRE(ys[i]->at_idx(j).derivative == expected->at_idx(j).derivative);
+    }
+    // Only the values are materialized.
+    REQUIRE(ys[i]->value_column().data() != x->value_column().data());
+    REQUIRE(ys[i]->time_column().data() == x->time_column().data());
+  }
+  REQUIRE(ys[0]->derivative_column().data() == x->derivative_column().data());
+  REQUIRE(ys[1]->derivative_column().data() == ys[3]->derivative_column().data());
+
+  // The outputs keep the columns of `x` alive.
+  auto times     = std::vector<double>(x->times().begin(), x->times().end());
+  auto values    = times;
+  auto z         = std::make_shared<Signal>(std::move(values), std::move(times));
+  auto zs        = stl::semantics::compute_predicates(z, predicates);
+  const double t = z->at_idx(10).time;
+  z.reset();
+  REQUIRE(zs[2]->at_idx(10).value == t - 1.0);
+
+  // Formulas with many predicates over each signal have the same robustness.
+  auto trace = Trace{{"x", x}, {"y", get_signal(3000)}};
+  auto args  = std::vector<stl::ast::Expr>{};
+  for (int i = 0; i < 20; i++) {
+    const double c = 0.1 * i - 1.0;
+    args.push_back(stl::Eventually(stl::Predicate("x") > c, {0.0, 0.1 * i + 0.1}));
+    args.push_back(stl::Always(stl::Predicate("y") <= c, {0.0, 0.2 * i + 0.1}));
+  }
+  const auto phi = stl::Or(args);
+  // The predicates of each signal are computed a few at a time, possibly for
+  // concurrently evaluated subformulas.
+  auto options        = stl::EvaluationOptions{};
+  options.num_threads = GENERATE(1, 4);
+  const auto rob      = stl::compute_robustness(phi, trace, options);
+  // Plans compute the predicates one at a time.
+  auto profile             = stl::EvaluationProfile{};
+  options.profile          = &profile;
+  const auto one_at_a_time = stl::compute_robustness(phi, trace, options);
+  REQUIRE(rob->size() == one_at_a_time->size());
+  for (size_t i = 0; i < rob->size(); i++) {
+    REQUIRE(rob->at_idx(i).value == one_at_a_time->at_idx(i).value);
+  }
+}
@@ -1,12 +1,18 @@
 #include "signal_tl/signal.hpp" // for Sample, Signal, signal
 
+#include "helpers.hpp" // for value_at
+
 #include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo
 
-#include <memory> // for __shared_ptr_access, shared_ptr, all...
-#include <random> // for default_random_engine, random_device
-#include <vector> // for vector
+#include <cstddef>   // for ptrdiff_t
+#include <limits>    // for numeric_limits
+#include <memory>    // for __shared_ptr_access, shared_ptr, all...
+#include <random>    // for default_random_engine, random_device
+#include <stdexcept> // for invalid_argument, out_of_range
+#include <vector>    // for vector
 
 using namespace signal_tl::signal;
+using helpers::value_at;
 
 namespace {
 class MonotonicIncreasingTimestampedSignal
@@ -73,3 +79,350 @@ TEST_CASE("Signals are monotonically increasing", "[signal]") {
     REQUIRE_NOTHROW(Signal{samples});
   }
 }
+
+TEST_CASE("Signal columns are consistent with the samples", "[signal]") {
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+  auto sig = Signal{std::vector<double>{1.0, 3.0, 2.0}, std::vector<double>{0, 1, 3}};
+
+  REQUIRE(sig.size() == 3);
+  REQUIRE(sig.times().size() == 3);
+  REQUIRE(sig.values().size() == 3);
+  REQUIRE(sig.derivatives().size() == 3);
+
+  size_t idx = 0;
+  for (const auto s : sig) {
+    REQUIRE(s.time == sig.times()[idx]);
+    REQUIRE(s.value == sig.values()[idx]);
+    REQUIRE(s.derivative == sig.derivatives()[idx]);
+    idx++;
+  }
+  REQUIRE(sig.derivatives()[0] == Approx(2.0));
+  REQUIRE(sig.derivatives()[1] == Approx(-0.5));
+  REQUIRE(sig.derivatives()[2] == Approx(0.0));
+  REQUIRE(sig.rbegin()->time == Approx(3.0));
+
+  SECTION("Taking ownership of columns validates the time stamps") {
+    REQUIRE_THROWS(Signal{std::vector<double>{1.0, 2.0}, std::vector<double>{1, 1}});
+    REQUIRE_THROWS(Signal{std::vector<double>{1.0}, std::vector<double>{0, 1}});
+  }
+
+  SECTION("Affine maps are applied to values and derivatives") {
+    auto y = sig.affine(-2.0, 1.0); // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+    REQUIRE(y->size() == sig.size());
+    for (size_t i = 0; i < sig.size(); i++) {
+      REQUIRE(y->at_idx(i).time == sig.at_idx(i).time);
+      REQUIRE(y->at_idx(i).value == Approx(-2.0 * sig.at_idx(i).value + 1.0));
+      REQUIRE(y->at_idx(i).derivative == Approx(-2.0 * sig.at_idx(i).derivative));
+    }
+  }
+}
+
+TEST_CASE("Signals are accessed by index and by time", "[signal]") {
+  const auto x =
+      Signal{std::vector{1.0, 3.0, 0.0, 2.0}, std::vector{0.0, 1.0, 2.0, 4.0}};
+
+  REQUIRE(x[1].value == 3.0);
+  REQUIRE(x[1].derivative == Approx(-3.0));
+  REQUIRE(x.interpolate(1.5, 1) == Approx(1.5));
+  REQUIRE_THROWS_AS(x.at_idx(4), std::out_of_range);
+
+  REQUIRE(x.at(1.0).value == 3.0);
+  REQUIRE(x.at(3.0).value == Approx(1.0));
+  REQUIRE(x.at(3.0).derivative == Approx(1.0));
+  REQUIRE(x.at(4.0).value == 2.0);
+  REQUIRE_THROWS_AS(x.at(-1.0), std::invalid_argument);
+  REQUIRE_THROWS_AS(x.at(5.0), std::invalid_argument);
+
+  for (const double t : {-1.0, 0.0, 0.5, 1.0, 2.0, 3.0, 4.0, 5.0}) {
+    const auto idx = x.end_at(t) - x.begin();
+    auto expected  = std::ptrdiff_t{0};
+    while (expected < 4 && x.times()[expected] <= t) { expected++; }
+    REQUIRE(idx == expected);
+  }
+}
+
+TEST_CASE("Signals are appended to and adopted in bulk", "[signal]") {
+  auto x = Signal{std::vector{1.0, 3.0}, std::vector{0.0, 1.0}};
+  const auto y = Signal{std::vector{0.0, 2.0, 2.0}, std::vector{2.0, 4.0, 5.0}};
+
+  SECTION("Derivatives are computed in the same pass") {
+    const auto ts = std::vector{2.0, 4.0, 5.0};
+    const auto xs = std::vector{0.0, 2.0, 2.0};
+    x.append({ts.data(), ts.size()}, {xs.data(), xs.size()});
+  }
+  SECTION("The derivatives of another signal are reused") {
+    x.append_sorted(y.times(), y.values(), y.derivatives());
+  }
+
+  // Either way, the result is the same as pushing the samples one by one.
+  auto expected = Signal{std::vector{1.0, 3.0}, std::vector{0.0, 1.0}};
+  for (const auto s : y) { expected.push_back(s); }
+  REQUIRE(x.size() == expected.size());
+  for (size_t i = 0; i < x.size(); i++) {
+    REQUIRE(x[i].time == expected[i].time);
+    REQUIRE(x[i].value == expected[i].value);
+    REQUIRE(x[i].derivative == Approx(expected[i].derivative));
+  }
+
+  // The first time stamp is always checked, and the rest unless they are sorted.
+  REQUIRE_THROWS_AS(
+      x.append_sorted(y.times(), y.values(), y.derivatives()), std::invalid_argument);
+  REQUIRE_THROWS_AS(
+      x.append(y.times(), {y.values().data(), 2}), std::invalid_argument);
+  const auto ts = std::vector{8.0, 7.0};
+  REQUIRE_THROWS_AS(
+      x.append({ts.data(), ts.size()}, {ts.data(), ts.size()}), std::invalid_argument);
+  REQUIRE_THROWS_AS(
+      Signal(std::vector{1.0, 2.0, 3.0}, std::vector{0.0, 2.0, 1.0}),
+      std::invalid_argument);
+
+  const auto z = Signal::from_sorted(
+      Column{std::vector{1.0, 3.0, 0.0}}, Column{std::vector{0.0, 1.0, 2.0}});
+  REQUIRE(z->size() == 3);
+  REQUIRE(z->front().derivative == Approx(2.0));
+  REQUIRE(z->back().derivative == 0.0);
+  REQUIRE_THROWS_AS(
+      Signal::from_sorted(Column{std::vector{1.0}}, Column{std::vector{0.0, 1.0}}),
+      std::invalid_argument);
+}
+
+TEST_CASE("Signals can view external columns", "[signal]") {
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+  auto data  = std::make_shared<std::vector<double>>(std::vector<double>{0, 1, 3, 5});
+  auto times = Column::view(data->data(), 3, data);
+  auto vals  = Column::view(data->data() + 1, 3, data);
+  REQUIRE(times.is_view());
+  REQUIRE(times.owner() == data);
+
+  auto sig = Signal{std::move(vals), std::move(times)};
+  REQUIRE(sig.size() == 3);
+  REQUIRE(sig.times().data() == data->data());
+  REQUIRE(sig.values().data() == data->data() + 1);
+  REQUIRE(sig.at_idx(2).value == 5);
+  REQUIRE(sig.derivatives()[0] == Approx(2.0));
+  REQUIRE(sig.derivatives()[1] == Approx(1.0));
+
+  SECTION("Views keep the memory alive") {
+    auto* raw = data->data();
+    data.reset();
+    REQUIRE(sig.times().data() == raw);
+    REQUIRE(sig.back().value == 5);
+  }
+
+  SECTION("Copies share the viewed memory") {
+    const auto copy = Signal{sig};
+    REQUIRE(copy.times().data() == sig.times().data());
+  }
+
+  SECTION("Modifying a signal copies the viewed columns") {
+    sig.push_back(4.0, 0.0);
+    REQUIRE(sig.size() == 4);
+    REQUIRE_FALSE(sig.time_column().is_view());
+    REQUIRE(data->size() == 4);
+    REQUIRE((*data)[3] == 5);
+    REQUIRE(sig.derivatives()[2] == Approx(-5.0));
+  }
+
+  SECTION("The time stamps are validated") {
+    auto bad = Column::view(data->data(), 3, data);
+    REQUIRE_THROWS(Signal{Column::view(data->data(), 2, data), std::move(bad)});
+    auto reversed = std::vector<double>{3, 1, 0};
+    REQUIRE_THROWS(Signal{Column::view(data->data(), 3, data), std::move(reversed)});
+  }
+}
+
+TEST_CASE("Signals are synchronized over the union of their time points", "[signal]") {
+  auto x = std::make_shared<Signal>();
+  x->push_back(0.0, 0.0);
+  x->push_back(2.0, 2.0);
+  x->push_back(4.0, 0.0);
+  auto y = std::make_shared<Signal>();
+  y->push_back(1.0, 1.0);
+  y->push_back(3.0, 3.0);
+  y->push_back(5.0, 1.0);
+
+  const auto [x_, y_] = synchronize(x, y);
+  REQUIRE(x_->size() == 4);
+  REQUIRE(y_->size() == 4);
+  // Both start at the later begin time and end at the earlier end time.
+  const auto expected_times = std::vector<double>{1, 2, 3, 4};
+  const auto expected_x     = std::vector<double>{1, 2, 1, 0};
+  const auto expected_y     = std::vector<double>{1, 2, 3, 2};
+  for (size_t i = 0; i < 4; i++) {
+    REQUIRE(x_->at_idx(i).time == expected_times[i]);
+    REQUIRE(y_->at_idx(i).time == expected_times[i]);
+    REQUIRE(x_->at_idx(i).value == Approx(expected_x[i]));
+    REQUIRE(y_->at_idx(i).value == Approx(expected_y[i]));
+  }
+  // The time stamps are shared.
+  REQUIRE(x_->times().data() == y_->times().data());
+
+  SECTION("The view yields the same points") {
+    const auto view = SynchronizedView{*x, *y};
+    size_t i        = 0;
+    for (const auto& p : view) {
+      REQUIRE(i < 4);
+      REQUIRE(p.time == expected_times[i]);
+      REQUIRE(p.x == Approx(expected_x[i]));
+      REQUIRE(p.y == Approx(expected_y[i]));
+      i++;
+    }
+    REQUIRE(i == 4);
+  }
+
+  SECTION("Constant infinite signals are synchronized") {
+    constexpr double TOP = std::numeric_limits<double>::infinity();
+    const auto top       = std::make_shared<Signal>(
+        std::vector<double>{TOP, TOP}, std::vector<double>{0.0, 10.0});
+    REQUIRE(top->front().derivative == 0.0);
+
+    const auto [a, b] = synchronize(top, y);
+    REQUIRE(a->size() == 3);
+    for (const auto s : *a) { REQUIRE(s.value == TOP); }
+    REQUIRE(b->at_idx(1).value == Approx(3.0));
+  }
+
+  SECTION("Signals that don't overlap are empty after synchronization") {
+    auto z = std::make_shared<Signal>();
+    z->push_back(6.0, 0.0);
+    z->push_back(7.0, 0.0);
+    const auto [a, b] = synchronize(x, z);
+    REQUIRE(a->empty());
+    REQUIRE(b->empty());
+  }
+}
+
+TEST_CASE("Signals in a trace can share their time stamps", "[signal][trace]") {
+  const auto trace = make_trace(
+      {0.0, 1.0, 2.0, 3.0}, {{"x", {1.0, 2.0, 0.0, 1.0}}, {"y", {0.0, 1.0, 1.0, 3.0}}});
+  const auto& x = trace.at("x");
+  const auto& y = trace.at("y");
+  REQUIRE(x->size() == 4);
+  REQUIRE(x->times().data() == y->times().data());
+  REQUIRE(x->at_idx(1).derivative == Approx(-2.0));
+
+  SECTION("Separately sampled signals are rebased on a shared time column") {
+    const auto copy = [](const SignalPtr& sig) {
+      return std::make_shared<Signal>(
+          std::vector<double>{sig->values().begin(), sig->values().end()},
+          std::vector<double>{sig->times().begin(), sig->times().end()});
+    };
+    const auto other = Trace{
+        {"x", copy(x)},
+        {"y", copy(y)},
+        {"z", std::make_shared<Signal>(std::vector{1.0, 2.0}, std::vector{0.0, 2.0})},
+    };
+    REQUIRE(other.at("x")->times().data() != other.at("y")->times().data());
+
+    const auto shared = share_time_bases(other);
+    REQUIRE(shared.at("x")->times().data() == shared.at("y")->times().data());
+    REQUIRE(shared.at("z")->size() == 2);
+    for (const auto& [name, sig] : other) {
+      const auto& rebased = shared.at(name);
+      REQUIRE(rebased->size() == sig->size());
+      for (size_t i = 0; i < sig->size(); i++) {
+        REQUIRE(rebased->at_idx(i).time == sig->at_idx(i).time);
+        REQUIRE(rebased->at_idx(i).value == sig->at_idx(i).value);
+        REQUIRE(rebased->at_idx(i).derivative == sig->at_idx(i).derivative);
+      }
+    }
+
+    REQUIRE_THROWS_AS(share_time_bases(other, true), std::invalid_argument);
+  }
+
+  SECTION("Affine transforms keep sharing the time stamps") {
+    REQUIRE(x->affine(-1.0, 2.0)->times().data() == x->times().data());
+  }
+}
+
+TEST_CASE("Signals can be sliced to a time range", "[signal]") {
+  const auto x = std::make_shared<Signal>(
+      std::vector{1.0, 3.0, 0.0, 2.0}, std::vector{0.0, 1.0, 2.0, 4.0});
+
+  SECTION("Ranges that end on samples view the columns") {
+    const auto y = slice(x, 1.0, 2.0);
+    REQUIRE(y->size() == 2);
+    REQUIRE(y->times().data() == x->times().data() + 1);
+    REQUIRE(y->values().data() == x->values().data() + 1);
+    REQUIRE(y->at_idx(0).derivative == Approx(-3.0));
+    REQUIRE(y->back().derivative == 0.0);
+  }
+
+  SECTION("The ends are interpolated") {
+    const auto y = slice(x, 0.5, 3.0);
+    REQUIRE(y->size() == 4);
+    REQUIRE(y->front().time == 0.5);
+    REQUIRE(y->front().value == Approx(2.0));
+    REQUIRE(y->back().time == 3.0);
+    REQUIRE(y->back().value == Approx(1.0));
+
+    const auto z = slice(x, 2.5, 2.5);
+    REQUIRE(z->size() == 1);
+    REQUIRE(z->front().value == Approx(0.5));
+  }
+
+  SECTION("Ranges are clipped to the signal") {
+    REQUIRE(slice(x, -1.0, 10.0) == x);
+    REQUIRE(slice(x, 3.0, 10.0)->begin_time() == 3.0);
+    REQUIRE(slice(x, 3.0, 10.0)->end_time() == 4.0);
+    REQUIRE(slice(x, 5.0, 10.0)->empty());
+  }
+}
+
+TEST_CASE("Signals can be compressed to their breakpoints", "[signal]") {
+  constexpr double INF = std::numeric_limits<double>::infinity();
+
+  // A piecewise constant channel, logged at a high rate, and a ramp.
+  auto times  = std::vector<double>{};
+  auto values = std::vector<double>{};
+  for (size_t i = 0; i < 1000; i++) {
+    times.push_back(0.01 * static_cast<double>(i));
+    values.push_back((i < 900) ? static_cast<double>(i / 100) : 0.5 * (i % 2));
+  }
+  const auto x = std::make_shared<Signal>(values, times);
+
+  SECTION("Only the ends of constant runs are kept") {
+    const auto y = Signal::compressed(std::vector{values}, std::vector{times});
+    REQUIRE(y->size() == 2 * 9 + 100);
+    REQUIRE(y->times().size() == y->values().size());
+    REQUIRE(y->front().time == x->front().time);
+    REQUIRE(y->back().time == x->back().time);
+    for (const auto s : *x) {
+      REQUIRE(value_at(*y, s.time) == s.value);
+    }
+
+    // `simplify` keeps the same breakpoints.
+    const auto z = x->simplify();
+    REQUIRE(z->size() == y->size());
+    for (size_t i = 0; i < y->size(); i++) {
+      REQUIRE(z->at_idx(i).time == y->at_idx(i).time);
+      REQUIRE(z->at_idx(i).value == y->at_idx(i).value);
+      REQUIRE(z->at_idx(i).derivative == y->at_idx(i).derivative);
+    }
+  }
+
+  SECTION("Samples within the tolerance of the segments are dropped") {
+    auto noisy = values;
+    for (size_t i = 0; i < noisy.size(); i++) { noisy[i] += 1e-3 * ((i % 3) - 1.0); }
+    const auto y = Signal::compressed(std::move(noisy), std::vector{times}, 0.01);
+    REQUIRE(y->size() <= 2 * 9 + 100);
+    for (const auto s : *x) {
+      REQUIRE(value_at(*y, s.time) == Approx(s.value).margin(0.01 + 1e-3));
+    }
+  }
+
+  SECTION("Infinite values are only merged when equal") {
+    const auto y = Signal::compressed(
+        {INF, INF, INF, -INF, 1.0, 1.0}, {0.0, 1.0, 2.0, 3.0, 4.0, 5.0});
+    REQUIRE(y->size() == 5);
+    REQUIRE(y->at_idx(1).time == 2.0);
+    REQUIRE(y->at_idx(1).value == INF);
+    REQUIRE(y->back().value == 1.0);
+  }
+
+  SECTION("The time stamps are validated") {
+    REQUIRE_THROWS_AS(
+        Signal::compressed({1.0, 1.0, 1.0}, {0.0, 2.0, 1.0}), std::invalid_argument);
+    REQUIRE_THROWS_AS(Signal::compressed({1.0}, {0.0, 1.0}), std::invalid_argument);
+  }
+}
@@ -0,0 +1,154 @@
+#include "signal_tl/signal_tl.hpp" // for simplify, Predicate, Always, Eventually, ...
+
+#include "helpers.hpp" // for sample_signal, value_at
+
+#include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo, StringRef
+
+#include <cmath>   // for sin, cos
+#include <limits>  // for numeric_limits
+#include <variant> // for get, holds_alternative
+#include <vector>  // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+using signal_tl::ast::ExprEqual;
+using helpers::sample_signal;
+using helpers::value_at;
+
+namespace {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+Trace get_trace(size_t n) {
+  // Irregular sampling.
+  auto ts  = std::vector<double>{};
+  double t = 0;
+  for (size_t i = 0; i < n; i++) {
+    ts.push_back(t);
+    t += (i % 3 == 0) ? 0.05 : 0.2;
+  }
+  const auto x = [](double s) { return std::sin(s) + 0.5 * std::cos(2.9 * s); };
+  const auto y = [](double s) { return std::cos(0.7 * s) - 0.3 * std::sin(4.1 * s); };
+  return Trace{{"x", sample_signal(x, ts)}, {"y", sample_signal(y, ts)}};
+}
+
+} // namespace
+
+TEST_CASE("Formulas are simplified", "[simplify]") {
+  using stl::ast::simplify;
+  const auto x    = stl::Predicate("x");
+  const auto y    = stl::Predicate("y");
+  const auto same = [](const Expr& lhs, const Expr& rhs) {
+    return ExprEqual{}(lhs, rhs);
+  };
+
+  SECTION("Constants are folded") {
+    REQUIRE(same(simplify(stl::Not(stl::Const(true))), stl::Const(false)));
+    REQUIRE(same(simplify(stl::And({x > 0, stl::Const(false)})), stl::Const(false)));
+    REQUIRE(same(simplify(stl::Or({x > 0, stl::Const(false)})), x > 0));
+    REQUIRE(same(
+        simplify(stl::Always(stl::Const(true), {1.0, 2.0})), stl::Const(true)));
+    REQUIRE(same(simplify(stl::Until(x > 0, stl::Const(false))), stl::Const(false)));
+    REQUIRE(same(
+        simplify(stl::Until(stl::Const(true), y > 0, {1.0, 2.0})),
+        stl::Eventually(y > 0, {1.0, 2.0})));
+  }
+
+  SECTION("Negations are pushed down to the predicates") {
+    REQUIRE(same(simplify(~(x > 1)), x <= 1));
+    REQUIRE(same(simplify(~(x <= 1)), x > 1));
+    REQUIRE(same(simplify(~~stl::Always(x > 1)), stl::Always(x > 1)));
+    REQUIRE(same(
+        simplify(~stl::Always((x > 1) & (y < 2), {0.0, 1.0})),
+        stl::Eventually((x <= 1) | (y >= 2), {0.0, 1.0})));
+
+    // Negations that wouldn't be absorbed are kept.
+    const auto u = stl::Until(x > 0, y > 0);
+    REQUIRE(same(simplify(~u), ~u));
+    REQUIRE(same(simplify(~((x > 1) & u)), ~((x > 1) & u)));
+  }
+
+  SECTION("Predicates over the same signal are collapsed") {
+    REQUIRE(same(simplify((x > 1) & (y < 0) & (x >= 2)), (x >= 2) & (y < 0)));
+    REQUIRE(same(simplify((x < 1) & (x < 3)), x < 1));
+    REQUIRE(same(simplify((x < 1) | (x < 3)), x < 3));
+    REQUIRE(same(simplify((x > 1) | (x < 3) | (x > 2)), (x > 1) | (x < 3)));
+    // The satisfaction at the bound is the same as the original's.
+    REQUIRE(same(simplify((x > 1) & (x >= 1)), x > 1));
+    REQUIRE(same(simplify((x > 1) | (x >= 1)), x >= 1));
+  }
+
+  SECTION("Nested temporal operators are merged") {
+    REQUIRE(same(
+        simplify(stl::Always(stl::Always(x > 0, {1.0, 2.0}), {0.5, 3.0})),
+        stl::Always(x > 0, {1.5, 5.0})));
+    const auto f =
+        simplify(stl::Eventually(stl::Eventually(x > 0, {1ULL, 2ULL}), {3ULL, 4ULL}));
+    REQUIRE(same(f, stl::Eventually(x > 0, {4ULL, 6ULL})));
+    const auto& steps = std::get<stl::ast::EventuallyPtr>(f)->interval;
+    REQUIRE(std::get<unsigned long long int>(steps.high) == 6);
+    REQUIRE(same(
+        simplify(stl::Eventually(stl::Eventually(x > 0), {1.0, 2.0})),
+        stl::Eventually(x > 0, {1.0, INF})));
+    REQUIRE(same(simplify(stl::Always(x > 0, {2ULL, 2ULL})), x > 0));
+
+    // Only for the classic semantics, e.g., averages of averages aren't averages.
+    auto options    = stl::ast::SimplifyOptions{};
+    options.classic = false;
+    const auto g    = stl::Always(stl::Always(x > 0, {1.0, 2.0}), {0.5, 3.0});
+    REQUIRE(same(simplify(g, options), g));
+  }
+
+  SECTION("Shared subformulas stay shared") {
+    const auto shared = stl::Eventually((x > 0) & (x > 1), {0.0, 1.0});
+    const auto phi    = stl::And({stl::Always(shared), ~shared, shared | (y > 0)});
+    const auto out    = simplify(phi);
+
+    const auto& args = std::get<stl::ast::AndPtr>(out)->args;
+    REQUIRE(args.size() == 3);
+    const auto& g = std::get<stl::ast::AlwaysPtr>(args[0]);
+    const auto& n = std::get<stl::ast::NotPtr>(args[1]);
+    const auto& o = std::get<stl::ast::OrPtr>(args[2]);
+    REQUIRE(same(g->arg, stl::Eventually(x > 1, {0.0, 1.0})));
+    REQUIRE(stl::ast::node_address(g->arg) == stl::ast::node_address(n->arg));
+    REQUIRE(stl::ast::node_address(g->arg) == stl::ast::node_address(o->args[0]));
+
+    // Subformulas that don't simplify are reused as they are.
+    const auto f = stl::Eventually((x > 0) | (y > 0), {0.0, 1.0});
+    REQUIRE(stl::ast::node_address(simplify(f)) == stl::ast::node_address(f));
+  }
+}
+
+TEST_CASE("Simplified formulas have the same robustness", "[simplify]") {
+  const auto x         = stl::Predicate("x");
+  const auto y         = stl::Predicate("y");
+  const auto semantics = GENERATE(stl::Semantics::Classic, stl::Semantics::Filtering);
+  const auto phi = GENERATE_COPY(
+      Expr{(x > 0.5) & (x > 1.0) & (y < 0.2)},
+      Expr{~((x > 0) | (x > 0.3) | stl::Always(y <= 0.1))},
+      Expr{~(stl::Always(x > 0, {0.0, 1.0}) | stl::Eventually(y <= 0.3, {0.5, 2.0}))},
+      Expr{stl::Always(stl::Always(x > -0.5, {0.0, 2.0}), {0.5, 1.0})},
+      Expr{stl::Eventually(stl::Eventually(y > 0, {0.2, 0.4}), {1.0, INF})},
+      Expr{stl::Eventually(stl::Eventually(y > 0), {1.0, 2.0})},
+      Expr{stl::Until(stl::Const(true), y > 0, {0.5, 2.0})},
+      Expr{stl::Until(stl::Const(true), y > 0)},
+      Expr{stl::Until(x > 0, y > 0) & stl::Const(true)},
+      Expr{~~((x > 0) | (x >= 1))},
+      Expr{~stl::Until(x > 0, ~(y > 0), {0.0, 1.0})},
+      Expr{stl::Always(x > 0, {1ULL, 1ULL}) | stl::Const(false)});
+
+  const auto trace  = get_trace(200);
+  auto options      = stl::EvaluationOptions{};
+  options.semantics = semantics;
+  options.simplify  = false;
+  const auto rob    = stl::compute_robustness(phi, trace, options);
+  options.simplify  = true;
+  const auto out    = stl::compute_robustness(phi, trace, options);
+
+  REQUIRE(out->begin_time() == rob->begin_time());
+  REQUIRE(out->end_time() == rob->end_time());
+  for (const auto& s : *rob) {
+    REQUIRE(value_at(*out, s.time) == Approx(s.value).margin(1e-9));
+  }
+}
@@ -0,0 +1,145 @@
+#include "signal_tl/spec_cache.hpp"          // for serialize_specification, ...
+#include "signal_tl/ast.hpp"                 // for Expr, ExprEqual, node_address
+#include "signal_tl/internal/filesystem.hpp" // for temp_directory_path, remove
+#include "signal_tl/parser.hpp"              // for Specification
+
+#include <catch2/catch.hpp> // for operator==, SourceLineInfo, StringRef
+
+#include <cmath>     // for isinf
+#include <stdexcept> // for invalid_argument
+#include <string>    // for string, to_string
+#include <variant>   // for get
+#include <vector>    // for vector
+
+namespace stl = signal_tl;
+using signal_tl::ast::Expr;
+using signal_tl::ast::ExprEqual;
+
+namespace {
+
+/// A specification with `k` formulas, each using the previous one (as a generated
+/// requirements file would).
+stl::Specification get_spec(size_t k) {
+  auto spec = stl::Specification{};
+  auto prev = Expr{stl::Predicate("p") < 0};
+  spec.formulas.emplace("phi0", prev);
+  for (size_t i = 1; i < k; i++) {
+    const auto x = stl::Predicate("x") > static_cast<double>(i) + 0.5;
+    const auto y = stl::Predicate("y") <= -static_cast<double>(i);
+    prev         = stl::And(
+        {prev,
+         stl::Always(x, {0.0, 0.5 * static_cast<double>(i)}),
+         stl::Eventually(stl::Not(y), {1ULL, i + 1}),
+         stl::Until(y, stl::Const(i % 2 == 0))});
+    spec.formulas.emplace("phi" + std::to_string(i), prev);
+  }
+  spec.assertions.emplace("monitor", stl::Or({prev, stl::Predicate("p") >= 1}));
+  spec.assertions.emplace("unbounded", stl::Always(prev));
+  return spec;
+}
+
+void require_equal(const stl::Specification& lhs, const stl::Specification& rhs) {
+  REQUIRE(lhs.formulas.size() == rhs.formulas.size());
+  REQUIRE(lhs.assertions.size() == rhs.assertions.size());
+  for (const auto& [name, phi] : lhs.formulas) {
+    REQUIRE(ExprEqual{}(phi, rhs.formulas.at(name)));
+  }
+  for (const auto& [name, phi] : lhs.assertions) {
+    REQUIRE(ExprEqual{}(phi, rhs.assertions.at(name)));
+  }
+}
+
+} // namespace
+
+TEST_CASE("Specifications are serialized", "[spec_cache]") {
+  const auto spec = get_spec(50);
+  const auto data = stl::serialize_specification(spec, 42);
+  REQUIRE(stl::serialized_source_hash(data) == 42);
+
+  const auto loaded = stl::deserialize_specification(data);
+  require_equal(spec, *loaded);
+
+  // The formulas share their subformulas again, so they aren't expanded into trees.
+  const auto& phi1 = std::get<stl::ast::AndPtr>(loaded->formulas.at("phi1"));
+  const auto& phi2 = std::get<stl::ast::AndPtr>(loaded->formulas.at("phi2"));
+  REQUIRE(
+      stl::ast::node_address(phi2->args.front()) ==
+      stl::ast::node_address(loaded->formulas.at("phi1")));
+  REQUIRE(
+      stl::ast::node_address(phi1->args.front()) !=
+      stl::ast::node_address(phi2->args.front()));
+
+  // The intervals keep the types of their bounds.
+  const auto& g = std::get<stl::ast::AlwaysPtr>(phi2->args[1]);
+  REQUIRE(std::get<double>(g->interval.high) == 1.0);
+  const auto& f = std::get<stl::ast::EventuallyPtr>(phi2->args[2]);
+  REQUIRE(std::get<unsigned long long int>(f->interval.high) == 3);
+  const auto& u = std::get<stl::ast::UntilPtr>(phi2->args[3]);
+  REQUIRE(std::isinf(std::get<double>(u->interval.high)));
+}
+
+TEST_CASE("Deep specifications are serialized", "[spec_cache]") {
+  // Formulas that are built on other formulas can get very deep.
+  auto spec = stl::Specification{};
+  auto phi  = Expr{stl::Predicate("x") > 0};
+  for (size_t i = 0; i < 1000; i++) { phi = stl::Not(phi); }
+  spec.assertions.emplace("deep", phi);
+
+  const auto data   = stl::serialize_specification(spec, 0);
+  const auto loaded = stl::deserialize_specification(data);
+  REQUIRE(loaded->assertions.size() == 1);
+  REQUIRE(loaded->assertions.at("deep").index() == phi.index());
+}
+
+TEST_CASE("Invalid specification caches are rejected", "[spec_cache]") {
+  const auto data = stl::serialize_specification(get_spec(5), 7);
+
+  REQUIRE_THROWS_AS(
+      stl::deserialize_specification("not a cache"), std::invalid_argument);
+  REQUIRE_THROWS_AS(
+      stl::deserialize_specification(data.substr(0, data.size() - 1)),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(stl::deserialize_specification(data + "x"), std::invalid_argument);
+  auto other_version = data;
+  other_version[8]   = 3;
+  REQUIRE_THROWS_AS(
+      stl::deserialize_specification(other_version), std::invalid_argument);
+
+  // Caches written by other versions of the library (or of the AST) are rejected,
+  // even if they have the same format.
+  auto other_ast = data;
+  other_ast[12]++;
+  REQUIRE_THROWS_AS(stl::deserialize_specification(other_ast), std::invalid_argument);
+  auto other_library = data;
+  other_library[16]++;
+  REQUIRE_THROWS_AS(
+      stl::deserialize_specification(other_library), std::invalid_argument);
+}
+
+TEST_CASE("Specification caches are keyed by the source", "[spec_cache]") {
+  const auto source = std::string{"(define-formula phi (< p 0))"};
+  const auto hash   = stl::hash_source(source);
+  REQUIRE(hash != stl::hash_source(source + " "));
+
+  const auto path = stdfs::temp_directory_path() / "signal_tl_test.stlspec";
+  stdfs::remove(path);
+  REQUIRE(stl::read_spec_cache(path, hash) == nullptr);
+
+  const auto spec = get_spec(10);
+  stl::write_spec_cache(path, spec, hash);
+  const auto loaded = stl::read_spec_cache(path, hash);
+  REQUIRE(loaded != nullptr);
+  require_equal(spec, *loaded);
+
+  // Caches of other sources are ignored.
+  REQUIRE(stl::read_spec_cache(path, hash + 1) == nullptr);
+
+  // Caches are replaced as a whole, without leaving temporary files behind.
+  stl::write_spec_cache(path, get_spec(3), hash);
+  require_equal(get_spec(3), *stl::read_spec_cache(path, hash));
+  for (const auto& entry : stdfs::directory_iterator{path.parent_path()}) {
+    const auto name = entry.path().filename().string();
+    REQUIRE(name.rfind("signal_tl_test.stlspec.", 0) == std::string::npos);
+  }
+  stdfs::remove(path);
+}
@@ -0,0 +1,152 @@
+#include "signal_tl/signal_tl.hpp"  // for Signal, Predicate, compute_robust...
+#include "signal_tl/trace_file.hpp" // for TraceFile, write_trace_file
+
+#include <catch2/catch.hpp> // for AssertionHandler, operator""_catch_sr
+
+#include <cmath>        // for sin, cos
+#include <fstream>      // for ifstream, ofstream
+#include <iterator>     // for istreambuf_iterator
+#include <memory>       // for make_shared
+#include <set>          // for set
+#include <stdexcept>    // for out_of_range, invalid_argument, runtime_error
+#include <string>       // for string
+#include <system_error> // for error_code
+#include <utility>      // for move
+#include <vector>       // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+
+namespace {
+
+/// A temporary file that is removed once the test is done.
+struct TempFile {
+  stdfs::path path;
+
+  explicit TempFile(const std::string& name) :
+      path{stdfs::temp_directory_path() / ("signaltl_test_" + name)} {}
+  ~TempFile() {
+    std::error_code ec;
+    stdfs::remove(path, ec);
+  }
+
+  TempFile(const TempFile&)            = delete;
+  TempFile& operator=(const TempFile&) = delete;
+};
+
+SignalPtr get_signal(size_t n, double dt, double (*f)(double)) {
+  auto times  = std::vector<double>(n);
+  auto values = std::vector<double>(n);
+  for (size_t i = 0; i < n; i++) {
+    times[i]  = dt * static_cast<double>(i);
+    values[i] = f(times[i]);
+  }
+  return std::make_shared<Signal>(std::move(values), std::move(times));
+}
+
+double sin_(double t) {
+  return std::sin(t);
+}
+
+double cos_(double t) {
+  return std::cos(t);
+}
+
+} // namespace
+
+TEST_CASE("Traces round trip through trace files", "[signal][trace_file]") {
+  const auto file  = TempFile{"round_trip.stltrace"};
+  const auto trace = Trace{
+      {"x", get_signal(1000, 0.01, sin_)},
+      {"y", get_signal(1000, 0.01, cos_)},
+      {"z", get_signal(300, 0.03, cos_)},
+      {"w", std::make_shared<Signal>()}};
+  write_trace_file(file.path, trace);
+
+  const auto loaded = TraceFile{file.path};
+  REQUIRE(loaded.channels() == std::vector<std::string>{"w", "x", "y", "z"});
+  REQUIRE(loaded.contains("x"));
+  REQUIRE_FALSE(loaded.contains("p"));
+
+  for (const auto& [name, sig] : trace) {
+    INFO("Channel " << name);
+    const auto col = loaded.signal(name);
+    REQUIRE(col->size() == sig->size());
+    REQUIRE(col->time_column().is_view());
+    for (size_t i = 0; i < sig->size(); i++) {
+      REQUIRE(col->at_idx(i).time == sig->at_idx(i).time);
+      REQUIRE(col->at_idx(i).value == sig->at_idx(i).value);
+      REQUIRE(col->at_idx(i).derivative == sig->at_idx(i).derivative);
+    }
+  }
+
+  // Channels with the same time points share the time base in the file.
+  REQUIRE(loaded.signal("x")->times().data() == loaded.signal("y")->times().data());
+  REQUIRE(loaded.signal("x")->times().data() != loaded.signal("z")->times().data());
+
+  SECTION("Only the channels used by a formula are loaded") {
+    const auto phi = stl::Until(stl::Predicate("x") > 0, stl::Predicate("y") < 0.5) &
+                     stl::Always(stl::Predicate("x") < 0.9);
+    REQUIRE(stl::ast::signal_names(phi) == std::set<std::string>{"x", "y"});
+
+    const auto partial = loaded.trace(phi);
+    REQUIRE(partial.size() == 2);
+    const auto expected = stl::compute_robustness(phi, trace);
+    const auto actual   = stl::compute_robustness(phi, partial);
+    REQUIRE(actual->size() == expected->size());
+    for (size_t i = 0; i < expected->size(); i++) {
+      REQUIRE(actual->at_idx(i).value == Approx(expected->at_idx(i).value));
+    }
+  }
+
+  SECTION("Signals keep the file mapped") {
+    auto sig = TraceFile{file.path}.signal("z");
+    REQUIRE(sig->back().value == trace.at("z")->back().value);
+    // Modifying the signal copies the columns.
+    sig->push_back(100.0, 1.0);
+    REQUIRE(sig->size() == 301);
+    REQUIRE(TraceFile{file.path}.signal("z")->size() == 300);
+  }
+
+  SECTION("Missing channels throw") {
+    REQUIRE_THROWS_AS(loaded.signal("p"), std::out_of_range);
+    REQUIRE_THROWS_AS(loaded.trace({"x", "p"}), std::out_of_range);
+  }
+}
+
+TEST_CASE("Invalid trace files are rejected", "[signal][trace_file]") {
+  const auto file = TempFile{"invalid.stltrace"};
+
+  SECTION("Missing files") {
+    REQUIRE_THROWS_AS(TraceFile{file.path}, std::runtime_error);
+  }
+
+  SECTION("Files that aren't traces") {
+    std::ofstream{file.path} << "time,x\n0.0,1.0\n";
+    REQUIRE_THROWS_AS(TraceFile{file.path}, std::invalid_argument);
+  }
+
+  SECTION("Truncated files") {
+    write_trace_file(file.path, Trace{{"x", get_signal(100, 0.1, sin_)}});
+    stdfs::resize_file(file.path, stdfs::file_size(file.path) - 8);
+    REQUIRE_THROWS_AS(TraceFile{file.path}, std::invalid_argument);
+  }
+
+  SECTION("Duplicate channels") {
+    write_trace_file(
+        file.path,
+        Trace{{"xa", get_signal(100, 0.1, sin_)}, {"xb", get_signal(100, 0.1, cos_)}});
+    // Rename the second channel to the first one.
+    auto contents = std::string{};
+    {
+      auto in  = std::ifstream{file.path, std::ios::binary};
+      contents = std::string{std::istreambuf_iterator<char>{in}, {}};
+    }
+    const auto pos = contents.find("xaxb");
+    REQUIRE(pos != std::string::npos);
+    contents[pos + 3] = 'a';
+    std::ofstream{file.path, std::ios::binary} << contents;
+    REQUIRE_THROWS_WITH(
+        TraceFile{file.path}, Catch::Contains("Duplicate channel `xa`"));
+  }
+}
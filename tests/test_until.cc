@@ -0,0 +1,170 @@
+#include "signal_tl/signal_tl.hpp" // for Signal, Predicate, compute_robust...
+
+#include "helpers.hpp" // for value_at
+
+#include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo
+
+#include <algorithm> // for max, min, sort
+#include <cmath>     // for sin, cos
+#include <limits>    // for numeric_limits
+#include <memory>    // for make_shared
+#include <utility>   // for make_pair
+#include <vector>    // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using helpers::value_at;
+
+namespace {
+
+constexpr double TOP = std::numeric_limits<double>::infinity();
+
+SignalPtr make_signal(double (*f)(double), double dt, size_t n) {
+  auto sig = std::make_shared<Signal>();
+  for (size_t i = 0; i < n; i++) {
+    const double t = dt * static_cast<double>(i);
+    sig->push_back(t, f(t));
+  }
+  return sig;
+}
+
+double slow_sin(double t) {
+  return std::sin(t / 2);
+}
+
+double fast_cos(double t) {
+  return std::cos(2 * t) - 0.25;
+}
+
+/// Brute force computation of the robustness of `x U[a, b] y` at time `t`.
+///
+/// The infimum of `x` is exact (as it is attained at the breakpoints of `x` or the
+/// ends of the interval), while the supremum is taken over a dense grid in the
+/// window.
+double until_at(const Signal& x, const Signal& y, double t, double a, double b) {
+  const double end_time = std::min(x.end_time(), y.end_time());
+  const double lo       = std::min(t + a, end_time);
+  const double hi       = std::min(t + b, end_time);
+
+  auto points = std::vector<double>{t, lo, hi};
+  for (const auto& s : x) {
+    if (t <= s.time && s.time <= hi) {
+      points.push_back(s.time);
+    }
+  }
+  for (const auto& s : y) {
+    if (lo <= s.time && s.time <= hi) {
+      points.push_back(s.time);
+    }
+  }
+  for (double s = lo; s < hi; s += 1e-3) { points.push_back(s); }
+  std::sort(points.begin(), points.end());
+
+  double inf_x = TOP;
+  double opt   = -TOP;
+  for (const double s : points) {
+    inf_x = std::min(inf_x, value_at(x, s));
+    if (s >= lo) {
+      opt = std::max(opt, std::min(value_at(y, s), inf_x));
+    }
+  }
+  return opt;
+}
+
+} // namespace
+
+TEST_CASE("Until matches brute force robustness", "[robustness][until]") {
+  const auto x     = make_signal(slow_sin, 0.25, 101);
+  const auto y     = make_signal(fast_cos, 0.125, 201);
+  const auto trace = Trace{{"x", x}, {"y", y}};
+
+  // The narrow windows (where [0, b - a] has fewer than 24 samples) are scanned, and
+  // the wider ones are computed with the wedges.
+  const auto [a, b] = GENERATE(
+      std::make_pair(0.0, TOP),
+      std::make_pair(0.0, 1.0),
+      std::make_pair(0.3, 2.2),
+      std::make_pair(1.5, 4.0),
+      std::make_pair(2.0, TOP),
+      std::make_pair(0.0, 100.0));
+
+  const auto phi = stl::Until(
+      stl::Predicate("x") > 0, stl::Predicate("y") > 0, stl::ast::Interval{a, b});
+  const auto rob = stl::compute_robustness(phi, trace);
+
+  REQUIRE(rob->begin_time() == x->begin_time());
+  REQUIRE(rob->end_time() == x->end_time());
+  for (const auto& s : *rob) {
+    INFO("Interval [" << a << ", " << b << "] at t = " << s.time);
+    REQUIRE(s.value == Approx(until_at(*x, *y, s.time, a, b)).margin(5e-3));
+  }
+  // The robustness is linear between its breakpoints, so it also matches between
+  // them (and between the samples of the operands).
+  for (double t = 0.01; t < x->end_time(); t += 0.11) {
+    INFO("Interval [" << a << ", " << b << "] at t = " << t);
+    REQUIRE(value_at(*rob, t) == Approx(until_at(*x, *y, t, a, b)).margin(5e-3));
+  }
+}
+
+TEST_CASE("Until has breakpoints between the samples", "[robustness][until]") {
+  auto y = std::make_shared<Signal>();
+  y->push_back(0, -3);
+  y->push_back(1, 3);
+  y->push_back(2, 3);
+  const auto trace = Trace{{"y", y}};
+  const auto lhs   = stl::Predicate("y") > 0;
+  const auto rhs   = stl::Predicate("y") > 1;
+
+  // At t = 5/6, y is 2 and only increases, so the best witness is at t = 1. The
+  // values at the samples are -3 and 2, so the result must have a breakpoint in
+  // between.
+  const auto bounded = stl::Until(lhs, rhs, stl::ast::Interval{1.0, 1.5});
+  REQUIRE(
+      value_at(*stl::compute_robustness(bounded, trace), 5.0 / 6) ==
+      Approx(2.0).margin(1e-12));
+  const auto unbounded = stl::Until(lhs, rhs);
+  REQUIRE(
+      value_at(*stl::compute_robustness(unbounded, trace), 5.0 / 6) ==
+      Approx(2.0).margin(1e-12));
+
+  // Until is 0 at t = 0.5 (where y is 0), which is in the window.
+  const auto nested = stl::Eventually(~bounded, stl::ast::Interval{0.5, 0.9});
+  REQUIRE(
+      value_at(*stl::compute_robustness(nested, trace), 0.0) ==
+      Approx(0.0).margin(1e-12));
+}
+
+TEST_CASE("Until handles crossing signals", "[robustness][until]") {
+  auto x = std::make_shared<Signal>();
+  x->push_back(0, 1);
+  x->push_back(1, -1);
+  auto y = std::make_shared<Signal>();
+  y->push_back(0, -1);
+  y->push_back(1, 1);
+  const auto trace = Trace{{"x", x}, {"y", y}};
+
+  // The best witness is at t = 0.5, where both signals are 0.
+  const auto unbounded = stl::Until(stl::Predicate("x") > 0, stl::Predicate("y") > 0);
+  const auto rob_unbounded = stl::compute_robustness(unbounded, trace);
+  REQUIRE(rob_unbounded->front().value == Approx(0.0).margin(1e-12));
+
+  const auto bounded = stl::Until(
+      stl::Predicate("x") > 0, stl::Predicate("y") > 0, stl::ast::Interval{0.0, 0.5});
+  const auto rob_bounded = stl::compute_robustness(bounded, trace);
+  REQUIRE(rob_bounded->front().value == Approx(0.0).margin(1e-12));
+
+  // Only y in [0.75, 1] counts, but x is negative there.
+  const auto late = stl::Until(
+      stl::Predicate("x") > 0, stl::Predicate("y") > 0, stl::ast::Interval{0.75, 1.0});
+  REQUIRE(stl::compute_robustness(late, trace)->front().value == Approx(-0.5));
+}
+
+TEST_CASE("Until never holds if its right operand never holds", "[robustness][until]") {
+  const auto trace = Trace{{"x", make_signal(slow_sin, 0.25, 101)}};
+  const auto phi   = stl::Until(stl::Predicate("x") > -2, stl::Predicate("x") > 2);
+  const auto rob   = stl::compute_robustness(phi, trace);
+  for (const auto& s : *rob) {
+    INFO("Sample at t = " << s.time);
+    REQUIRE(s.value < 0);
+  }
+}